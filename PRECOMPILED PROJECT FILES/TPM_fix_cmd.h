@@ -1,27 +0,0 @@
-unsigned char TPM_fix_cmd[] = {
-  0x72, 0x65, 0x67, 0x20, 0x61, 0x64, 0x64, 0x20, 0x22, 0x48, 0x4b, 0x4c,
-  0x4d, 0x5c, 0x53, 0x59, 0x53, 0x54, 0x45, 0x4d, 0x5c, 0x53, 0x65, 0x74,
-  0x75, 0x70, 0x5c, 0x4c, 0x61, 0x62, 0x43, 0x6f, 0x6e, 0x66, 0x69, 0x67,
-  0x22, 0x20, 0x2f, 0x76, 0x20, 0x22, 0x42, 0x79, 0x70, 0x61, 0x73, 0x73,
-  0x54, 0x50, 0x4d, 0x43, 0x68, 0x65, 0x63, 0x6b, 0x22, 0x20, 0x2f, 0x74,
-  0x20, 0x52, 0x45, 0x47, 0x5f, 0x44, 0x57, 0x4f, 0x52, 0x44, 0x20, 0x2f,
-  0x64, 0x20, 0x31, 0x0d, 0x0a, 0x72, 0x65, 0x67, 0x20, 0x61, 0x64, 0x64,
-  0x20, 0x22, 0x48, 0x4b, 0x4c, 0x4d, 0x5c, 0x53, 0x59, 0x53, 0x54, 0x45,
-  0x4d, 0x5c, 0x53, 0x65, 0x74, 0x75, 0x70, 0x5c, 0x4c, 0x61, 0x62, 0x43,
-  0x6f, 0x6e, 0x66, 0x69, 0x67, 0x22, 0x20, 0x2f, 0x76, 0x20, 0x22, 0x42,
-  0x79, 0x70, 0x61, 0x73, 0x73, 0x52, 0x41, 0x4d, 0x43, 0x68, 0x65, 0x63,
-  0x6b, 0x22, 0x20, 0x2f, 0x74, 0x20, 0x52, 0x45, 0x47, 0x5f, 0x44, 0x57,
-  0x4f, 0x52, 0x44, 0x20, 0x2f, 0x64, 0x20, 0x31, 0x0d, 0x0a, 0x72, 0x65,
-  0x67, 0x20, 0x61, 0x64, 0x64, 0x20, 0x22, 0x48, 0x4b, 0x4c, 0x4d, 0x5c,
-  0x53, 0x59, 0x53, 0x54, 0x45, 0x4d, 0x5c, 0x53, 0x65, 0x74, 0x75, 0x70,
-  0x5c, 0x4c, 0x61, 0x62, 0x43, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x22, 0x20,
-  0x2f, 0x76, 0x20, 0x22, 0x42, 0x79, 0x70, 0x61, 0x73, 0x73, 0x53, 0x65,
-  0x63, 0x75, 0x72, 0x65, 0x42, 0x6f, 0x6f, 0x74, 0x43, 0x68, 0x65, 0x63,
-  0x6b, 0x22, 0x20, 0x2f, 0x74, 0x20, 0x52, 0x45, 0x47, 0x5f, 0x44, 0x57,
-  0x4f, 0x52, 0x44, 0x20, 0x2f, 0x64, 0x20, 0x31, 0x0d, 0x0a, 0x65, 0x63,
-  0x68, 0x6f, 0x20, 0x72, 0x65, 0x67, 0x20, 0x70, 0x61, 0x74, 0x63, 0x68,
-  0x20, 0x72, 0x61, 0x6e, 0x20, 0x4f, 0x4b, 0x20, 0x3e, 0x20, 0x58, 0x3a,
-  0x5c, 0x54, 0x50, 0x4d, 0x46, 0x49, 0x58, 0x2e, 0x54, 0x58, 0x54, 0x0d,
-  0x0a, 0x65, 0x78, 0x69, 0x74
-};
-unsigned int TPM_fix_cmd_len = 281;
@@ -1,896 +0,0 @@
-unsigned char autounattend_xml[] = {
-  0x3c, 0x3f, 0x78, 0x6d, 0x6c, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f,
-  0x6e, 0x3d, 0x22, 0x31, 0x2e, 0x30, 0x22, 0x20, 0x65, 0x6e, 0x63, 0x6f,
-  0x64, 0x69, 0x6e, 0x67, 0x3d, 0x22, 0x75, 0x74, 0x66, 0x2d, 0x38, 0x22,
-  0x3f, 0x3e, 0x0d, 0x0a, 0x3c, 0x75, 0x6e, 0x61, 0x74, 0x74, 0x65, 0x6e,
-  0x64, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3d, 0x22, 0x75, 0x72, 0x6e,
-  0x3a, 0x73, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x73, 0x2d, 0x6d, 0x69, 0x63,
-  0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2d, 0x63, 0x6f, 0x6d, 0x3a, 0x75,
-  0x6e, 0x61, 0x74, 0x74, 0x65, 0x6e, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73,
-  0x20, 0x70, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x77, 0x69, 0x6e, 0x64, 0x6f,
-  0x77, 0x73, 0x50, 0x45, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65,
-  0x6e, 0x74, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x4d, 0x69, 0x63,
-  0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2d, 0x57, 0x69, 0x6e, 0x64, 0x6f,
-  0x77, 0x73, 0x2d, 0x49, 0x6e, 0x74, 0x65, 0x72, 0x6e, 0x61, 0x74, 0x69,
-  0x6f, 0x6e, 0x61, 0x6c, 0x2d, 0x43, 0x6f, 0x72, 0x65, 0x2d, 0x57, 0x69,
-  0x6e, 0x50, 0x45, 0x22, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73,
-  0x6f, 0x72, 0x41, 0x72, 0x63, 0x68, 0x69, 0x74, 0x65, 0x63, 0x74, 0x75,
-  0x72, 0x65, 0x3d, 0x22, 0x61, 0x6d, 0x64, 0x36, 0x34, 0x22, 0x20, 0x70,
-  0x75, 0x62, 0x6c, 0x69, 0x63, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x6b, 0x65,
-  0x6e, 0x3d, 0x22, 0x33, 0x31, 0x62, 0x66, 0x33, 0x38, 0x35, 0x36, 0x61,
-  0x64, 0x33, 0x36, 0x34, 0x65, 0x33, 0x35, 0x22, 0x20, 0x6c, 0x61, 0x6e,
-  0x67, 0x75, 0x61, 0x67, 0x65, 0x3d, 0x22, 0x6e, 0x65, 0x75, 0x74, 0x72,
-  0x61, 0x6c, 0x22, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x53,
-  0x63, 0x6f, 0x70, 0x65, 0x3d, 0x22, 0x6e, 0x6f, 0x6e, 0x53, 0x78, 0x53,
-  0x22, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x77, 0x63, 0x6d,
-  0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x73, 0x63, 0x68,
-  0x65, 0x6d, 0x61, 0x73, 0x2e, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f,
-  0x66, 0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x57, 0x4d, 0x49, 0x43, 0x6f,
-  0x6e, 0x66, 0x69, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x32, 0x2f, 0x53, 0x74,
-  0x61, 0x74, 0x65, 0x22, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a,
-  0x78, 0x73, 0x69, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f,
-  0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x32,
-  0x30, 0x30, 0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68, 0x65, 0x6d,
-  0x61, 0x2d, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x22, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x3c, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x4c, 0x6f, 0x63, 0x61,
-  0x6c, 0x65, 0x3e, 0x30, 0x34, 0x30, 0x39, 0x3a, 0x30, 0x30, 0x30, 0x30,
-  0x30, 0x34, 0x30, 0x39, 0x3c, 0x2f, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x4c,
-  0x6f, 0x63, 0x61, 0x6c, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x53, 0x79, 0x73,
-  0x74, 0x65, 0x6d, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x65, 0x3e, 0x65, 0x6e,
-  0x2d, 0x55, 0x53, 0x3c, 0x2f, 0x53, 0x79, 0x73, 0x74, 0x65, 0x6d, 0x4c,
-  0x6f, 0x63, 0x61, 0x6c, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x55, 0x49, 0x4c,
-  0x61, 0x6e, 0x67, 0x75, 0x61, 0x67, 0x65, 0x3e, 0x65, 0x6e, 0x2d, 0x55,
-  0x53, 0x3c, 0x2f, 0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67, 0x75, 0x61, 0x67,
-  0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67, 0x75,
-  0x61, 0x67, 0x65, 0x46, 0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63, 0x6b, 0x3e,
-  0x65, 0x6e, 0x2d, 0x55, 0x53, 0x3c, 0x2f, 0x55, 0x49, 0x4c, 0x61, 0x6e,
-  0x67, 0x75, 0x61, 0x67, 0x65, 0x46, 0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63,
-  0x6b, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x55, 0x73, 0x65, 0x72, 0x4c, 0x6f, 0x63,
-  0x61, 0x6c, 0x65, 0x3e, 0x65, 0x6e, 0x2d, 0x55, 0x53, 0x3c, 0x2f, 0x55,
-  0x73, 0x65, 0x72, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x65, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x53, 0x65, 0x74, 0x75, 0x70, 0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67,
-  0x75, 0x61, 0x67, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67, 0x75, 0x61, 0x67, 0x65, 0x3e, 0x65,
-  0x6e, 0x2d, 0x55, 0x53, 0x3c, 0x2f, 0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67,
-  0x75, 0x61, 0x67, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x53, 0x65, 0x74,
-  0x75, 0x70, 0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67, 0x75, 0x61, 0x67, 0x65,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x2f, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x63, 0x6f,
-  0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x20, 0x6e, 0x61, 0x6d, 0x65,
-  0x3d, 0x22, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2d,
-  0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x2d, 0x53, 0x65, 0x74, 0x75,
-  0x70, 0x22, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x6f, 0x72,
-  0x41, 0x72, 0x63, 0x68, 0x69, 0x74, 0x65, 0x63, 0x74, 0x75, 0x72, 0x65,
-  0x3d, 0x22, 0x61, 0x6d, 0x64, 0x36, 0x34, 0x22, 0x20, 0x70, 0x75, 0x62,
-  0x6c, 0x69, 0x63, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x6b, 0x65, 0x6e, 0x3d,
-  0x22, 0x33, 0x31, 0x62, 0x66, 0x33, 0x38, 0x35, 0x36, 0x61, 0x64, 0x33,
-  0x36, 0x34, 0x65, 0x33, 0x35, 0x22, 0x20, 0x6c, 0x61, 0x6e, 0x67, 0x75,
-  0x61, 0x67, 0x65, 0x3d, 0x22, 0x6e, 0x65, 0x75, 0x74, 0x72, 0x61, 0x6c,
-  0x22, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x53, 0x63, 0x6f,
-  0x70, 0x65, 0x3d, 0x22, 0x6e, 0x6f, 0x6e, 0x53, 0x78, 0x53, 0x22, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x77, 0x63, 0x6d, 0x3d, 0x22,
-  0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x73, 0x63, 0x68, 0x65, 0x6d,
-  0x61, 0x73, 0x2e, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74,
-  0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x57, 0x4d, 0x49, 0x43, 0x6f, 0x6e, 0x66,
-  0x69, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x32, 0x2f, 0x53, 0x74, 0x61, 0x74,
-  0x65, 0x22, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x78, 0x73,
-  0x69, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77,
-  0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x32, 0x30, 0x30,
-  0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x2d,
-  0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x22, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x44, 0x69, 0x73, 0x6b, 0x43, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x75,
-  0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x44, 0x69, 0x73, 0x6b, 0x20, 0x77, 0x63, 0x6d, 0x3a, 0x61,
-  0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x44,
-  0x69, 0x73, 0x6b, 0x49, 0x44, 0x3e, 0x30, 0x3c, 0x2f, 0x44, 0x69, 0x73,
-  0x6b, 0x49, 0x44, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x3c, 0x57, 0x69, 0x6c, 0x6c, 0x57, 0x69, 0x70, 0x65, 0x44,
-  0x69, 0x73, 0x6b, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x57, 0x69,
-  0x6c, 0x6c, 0x57, 0x69, 0x70, 0x65, 0x44, 0x69, 0x73, 0x6b, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x43, 0x72,
-  0x65, 0x61, 0x74, 0x65, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f,
-  0x6e, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65,
-  0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x77, 0x63,
-  0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64,
-  0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f, 0x72,
-  0x64, 0x65, 0x72, 0x3e, 0x31, 0x3c, 0x2f, 0x4f, 0x72, 0x64, 0x65, 0x72,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x54, 0x79, 0x70, 0x65,
-  0x3e, 0x50, 0x72, 0x69, 0x6d, 0x61, 0x72, 0x79, 0x3c, 0x2f, 0x54, 0x79,
-  0x70, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x53, 0x69,
-  0x7a, 0x65, 0x3e, 0x33, 0x30, 0x30, 0x3c, 0x2f, 0x53, 0x69, 0x7a, 0x65,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x2f, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x50,
-  0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74,
-  0x69, 0x6f, 0x6e, 0x20, 0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69,
-  0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x32, 0x3c,
-  0x2f, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x54, 0x79, 0x70, 0x65, 0x3e, 0x45, 0x46, 0x49, 0x3c, 0x2f,
-  0x54, 0x79, 0x70, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x53, 0x69, 0x7a, 0x65, 0x3e, 0x31, 0x30, 0x30, 0x3c, 0x2f, 0x53, 0x69,
-  0x7a, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x43, 0x72, 0x65, 0x61, 0x74,
-  0x65, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x50, 0x61, 0x72, 0x74,
-  0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63,
-  0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e,
-  0x33, 0x3c, 0x2f, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x54, 0x79, 0x70, 0x65, 0x3e, 0x4d, 0x53, 0x52,
-  0x3c, 0x2f, 0x54, 0x79, 0x70, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x53, 0x69, 0x7a, 0x65, 0x3e, 0x31, 0x32, 0x38, 0x3c, 0x2f,
-  0x53, 0x69, 0x7a, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x43, 0x72, 0x65,
-  0x61, 0x74, 0x65, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x50, 0x61,
-  0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x77, 0x63, 0x6d, 0x3a,
-  0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f, 0x72, 0x64, 0x65,
-  0x72, 0x3e, 0x34, 0x3c, 0x2f, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x54, 0x79, 0x70, 0x65, 0x3e, 0x50,
-  0x72, 0x69, 0x6d, 0x61, 0x72, 0x79, 0x3c, 0x2f, 0x54, 0x79, 0x70, 0x65,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x45, 0x78, 0x74, 0x65,
-  0x6e, 0x64, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x45, 0x78, 0x74,
-  0x65, 0x6e, 0x64, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x43, 0x72, 0x65, 0x61,
-  0x74, 0x65, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f,
-  0x43, 0x72, 0x65, 0x61, 0x74, 0x65, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74,
-  0x69, 0x6f, 0x6e, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x4d, 0x6f, 0x64, 0x69, 0x66, 0x79, 0x50, 0x61,
-  0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x4d, 0x6f, 0x64, 0x69, 0x66, 0x79, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74,
-  0x69, 0x6f, 0x6e, 0x20, 0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69,
-  0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x31, 0x3c,
-  0x2f, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x49,
-  0x44, 0x3e, 0x31, 0x3c, 0x2f, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69,
-  0x6f, 0x6e, 0x49, 0x44, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x4c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x57, 0x49, 0x4e, 0x52, 0x45, 0x3c,
-  0x2f, 0x4c, 0x61, 0x62, 0x65, 0x6c, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x46, 0x6f, 0x72, 0x6d, 0x61, 0x74, 0x3e, 0x4e, 0x54, 0x46,
-  0x53, 0x3c, 0x2f, 0x46, 0x6f, 0x72, 0x6d, 0x61, 0x74, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x54, 0x79, 0x70, 0x65, 0x49, 0x44, 0x3e,
-  0x44, 0x45, 0x39, 0x34, 0x42, 0x42, 0x41, 0x34, 0x2d, 0x30, 0x36, 0x44,
-  0x31, 0x2d, 0x34, 0x44, 0x34, 0x30, 0x2d, 0x41, 0x31, 0x36, 0x41, 0x2d,
-  0x42, 0x46, 0x44, 0x35, 0x30, 0x31, 0x37, 0x39, 0x44, 0x36, 0x41, 0x43,
-  0x3c, 0x2f, 0x54, 0x79, 0x70, 0x65, 0x49, 0x44, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x2f, 0x4d, 0x6f, 0x64, 0x69, 0x66, 0x79, 0x50, 0x61, 0x72, 0x74, 0x69,
-  0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4d, 0x6f, 0x64, 0x69,
-  0x66, 0x79, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20,
-  0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22,
-  0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x32, 0x3c, 0x2f, 0x4f, 0x72, 0x64,
-  0x65, 0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x50, 0x61,
-  0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44, 0x3e, 0x32, 0x3c,
-  0x2f, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4c, 0x61, 0x62, 0x65,
-  0x6c, 0x3e, 0x53, 0x79, 0x73, 0x74, 0x65, 0x6d, 0x3c, 0x2f, 0x4c, 0x61,
-  0x62, 0x65, 0x6c, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x46,
-  0x6f, 0x72, 0x6d, 0x61, 0x74, 0x3e, 0x46, 0x41, 0x54, 0x33, 0x32, 0x3c,
-  0x2f, 0x46, 0x6f, 0x72, 0x6d, 0x61, 0x74, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f,
-  0x4d, 0x6f, 0x64, 0x69, 0x66, 0x79, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74,
-  0x69, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4d, 0x6f, 0x64, 0x69, 0x66,
-  0x79, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x77,
-  0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22, 0x61,
-  0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f,
-  0x72, 0x64, 0x65, 0x72, 0x3e, 0x33, 0x3c, 0x2f, 0x4f, 0x72, 0x64, 0x65,
-  0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x50, 0x61, 0x72,
-  0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44, 0x3e, 0x33, 0x3c, 0x2f,
-  0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x3c, 0x2f, 0x4d, 0x6f, 0x64, 0x69, 0x66, 0x79, 0x50, 0x61,
-  0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4d,
-  0x6f, 0x64, 0x69, 0x66, 0x79, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69,
-  0x6f, 0x6e, 0x20, 0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69, 0x6f,
-  0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x3c, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x34, 0x3c, 0x2f,
-  0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44,
-  0x3e, 0x34, 0x3c, 0x2f, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f,
-  0x6e, 0x49, 0x44, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4c,
-  0x61, 0x62, 0x65, 0x6c, 0x3e, 0x4f, 0x53, 0x3c, 0x2f, 0x4c, 0x61, 0x62,
-  0x65, 0x6c, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4c, 0x65,
-  0x74, 0x74, 0x65, 0x72, 0x3e, 0x43, 0x3c, 0x2f, 0x4c, 0x65, 0x74, 0x74,
-  0x65, 0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x46, 0x6f,
-  0x72, 0x6d, 0x61, 0x74, 0x3e, 0x4e, 0x54, 0x46, 0x53, 0x3c, 0x2f, 0x46,
-  0x6f, 0x72, 0x6d, 0x61, 0x74, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x4d, 0x6f,
-  0x64, 0x69, 0x66, 0x79, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f,
-  0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x2f, 0x4d, 0x6f, 0x64, 0x69, 0x66, 0x79, 0x50, 0x61, 0x72, 0x74,
-  0x69, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x2f, 0x44, 0x69, 0x73, 0x6b, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f,
-  0x44, 0x69, 0x73, 0x6b, 0x43, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x75, 0x72,
-  0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x52, 0x75, 0x6e,
-  0x53, 0x79, 0x6e, 0x63, 0x68, 0x72, 0x6f, 0x6e, 0x6f, 0x75, 0x73, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x52, 0x75, 0x6e, 0x53, 0x79,
-  0x6e, 0x63, 0x68, 0x72, 0x6f, 0x6e, 0x6f, 0x75, 0x73, 0x43, 0x6f, 0x6d,
-  0x6d, 0x61, 0x6e, 0x64, 0x20, 0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74,
-  0x69, 0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f, 0x72, 0x64,
-  0x65, 0x72, 0x3e, 0x31, 0x3c, 0x2f, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x50,
-  0x61, 0x74, 0x68, 0x3e, 0x63, 0x6d, 0x64, 0x20, 0x2f, 0x71, 0x20, 0x2f,
-  0x63, 0x20, 0x22, 0x46, 0x4f, 0x52, 0x20, 0x25, 0x69, 0x20, 0x49, 0x4e,
-  0x20, 0x28, 0x43, 0x20, 0x44, 0x20, 0x45, 0x20, 0x46, 0x20, 0x47, 0x20,
-  0x48, 0x20, 0x49, 0x20, 0x4a, 0x20, 0x4b, 0x20, 0x4c, 0x20, 0x4e, 0x20,
-  0x4d, 0x20, 0x4f, 0x20, 0x50, 0x20, 0x51, 0x20, 0x52, 0x20, 0x53, 0x20,
-  0x54, 0x20, 0x55, 0x20, 0x56, 0x20, 0x57, 0x20, 0x58, 0x20, 0x59, 0x20,
-  0x5a, 0x29, 0x20, 0x44, 0x4f, 0x20, 0x49, 0x46, 0x20, 0x45, 0x58, 0x49,
-  0x53, 0x54, 0x20, 0x25, 0x69, 0x3a, 0x5c, 0x54, 0x50, 0x4d, 0x5f, 0x46,
-  0x69, 0x78, 0x2e, 0x63, 0x6d, 0x64, 0x20, 0x63, 0x6d, 0x64, 0x20, 0x2f,
-  0x6b, 0x20, 0x25, 0x69, 0x3a, 0x5c, 0x54, 0x50, 0x4d, 0x5f, 0x46, 0x69,
-  0x78, 0x2e, 0x63, 0x6d, 0x64, 0x22, 0x3c, 0x2f, 0x50, 0x61, 0x74, 0x68,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x69, 0x6f, 0x6e, 0x3e,
-  0x44, 0x65, 0x74, 0x65, 0x63, 0x74, 0x69, 0x6e, 0x67, 0x20, 0x54, 0x50,
-  0x4d, 0x20, 0x66, 0x69, 0x78, 0x20, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74,
-  0x3c, 0x2f, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x69, 0x6f,
-  0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x52, 0x75,
-  0x6e, 0x53, 0x79, 0x6e, 0x63, 0x68, 0x72, 0x6f, 0x6e, 0x6f, 0x75, 0x73,
-  0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f,
-  0x52, 0x75, 0x6e, 0x53, 0x79, 0x6e, 0x63, 0x68, 0x72, 0x6f, 0x6e, 0x6f,
-  0x75, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x44, 0x69, 0x61, 0x67, 0x6e, 0x6f,
-  0x73, 0x74, 0x69, 0x63, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x4f, 0x70, 0x74, 0x49, 0x6e, 0x3e, 0x66, 0x61, 0x6c, 0x73, 0x65,
-  0x3c, 0x2f, 0x4f, 0x70, 0x74, 0x49, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f,
-  0x44, 0x69, 0x61, 0x67, 0x6e, 0x6f, 0x73, 0x74, 0x69, 0x63, 0x73, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x3c, 0x44, 0x79, 0x6e, 0x61, 0x6d, 0x69, 0x63, 0x55, 0x70,
-  0x64, 0x61, 0x74, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x45, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x3e, 0x66, 0x61, 0x6c, 0x73, 0x65,
-  0x3c, 0x2f, 0x45, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x57, 0x69, 0x6c, 0x6c, 0x53, 0x68, 0x6f, 0x77,
-  0x55, 0x49, 0x3e, 0x4f, 0x6e, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x3c, 0x2f,
-  0x57, 0x69, 0x6c, 0x6c, 0x53, 0x68, 0x6f, 0x77, 0x55, 0x49, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x2f, 0x44, 0x79, 0x6e, 0x61, 0x6d, 0x69, 0x63, 0x55, 0x70,
-  0x64, 0x61, 0x74, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x55, 0x73, 0x65, 0x72,
-  0x44, 0x61, 0x74, 0x61, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x41, 0x63, 0x63, 0x65, 0x70, 0x74, 0x45, 0x75, 0x6c, 0x61, 0x3e, 0x74,
-  0x72, 0x75, 0x65, 0x3c, 0x2f, 0x41, 0x63, 0x63, 0x65, 0x70, 0x74, 0x45,
-  0x75, 0x6c, 0x61, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x50,
-  0x72, 0x6f, 0x64, 0x75, 0x63, 0x74, 0x4b, 0x65, 0x79, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4b, 0x65, 0x79,
-  0x3e, 0x3c, 0x2f, 0x4b, 0x65, 0x79, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x57, 0x69, 0x6c, 0x6c, 0x53, 0x68,
-  0x6f, 0x77, 0x55, 0x49, 0x3e, 0x4e, 0x65, 0x76, 0x65, 0x72, 0x3c, 0x2f,
-  0x57, 0x69, 0x6c, 0x6c, 0x53, 0x68, 0x6f, 0x77, 0x55, 0x49, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x50, 0x72, 0x6f, 0x64, 0x75,
-  0x63, 0x74, 0x4b, 0x65, 0x79, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x55, 0x73,
-  0x65, 0x72, 0x44, 0x61, 0x74, 0x61, 0x3e, 0x0d, 0x0a, 0x09, 0x09, 0x09,
-  0x3c, 0x49, 0x6d, 0x61, 0x67, 0x65, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6c,
-  0x6c, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f, 0x53, 0x49,
-  0x6d, 0x61, 0x67, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6c, 0x6c, 0x46,
-  0x72, 0x6f, 0x6d, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4d, 0x65, 0x74, 0x61, 0x44,
-  0x61, 0x74, 0x61, 0x20, 0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69,
-  0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x4b, 0x65, 0x79, 0x3e, 0x2f, 0x49, 0x4d, 0x41,
-  0x47, 0x45, 0x2f, 0x4e, 0x41, 0x4d, 0x45, 0x3c, 0x2f, 0x4b, 0x65, 0x79,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x56, 0x61, 0x6c, 0x75,
-  0x65, 0x3e, 0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x20, 0x31, 0x30,
-  0x20, 0x48, 0x6f, 0x6d, 0x65, 0x3c, 0x2f, 0x56, 0x61, 0x6c, 0x75, 0x65,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x2f, 0x4d, 0x65, 0x74, 0x61, 0x44, 0x61, 0x74,
-  0x61, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x2f, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6c, 0x6c, 0x46, 0x72, 0x6f,
-  0x6d, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6c, 0x6c, 0x54, 0x6f, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x44, 0x69, 0x73, 0x6b, 0x49, 0x44, 0x3e, 0x30, 0x3c, 0x2f,
-  0x44, 0x69, 0x73, 0x6b, 0x49, 0x44, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x50, 0x61,
-  0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44, 0x3e, 0x34, 0x3c,
-  0x2f, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x49, 0x44,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x2f, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6c, 0x6c, 0x54, 0x6f, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x49, 0x6e,
-  0x73, 0x74, 0x61, 0x6c, 0x6c, 0x54, 0x6f, 0x41, 0x76, 0x61, 0x69, 0x6c,
-  0x61, 0x62, 0x6c, 0x65, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f,
-  0x6e, 0x3e, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3c, 0x2f, 0x49, 0x6e, 0x73,
-  0x74, 0x61, 0x6c, 0x6c, 0x54, 0x6f, 0x41, 0x76, 0x61, 0x69, 0x6c, 0x61,
-  0x62, 0x6c, 0x65, 0x50, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x4f, 0x53, 0x49,
-  0x6d, 0x61, 0x67, 0x65, 0x3e, 0x0d, 0x0a, 0x3c, 0x2f, 0x49, 0x6d, 0x61,
-  0x67, 0x65, 0x49, 0x6e, 0x73, 0x74, 0x61, 0x6c, 0x6c, 0x3e, 0x0d, 0x0a,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f,
-  0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e,
-  0x67, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x73, 0x65,
-  0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x20, 0x70, 0x61, 0x73, 0x73, 0x3d,
-  0x22, 0x6f, 0x66, 0x66, 0x6c, 0x69, 0x6e, 0x65, 0x53, 0x65, 0x72, 0x76,
-  0x69, 0x63, 0x69, 0x6e, 0x67, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e,
-  0x65, 0x6e, 0x74, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x4d, 0x69,
-  0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2d, 0x57, 0x69, 0x6e, 0x64,
-  0x6f, 0x77, 0x73, 0x2d, 0x4c, 0x55, 0x41, 0x2d, 0x53, 0x65, 0x74, 0x74,
-  0x69, 0x6e, 0x67, 0x73, 0x22, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73,
-  0x73, 0x6f, 0x72, 0x41, 0x72, 0x63, 0x68, 0x69, 0x74, 0x65, 0x63, 0x74,
-  0x75, 0x72, 0x65, 0x3d, 0x22, 0x61, 0x6d, 0x64, 0x36, 0x34, 0x22, 0x20,
-  0x70, 0x75, 0x62, 0x6c, 0x69, 0x63, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x6b,
-  0x65, 0x6e, 0x3d, 0x22, 0x33, 0x31, 0x62, 0x66, 0x33, 0x38, 0x35, 0x36,
-  0x61, 0x64, 0x33, 0x36, 0x34, 0x65, 0x33, 0x35, 0x22, 0x20, 0x6c, 0x61,
-  0x6e, 0x67, 0x75, 0x61, 0x67, 0x65, 0x3d, 0x22, 0x6e, 0x65, 0x75, 0x74,
-  0x72, 0x61, 0x6c, 0x22, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e,
-  0x53, 0x63, 0x6f, 0x70, 0x65, 0x3d, 0x22, 0x6e, 0x6f, 0x6e, 0x53, 0x78,
-  0x53, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x77, 0x63, 0x6d,
-  0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x73, 0x63, 0x68,
-  0x65, 0x6d, 0x61, 0x73, 0x2e, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f,
-  0x66, 0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x57, 0x4d, 0x49, 0x43, 0x6f,
-  0x6e, 0x66, 0x69, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x32, 0x2f, 0x53, 0x74,
-  0x61, 0x74, 0x65, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x78,
-  0x73, 0x69, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77,
-  0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x32, 0x30,
-  0x30, 0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61,
-  0x2d, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x22, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x45, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x4c, 0x55, 0x41, 0x3e,
-  0x66, 0x61, 0x6c, 0x73, 0x65, 0x3c, 0x2f, 0x45, 0x6e, 0x61, 0x62, 0x6c,
-  0x65, 0x4c, 0x55, 0x41, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x2f, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65,
-  0x6e, 0x74, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x73,
-  0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x3c, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x20,
-  0x70, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x67, 0x65, 0x6e, 0x65, 0x72, 0x61,
-  0x6c, 0x69, 0x7a, 0x65, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65,
-  0x6e, 0x74, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x4d, 0x69, 0x63,
-  0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2d, 0x57, 0x69, 0x6e, 0x64, 0x6f,
-  0x77, 0x73, 0x2d, 0x53, 0x65, 0x63, 0x75, 0x72, 0x69, 0x74, 0x79, 0x2d,
-  0x53, 0x50, 0x50, 0x22, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73,
-  0x6f, 0x72, 0x41, 0x72, 0x63, 0x68, 0x69, 0x74, 0x65, 0x63, 0x74, 0x75,
-  0x72, 0x65, 0x3d, 0x22, 0x61, 0x6d, 0x64, 0x36, 0x34, 0x22, 0x20, 0x70,
-  0x75, 0x62, 0x6c, 0x69, 0x63, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x6b, 0x65,
-  0x6e, 0x3d, 0x22, 0x33, 0x31, 0x62, 0x66, 0x33, 0x38, 0x35, 0x36, 0x61,
-  0x64, 0x33, 0x36, 0x34, 0x65, 0x33, 0x35, 0x22, 0x20, 0x6c, 0x61, 0x6e,
-  0x67, 0x75, 0x61, 0x67, 0x65, 0x3d, 0x22, 0x6e, 0x65, 0x75, 0x74, 0x72,
-  0x61, 0x6c, 0x22, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x53,
-  0x63, 0x6f, 0x70, 0x65, 0x3d, 0x22, 0x6e, 0x6f, 0x6e, 0x53, 0x78, 0x53,
-  0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x77, 0x63, 0x6d, 0x3d,
-  0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x73, 0x63, 0x68, 0x65,
-  0x6d, 0x61, 0x73, 0x2e, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66,
-  0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x57, 0x4d, 0x49, 0x43, 0x6f, 0x6e,
-  0x66, 0x69, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x32, 0x2f, 0x53, 0x74, 0x61,
-  0x74, 0x65, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x78, 0x73,
-  0x69, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77,
-  0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x32, 0x30, 0x30,
-  0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x2d,
-  0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x22, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x53, 0x6b, 0x69, 0x70, 0x52, 0x65, 0x61, 0x72, 0x6d, 0x3e, 0x31,
-  0x3c, 0x2f, 0x53, 0x6b, 0x69, 0x70, 0x52, 0x65, 0x61, 0x72, 0x6d, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f,
-  0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e,
-  0x67, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x73, 0x65,
-  0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x20, 0x70, 0x61, 0x73, 0x73, 0x3d,
-  0x22, 0x73, 0x70, 0x65, 0x63, 0x69, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x22,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x20, 0x6e, 0x61,
-  0x6d, 0x65, 0x3d, 0x22, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66,
-  0x74, 0x2d, 0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x2d, 0x49, 0x6e,
-  0x74, 0x65, 0x72, 0x6e, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x61, 0x6c, 0x2d,
-  0x43, 0x6f, 0x72, 0x65, 0x22, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73,
-  0x73, 0x6f, 0x72, 0x41, 0x72, 0x63, 0x68, 0x69, 0x74, 0x65, 0x63, 0x74,
-  0x75, 0x72, 0x65, 0x3d, 0x22, 0x61, 0x6d, 0x64, 0x36, 0x34, 0x22, 0x20,
-  0x70, 0x75, 0x62, 0x6c, 0x69, 0x63, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x6b,
-  0x65, 0x6e, 0x3d, 0x22, 0x33, 0x31, 0x62, 0x66, 0x33, 0x38, 0x35, 0x36,
-  0x61, 0x64, 0x33, 0x36, 0x34, 0x65, 0x33, 0x35, 0x22, 0x20, 0x6c, 0x61,
-  0x6e, 0x67, 0x75, 0x61, 0x67, 0x65, 0x3d, 0x22, 0x6e, 0x65, 0x75, 0x74,
-  0x72, 0x61, 0x6c, 0x22, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e,
-  0x53, 0x63, 0x6f, 0x70, 0x65, 0x3d, 0x22, 0x6e, 0x6f, 0x6e, 0x53, 0x78,
-  0x53, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x77, 0x63, 0x6d,
-  0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x73, 0x63, 0x68,
-  0x65, 0x6d, 0x61, 0x73, 0x2e, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f,
-  0x66, 0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x57, 0x4d, 0x49, 0x43, 0x6f,
-  0x6e, 0x66, 0x69, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x32, 0x2f, 0x53, 0x74,
-  0x61, 0x74, 0x65, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x78,
-  0x73, 0x69, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77,
-  0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x32, 0x30,
-  0x30, 0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61,
-  0x2d, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x22, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x4c, 0x6f, 0x63, 0x61, 0x6c,
-  0x65, 0x3e, 0x30, 0x34, 0x30, 0x39, 0x3a, 0x30, 0x30, 0x30, 0x30, 0x30,
-  0x34, 0x30, 0x39, 0x3c, 0x2f, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x4c, 0x6f,
-  0x63, 0x61, 0x6c, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x53, 0x79, 0x73, 0x74,
-  0x65, 0x6d, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x65, 0x3e, 0x65, 0x6e, 0x2d,
-  0x55, 0x53, 0x3c, 0x2f, 0x53, 0x79, 0x73, 0x74, 0x65, 0x6d, 0x4c, 0x6f,
-  0x63, 0x61, 0x6c, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x55, 0x49, 0x4c, 0x61,
-  0x6e, 0x67, 0x75, 0x61, 0x67, 0x65, 0x3e, 0x65, 0x6e, 0x2d, 0x55, 0x53,
-  0x3c, 0x2f, 0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67, 0x75, 0x61, 0x67, 0x65,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67, 0x75, 0x61,
-  0x67, 0x65, 0x46, 0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63, 0x6b, 0x3e, 0x65,
-  0x6e, 0x2d, 0x55, 0x53, 0x3c, 0x2f, 0x55, 0x49, 0x4c, 0x61, 0x6e, 0x67,
-  0x75, 0x61, 0x67, 0x65, 0x46, 0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63, 0x6b,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x55, 0x73, 0x65, 0x72, 0x4c, 0x6f, 0x63, 0x61,
-  0x6c, 0x65, 0x3e, 0x65, 0x6e, 0x2d, 0x55, 0x53, 0x3c, 0x2f, 0x55, 0x73,
-  0x65, 0x72, 0x4c, 0x6f, 0x63, 0x61, 0x6c, 0x65, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x63, 0x6f, 0x6d,
-  0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e,
-  0x65, 0x6e, 0x74, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x4d, 0x69,
-  0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2d, 0x57, 0x69, 0x6e, 0x64,
-  0x6f, 0x77, 0x73, 0x2d, 0x53, 0x65, 0x63, 0x75, 0x72, 0x69, 0x74, 0x79,
-  0x2d, 0x53, 0x50, 0x50, 0x2d, 0x55, 0x58, 0x22, 0x20, 0x70, 0x72, 0x6f,
-  0x63, 0x65, 0x73, 0x73, 0x6f, 0x72, 0x41, 0x72, 0x63, 0x68, 0x69, 0x74,
-  0x65, 0x63, 0x74, 0x75, 0x72, 0x65, 0x3d, 0x22, 0x61, 0x6d, 0x64, 0x36,
-  0x34, 0x22, 0x20, 0x70, 0x75, 0x62, 0x6c, 0x69, 0x63, 0x4b, 0x65, 0x79,
-  0x54, 0x6f, 0x6b, 0x65, 0x6e, 0x3d, 0x22, 0x33, 0x31, 0x62, 0x66, 0x33,
-  0x38, 0x35, 0x36, 0x61, 0x64, 0x33, 0x36, 0x34, 0x65, 0x33, 0x35, 0x22,
-  0x20, 0x6c, 0x61, 0x6e, 0x67, 0x75, 0x61, 0x67, 0x65, 0x3d, 0x22, 0x6e,
-  0x65, 0x75, 0x74, 0x72, 0x61, 0x6c, 0x22, 0x20, 0x76, 0x65, 0x72, 0x73,
-  0x69, 0x6f, 0x6e, 0x53, 0x63, 0x6f, 0x70, 0x65, 0x3d, 0x22, 0x6e, 0x6f,
-  0x6e, 0x53, 0x78, 0x53, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a,
-  0x77, 0x63, 0x6d, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f,
-  0x73, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x73, 0x2e, 0x6d, 0x69, 0x63, 0x72,
-  0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x57, 0x4d,
-  0x49, 0x43, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x32,
-  0x2f, 0x53, 0x74, 0x61, 0x74, 0x65, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e,
-  0x73, 0x3a, 0x78, 0x73, 0x69, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a,
-  0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67,
-  0x2f, 0x32, 0x30, 0x30, 0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68,
-  0x65, 0x6d, 0x61, 0x2d, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65,
-  0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x53, 0x6b, 0x69, 0x70, 0x41, 0x75, 0x74,
-  0x6f, 0x41, 0x63, 0x74, 0x69, 0x76, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3e,
-  0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x53, 0x6b, 0x69, 0x70, 0x41, 0x75,
-  0x74, 0x6f, 0x41, 0x63, 0x74, 0x69, 0x76, 0x61, 0x74, 0x69, 0x6f, 0x6e,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x2f, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x63, 0x6f,
-  0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x20, 0x6e, 0x61, 0x6d, 0x65,
-  0x3d, 0x22, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2d,
-  0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x2d, 0x53, 0x51, 0x4d, 0x41,
-  0x70, 0x69, 0x22, 0x20, 0x70, 0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x6f,
-  0x72, 0x41, 0x72, 0x63, 0x68, 0x69, 0x74, 0x65, 0x63, 0x74, 0x75, 0x72,
-  0x65, 0x3d, 0x22, 0x61, 0x6d, 0x64, 0x36, 0x34, 0x22, 0x20, 0x70, 0x75,
-  0x62, 0x6c, 0x69, 0x63, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x6b, 0x65, 0x6e,
-  0x3d, 0x22, 0x33, 0x31, 0x62, 0x66, 0x33, 0x38, 0x35, 0x36, 0x61, 0x64,
-  0x33, 0x36, 0x34, 0x65, 0x33, 0x35, 0x22, 0x20, 0x6c, 0x61, 0x6e, 0x67,
-  0x75, 0x61, 0x67, 0x65, 0x3d, 0x22, 0x6e, 0x65, 0x75, 0x74, 0x72, 0x61,
-  0x6c, 0x22, 0x20, 0x76, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x53, 0x63,
-  0x6f, 0x70, 0x65, 0x3d, 0x22, 0x6e, 0x6f, 0x6e, 0x53, 0x78, 0x53, 0x22,
-  0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x77, 0x63, 0x6d, 0x3d, 0x22,
-  0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x73, 0x63, 0x68, 0x65, 0x6d,
-  0x61, 0x73, 0x2e, 0x6d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74,
-  0x2e, 0x63, 0x6f, 0x6d, 0x2f, 0x57, 0x4d, 0x49, 0x43, 0x6f, 0x6e, 0x66,
-  0x69, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x32, 0x2f, 0x53, 0x74, 0x61, 0x74,
-  0x65, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e, 0x73, 0x3a, 0x78, 0x73, 0x69,
-  0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77,
-  0x2e, 0x77, 0x33, 0x2e, 0x6f, 0x72, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x31,
-  0x2f, 0x58, 0x4d, 0x4c, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x2d, 0x69,
-  0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x22, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x43, 0x45, 0x49, 0x50, 0x45, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x3e,
-  0x30, 0x3c, 0x2f, 0x43, 0x45, 0x49, 0x50, 0x45, 0x6e, 0x61, 0x62, 0x6c,
-  0x65, 0x64, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x2f, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e,
-  0x67, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x73, 0x65,
-  0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x20, 0x70, 0x61, 0x73, 0x73, 0x3d,
-  0x22, 0x6f, 0x6f, 0x62, 0x65, 0x53, 0x79, 0x73, 0x74, 0x65, 0x6d, 0x22,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x20, 0x6e, 0x61,
-  0x6d, 0x65, 0x3d, 0x22, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66,
-  0x74, 0x2d, 0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x2d, 0x53, 0x68,
-  0x65, 0x6c, 0x6c, 0x2d, 0x53, 0x65, 0x74, 0x75, 0x70, 0x22, 0x20, 0x70,
-  0x72, 0x6f, 0x63, 0x65, 0x73, 0x73, 0x6f, 0x72, 0x41, 0x72, 0x63, 0x68,
-  0x69, 0x74, 0x65, 0x63, 0x74, 0x75, 0x72, 0x65, 0x3d, 0x22, 0x61, 0x6d,
-  0x64, 0x36, 0x34, 0x22, 0x20, 0x70, 0x75, 0x62, 0x6c, 0x69, 0x63, 0x4b,
-  0x65, 0x79, 0x54, 0x6f, 0x6b, 0x65, 0x6e, 0x3d, 0x22, 0x33, 0x31, 0x62,
-  0x66, 0x33, 0x38, 0x35, 0x36, 0x61, 0x64, 0x33, 0x36, 0x34, 0x65, 0x33,
-  0x35, 0x22, 0x20, 0x6c, 0x61, 0x6e, 0x67, 0x75, 0x61, 0x67, 0x65, 0x3d,
-  0x22, 0x6e, 0x65, 0x75, 0x74, 0x72, 0x61, 0x6c, 0x22, 0x20, 0x76, 0x65,
-  0x72, 0x73, 0x69, 0x6f, 0x6e, 0x53, 0x63, 0x6f, 0x70, 0x65, 0x3d, 0x22,
-  0x6e, 0x6f, 0x6e, 0x53, 0x78, 0x53, 0x22, 0x20, 0x78, 0x6d, 0x6c, 0x6e,
-  0x73, 0x3a, 0x77, 0x63, 0x6d, 0x3d, 0x22, 0x68, 0x74, 0x74, 0x70, 0x3a,
-  0x2f, 0x2f, 0x73, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x73, 0x2e, 0x6d, 0x69,
-  0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x2e, 0x63, 0x6f, 0x6d, 0x2f,
-  0x57, 0x4d, 0x49, 0x43, 0x6f, 0x6e, 0x66, 0x69, 0x67, 0x2f, 0x32, 0x30,
-  0x30, 0x32, 0x2f, 0x53, 0x74, 0x61, 0x74, 0x65, 0x22, 0x20, 0x78, 0x6d,
-  0x6c, 0x6e, 0x73, 0x3a, 0x78, 0x73, 0x69, 0x3d, 0x22, 0x68, 0x74, 0x74,
-  0x70, 0x3a, 0x2f, 0x2f, 0x77, 0x77, 0x77, 0x2e, 0x77, 0x33, 0x2e, 0x6f,
-  0x72, 0x67, 0x2f, 0x32, 0x30, 0x30, 0x31, 0x2f, 0x58, 0x4d, 0x4c, 0x53,
-  0x63, 0x68, 0x65, 0x6d, 0x61, 0x2d, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e,
-  0x63, 0x65, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x41, 0x75, 0x74, 0x6f, 0x4c,
-  0x6f, 0x67, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x50, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x56, 0x61, 0x6c, 0x75,
-  0x65, 0x3e, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x3c, 0x2f,
-  0x56, 0x61, 0x6c, 0x75, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x50, 0x6c, 0x61, 0x69, 0x6e, 0x54, 0x65,
-  0x78, 0x74, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x50, 0x6c, 0x61,
-  0x69, 0x6e, 0x54, 0x65, 0x78, 0x74, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x2f, 0x50, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x45, 0x6e, 0x61, 0x62, 0x6c,
-  0x65, 0x64, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x45, 0x6e, 0x61,
-  0x62, 0x6c, 0x65, 0x64, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x55, 0x73, 0x65, 0x72, 0x6e, 0x61, 0x6d, 0x65, 0x3e, 0x75, 0x73, 0x65,
-  0x72, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3c, 0x2f, 0x55, 0x73, 0x65, 0x72,
-  0x6e, 0x61, 0x6d, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x41, 0x75, 0x74,
-  0x6f, 0x4c, 0x6f, 0x67, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f, 0x4f,
-  0x42, 0x45, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x48, 0x69,
-  0x64, 0x65, 0x45, 0x55, 0x4c, 0x41, 0x50, 0x61, 0x67, 0x65, 0x3e, 0x74,
-  0x72, 0x75, 0x65, 0x3c, 0x2f, 0x48, 0x69, 0x64, 0x65, 0x45, 0x55, 0x4c,
-  0x41, 0x50, 0x61, 0x67, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x48, 0x69, 0x64, 0x65, 0x4f, 0x45, 0x4d, 0x52, 0x65, 0x67, 0x69,
-  0x73, 0x74, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x53, 0x63, 0x72, 0x65,
-  0x65, 0x6e, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x48, 0x69, 0x64,
-  0x65, 0x4f, 0x45, 0x4d, 0x52, 0x65, 0x67, 0x69, 0x73, 0x74, 0x72, 0x61,
-  0x74, 0x69, 0x6f, 0x6e, 0x53, 0x63, 0x72, 0x65, 0x65, 0x6e, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x48, 0x69, 0x64, 0x65, 0x4f, 0x6e,
-  0x6c, 0x69, 0x6e, 0x65, 0x41, 0x63, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x53,
-  0x63, 0x72, 0x65, 0x65, 0x6e, 0x73, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c,
-  0x2f, 0x48, 0x69, 0x64, 0x65, 0x4f, 0x6e, 0x6c, 0x69, 0x6e, 0x65, 0x41,
-  0x63, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x53, 0x63, 0x72, 0x65, 0x65, 0x6e,
-  0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x48, 0x69, 0x64,
-  0x65, 0x57, 0x69, 0x72, 0x65, 0x6c, 0x65, 0x73, 0x73, 0x53, 0x65, 0x74,
-  0x75, 0x70, 0x49, 0x6e, 0x4f, 0x4f, 0x42, 0x45, 0x3e, 0x74, 0x72, 0x75,
-  0x65, 0x3c, 0x2f, 0x48, 0x69, 0x64, 0x65, 0x57, 0x69, 0x72, 0x65, 0x6c,
-  0x65, 0x73, 0x73, 0x53, 0x65, 0x74, 0x75, 0x70, 0x49, 0x6e, 0x4f, 0x4f,
-  0x42, 0x45, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4e, 0x65,
-  0x74, 0x77, 0x6f, 0x72, 0x6b, 0x4c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f,
-  0x6e, 0x3e, 0x48, 0x6f, 0x6d, 0x65, 0x3c, 0x2f, 0x4e, 0x65, 0x74, 0x77,
-  0x6f, 0x72, 0x6b, 0x4c, 0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x53, 0x6b, 0x69, 0x70, 0x55,
-  0x73, 0x65, 0x72, 0x4f, 0x4f, 0x42, 0x45, 0x3e, 0x74, 0x72, 0x75, 0x65,
-  0x3c, 0x2f, 0x53, 0x6b, 0x69, 0x70, 0x55, 0x73, 0x65, 0x72, 0x4f, 0x4f,
-  0x42, 0x45, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x53, 0x6b,
-  0x69, 0x70, 0x4d, 0x61, 0x63, 0x68, 0x69, 0x6e, 0x65, 0x4f, 0x4f, 0x42,
-  0x45, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x53, 0x6b, 0x69, 0x70,
-  0x4d, 0x61, 0x63, 0x68, 0x69, 0x6e, 0x65, 0x4f, 0x4f, 0x42, 0x45, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x50, 0x72, 0x6f, 0x74, 0x65,
-  0x63, 0x74, 0x59, 0x6f, 0x75, 0x72, 0x50, 0x43, 0x3e, 0x31, 0x3c, 0x2f,
-  0x50, 0x72, 0x6f, 0x74, 0x65, 0x63, 0x74, 0x59, 0x6f, 0x75, 0x72, 0x50,
-  0x43, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x4f, 0x4f, 0x42, 0x45, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x55, 0x73, 0x65, 0x72, 0x41, 0x63, 0x63, 0x6f, 0x75, 0x6e,
-  0x74, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4c, 0x6f,
-  0x63, 0x61, 0x6c, 0x41, 0x63, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x73, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4c,
-  0x6f, 0x63, 0x61, 0x6c, 0x41, 0x63, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x20,
-  0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22,
-  0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x50, 0x61, 0x73, 0x73,
-  0x77, 0x6f, 0x72, 0x64, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x56, 0x61, 0x6c, 0x75, 0x65, 0x3e, 0x70, 0x61, 0x73, 0x73, 0x77, 0x6f,
-  0x72, 0x64, 0x3c, 0x2f, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x50, 0x6c, 0x61, 0x69, 0x6e, 0x54, 0x65,
-  0x78, 0x74, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x50, 0x6c, 0x61,
-  0x69, 0x6e, 0x54, 0x65, 0x78, 0x74, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x50,
-  0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x44,
-  0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x3c,
-  0x2f, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x69, 0x6f, 0x6e,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x44, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x4e,
-  0x61, 0x6d, 0x65, 0x3e, 0x75, 0x73, 0x65, 0x72, 0x20, 0x6e, 0x61, 0x6d,
-  0x65, 0x3c, 0x2f, 0x44, 0x69, 0x73, 0x70, 0x6c, 0x61, 0x79, 0x4e, 0x61,
-  0x6d, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x47, 0x72, 0x6f, 0x75, 0x70, 0x3e,
-  0x41, 0x64, 0x6d, 0x69, 0x6e, 0x69, 0x73, 0x74, 0x72, 0x61, 0x74, 0x6f,
-  0x72, 0x73, 0x3c, 0x2f, 0x47, 0x72, 0x6f, 0x75, 0x70, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x4e, 0x61, 0x6d, 0x65, 0x3e, 0x75, 0x73, 0x65, 0x72, 0x20, 0x6e,
-  0x61, 0x6d, 0x65, 0x3c, 0x2f, 0x4e, 0x61, 0x6d, 0x65, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x4c, 0x6f,
-  0x63, 0x61, 0x6c, 0x41, 0x63, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x3e, 0x0d,
-  0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x4c, 0x6f, 0x63, 0x61, 0x6c,
-  0x41, 0x63, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x73, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x2f, 0x55, 0x73, 0x65, 0x72, 0x41, 0x63, 0x63, 0x6f, 0x75, 0x6e, 0x74,
-  0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x52, 0x65, 0x67, 0x69, 0x73, 0x74, 0x65,
-  0x72, 0x65, 0x64, 0x4f, 0x72, 0x67, 0x61, 0x6e, 0x69, 0x7a, 0x61, 0x74,
-  0x69, 0x6f, 0x6e, 0x3e, 0x4f, 0x72, 0x67, 0x61, 0x6e, 0x69, 0x7a, 0x61,
-  0x74, 0x69, 0x6f, 0x6e, 0x20, 0x4e, 0x61, 0x6d, 0x65, 0x3c, 0x2f, 0x52,
-  0x65, 0x67, 0x69, 0x73, 0x74, 0x65, 0x72, 0x65, 0x64, 0x4f, 0x72, 0x67,
-  0x61, 0x6e, 0x69, 0x7a, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x52, 0x65, 0x67, 0x69, 0x73, 0x74, 0x65, 0x72, 0x65, 0x64, 0x4f,
-  0x77, 0x6e, 0x65, 0x72, 0x3e, 0x75, 0x73, 0x65, 0x72, 0x20, 0x6e, 0x61,
-  0x6d, 0x65, 0x3c, 0x2f, 0x52, 0x65, 0x67, 0x69, 0x73, 0x74, 0x65, 0x72,
-  0x65, 0x64, 0x4f, 0x77, 0x6e, 0x65, 0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x44,
-  0x69, 0x73, 0x61, 0x62, 0x6c, 0x65, 0x41, 0x75, 0x74, 0x6f, 0x44, 0x61,
-  0x79, 0x6c, 0x69, 0x67, 0x68, 0x74, 0x54, 0x69, 0x6d, 0x65, 0x53, 0x65,
-  0x74, 0x3e, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3c, 0x2f, 0x44, 0x69, 0x73,
-  0x61, 0x62, 0x6c, 0x65, 0x41, 0x75, 0x74, 0x6f, 0x44, 0x61, 0x79, 0x6c,
-  0x69, 0x67, 0x68, 0x74, 0x54, 0x69, 0x6d, 0x65, 0x53, 0x65, 0x74, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x3c, 0x46, 0x69, 0x72, 0x73, 0x74, 0x4c, 0x6f, 0x67, 0x6f,
-  0x6e, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x73, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x53, 0x79, 0x6e, 0x63, 0x68, 0x72, 0x6f,
-  0x6e, 0x6f, 0x75, 0x73, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x20,
-  0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22,
-  0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74,
-  0x69, 0x6f, 0x6e, 0x3e, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x20,
-  0x50, 0x61, 0x6e, 0x65, 0x6c, 0x20, 0x56, 0x69, 0x65, 0x77, 0x3c, 0x2f,
-  0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x69, 0x6f, 0x6e, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f,
-  0x72, 0x64, 0x65, 0x72, 0x3e, 0x31, 0x3c, 0x2f, 0x4f, 0x72, 0x64, 0x65,
-  0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x4c, 0x69, 0x6e, 0x65,
-  0x3e, 0x72, 0x65, 0x67, 0x20, 0x61, 0x64, 0x64, 0x20, 0x22, 0x48, 0x4b,
-  0x45, 0x59, 0x5f, 0x43, 0x55, 0x52, 0x52, 0x45, 0x4e, 0x54, 0x5f, 0x55,
-  0x53, 0x45, 0x52, 0x5c, 0x53, 0x6f, 0x66, 0x74, 0x77, 0x61, 0x72, 0x65,
-  0x5c, 0x4d, 0x69, 0x63, 0x72, 0x6f, 0x73, 0x6f, 0x66, 0x74, 0x5c, 0x57,
-  0x69, 0x6e, 0x64, 0x6f, 0x77, 0x73, 0x5c, 0x43, 0x75, 0x72, 0x72, 0x65,
-  0x6e, 0x74, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6f, 0x6e, 0x5c, 0x45, 0x78,
-  0x70, 0x6c, 0x6f, 0x72, 0x65, 0x72, 0x5c, 0x43, 0x6f, 0x6e, 0x74, 0x72,
-  0x6f, 0x6c, 0x50, 0x61, 0x6e, 0x65, 0x6c, 0x22, 0x20, 0x2f, 0x76, 0x20,
-  0x53, 0x74, 0x61, 0x72, 0x74, 0x75, 0x70, 0x50, 0x61, 0x67, 0x65, 0x20,
-  0x2f, 0x74, 0x20, 0x52, 0x45, 0x47, 0x5f, 0x44, 0x57, 0x4f, 0x52, 0x44,
-  0x20, 0x2f, 0x64, 0x20, 0x31, 0x20, 0x2f, 0x66, 0x3c, 0x2f, 0x43, 0x6f,
-  0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x4c, 0x69, 0x6e, 0x65, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x52, 0x65, 0x71,
-  0x75, 0x69, 0x72, 0x65, 0x73, 0x55, 0x73, 0x65, 0x72, 0x49, 0x6e, 0x70,
-  0x75, 0x74, 0x3e, 0x74, 0x72, 0x75, 0x65, 0x3c, 0x2f, 0x52, 0x65, 0x71,
-  0x75, 0x69, 0x72, 0x65, 0x73, 0x55, 0x73, 0x65, 0x72, 0x49, 0x6e, 0x70,
-  0x75, 0x74, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x53,
-  0x79, 0x6e, 0x63, 0x68, 0x72, 0x6f, 0x6e, 0x6f, 0x75, 0x73, 0x43, 0x6f,
-  0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x53, 0x79, 0x6e, 0x63, 0x68, 0x72, 0x6f, 0x6e, 0x6f, 0x75, 0x73,
-  0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x20, 0x77, 0x63, 0x6d, 0x3a,
-  0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c,
-  0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x32, 0x3c, 0x2f, 0x4f, 0x72, 0x64,
-  0x65, 0x72, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x69, 0x6f,
-  0x6e, 0x3e, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x20, 0x50, 0x61,
-  0x6e, 0x65, 0x6c, 0x20, 0x49, 0x63, 0x6f, 0x6e, 0x20, 0x53, 0x69, 0x7a,
-  0x65, 0x3c, 0x2f, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x69,
-  0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x3c, 0x52, 0x65, 0x71, 0x75, 0x69, 0x72, 0x65, 0x73, 0x55, 0x73,
-  0x65, 0x72, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x3e, 0x66, 0x61, 0x6c, 0x73,
-  0x65, 0x3c, 0x2f, 0x52, 0x65, 0x71, 0x75, 0x69, 0x72, 0x65, 0x73, 0x55,
-  0x73, 0x65, 0x72, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x3e, 0x0d, 0x0a, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x43, 0x6f, 0x6d, 0x6d,
-  0x61, 0x6e, 0x64, 0x4c, 0x69, 0x6e, 0x65, 0x3e, 0x72, 0x65, 0x67, 0x20,
-  0x61, 0x64, 0x64, 0x20, 0x22, 0x48, 0x4b, 0x45, 0x59, 0x5f, 0x43, 0x55,
-  0x52, 0x52, 0x45, 0x4e, 0x54, 0x5f, 0x55, 0x53, 0x45, 0x52, 0x5c, 0x53,
-  0x6f, 0x66, 0x74, 0x77, 0x61, 0x72, 0x65, 0x5c, 0x4d, 0x69, 0x63, 0x72,
-  0x6f, 0x73, 0x6f, 0x66, 0x74, 0x5c, 0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77,
-  0x73, 0x5c, 0x43, 0x75, 0x72, 0x72, 0x65, 0x6e, 0x74, 0x56, 0x65, 0x72,
-  0x73, 0x69, 0x6f, 0x6e, 0x5c, 0x45, 0x78, 0x70, 0x6c, 0x6f, 0x72, 0x65,
-  0x72, 0x5c, 0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x50, 0x61, 0x6e,
-  0x65, 0x6c, 0x22, 0x20, 0x2f, 0x76, 0x20, 0x41, 0x6c, 0x6c, 0x49, 0x74,
-  0x65, 0x6d, 0x73, 0x49, 0x63, 0x6f, 0x6e, 0x56, 0x69, 0x65, 0x77, 0x20,
-  0x2f, 0x74, 0x20, 0x52, 0x45, 0x47, 0x5f, 0x44, 0x57, 0x4f, 0x52, 0x44,
-  0x20, 0x2f, 0x64, 0x20, 0x30, 0x20, 0x2f, 0x66, 0x3c, 0x2f, 0x43, 0x6f,
-  0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x4c, 0x69, 0x6e, 0x65, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x53, 0x79, 0x6e, 0x63, 0x68, 0x72,
-  0x6f, 0x6e, 0x6f, 0x75, 0x73, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64,
-  0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x53, 0x79, 0x6e, 0x63,
-  0x68, 0x72, 0x6f, 0x6e, 0x6f, 0x75, 0x73, 0x43, 0x6f, 0x6d, 0x6d, 0x61,
-  0x6e, 0x64, 0x20, 0x77, 0x63, 0x6d, 0x3a, 0x61, 0x63, 0x74, 0x69, 0x6f,
-  0x6e, 0x3d, 0x22, 0x61, 0x64, 0x64, 0x22, 0x3e, 0x0d, 0x0a, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x4f, 0x72, 0x64, 0x65, 0x72,
-  0x3e, 0x33, 0x3c, 0x2f, 0x4f, 0x72, 0x64, 0x65, 0x72, 0x3e, 0x0d, 0x0a,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x52, 0x65, 0x71,
-  0x75, 0x69, 0x72, 0x65, 0x73, 0x55, 0x73, 0x65, 0x72, 0x49, 0x6e, 0x70,
-  0x75, 0x74, 0x3e, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3c, 0x2f, 0x52, 0x65,
-  0x71, 0x75, 0x69, 0x72, 0x65, 0x73, 0x55, 0x73, 0x65, 0x72, 0x49, 0x6e,
-  0x70, 0x75, 0x74, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x3c, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x4c, 0x69,
-  0x6e, 0x65, 0x3e, 0x63, 0x6d, 0x64, 0x20, 0x2f, 0x43, 0x20, 0x77, 0x6d,
-  0x69, 0x63, 0x20, 0x75, 0x73, 0x65, 0x72, 0x61, 0x63, 0x63, 0x6f, 0x75,
-  0x6e, 0x74, 0x20, 0x77, 0x68, 0x65, 0x72, 0x65, 0x20, 0x6e, 0x61, 0x6d,
-  0x65, 0x3d, 0x22, 0x75, 0x73, 0x65, 0x72, 0x20, 0x6e, 0x61, 0x6d, 0x65,
-  0x22, 0x20, 0x73, 0x65, 0x74, 0x20, 0x50, 0x61, 0x73, 0x73, 0x77, 0x6f,
-  0x72, 0x64, 0x45, 0x78, 0x70, 0x69, 0x72, 0x65, 0x73, 0x3d, 0x66, 0x61,
-  0x6c, 0x73, 0x65, 0x3c, 0x2f, 0x43, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64,
-  0x4c, 0x69, 0x6e, 0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x3c, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74,
-  0x69, 0x6f, 0x6e, 0x3e, 0x50, 0x61, 0x73, 0x73, 0x77, 0x6f, 0x72, 0x64,
-  0x20, 0x4e, 0x65, 0x76, 0x65, 0x72, 0x20, 0x45, 0x78, 0x70, 0x69, 0x72,
-  0x65, 0x73, 0x3c, 0x2f, 0x44, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74,
-  0x69, 0x6f, 0x6e, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f,
-  0x53, 0x79, 0x6e, 0x63, 0x68, 0x72, 0x6f, 0x6e, 0x6f, 0x75, 0x73, 0x43,
-  0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x46,
-  0x69, 0x72, 0x73, 0x74, 0x4c, 0x6f, 0x67, 0x6f, 0x6e, 0x43, 0x6f, 0x6d,
-  0x6d, 0x61, 0x6e, 0x64, 0x73, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20,
-  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x54, 0x69, 0x6d,
-  0x65, 0x5a, 0x6f, 0x6e, 0x65, 0x3e, 0x43, 0x65, 0x6e, 0x74, 0x72, 0x61,
-  0x6c, 0x20, 0x53, 0x74, 0x61, 0x6e, 0x64, 0x61, 0x72, 0x64, 0x20, 0x54,
-  0x69, 0x6d, 0x65, 0x3c, 0x2f, 0x54, 0x69, 0x6d, 0x65, 0x5a, 0x6f, 0x6e,
-  0x65, 0x3e, 0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20,
-  0x3c, 0x2f, 0x63, 0x6f, 0x6d, 0x70, 0x6f, 0x6e, 0x65, 0x6e, 0x74, 0x3e,
-  0x0d, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x3c, 0x2f, 0x73, 0x65, 0x74, 0x74,
-  0x69, 0x6e, 0x67, 0x73, 0x3e, 0x0d, 0x0a, 0x3c, 0x2f, 0x75, 0x6e, 0x61,
-  0x74, 0x74, 0x65, 0x6e, 0x64, 0x3e, 0x0d, 0x0a
-};
-unsigned int autounattend_xml_len = 10712;
@@ -0,0 +1,354 @@
+#include "direct_io.h"
+#ifdef _WIN32
+#define NOMINMAX // Prevents the Windows headers from defining the min() and max() macros
+#include <windows.h> // CreateFileW, ReadFile, WriteFile, FlushFileBuffers and MapViewOfFile
+#else
+#include <fcntl.h>    // open and posix_fadvise
+#include <sys/mman.h> // mmap and madvise
+#include <sys/stat.h> // fstat for the size of mapped files
+#include <unistd.h>   // read, write, pwrite, fsync, ftruncate and close
+#endif
+#include <algorithm> // std::min
+
+// Largest single read or write request, ReadFile and WriteFile take 32 bit sizes
+static constexpr size_t IO_MAX_REQUEST = 1u << 30;
+
+// Function to allocate a buffer usable for unbuffered I/O
+AlignedBuffer AllocateAligned(size_t size) {
+    return AlignedBuffer(static_cast<uint8_t*>(::operator new(size, std::align_val_t(IO_ALIGNMENT))));
+}
+
+#ifdef _WIN32
+
+bool SequentialFileReader::Open(const std::filesystem::path& path) {
+    Close();
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    handle = reinterpret_cast<intptr_t>(file);
+    offset = 0;
+    return true;
+}
+
+bool SequentialFileReader::Read(uint8_t* data, size_t size) {
+    while (size > 0) {
+        DWORD done = 0;
+        DWORD request = static_cast<DWORD>(std::min(size, IO_MAX_REQUEST));
+        if (!ReadFile(reinterpret_cast<HANDLE>(handle), data, request, &done, nullptr) || done == 0) {
+            return false;
+        }
+        data += done;
+        size -= done;
+        offset += done;
+    }
+    return true;
+}
+
+void SequentialFileReader::Close() {
+    if (handle != -1) {
+        CloseHandle(reinterpret_cast<HANDLE>(handle));
+        handle = -1;
+    }
+}
+
+bool SequentialFileWriter::Open(const std::filesystem::path& path, bool useUnbuffered) {
+    Discard();
+    HANDLE file = INVALID_HANDLE_VALUE;
+    if (useUnbuffered) {
+        file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING, nullptr);
+    }
+    unbuffered = file != INVALID_HANDLE_VALUE;
+    if (!unbuffered) { // Some network and virtual disks refuse unbuffered handles
+        file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    }
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    handle = reinterpret_cast<intptr_t>(file);
+    return true;
+}
+
+bool SequentialFileWriter::Write(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        DWORD done = 0;
+        DWORD request = static_cast<DWORD>(std::min(size, IO_MAX_REQUEST));
+        if (!WriteFile(reinterpret_cast<HANDLE>(handle), data, request, &done, nullptr) || done == 0) {
+            return false;
+        }
+        data += done;
+        size -= done;
+    }
+    return true;
+}
+
+bool SequentialFileWriter::Close(uint64_t finalSize) {
+    if (handle == -1) {
+        return true;
+    }
+    FILE_END_OF_FILE_INFO end = {};
+    end.EndOfFile.QuadPart = static_cast<LONGLONG>(finalSize);
+    bool ok = SetFileInformationByHandle(reinterpret_cast<HANDLE>(handle), FileEndOfFileInfo, &end, sizeof(end)) != 0;
+    ok = CloseHandle(reinterpret_cast<HANDLE>(handle)) != 0 && ok;
+    handle = -1;
+    return ok;
+}
+
+void SequentialFileWriter::Discard() {
+    if (handle != -1) {
+        CloseHandle(reinterpret_cast<HANDLE>(handle));
+        handle = -1;
+    }
+}
+
+bool PatchFileWriter::Open(const std::filesystem::path& path, bool truncate) {
+    Close();
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    handle = reinterpret_cast<intptr_t>(file);
+    return true;
+}
+
+bool PatchFileWriter::WriteAt(uint64_t offset, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        OVERLAPPED position = {};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD done = 0;
+        DWORD request = static_cast<DWORD>(std::min(size, IO_MAX_REQUEST));
+        if (!WriteFile(reinterpret_cast<HANDLE>(handle), data, request, &done, &position) || done == 0) {
+            return false;
+        }
+        data += done;
+        size -= done;
+        offset += done;
+    }
+    return true;
+}
+
+bool PatchFileWriter::Flush() {
+    return FlushFileBuffers(reinterpret_cast<HANDLE>(handle)) != 0;
+}
+
+void PatchFileWriter::Close() {
+    if (handle != -1) {
+        CloseHandle(reinterpret_cast<HANDLE>(handle));
+        handle = -1;
+    }
+}
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    handle = reinterpret_cast<intptr_t>(file);
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        Close();
+        return false;
+    }
+    size = static_cast<uint64_t>(fileSize.QuadPart);
+    if (size == 0) { // Empty files cannot be mapped
+        return true;
+    }
+    HANDLE view = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (view == nullptr) {
+        Close();
+        return false;
+    }
+    mapping = reinterpret_cast<intptr_t>(view);
+    data = static_cast<const uint8_t*>(MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0));
+    if (data == nullptr) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+        data = nullptr;
+    }
+    if (mapping != 0) {
+        CloseHandle(reinterpret_cast<HANDLE>(mapping));
+        mapping = 0;
+    }
+    if (handle != -1) {
+        CloseHandle(reinterpret_cast<HANDLE>(handle));
+        handle = -1;
+    }
+    size = 0;
+}
+
+#else
+
+bool SequentialFileReader::Open(const std::filesystem::path& path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    handle = fd;
+    offset = 0;
+    return true;
+}
+
+bool SequentialFileReader::Read(uint8_t* data, size_t size) {
+    int fd = static_cast<int>(handle);
+    uint64_t start = offset;
+    while (size > 0) {
+        ssize_t done = read(fd, data, std::min(size, IO_MAX_REQUEST));
+        if (done <= 0) {
+            return false;
+        }
+        data += done;
+        size -= static_cast<size_t>(done);
+        offset += static_cast<uint64_t>(done);
+    }
+#ifdef POSIX_FADV_DONTNEED
+    posix_fadvise(fd, static_cast<off_t>(start), static_cast<off_t>(offset - start), POSIX_FADV_DONTNEED); // Read once, no need to cache
+#endif
+    return true;
+}
+
+void SequentialFileReader::Close() {
+    if (handle != -1) {
+        close(static_cast<int>(handle));
+        handle = -1;
+    }
+}
+
+bool SequentialFileWriter::Open(const std::filesystem::path& path, bool useUnbuffered) {
+    Discard();
+    int fd = -1;
+#ifdef O_DIRECT
+    if (useUnbuffered) {
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    }
+#endif
+    unbuffered = fd >= 0;
+    if (!unbuffered) { // Some file systems (tmpfs) refuse O_DIRECT
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (fd < 0) {
+        return false;
+    }
+    handle = fd;
+    return true;
+}
+
+bool SequentialFileWriter::Write(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t done = write(static_cast<int>(handle), data, std::min(size, IO_MAX_REQUEST));
+        if (done <= 0) {
+            return false;
+        }
+        data += done;
+        size -= static_cast<size_t>(done);
+    }
+    return true;
+}
+
+bool SequentialFileWriter::Close(uint64_t finalSize) {
+    if (handle == -1) {
+        return true;
+    }
+    int fd = static_cast<int>(handle);
+    bool ok = ftruncate(fd, static_cast<off_t>(finalSize)) == 0;
+    ok = close(fd) == 0 && ok;
+    handle = -1;
+    return ok;
+}
+
+void SequentialFileWriter::Discard() {
+    if (handle != -1) {
+        close(static_cast<int>(handle));
+        handle = -1;
+    }
+}
+
+bool PatchFileWriter::Open(const std::filesystem::path& path, bool truncate) {
+    Close();
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0), 0644);
+    if (fd < 0) {
+        return false;
+    }
+    handle = fd;
+    return true;
+}
+
+bool PatchFileWriter::WriteAt(uint64_t offset, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t done = pwrite(static_cast<int>(handle), data, std::min(size, IO_MAX_REQUEST), static_cast<off_t>(offset));
+        if (done <= 0) {
+            return false;
+        }
+        data += done;
+        size -= static_cast<size_t>(done);
+        offset += static_cast<uint64_t>(done);
+    }
+    return true;
+}
+
+bool PatchFileWriter::Flush() {
+    return fsync(static_cast<int>(handle)) == 0;
+}
+
+void PatchFileWriter::Close() {
+    if (handle != -1) {
+        close(static_cast<int>(handle));
+        handle = -1;
+    }
+}
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    handle = fd;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        Close();
+        return false;
+    }
+    size = static_cast<uint64_t>(info.st_size);
+    if (size == 0) { // Empty files cannot be mapped
+        return true;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        Close();
+        return false;
+    }
+    madvise(view, static_cast<size_t>(size), MADV_SEQUENTIAL); // Read ahead, mapped files are read front to back
+    data = static_cast<const uint8_t*>(view);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data != nullptr) {
+        munmap(const_cast<uint8_t*>(data), static_cast<size_t>(size));
+        data = nullptr;
+    }
+    if (handle != -1) {
+        close(static_cast<int>(handle));
+        handle = -1;
+    }
+    size = 0;
+}
+
+#endif
@@ -0,0 +1,103 @@
+#pragma once
+// Sequential file I/O for large copies. Output goes straight to the disk (FILE_FLAG_NO_BUFFERING, O_DIRECT elsewhere)
+// from sector aligned buffers so multi-gigabyte images do not push everything else out of the file cache, and
+// input is read with a sequential hint and dropped from the cache once consumed.
+#include <cstddef>    // size_t
+#include <cstdint>    // Fixed width integer types
+#include <filesystem> // std::filesystem::path for opening files
+#include <memory>     // std::unique_ptr for aligned buffers
+#include <new>        // std::align_val_t for aligned allocation
+
+// Buffers, write sizes and write offsets of unbuffered files must be multiples of the disk's sector size.
+// 4096 covers both 512 byte and 4K sector disks.
+constexpr size_t IO_ALIGNMENT = 4096;
+
+// Memory block aligned to IO_ALIGNMENT
+struct AlignedDelete {
+    void operator()(uint8_t* p) const { ::operator delete(p, std::align_val_t(IO_ALIGNMENT)); }
+};
+using AlignedBuffer = std::unique_ptr<uint8_t[], AlignedDelete>;
+
+// Reads a file front to back
+class SequentialFileReader {
+public:
+    SequentialFileReader() = default;
+    ~SequentialFileReader() { Close(); }
+    SequentialFileReader(const SequentialFileReader&) = delete;
+    SequentialFileReader& operator=(const SequentialFileReader&) = delete;
+
+    bool Open(const std::filesystem::path& path);
+    // Reads exactly 'size' bytes into any buffer, false on an error or if the file ends early
+    bool Read(uint8_t* data, size_t size);
+    void Close();
+
+private:
+    intptr_t handle = -1; // HANDLE on Windows, file descriptor elsewhere
+    uint64_t offset = 0;
+};
+
+// Writes a file front to back, bypassing the file cache when the disk allows it
+class SequentialFileWriter {
+public:
+    SequentialFileWriter() = default;
+    ~SequentialFileWriter() { Discard(); }
+    SequentialFileWriter(const SequentialFileWriter&) = delete;
+    SequentialFileWriter& operator=(const SequentialFileWriter&) = delete;
+
+    bool Open(const std::filesystem::path& path, bool useUnbuffered = true);
+    // 'data' must come from AllocateAligned and 'size' be a multiple of IO_ALIGNMENT
+    bool Write(const uint8_t* data, size_t size);
+    // Cuts the file to 'finalSize' (dropping the padding of the last write) and closes it
+    bool Close(uint64_t finalSize);
+    // Closes the file as it is, used when giving up on it
+    void Discard();
+    // True when writes go straight to the disk
+    bool Unbuffered() const { return unbuffered; }
+
+private:
+    intptr_t handle = -1; // HANDLE on Windows, file descriptor elsewhere
+    bool unbuffered = false;
+};
+
+// Rewrites parts of a file in place, for files updated a few blocks at a time
+class PatchFileWriter {
+public:
+    PatchFileWriter() = default;
+    ~PatchFileWriter() { Close(); }
+    PatchFileWriter(const PatchFileWriter&) = delete;
+    PatchFileWriter& operator=(const PatchFileWriter&) = delete;
+
+    // Opens the file for writing, creating it if it is missing. 'truncate' empties it first.
+    bool Open(const std::filesystem::path& path, bool truncate = false);
+    // Writes 'size' bytes at 'offset', growing the file when the write ends past its end
+    bool WriteAt(uint64_t offset, const uint8_t* data, size_t size);
+    // Returns once everything written so far is on the disk
+    bool Flush();
+    void Close();
+
+private:
+    intptr_t handle = -1; // HANDLE on Windows, file descriptor elsewhere
+};
+
+// Maps a whole file into memory read-only, so any number of threads can read any part of it without copying
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::filesystem::path& path);
+    void Close();
+    const uint8_t* Data() const { return data; }
+    uint64_t Size() const { return size; }
+
+private:
+    intptr_t handle = -1;  // HANDLE on Windows, file descriptor elsewhere
+    intptr_t mapping = 0;  // File mapping HANDLE on Windows
+    const uint8_t* data = nullptr;
+    uint64_t size = 0;
+};
+
+// Function declarations for unbuffered I/O
+AlignedBuffer AllocateAligned(size_t size);
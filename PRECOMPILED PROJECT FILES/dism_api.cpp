@@ -0,0 +1,302 @@
+#include "image_servicing.h"
+#ifdef _WIN32
+#define NOMINMAX // Prevents the Windows headers from defining the min() and max() macros
+#include <windows.h> // Basic Windows types, MultiByteToWideChar and GetProcAddress
+#include <dismapi.h> // DISM API: DismInitialize, DismOpenSession, DismRemovePackage, ...
+#include <iostream>  // std::cerr for the warning when the provisioned app functions are missing
+#pragma comment(lib, "dismapi.lib")
+
+// Returned by DISM API calls that changed the servicing stack, the session has to be reopened before the next call
+#ifndef DISMAPI_S_RELOAD_IMAGE_SESSION_REQUIRED
+#define DISMAPI_S_RELOAD_IMAGE_SESSION_REQUIRED 0x00000001
+#endif
+
+// The provisioned app functions are missing from older SDK headers, so they are looked up in dismapi.dll at run
+// time. The structure matches DismAppxPackage, which dismapi.h declares with 1 byte packing.
+#pragma pack(push, 1)
+struct DismAppxPackageEntry {
+    PCWSTR PackageName;
+    PCWSTR DisplayName;
+    PCWSTR PublisherId;
+    UINT MajorVersion;
+    UINT MinorVersion;
+    UINT Build;
+    UINT RevisionNumber;
+    UINT Architecture;
+    PCWSTR ResourceId;
+    PCWSTR InstallLocation;
+    PCWSTR Region;
+};
+#pragma pack(pop)
+using DismGetProvisionedAppxPackagesFn = HRESULT(WINAPI*)(DismSession, DismAppxPackageEntry**, UINT*);
+using DismRemoveProvisionedAppxPackageFn = HRESULT(WINAPI*)(DismSession, PCWSTR);
+using DismAddProvisionedAppxPackageFn = HRESULT(WINAPI*)(DismSession, PCWSTR, PCWSTR*, UINT, PCWSTR*, UINT, PCWSTR*, UINT,
+    BOOL, PCWSTR, PCWSTR, UINT);
+
+// Function to convert console text (ANSI code page) to the UTF-16 the DISM API takes
+static std::wstring Widen(const std::string& text) {
+    if (text.empty()) {
+        return std::wstring();
+    }
+    int length = MultiByteToWideChar(CP_ACP, 0, text.data(), static_cast<int>(text.size()), nullptr, 0);
+    std::wstring wide(length, L'\0');
+    MultiByteToWideChar(CP_ACP, 0, text.data(), static_cast<int>(text.size()), &wide[0], length);
+    return wide;
+}
+
+// Function to convert UTF-16 text from the DISM API back to the console code page
+static std::string Narrow(PCWSTR text) {
+    if (!text || !*text) {
+        return std::string();
+    }
+    int length = WideCharToMultiByte(CP_ACP, 0, text, -1, nullptr, 0, nullptr, nullptr);
+    std::string narrow(length, '\0');
+    WideCharToMultiByte(CP_ACP, 0, text, -1, &narrow[0], length, nullptr, nullptr);
+    narrow.resize(length - 1); // Drop the terminating zero
+    return narrow;
+}
+
+// Function to map DismProcessorArchitecture to MODWIN's architecture
+static ProcessorArchitecture ToArchitecture(UINT architecture) {
+    switch (architecture) {
+    case 0: return ProcessorArchitecture::X86;     // DismProcessorArchitectureIntel
+    case 5: return ProcessorArchitecture::Arm;     // DismProcessorArchitectureARM
+    case 9: return ProcessorArchitecture::X64;     // DismProcessorArchitectureAMD64
+    case 11: return ProcessorArchitecture::Neutral; // DismProcessorArchitectureNeutral
+    case 12: return ProcessorArchitecture::Arm64;  // DismProcessorArchitectureARM64
+    default: return ProcessorArchitecture::Unknown;
+    }
+}
+
+// Function to pack a SYSTEMTIME into YYYYMMDDhhmm
+static uint64_t ToInstallTime(const SYSTEMTIME& time) {
+    if (time.wYear == 0) {
+        return 0;
+    }
+    return ((((uint64_t(time.wYear) * 100 + time.wMonth) * 100 + time.wDay) * 100 + time.wHour) * 100) + time.wMinute;
+}
+
+// Backend holding one DISM API session on the mounted image for all operations
+class DismApiServicing : public ImageServicing {
+public:
+    DismApiServicing(const std::string& imageDir, const std::string& scratchDir)
+        : imageDir(Widen(imageDir)), scratchDir(scratchDir) {}
+    ~DismApiServicing() override { Close(); }
+
+    bool Open() {
+        if (FAILED(DismInitialize(DismLogErrors, nullptr, nullptr))) {
+            return false;
+        }
+        initialized = true;
+        if (FAILED(DismOpenSession(imageDir.c_str(), nullptr, nullptr, &session))) {
+            session = DISM_SESSION_DEFAULT;
+            return false;
+        }
+        // dismapi.dll exports the provisioned app functions with a leading underscore, the plain names are tried
+        // for builds that export them without it
+        HMODULE dismApi = GetModuleHandleW(L"dismapi.dll");
+        auto resolve = [dismApi](const char* name) -> FARPROC {
+            if (!dismApi) {
+                return nullptr;
+            }
+            FARPROC function = GetProcAddress(dismApi, (std::string("_") + name).c_str());
+            return function ? function : GetProcAddress(dismApi, name);
+        };
+        getApps = reinterpret_cast<DismGetProvisionedAppxPackagesFn>(resolve("DismGetProvisionedAppxPackages"));
+        removeApp = reinterpret_cast<DismRemoveProvisionedAppxPackageFn>(resolve("DismRemoveProvisionedAppxPackage"));
+        addApp = reinterpret_cast<DismAddProvisionedAppxPackageFn>(resolve("DismAddProvisionedAppxPackage"));
+        if (!getApps || !removeApp || !addApp) {
+            std::cerr << "Warning: dismapi.dll does not export the provisioned app functions, provisioned apps will be "
+                "serviced through dism.exe.\n";
+        }
+        return true;
+    }
+
+    void Close() {
+        if (session != DISM_SESSION_DEFAULT) {
+            DismCloseSession(session);
+            session = DISM_SESSION_DEFAULT;
+        }
+        if (initialized) {
+            DismShutdown();
+            initialized = false;
+        }
+    }
+
+    const char* Name() const override { return "DISM API"; }
+
+    bool ListProvisionedApps(AppxPackageTable& apps) override {
+        if (!getApps) {
+            return Fallback().ListProvisionedApps(apps);
+        }
+        DismAppxPackageEntry* list = nullptr;
+        UINT count = 0;
+        if (FAILED(getApps(session, &list, &count))) {
+            return false;
+        }
+        apps.Clear();
+        for (UINT i = 0; i < count; i++) {
+            uint64_t version = (uint64_t(list[i].MajorVersion & 0xFFFF) << 48) | (uint64_t(list[i].MinorVersion & 0xFFFF) << 32) |
+                (uint64_t(list[i].Build & 0xFFFF) << 16) | (list[i].RevisionNumber & 0xFFFF);
+            apps.Add(Narrow(list[i].PackageName), Narrow(list[i].DisplayName), version, ToArchitecture(list[i].Architecture));
+        }
+        DismDelete(list);
+        return true;
+    }
+
+    bool ListPackages(PackageTable& packages) override {
+        DismPackage* list = nullptr;
+        UINT count = 0;
+        if (FAILED(DismGetPackages(session, &list, &count))) {
+            return false;
+        }
+        packages.Clear();
+        for (UINT i = 0; i < count; i++) {
+            packages.Add(Narrow(list[i].PackageName), static_cast<ServicingState>(list[i].PackageState),
+                static_cast<ReleaseType>(list[i].ReleaseType), ToInstallTime(list[i].InstallTime));
+        }
+        DismDelete(list);
+        return true;
+    }
+
+    bool ListFeatures(FeatureTable& features) override {
+        DismFeature* list = nullptr;
+        UINT count = 0;
+        if (FAILED(DismGetFeatures(session, nullptr, DismPackageNone, &list, &count))) {
+            return false;
+        }
+        features.Clear();
+        for (UINT i = 0; i < count; i++) {
+            features.Add(Narrow(list[i].FeatureName), static_cast<ServicingState>(list[i].State));
+        }
+        DismDelete(list);
+        return true;
+    }
+
+    ServicingResult AddProvisionedApp(const std::string& appPath) override {
+        if (!addApp) {
+            return Fallback().AddProvisionedApp(appPath);
+        }
+        std::wstring path = Widen(appPath);
+        return Check(addApp(session, path.c_str(), nullptr, 0, nullptr, 0, nullptr, 0, TRUE, nullptr, nullptr, 0));
+    }
+
+    ServicingResult RemoveProvisionedApp(const std::string& packageName) override {
+        if (!removeApp) {
+            return Fallback().RemoveProvisionedApp(packageName);
+        }
+        std::wstring name = Widen(packageName);
+        return Check(removeApp(session, name.c_str()));
+    }
+
+    ServicingResult AddPackage(const std::string& packagePath) override {
+        std::wstring path = Widen(packagePath);
+        return Check(DismAddPackage(session, path.c_str(), FALSE, FALSE, nullptr, nullptr, nullptr));
+    }
+
+    ServicingResult RemovePackage(const std::string& packageIdentity) override {
+        std::wstring name = Widen(packageIdentity);
+        return Check(DismRemovePackage(session, name.c_str(), DismPackageName, nullptr, nullptr, nullptr));
+    }
+
+    // Removes every app on the open session, or in one dism.exe batch when dismapi.dll cannot remove apps
+    std::vector<ServicingBatchItem> RemoveProvisionedApps(const std::vector<std::string>& packageNames) override {
+        if (!removeApp) {
+            return Fallback().RemoveProvisionedApps(packageNames);
+        }
+        return RemoveAll(packageNames, [this](const std::wstring& name) { return removeApp(session, name.c_str()); });
+    }
+
+    std::vector<ServicingBatchItem> RemovePackages(const std::vector<std::string>& packageIdentities) override {
+        return RemoveAll(packageIdentities, [this](const std::wstring& name) {
+            return DismRemovePackage(session, name.c_str(), DismPackageName, nullptr, nullptr, nullptr);
+        });
+    }
+
+    ServicingResult EnableFeature(const std::string& featureName) override {
+        std::wstring name = Widen(featureName);
+        return Check(DismEnableFeature(session, name.c_str(), nullptr, DismPackageNone, FALSE, nullptr, 0, FALSE,
+            nullptr, nullptr, nullptr));
+    }
+
+    ServicingResult DisableFeature(const std::string& featureName) override {
+        std::wstring name = Widen(featureName);
+        return Check(DismDisableFeature(session, name.c_str(), nullptr, FALSE, nullptr, nullptr, nullptr));
+    }
+
+private:
+    // Turns an HRESULT into a result, picking up DISM's error text and reopening the session when DISM asks for it
+    ServicingResult Check(HRESULT hr) {
+        ServicingResult result;
+        result.code = hr;
+        result.ok = SUCCEEDED(hr) || hr == HRESULT_FROM_WIN32(ERROR_SUCCESS_REBOOT_REQUIRED);
+        if (!result.ok) {
+            DismString* errorMessage = nullptr;
+            if (SUCCEEDED(DismGetLastErrorMessage(&errorMessage)) && errorMessage) {
+                result.message = Narrow(errorMessage->Value);
+                DismDelete(errorMessage);
+            }
+        }
+        if (hr == DISMAPI_S_RELOAD_IMAGE_SESSION_REQUIRED) {
+            DismCloseSession(session);
+            if (FAILED(DismOpenSession(imageDir.c_str(), nullptr, nullptr, &session))) {
+                session = DISM_SESSION_DEFAULT;
+            }
+        }
+        return result;
+    }
+
+    // Runs 'remove' for each name back to back on the one session. When DISM asked for the session to be reopened
+    // and it could not be, the names left are failed rather than passed to a closed session.
+    template <typename Remove>
+    std::vector<ServicingBatchItem> RemoveAll(const std::vector<std::string>& names, Remove remove) {
+        std::vector<ServicingBatchItem> items;
+        for (const std::string& name : names) {
+            ServicingResult result;
+            if (session == DISM_SESSION_DEFAULT) {
+                result.code = E_HANDLE;
+                result.message = "The DISM session on the image could not be reopened";
+            }
+            else {
+                result = Check(remove(Widen(name)));
+            }
+            items.push_back({ name, result });
+        }
+        return items;
+    }
+
+    // dism.exe backend for the provisioned app calls this dismapi.dll does not export
+    DismCommandServicing& Fallback() {
+        if (!fallback) {
+            fallback = std::make_unique<DismCommandServicing>(Narrow(imageDir.c_str()), scratchDir);
+        }
+        return *fallback;
+    }
+
+    std::wstring imageDir;
+    std::string scratchDir; // Scratch folder for the dism.exe fallback
+    DismSession session = DISM_SESSION_DEFAULT;
+    bool initialized = false;
+    DismGetProvisionedAppxPackagesFn getApps = nullptr;
+    DismRemoveProvisionedAppxPackageFn removeApp = nullptr;
+    DismAddProvisionedAppxPackageFn addApp = nullptr;
+    std::unique_ptr<DismCommandServicing> fallback;
+};
+
+// Function to open a DISM API session on a mounted image, nullptr if the API is unavailable or refuses the image
+std::unique_ptr<ImageServicing> CreateDismApiServicing(const std::string& imageDir, const std::string& scratchDir) {
+    auto servicing = std::make_unique<DismApiServicing>(imageDir, scratchDir);
+    if (!servicing->Open()) {
+        return nullptr;
+    }
+    return servicing;
+}
+
+#else
+
+// The DISM API only exists on Windows
+std::unique_ptr<ImageServicing> CreateDismApiServicing(const std::string&, const std::string&) {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "dism_output.h"
+
+// Function to cut spaces, tabs and carriage returns off both ends of a string
+static std::string Trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+// Function to check if a table row is a rule like "-------- | -----"
+static bool IsTableRule(const std::vector<std::string>& cells) {
+    for (const std::string& cell : cells) {
+        if (cell.empty() || cell.find_first_not_of('-') != std::string::npos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to split "Feature Name | State" into trimmed cells
+std::vector<std::string> SplitDismTableRow(const std::string& line) {
+    std::vector<std::string> cells;
+    size_t start = 0;
+    while (true) {
+        size_t bar = line.find('|', start);
+        cells.push_back(Trim(line.substr(start, bar == std::string::npos ? std::string::npos : bar - start)));
+        if (bar == std::string::npos) {
+            return cells;
+        }
+        start = bar + 1;
+    }
+}
+
+void DismOutputParser::Feed(const char* data, size_t size) {
+    size_t start = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] == '\n') {
+            partialLine.append(data + start, i - start);
+            ParseLine(partialLine);
+            partialLine.clear();
+            start = i + 1;
+        }
+    }
+    partialLine.append(data + start, size - start);
+}
+
+void DismOutputParser::Finish() {
+    if (!partialLine.empty()) {
+        ParseLine(partialLine);
+        partialLine.clear();
+    }
+    FlushTableRow();
+    EndRecord();
+}
+
+void DismOutputParser::ParseLine(const std::string& rawLine) {
+    std::string line = rawLine;
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back(); // Windows line ending
+    }
+    size_t lastReturn = line.find_last_of('\r'); // DISM redraws its progress bar with carriage returns, only the text after the last one is the real line
+    if (lastReturn != std::string::npos) {
+        line.erase(0, lastReturn + 1);
+    }
+    line = Trim(line);
+
+    if (line.find('|') != std::string::npos) {
+        std::vector<std::string> cells = SplitDismTableRow(line);
+        if (IsTableRule(cells)) {
+            hasPendingRow = false; // The row above a rule is the header
+            return;
+        }
+        FlushTableRow();
+        pendingRow = cells;
+        hasPendingRow = true;
+        return;
+    }
+    FlushTableRow();
+
+    size_t separator = line.find(" : ");
+    if (separator != std::string::npos) {
+        inRecord = true;
+        if (onField) {
+            onField(Trim(line.substr(0, separator)), Trim(line.substr(separator + 3)));
+        }
+    }
+    else if (line.empty()) {
+        EndRecord();
+    }
+}
+
+void DismOutputParser::EndRecord() {
+    if (inRecord) {
+        inRecord = false;
+        if (onRecordEnd) {
+            onRecordEnd();
+        }
+    }
+}
+
+void DismOutputParser::FlushTableRow() {
+    if (hasPendingRow) {
+        hasPendingRow = false;
+        if (onTableRow) {
+            onTableRow(pendingRow);
+        }
+    }
+}
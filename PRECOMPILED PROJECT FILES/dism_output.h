@@ -0,0 +1,34 @@
+#pragma once
+// Streaming parser for the text DISM prints. Output is fed in whatever pieces the pipe delivers and is turned
+// into the two shapes DISM uses for listings:
+//   "Key : Value" lines grouped into records separated by blank lines (/Get-Packages, /Get-ProvisionedAppxPackages)
+//   "Cell | Cell" table rows (/Format:Table), with the header row and the "----" rules left out
+#include <cstddef>    // size_t
+#include <functional> // std::function for the callbacks
+#include <string>     // std::string for lines, keys and values
+#include <vector>     // std::vector for table cells
+
+class DismOutputParser {
+public:
+    std::function<void(const std::string& key, const std::string& value)> onField; // One "Key : Value" line
+    std::function<void()> onRecordEnd;                                          // End of a group of fields
+    std::function<void(const std::vector<std::string>& cells)> onTableRow;      // One data row of a table
+
+    // Adds more output, calling the callbacks for every line it completes
+    void Feed(const char* data, size_t size);
+    // Ends the output, flushing the last line, table row and record
+    void Finish();
+
+private:
+    void ParseLine(const std::string& line);
+    void EndRecord();
+    void FlushTableRow();
+
+    std::string partialLine;             // Output after the last line break
+    bool inRecord = false;               // Fields were seen since the last record end
+    bool hasPendingRow = false;          // A table row is held back until we know whether it is the header
+    std::vector<std::string> pendingRow;
+};
+
+// Function declarations for DISM output
+std::vector<std::string> SplitDismTableRow(const std::string& line);
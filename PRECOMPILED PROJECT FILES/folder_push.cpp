@@ -0,0 +1,295 @@
+#include "folder_push.h"
+#include "direct_io.h"    // Large sequential reads and writes for the copies
+#include "sha1.h"         // SHA-1 of the pushed files
+#include "thread_pool.h"  // WorkerPool for copying on all cores
+#include "tsv_manifest.h" // Reading and writing the manifest
+#include <algorithm>  // std::min and std::max
+#include <chrono>     // std::chrono::steady_clock for timing
+#include <cstring>    // std::memset for the padding of the last block
+#include <filesystem> // std::filesystem for walking the folders
+#include <iostream>   // std::cout and std::cerr for output
+#include <map>        // std::map for finding files of the same size and content
+#include <vector>     // std::vector for the work list
+
+namespace fs = std::filesystem;
+
+// First line of a manifest file
+static constexpr const char* PUSH_MANIFEST_HEADER = "MODWIN push manifest 1";
+// Largest block read and written at once per file
+static constexpr size_t PUSH_COPY_BUFFER_SIZE = 4 * 1024 * 1024;
+
+// Manifest lines are "sha1 <tab> size <tab> time <tab> copy size <tab> copy time <tab> relative path"
+bool LoadPushManifest(const std::string& manifestPath, PushManifest& manifest) {
+    manifest.clear();
+    std::vector<TsvManifestLine> lines;
+    if (!LoadTsvManifest(manifestPath, PUSH_MANIFEST_HEADER, 5, lines)) {
+        return false;
+    }
+    for (const TsvManifestLine& line : lines) {
+        PushManifestEntry entry;
+        entry.sha1 = line.fields[0];
+        if (ParseTsvField(line.fields[1], entry.source.size) && ParseTsvField(line.fields[2], entry.source.writeTime) &&
+            ParseTsvField(line.fields[3], entry.copy.size) && ParseTsvField(line.fields[4], entry.copy.writeTime)) {
+            entry.source.exists = true;
+            entry.copy.exists = true;
+            manifest[line.name] = entry;
+        }
+    }
+    return true;
+}
+
+bool SavePushManifest(const std::string& manifestPath, const PushManifest& manifest) {
+    std::vector<TsvManifestLine> lines;
+    for (const auto& [path, entry] : manifest) {
+        lines.push_back({ { entry.sha1, std::to_string(entry.source.size), std::to_string(entry.source.writeTime),
+            std::to_string(entry.copy.size), std::to_string(entry.copy.writeTime) }, path });
+    }
+    return SaveTsvManifest(manifestPath, PUSH_MANIFEST_HEADER, lines);
+}
+
+// Decides what to do with a file from its state now ('source' in the folder, 'copy' in the image) and what the
+// last push recorded about it, if anything
+PushAction DiffPushFile(const PushFileState& source, const PushFileState& copy, const PushManifestEntry* last) {
+    if (!last || !copy.exists || copy.size != last->copy.size || copy.writeTime != last->copy.writeTime) {
+        return PushAction::Copy; // New, or the copy in the image is gone or was changed there
+    }
+    if (source.size != last->source.size) {
+        return PushAction::Copy;
+    }
+    return source.writeTime == last->source.writeTime ? PushAction::Skip : PushAction::Verify;
+}
+
+// Function to read the size and write time of a file
+static PushFileState FileState(const fs::path& path) {
+    PushFileState state;
+    std::error_code error;
+    if (fs::is_regular_file(path, error)) {
+        state.size = fs::file_size(path, error);
+        state.writeTime = static_cast<int64_t>(fs::last_write_time(path, error).time_since_epoch().count());
+        state.exists = !error;
+    }
+    return state;
+}
+
+// Function to size the buffer for a file: whole sectors, no more than the file needs up to PUSH_COPY_BUFFER_SIZE
+static size_t CopyBufferSize(uint64_t fileSize) {
+    uint64_t sectors = std::max<uint64_t>(1, (fileSize + IO_ALIGNMENT - 1) / IO_ALIGNMENT);
+    return static_cast<size_t>(std::min<uint64_t>(PUSH_COPY_BUFFER_SIZE, sectors * IO_ALIGNMENT));
+}
+
+// Function to hash a file without copying it
+static bool HashFile(const fs::path& path, uint64_t size, std::string& sha1) {
+    SequentialFileReader reader;
+    if (!reader.Open(path)) {
+        return false;
+    }
+    AlignedBuffer buffer = AllocateAligned(CopyBufferSize(size));
+    Sha1Context context;
+    Sha1Init(context);
+    for (uint64_t remaining = size; remaining > 0;) {
+        size_t part = static_cast<size_t>(std::min<uint64_t>(remaining, PUSH_COPY_BUFFER_SIZE));
+        if (!reader.Read(buffer.get(), part)) {
+            return false;
+        }
+        Sha1Update(context, buffer.get(), part);
+        remaining -= part;
+    }
+    uint8_t digest[SHA1_DIGEST_SIZE];
+    Sha1Final(context, digest);
+    sha1 = Sha1ToHex(digest);
+    return true;
+}
+
+// Function to delete a file of the image before it is replaced. Read-only files are replaced too, as "xcopy /r" did,
+// and a file that is hardlinked elsewhere is unlinked rather than overwritten, so the other names keep their content.
+static void RemoveOldCopy(const fs::path& path) {
+    std::error_code error;
+    if (fs::exists(path, error)) {
+        fs::permissions(path, fs::perms::owner_write, fs::perm_options::add, error);
+        fs::remove(path, error);
+    }
+}
+
+// Function to make 'link' another name of the file 'target' of the image
+static bool LinkFile(const fs::path& target, const fs::path& link) {
+    std::error_code error;
+    RemoveOldCopy(link);
+    fs::create_hard_link(target, link, error);
+    return !error;
+}
+
+// Function to copy a file, hashing it on the way, and give the copy the write time of the original
+static bool CopyFileHashed(const fs::path& from, const fs::path& to, uint64_t size, int64_t writeTime, std::string& sha1) {
+    std::error_code error;
+    RemoveOldCopy(to);
+    SequentialFileReader reader;
+    SequentialFileWriter writer;
+    if (!reader.Open(from) || !writer.Open(to)) {
+        return false;
+    }
+    AlignedBuffer buffer = AllocateAligned(CopyBufferSize(size));
+    Sha1Context context;
+    Sha1Init(context);
+    for (uint64_t remaining = size; remaining > 0;) {
+        size_t part = static_cast<size_t>(std::min<uint64_t>(remaining, PUSH_COPY_BUFFER_SIZE));
+        if (!reader.Read(buffer.get(), part)) {
+            writer.Discard();
+            return false;
+        }
+        Sha1Update(context, buffer.get(), part);
+        size_t padded = (part + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT; // Unbuffered writes take whole sectors
+        std::memset(buffer.get() + part, 0, padded - part);
+        if (!writer.Write(buffer.get(), padded)) {
+            writer.Discard();
+            return false;
+        }
+        remaining -= part;
+    }
+    if (!writer.Close(size)) {
+        return false;
+    }
+    uint8_t digest[SHA1_DIGEST_SIZE];
+    Sha1Final(context, digest);
+    sha1 = Sha1ToHex(digest);
+    fs::last_write_time(to, fs::file_time_type(fs::file_time_type::duration(writeTime)), error);
+    return !error;
+}
+
+// Function to push 'sourceDir' into 'destDir', using and updating the manifest at 'manifestPath'. Files removed from
+// the source stay in the image, as with xcopy.
+bool PushFolder(const std::string& sourceDir, const std::string& destDir, const std::string& manifestPath, FolderPushStats& stats,
+    unsigned threadCount) {
+    auto start = std::chrono::steady_clock::now();
+    stats = FolderPushStats();
+    PushManifest last;
+    LoadPushManifest(manifestPath, last); // A missing manifest means everything is copied
+
+    // Walks the source, creating its folders in the image (empty ones too) and deciding what each file needs
+    struct WorkItem {
+        std::string path;
+        PushFileState source;
+        PushAction action;
+        const PushManifestEntry* last;
+        bool ok;
+        PushManifestEntry result;
+        size_t linkTo;  // Item whose file in the image this one links to, NO_LINK to copy it
+        bool linked;
+    };
+    constexpr size_t NO_LINK = SIZE_MAX;
+    std::vector<WorkItem> items;
+    std::error_code error;
+    fs::recursive_directory_iterator walk(sourceDir, fs::directory_options::skip_permission_denied, error);
+    if (error) {
+        std::cerr << "Error: Cannot read " << sourceDir << ".\n";
+        return false;
+    }
+    for (; walk != fs::recursive_directory_iterator(); walk.increment(error)) {
+        if (error) {
+            break;
+        }
+        fs::path relative = walk->path().lexically_relative(sourceDir);
+        if (walk->is_directory(error)) {
+            fs::create_directories(fs::path(destDir) / relative, error);
+            continue;
+        }
+        PushFileState source = FileState(walk->path());
+        if (!source.exists) {
+            continue;
+        }
+        std::string key = relative.generic_u8string(); // UTF-8, so names outside the ANSI code page survive the manifest
+        auto found = last.find(key);
+        const PushManifestEntry* lastEntry = found == last.end() ? nullptr : &found->second;
+        PushAction action = DiffPushFile(source, FileState(fs::path(destDir) / relative), lastEntry);
+        items.push_back({ key, source, action, lastEntry, false, PushManifestEntry(), NO_LINK, false });
+    }
+
+    // Files to copy that share their size with another file are hashed first, along with the files to verify, so
+    // each content is copied into the image once
+    std::map<uint64_t, size_t> sizeCounts;
+    for (const WorkItem& item : items) {
+        sizeCounts[item.source.size]++;
+    }
+    WorkerPool pool(threadCount);
+    pool.ParallelFor(items.size(), [&](size_t i) {
+        WorkItem& item = items[i];
+        item.result.source = item.source;
+        if (item.action == PushAction::Skip) {
+            item.ok = true;
+            item.result = *item.last;
+            return;
+        }
+        bool sharedSize = item.source.size > 0 && sizeCounts.at(item.source.size) > 1;
+        if (item.action == PushAction::Verify || sharedSize) {
+            if (!HashFile(fs::path(sourceDir) / fs::u8path(item.path), item.source.size, item.result.sha1)) {
+                item.result.sha1.clear();
+                item.action = PushAction::Copy; // The copy reports the error
+                return;
+            }
+            if (item.action == PushAction::Verify && item.result.sha1 == item.last->sha1) {
+                item.ok = true;
+                item.result.copy = item.last->copy;
+                return;
+            }
+            item.action = PushAction::Copy;
+        }
+    });
+
+    // Duplicates become hardlinks to a file of the same content, one already in the image or the first one copied
+    std::map<std::pair<std::string, uint64_t>, size_t> contents; // SHA-1 and size to the item holding them
+    for (size_t i = 0; i < items.size(); i++) {
+        if (items[i].ok && !items[i].result.sha1.empty()) {
+            contents.emplace(std::make_pair(items[i].result.sha1, items[i].source.size), i);
+        }
+    }
+    for (size_t i = 0; i < items.size(); i++) {
+        if (items[i].action == PushAction::Copy && !items[i].result.sha1.empty()) {
+            auto found = contents.emplace(std::make_pair(items[i].result.sha1, items[i].source.size), i).first;
+            items[i].linkTo = found->second == i ? NO_LINK : found->second;
+        }
+    }
+
+    for (bool links : { false, true }) { // Copies first, then the links to them
+        pool.ParallelFor(items.size(), [&](size_t i) {
+            WorkItem& item = items[i];
+            if (item.action != PushAction::Copy || (item.linkTo != NO_LINK) != links) {
+                return;
+            }
+            fs::path to = fs::path(destDir) / fs::u8path(item.path);
+            if (links && items[item.linkTo].ok && LinkFile(fs::path(destDir) / fs::u8path(items[item.linkTo].path), to)) {
+                item.linked = true;
+                item.ok = true;
+            }
+            else { // Also when the file system has no hardlinks
+                item.ok = CopyFileHashed(fs::path(sourceDir) / fs::u8path(item.path), to, item.source.size, item.source.writeTime, item.result.sha1);
+            }
+            item.result.copy = FileState(to);
+        });
+    }
+
+    PushManifest manifest;
+    for (const WorkItem& item : items) {
+        if (!item.ok) {
+            std::cerr << "Error: Failed to copy " << item.path << " into the image.\n";
+            stats.failed++;
+            continue;
+        }
+        manifest[item.path] = item.result;
+        if (item.linked) {
+            stats.linked++;
+            stats.bytesLinked += item.source.size;
+        }
+        else if (item.action == PushAction::Copy) {
+            stats.copied++;
+            stats.bytesCopied += item.source.size;
+        }
+        else {
+            stats.skipped++;
+            stats.verified += item.action == PushAction::Verify;
+        }
+    }
+    if (!SavePushManifest(manifestPath, manifest)) {
+        std::cerr << "Warning: Could not save the push manifest " << manifestPath << ", the next push copies everything.\n";
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats.failed == 0;
+}
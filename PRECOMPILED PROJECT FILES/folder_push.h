@@ -0,0 +1,51 @@
+#pragma once
+// Copies a folder into the mounted image, such as C:\MODWIN\USER into C:\MODWIN\PATH, copying only what changed
+// since the last push. A manifest records the size, write time and SHA-1 of every file pushed and the size and
+// write time of the copy it left in the image. Files that match it on both sides are skipped, files whose write time
+// changed are hashed and only copied if their content differs, and the rest is copied on all cores with large
+// sequential reads and writes. Each content is copied once: files with the same SHA-1 become hardlinks to one copy,
+// which the WIM captures as a single resource anyway.
+#include <cstdint>     // Fixed width integer types for sizes and times
+#include <map>         // std::map for the manifest
+#include <string>      // std::string for paths and hashes
+
+// Size and last write time of a file, 'exists' is false when there is no file
+struct PushFileState {
+    bool exists = false;
+    uint64_t size = 0;
+    int64_t writeTime = 0; // std::filesystem::file_time_type ticks
+};
+
+// What the last push recorded about one file, keyed by its UTF-8 path relative to the folder with '/' separators
+struct PushManifestEntry {
+    PushFileState source;
+    PushFileState copy;   // The file it left in the image
+    std::string sha1;     // Hex SHA-1 of the content
+};
+using PushManifest = std::map<std::string, PushManifestEntry>;
+
+// What a push does with one file
+enum class PushAction {
+    Skip,   // Same as last time on both sides
+    Verify, // Only the write time changed, compare the content hash
+    Copy
+};
+
+// Totals of one push
+struct FolderPushStats {
+    size_t copied = 0;
+    size_t skipped = 0;   // Including files verified to be unchanged
+    size_t verified = 0;
+    size_t linked = 0;    // Duplicates made hardlinks instead of copies
+    size_t failed = 0;
+    uint64_t bytesCopied = 0;
+    uint64_t bytesLinked = 0;
+    double seconds = 0;
+};
+
+// Function declarations for folder pushes
+bool LoadPushManifest(const std::string& manifestPath, PushManifest& manifest);
+bool SavePushManifest(const std::string& manifestPath, const PushManifest& manifest);
+PushAction DiffPushFile(const PushFileState& source, const PushFileState& copy, const PushManifestEntry* last);
+bool PushFolder(const std::string& sourceDir, const std::string& destDir, const std::string& manifestPath, FolderPushStats& stats,
+    unsigned threadCount = 0);
@@ -1,33 +0,0 @@
-unsigned char _gitignore[] = {
-  0x23, 0x20, 0x42, 0x75, 0x69, 0x6c, 0x64, 0x20, 0x61, 0x6e, 0x64, 0x20,
-  0x52, 0x65, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x20, 0x46, 0x6f, 0x6c, 0x64,
-  0x65, 0x72, 0x73, 0x0a, 0x62, 0x69, 0x6e, 0x2d, 0x64, 0x65, 0x62, 0x75,
-  0x67, 0x2f, 0x0a, 0x62, 0x69, 0x6e, 0x2d, 0x72, 0x65, 0x6c, 0x65, 0x61,
-  0x73, 0x65, 0x2f, 0x0a, 0x5b, 0x4f, 0x6f, 0x5d, 0x62, 0x6a, 0x2f, 0x0a,
-  0x5b, 0x42, 0x62, 0x5d, 0x69, 0x6e, 0x2f, 0x0a, 0x0a, 0x23, 0x20, 0x4f,
-  0x74, 0x68, 0x65, 0x72, 0x20, 0x66, 0x69, 0x6c, 0x65, 0x73, 0x20, 0x61,
-  0x6e, 0x64, 0x20, 0x66, 0x6f, 0x6c, 0x64, 0x65, 0x72, 0x73, 0x0a, 0x2e,
-  0x73, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x2f, 0x0a, 0x0a, 0x23,
-  0x20, 0x45, 0x78, 0x65, 0x63, 0x75, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x73,
-  0x0a, 0x2a, 0x2e, 0x73, 0x77, 0x66, 0x0a, 0x2a, 0x2e, 0x61, 0x69, 0x72,
-  0x0a, 0x2a, 0x2e, 0x69, 0x70, 0x61, 0x0a, 0x2a, 0x2e, 0x61, 0x70, 0x6b,
-  0x0a, 0x0a, 0x23, 0x20, 0x50, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x20,
-  0x66, 0x69, 0x6c, 0x65, 0x73, 0x2c, 0x20, 0x69, 0x2e, 0x65, 0x2e, 0x20,
-  0x60, 0x2e, 0x70, 0x72, 0x6f, 0x6a, 0x65, 0x63, 0x74, 0x60, 0x2c, 0x20,
-  0x60, 0x2e, 0x61, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x53, 0x63, 0x72, 0x69,
-  0x70, 0x74, 0x50, 0x72, 0x6f, 0x70, 0x65, 0x72, 0x74, 0x69, 0x65, 0x73,
-  0x60, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x60, 0x2e, 0x66, 0x6c, 0x65, 0x78,
-  0x50, 0x72, 0x6f, 0x70, 0x65, 0x72, 0x74, 0x69, 0x65, 0x73, 0x60, 0x0a,
-  0x23, 0x20, 0x73, 0x68, 0x6f, 0x75, 0x6c, 0x64, 0x20, 0x4e, 0x4f, 0x54,
-  0x20, 0x62, 0x65, 0x20, 0x65, 0x78, 0x63, 0x6c, 0x75, 0x64, 0x65, 0x64,
-  0x20, 0x61, 0x73, 0x20, 0x74, 0x68, 0x65, 0x79, 0x20, 0x63, 0x6f, 0x6e,
-  0x74, 0x61, 0x69, 0x6e, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x69, 0x6c, 0x65,
-  0x72, 0x20, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73, 0x20, 0x61,
-  0x6e, 0x64, 0x20, 0x6f, 0x74, 0x68, 0x65, 0x72, 0x20, 0x69, 0x6d, 0x70,
-  0x6f, 0x72, 0x74, 0x61, 0x6e, 0x74, 0x0a, 0x23, 0x20, 0x69, 0x6e, 0x66,
-  0x6f, 0x72, 0x6d, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x6f, 0x72,
-  0x20, 0x45, 0x63, 0x6c, 0x69, 0x70, 0x73, 0x65, 0x20, 0x2f, 0x20, 0x46,
-  0x6c, 0x61, 0x73, 0x68, 0x20, 0x42, 0x75, 0x69, 0x6c, 0x64, 0x65, 0x72,
-  0x2e, 0x0a
-};
-unsigned int _gitignore_len = 350;
@@ -0,0 +1,162 @@
+#include "huffman.h"
+#include <algorithm> // std::sort for ordering the symbols by frequency
+
+// Number of low bits used to hold a symbol when symbols and frequencies are packed into one integer
+static constexpr unsigned NUM_SYMBOL_BITS = 10;
+static constexpr uint32_t SYMBOL_MASK = (1U << NUM_SYMBOL_BITS) - 1;
+
+// Builds the Huffman tree in place. A[] holds (freq << NUM_SYMBOL_BITS) | sym sorted by frequency;
+// afterwards each of the first (count - 1) entries holds the index of its parent in the high bits.
+static void BuildTree(uint32_t A[], unsigned count) {
+    unsigned i = 0; // Next unprocessed leaf
+    unsigned b = 0; // Next parentless non-leaf node
+    unsigned e = 0; // Next slot to allocate a non-leaf node in
+    do {
+        unsigned m, n;
+        // Pick the two lowest frequency entries, preferring leaves when frequencies are equal
+        if (i != count && (b == e || (A[i] >> NUM_SYMBOL_BITS) <= (A[b] >> NUM_SYMBOL_BITS))) {
+            m = i++;
+        }
+        else {
+            m = b++;
+        }
+        if (i != count && (b == e || (A[i] >> NUM_SYMBOL_BITS) <= (A[b] >> NUM_SYMBOL_BITS))) {
+            n = i++;
+        }
+        else {
+            n = b++;
+        }
+        uint32_t freqShifted = (A[m] & ~SYMBOL_MASK) + (A[n] & ~SYMBOL_MASK); // Frequency of the new node
+        A[m] = (A[m] & SYMBOL_MASK) | (e << NUM_SYMBOL_BITS); // Link both children to the new node
+        A[n] = (A[n] & SYMBOL_MASK) | (e << NUM_SYMBOL_BITS);
+        A[e] = (A[e] & SYMBOL_MASK) | freqShifted;
+        e++;
+    } while (count - e > 1);
+}
+
+// Walks the tree from the root down and counts how many codewords get each length,
+// pushing leaves up whenever they would be deeper than the length limit
+static void ComputeLengthCounts(uint32_t A[], unsigned rootIndex, unsigned lenCounts[], unsigned maxLen) {
+    for (unsigned len = 0; len <= maxLen; len++) {
+        lenCounts[len] = 0;
+    }
+    lenCounts[1] = 2; // The root has two children of depth 1
+    A[rootIndex] &= SYMBOL_MASK; // The root has depth 0
+    for (int node = static_cast<int>(rootIndex) - 1; node >= 0; node--) {
+        unsigned parent = A[node] >> NUM_SYMBOL_BITS;
+        unsigned depth = (A[parent] >> NUM_SYMBOL_BITS) + 1;
+        unsigned len = depth;
+        A[node] = (A[node] & SYMBOL_MASK) | (depth << NUM_SYMBOL_BITS); // Remember the depth for the children
+        if (len >= maxLen) { // Too deep, hang the children off the deepest shorter leaf instead
+            len = maxLen;
+            do {
+                len--;
+            } while (lenCounts[len] == 0);
+        }
+        lenCounts[len]--;        // This position becomes a non-leaf node...
+        lenCounts[len + 1] += 2; // ...with two children one level deeper
+    }
+}
+
+// Function to build a length-limited canonical Huffman code from symbol frequencies
+void MakeHuffmanCode(unsigned numSyms, unsigned maxLen, const uint32_t freqs[], uint8_t lens[], uint32_t codewords[]) {
+    uint32_t A[HUFFMAN_MAX_SYMBOLS];
+    unsigned used = 0;
+    for (unsigned sym = 0; sym < numSyms; sym++) { // Pack every used symbol with its frequency
+        lens[sym] = 0;
+        codewords[sym] = 0;
+        if (freqs[sym] != 0) {
+            uint32_t freq = std::min<uint32_t>(freqs[sym], (1U << (32 - NUM_SYMBOL_BITS)) - 1);
+            A[used++] = (freq << NUM_SYMBOL_BITS) | sym;
+        }
+    }
+    if (used == 0) { // Empty code, nothing to do
+        return;
+    }
+    if (used == 1) { // A single symbol still needs a complete code, so pair it with another one
+        unsigned sym = A[0] & SYMBOL_MASK;
+        unsigned other = (sym == 0) ? 1 : 0;
+        lens[sym] = 1;
+        lens[other] = 1;
+        codewords[std::min(sym, other)] = 0;
+        codewords[std::max(sym, other)] = 1;
+        return;
+    }
+    std::sort(A, A + used); // Sort by frequency, then by symbol value
+    BuildTree(A, used);
+    unsigned lenCounts[HUFFMAN_MAX_CODEWORD_LEN + 1];
+    ComputeLengthCounts(A, used - 2, lenCounts, maxLen);
+    // Hand out the lengths, longest first, to the symbols in order of increasing frequency
+    unsigned i = 0;
+    for (unsigned len = maxLen; len >= 1; len--) {
+        for (unsigned c = lenCounts[len]; c > 0; c--) {
+            lens[A[i++] & SYMBOL_MASK] = static_cast<uint8_t>(len);
+        }
+    }
+    // Assign canonical codewords: shorter codes first, then in symbol order
+    uint32_t nextCodeword[HUFFMAN_MAX_CODEWORD_LEN + 2] = {};
+    for (unsigned len = 2; len <= maxLen; len++) {
+        nextCodeword[len] = (nextCodeword[len - 1] + lenCounts[len - 1]) << 1;
+    }
+    for (unsigned sym = 0; sym < numSyms; sym++) {
+        if (lens[sym] != 0) {
+            codewords[sym] = nextCodeword[lens[sym]]++;
+        }
+    }
+}
+
+// Function to build the decode tables for a canonical Huffman code
+bool HuffmanDecoder::Build(const uint8_t lens[], unsigned numSyms, unsigned maxCodewordLen, unsigned directBits) {
+    maxLen = maxCodewordLen;
+    tableBits = std::min(directBits, maxCodewordLen);
+    for (unsigned len = 0; len <= HUFFMAN_MAX_CODEWORD_LEN; len++) {
+        count[len] = 0;
+    }
+    for (unsigned sym = 0; sym < numSyms; sym++) {
+        if (lens[sym] > maxLen) {
+            return false; // Codeword longer than the format allows
+        }
+        count[lens[sym]]++;
+    }
+    count[0] = 0; // Unused symbols do not take part in the code
+    // Check that the code is not over-subscribed (Kraft inequality)
+    int64_t remaining = 1;
+    for (unsigned len = 1; len <= maxLen; len++) {
+        remaining = (remaining << 1) - count[len];
+        if (remaining < 0) {
+            return false;
+        }
+    }
+    // Compute the first codeword and first sorted position of every length
+    uint32_t code = 0;
+    uint32_t index = 0;
+    for (unsigned len = 1; len <= maxLen; len++) {
+        firstCode[len] = code;
+        firstIndex[len] = index;
+        code = (code + count[len]) << 1;
+        index += count[len];
+    }
+    sortedSyms.assign(index, 0);
+    uint32_t next[HUFFMAN_MAX_CODEWORD_LEN + 1];
+    for (unsigned len = 1; len <= maxLen; len++) {
+        next[len] = firstIndex[len];
+    }
+    for (unsigned sym = 0; sym < numSyms; sym++) {
+        if (lens[sym] != 0) {
+            sortedSyms[next[lens[sym]]++] = static_cast<uint16_t>(sym);
+        }
+    }
+    // Fill the direct lookup table for every codeword that fits in tableBits
+    table.assign(size_t(1) << tableBits, 0);
+    for (unsigned len = 1; len <= tableBits; len++) {
+        for (uint32_t i = 0; i < count[len]; i++) {
+            uint32_t sym = sortedSyms[firstIndex[len] + i];
+            uint32_t start = (firstCode[len] + i) << (tableBits - len);
+            uint32_t end = start + (1U << (tableBits - len));
+            for (uint32_t j = start; j < end; j++) {
+                table[j] = (sym << 5) | len;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+// Canonical Huffman codes shared by the LZX, XPRESS and LZMS compressors and decompressors.
+#include <cstdint> // Fixed width integer types
+#include <vector>  // std::vector for the decode tables
+
+// Largest alphabet any of MODWIN's codecs uses (the LZMS offset alphabet)
+constexpr unsigned HUFFMAN_MAX_SYMBOLS = 1024;
+// Longest codeword any of MODWIN's codecs allows
+constexpr unsigned HUFFMAN_MAX_CODEWORD_LEN = 16;
+
+// Function to build a length-limited canonical Huffman code from symbol frequencies.
+// The construction is deterministic (ties are broken by symbol value) because LZMS rebuilds its
+// codes from the same frequencies on both sides and the result must match bit for bit.
+void MakeHuffmanCode(unsigned numSyms, unsigned maxLen, const uint32_t freqs[], uint8_t lens[], uint32_t codewords[]);
+
+// Table driven decoder for a canonical Huffman code given its codeword lengths
+class HuffmanDecoder {
+public:
+    // Builds the tables, returns false if the lengths do not describe a valid prefix code
+    bool Build(const uint8_t lens[], unsigned numSyms, unsigned maxLen, unsigned tableBits);
+
+    // Decodes one symbol from a bit reader that provides Peek(n) and Skip(n), returns -1 on a bad code
+    template <class BitReader>
+    int Decode(BitReader& bits) const {
+        uint32_t entry = table[bits.Peek(tableBits)];
+        if (entry & 0x1F) { // Short codeword, resolved by the lookup table alone
+            bits.Skip(entry & 0x1F);
+            return static_cast<int>(entry >> 5);
+        }
+        for (unsigned len = tableBits + 1; len <= maxLen; ++len) { // Long codeword, walk the canonical ranges
+            uint32_t code = bits.Peek(len);
+            if (code >= firstCode[len] && code - firstCode[len] < count[len]) {
+                bits.Skip(len);
+                return sortedSyms[firstIndex[len] + (code - firstCode[len])];
+            }
+        }
+        return -1;
+    }
+
+private:
+    unsigned tableBits = 0; // Number of bits resolved by the direct lookup table
+    unsigned maxLen = 0;    // Longest codeword of this code
+    std::vector<uint32_t> table;      // (symbol << 5) | length for every tableBits-bit prefix, 0 for long codes
+    std::vector<uint16_t> sortedSyms; // Symbols sorted by codeword length, then by symbol value
+    uint32_t count[HUFFMAN_MAX_CODEWORD_LEN + 1] = {};      // Number of codewords of each length
+    uint32_t firstCode[HUFFMAN_MAX_CODEWORD_LEN + 1] = {};  // First codeword of each length
+    uint32_t firstIndex[HUFFMAN_MAX_CODEWORD_LEN + 1] = {}; // Position in sortedSyms of the first symbol of each length
+};
@@ -0,0 +1,167 @@
+#include "image_inventory.h"
+#include <filesystem> // std::filesystem for the size and write time of the logs
+#include <sstream>    // std::istringstream for splitting the log paths
+
+// Files the servicing stack writes whenever it changes the image: the session list of the component store and
+// the CBS and DISM logs kept inside the image
+static const char* const SERVICING_LOGS[] = {
+    "Windows\\servicing\\Sessions\\Sessions.xml",
+    "Windows\\Logs\\CBS\\CBS.log",
+    "Windows\\Logs\\DISM\\dism.log"
+};
+
+// Function to take the size and write time of each servicing log of the image at 'imageDir'
+ServicingLogStamp StampServicingLogs(const std::string& imageDir) {
+    ServicingLogStamp stamp;
+    for (const char* log : SERVICING_LOGS) {
+        std::filesystem::path path = imageDir;
+        std::istringstream parts(log);
+        std::string part;
+        while (std::getline(parts, part, '\\')) { // Joined part by part, so the path holds native separators
+            path /= part;
+        }
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(path, error);
+        if (error) {
+            size = 0;
+        }
+        auto writeTime = std::filesystem::last_write_time(path, error);
+        stamp.values.push_back(size);
+        stamp.values.push_back(error ? 0 : static_cast<uint64_t>(writeTime.time_since_epoch().count()));
+    }
+    return stamp;
+}
+
+CachedImageServicing::CachedImageServicing(std::unique_ptr<ImageServicing> backend, const std::string& imageDir)
+    : backend(std::move(backend)), imageDir(imageDir) {
+}
+
+void CachedImageServicing::Invalidate() {
+    appsValid = false;
+    packagesValid = false;
+    featuresValid = false;
+}
+
+// Drops the cache when the image was serviced since it was filled, e.g. by a dism.exe run outside MODWIN
+void CachedImageServicing::CheckLogs() {
+    ServicingLogStamp stamp = StampServicingLogs(imageDir);
+    if (stamp != logStamp) {
+        Invalidate();
+        logStamp = stamp;
+    }
+}
+
+void CachedImageServicing::StampLogs() {
+    logStamp = StampServicingLogs(imageDir);
+}
+
+bool CachedImageServicing::ListProvisionedApps(AppxPackageTable& apps) {
+    CheckLogs();
+    if (!appsValid) {
+        appsValid = backend->ListProvisionedApps(this->apps);
+        StampLogs(); // Listing through DISM can write to the logs itself
+        if (!appsValid) {
+            return false;
+        }
+    }
+    apps = this->apps;
+    return true;
+}
+
+bool CachedImageServicing::ListPackages(PackageTable& packages) {
+    CheckLogs();
+    if (!packagesValid) {
+        packagesValid = backend->ListPackages(this->packages);
+        StampLogs();
+        if (!packagesValid) {
+            return false;
+        }
+    }
+    packages = this->packages;
+    return true;
+}
+
+bool CachedImageServicing::ListFeatures(FeatureTable& features) {
+    CheckLogs();
+    if (!featuresValid) {
+        featuresValid = backend->ListFeatures(this->features);
+        StampLogs();
+        if (!featuresValid) {
+            return false;
+        }
+    }
+    features = this->features;
+    return true;
+}
+
+// Changes drop the affected tables whether or not they succeed, since a failed operation can still leave part of
+// its work behind. The logs are checked before the change and stamped again after it, so MODWIN's own change does
+// not also drop the tables it cannot affect.
+ServicingResult CachedImageServicing::AddProvisionedApp(const std::string& appPath) {
+    CheckLogs();
+    appsValid = false;
+    ServicingResult result = backend->AddProvisionedApp(appPath);
+    StampLogs();
+    return result;
+}
+
+ServicingResult CachedImageServicing::RemoveProvisionedApp(const std::string& packageName) {
+    CheckLogs();
+    appsValid = false;
+    ServicingResult result = backend->RemoveProvisionedApp(packageName);
+    StampLogs();
+    return result;
+}
+
+std::vector<ServicingBatchItem> CachedImageServicing::RemoveProvisionedApps(const std::vector<std::string>& packageNames) {
+    CheckLogs();
+    appsValid = false;
+    std::vector<ServicingBatchItem> items = backend->RemoveProvisionedApps(packageNames);
+    StampLogs();
+    return items;
+}
+
+ServicingResult CachedImageServicing::AddPackage(const std::string& packagePath) {
+    CheckLogs();
+    packagesValid = false;
+    featuresValid = false;
+    ServicingResult result = backend->AddPackage(packagePath);
+    StampLogs();
+    return result;
+}
+
+ServicingResult CachedImageServicing::RemovePackage(const std::string& packageIdentity) {
+    CheckLogs();
+    packagesValid = false;
+    featuresValid = false;
+    ServicingResult result = backend->RemovePackage(packageIdentity);
+    StampLogs();
+    return result;
+}
+
+std::vector<ServicingBatchItem> CachedImageServicing::RemovePackages(const std::vector<std::string>& packageIdentities) {
+    CheckLogs();
+    packagesValid = false;
+    featuresValid = false;
+    std::vector<ServicingBatchItem> items = backend->RemovePackages(packageIdentities);
+    StampLogs();
+    return items;
+}
+
+ServicingResult CachedImageServicing::EnableFeature(const std::string& featureName) {
+    CheckLogs();
+    packagesValid = false;
+    featuresValid = false;
+    ServicingResult result = backend->EnableFeature(featureName);
+    StampLogs();
+    return result;
+}
+
+ServicingResult CachedImageServicing::DisableFeature(const std::string& featureName) {
+    CheckLogs();
+    packagesValid = false;
+    featuresValid = false;
+    ServicingResult result = backend->DisableFeature(featureName);
+    StampLogs();
+    return result;
+}
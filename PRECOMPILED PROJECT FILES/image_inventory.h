@@ -0,0 +1,59 @@
+#pragma once
+// Cached inventory of the mounted image. Listing apps, packages or features through DISM takes seconds, so the
+// tables are kept after the first listing and handed out again until MODWIN changes the image through the same
+// ImageServicing, or the servicing stack of the image records a change made from outside MODWIN.
+#include "image_servicing.h" // ImageServicing wrapped by the cache
+#include <cstdint>    // uint64_t for the log stamps
+#include <memory>     // std::unique_ptr owning the wrapped backend
+#include <string>     // std::string for the mount folder
+#include <vector>     // std::vector for the log stamps
+
+// Size and last write time of the servicing logs of an image, compared to spot changes made from outside MODWIN
+struct ServicingLogStamp {
+    std::vector<uint64_t> values; // Size and write time of every log, 0 for a missing log
+
+    bool operator==(const ServicingLogStamp& other) const { return values == other.values; }
+    bool operator!=(const ServicingLogStamp& other) const { return values != other.values; }
+};
+
+// ImageServicing that answers listings from its cache and forwards every change to the wrapped backend. A change
+// drops the tables it can affect: app changes drop the apps, package and feature changes drop both packages and
+// features, since enabling or disabling a feature changes the state of the package it belongs to.
+class CachedImageServicing : public ImageServicing {
+public:
+    // 'imageDir' is the mount folder whose servicing logs are watched
+    CachedImageServicing(std::unique_ptr<ImageServicing> backend, const std::string& imageDir);
+
+    const char* Name() const override { return backend->Name(); }
+    bool ListProvisionedApps(AppxPackageTable& apps) override;
+    bool ListPackages(PackageTable& packages) override;
+    bool ListFeatures(FeatureTable& features) override;
+    ServicingResult AddProvisionedApp(const std::string& appPath) override;
+    ServicingResult RemoveProvisionedApp(const std::string& packageName) override;
+    ServicingResult AddPackage(const std::string& packagePath) override;
+    ServicingResult RemovePackage(const std::string& packageIdentity) override;
+    ServicingResult EnableFeature(const std::string& featureName) override;
+    ServicingResult DisableFeature(const std::string& featureName) override;
+    std::vector<ServicingBatchItem> RemoveProvisionedApps(const std::vector<std::string>& packageNames) override;
+    std::vector<ServicingBatchItem> RemovePackages(const std::vector<std::string>& packageIdentities) override;
+
+    // Drops every cached table, the next listings go to DISM
+    void Invalidate();
+
+private:
+    void CheckLogs();
+    void StampLogs();
+
+    std::unique_ptr<ImageServicing> backend;
+    std::string imageDir;
+    ServicingLogStamp logStamp; // Stamp taken when the cached tables were filled
+    AppxPackageTable apps;
+    PackageTable packages;
+    FeatureTable features;
+    bool appsValid = false;
+    bool packagesValid = false;
+    bool featuresValid = false;
+};
+
+// Function declarations for the image inventory
+ServicingLogStamp StampServicingLogs(const std::string& imageDir);
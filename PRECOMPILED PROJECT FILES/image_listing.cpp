@@ -0,0 +1,272 @@
+#include "image_listing.h"
+#include "dism_output.h" // DismOutputParser for reading dism.exe listings
+#include <algorithm> // std::sort for ordering rows
+#include <cctype>    // std::tolower and std::isdigit for parsing
+#include <cstdio>    // std::snprintf for formatting times
+#include <memory>    // std::shared_ptr for the record being collected
+
+// Text dism.exe prints for each ReleaseType, in enum order
+static const char* const RELEASE_TYPE_NAMES[] = {
+    "Critical Update", "Driver", "Feature Pack", "Hotfix", "Security Update", "Software Update", "Update",
+    "Update Rollup", "Language Pack", "Foundation", "Service Pack", "Product", "Local Pack", "Other", "OnDemand Pack"
+};
+
+// Function to compare two strings ignoring case and spaces, so "OnDemand Pack" matches "On Demand Pack"
+static bool LooseEquals(std::string_view a, std::string_view b) {
+    size_t i = 0, j = 0;
+    while (true) {
+        while (i < a.size() && a[i] == ' ') i++;
+        while (j < b.size() && b[j] == ' ') j++;
+        if (i == a.size() || j == b.size()) {
+            return i == a.size() && j == b.size();
+        }
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[j]))) {
+            return false;
+        }
+        i++;
+        j++;
+    }
+}
+
+// Function to read the number at 'pos' and move past it, 0 if there is none
+static unsigned ReadNumber(std::string_view text, size_t& pos) {
+    unsigned value = 0;
+    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+        value = value * 10 + (text[pos++] - '0');
+    }
+    return value;
+}
+
+// Function to pack "10.0.22621.1702" into 16 bits per part, so versions compare as plain numbers
+uint64_t PackVersion(std::string_view text) {
+    uint64_t version = 0;
+    size_t pos = 0;
+    for (int part = 0; part < 4; part++) {
+        version = (version << 16) | (ReadNumber(text, pos) & 0xFFFF);
+        if (pos < text.size() && text[pos] == '.') {
+            pos++;
+        }
+    }
+    return version;
+}
+
+std::string FormatVersion(uint64_t version) {
+    return std::to_string((version >> 48) & 0xFFFF) + "." + std::to_string((version >> 32) & 0xFFFF) + "." +
+        std::to_string((version >> 16) & 0xFFFF) + "." + std::to_string(version & 0xFFFF);
+}
+
+ProcessorArchitecture ParseArchitecture(std::string_view text) {
+    if (LooseEquals(text, "neutral")) return ProcessorArchitecture::Neutral;
+    if (LooseEquals(text, "x86") || LooseEquals(text, "wow64")) return ProcessorArchitecture::X86;
+    if (LooseEquals(text, "amd64") || LooseEquals(text, "x64")) return ProcessorArchitecture::X64;
+    if (LooseEquals(text, "arm")) return ProcessorArchitecture::Arm;
+    if (LooseEquals(text, "arm64")) return ProcessorArchitecture::Arm64;
+    return ProcessorArchitecture::Unknown;
+}
+
+const char* ArchitectureName(ProcessorArchitecture architecture) {
+    switch (architecture) {
+    case ProcessorArchitecture::Neutral: return "neutral";
+    case ProcessorArchitecture::X86: return "x86";
+    case ProcessorArchitecture::X64: return "x64";
+    case ProcessorArchitecture::Arm: return "arm";
+    case ProcessorArchitecture::Arm64: return "arm64";
+    default: return "unknown";
+    }
+}
+
+// Function to read a state as dism.exe prints it for packages ("Installed") or for features ("Enabled")
+ServicingState ParseServicingState(std::string_view text) {
+    if (LooseEquals(text, "Installed") || LooseEquals(text, "Enabled")) return ServicingState::Installed;
+    if (LooseEquals(text, "Staged") || LooseEquals(text, "Disabled")) return ServicingState::Staged;
+    if (LooseEquals(text, "Removed") || LooseEquals(text, "Disabled with Payload Removed")) return ServicingState::Removed;
+    if (LooseEquals(text, "Install Pending") || LooseEquals(text, "Enable Pending")) return ServicingState::InstallPending;
+    if (LooseEquals(text, "Uninstall Pending") || LooseEquals(text, "Disable Pending")) return ServicingState::UninstallPending;
+    if (LooseEquals(text, "Superseded")) return ServicingState::Superseded;
+    if (LooseEquals(text, "Partially Installed")) return ServicingState::PartiallyInstalled;
+    if (LooseEquals(text, "Not Present")) return ServicingState::NotPresent;
+    return ServicingState::Unknown;
+}
+
+const char* PackageStateName(ServicingState state) {
+    switch (state) {
+    case ServicingState::NotPresent: return "Not Present";
+    case ServicingState::UninstallPending: return "Uninstall Pending";
+    case ServicingState::Staged: return "Staged";
+    case ServicingState::Removed: return "Removed";
+    case ServicingState::Installed: return "Installed";
+    case ServicingState::InstallPending: return "Install Pending";
+    case ServicingState::Superseded: return "Superseded";
+    case ServicingState::PartiallyInstalled: return "Partially Installed";
+    default: return "Unknown";
+    }
+}
+
+const char* FeatureStateName(ServicingState state) {
+    switch (state) {
+    case ServicingState::UninstallPending: return "Disable Pending";
+    case ServicingState::Staged: return "Disabled";
+    case ServicingState::Removed: return "Disabled with Payload Removed";
+    case ServicingState::Installed: return "Enabled";
+    case ServicingState::InstallPending: return "Enable Pending";
+    default: return PackageStateName(state);
+    }
+}
+
+ReleaseType ParseReleaseType(std::string_view text) {
+    for (size_t i = 0; i < sizeof(RELEASE_TYPE_NAMES) / sizeof(RELEASE_TYPE_NAMES[0]); i++) {
+        if (LooseEquals(text, RELEASE_TYPE_NAMES[i])) {
+            return static_cast<ReleaseType>(i);
+        }
+    }
+    return ReleaseType::Unknown;
+}
+
+const char* ReleaseTypeName(ReleaseType releaseType) {
+    size_t index = static_cast<size_t>(releaseType);
+    return index < sizeof(RELEASE_TYPE_NAMES) / sizeof(RELEASE_TYPE_NAMES[0]) ? RELEASE_TYPE_NAMES[index] : "Unknown";
+}
+
+// Function to read "5/9/2023 5:45 AM", the format dism.exe /English prints, into YYYYMMDDhhmm
+uint64_t ParseInstallTime(std::string_view text) {
+    size_t pos = 0;
+    unsigned month = ReadNumber(text, pos);
+    if (pos >= text.size() || text[pos++] != '/') return 0;
+    unsigned day = ReadNumber(text, pos);
+    if (pos >= text.size() || text[pos++] != '/') return 0;
+    unsigned year = ReadNumber(text, pos);
+    while (pos < text.size() && text[pos] == ' ') pos++;
+    unsigned hour = ReadNumber(text, pos);
+    unsigned minute = 0;
+    if (pos < text.size() && text[pos] == ':') {
+        pos++;
+        minute = ReadNumber(text, pos);
+    }
+    std::string_view rest = text.substr(pos);
+    if (rest.find("PM") != std::string_view::npos && hour < 12) hour += 12;
+    if (rest.find("AM") != std::string_view::npos && hour == 12) hour = 0;
+    if (month < 1 || month > 12 || day < 1 || day > 31 || year == 0) return 0;
+    return ((((uint64_t(year) * 100 + month) * 100 + day) * 100 + hour) * 100) + minute;
+}
+
+std::string FormatInstallTime(uint64_t installTime) {
+    if (installTime == 0) {
+        return "";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%04u-%02u-%02u %02u:%02u", unsigned(installTime / 100000000),
+        unsigned(installTime / 1000000 % 100), unsigned(installTime / 10000 % 100), unsigned(installTime / 100 % 100),
+        unsigned(installTime % 100));
+    return text;
+}
+
+void AppxPackageTable::Add(std::string_view packageName, std::string_view displayName, uint64_t version, ProcessorArchitecture architecture) {
+    packageNames.push_back(strings.Add(packageName));
+    displayNames.push_back(strings.Add(displayName));
+    versions.push_back(version);
+    architectures.push_back(architecture);
+}
+
+void AppxPackageTable::Clear() {
+    strings.Clear();
+    packageNames.clear();
+    displayNames.clear();
+    versions.clear();
+    architectures.clear();
+}
+
+// Adds a package, taking its architecture and version from the identity "Name~PublicKeyToken~Arch~Language~Version"
+void PackageTable::Add(std::string_view identity, ServicingState state, ReleaseType releaseType, uint64_t installTime) {
+    std::string_view fields[5];
+    size_t start = 0;
+    for (int i = 0; i < 5 && start <= identity.size(); i++) {
+        size_t tilde = identity.find('~', start);
+        fields[i] = identity.substr(start, tilde == std::string_view::npos ? std::string_view::npos : tilde - start);
+        start = tilde == std::string_view::npos ? identity.size() + 1 : tilde + 1;
+    }
+    identities.push_back(strings.Add(identity));
+    versions.push_back(PackVersion(fields[4]));
+    architectures.push_back(ParseArchitecture(fields[2]));
+    states.push_back(state);
+    releaseTypes.push_back(releaseType);
+    installTimes.push_back(installTime);
+}
+
+void PackageTable::Clear() {
+    strings.Clear();
+    identities.clear();
+    versions.clear();
+    architectures.clear();
+    states.clear();
+    releaseTypes.clear();
+    installTimes.clear();
+}
+
+void FeatureTable::Add(std::string_view name, ServicingState state) {
+    names.push_back(strings.Add(name));
+    states.push_back(state);
+}
+
+void FeatureTable::Clear() {
+    strings.Clear();
+    names.clear();
+    states.clear();
+}
+
+// Fills 'table' from the records of "dism /Get-ProvisionedAppxPackages"
+void CollectAppxPackages(DismOutputParser& parser, AppxPackageTable& table) {
+    struct Record { std::string packageName, displayName, version, architecture; };
+    auto record = std::make_shared<Record>();
+    parser.onField = [record](const std::string& key, const std::string& value) {
+        if (key == "PackageName") record->packageName = value;
+        else if (key == "DisplayName") record->displayName = value;
+        else if (key == "Version") record->version = value;
+        else if (key == "Architecture") record->architecture = value;
+    };
+    parser.onRecordEnd = [record, &table] {
+        if (!record->packageName.empty()) {
+            table.Add(record->packageName, record->displayName, PackVersion(record->version), ParseArchitecture(record->architecture));
+        }
+        *record = Record();
+    };
+}
+
+// Fills 'table' from the records of "dism /Get-Packages"
+void CollectPackages(DismOutputParser& parser, PackageTable& table) {
+    struct Record { std::string identity, state, releaseType, installTime; };
+    auto record = std::make_shared<Record>();
+    parser.onField = [record](const std::string& key, const std::string& value) {
+        if (key == "Package Identity") record->identity = value;
+        else if (key == "State") record->state = value;
+        else if (key == "Release Type") record->releaseType = value;
+        else if (key == "Install Time") record->installTime = value;
+    };
+    parser.onRecordEnd = [record, &table] {
+        if (!record->identity.empty()) {
+            table.Add(record->identity, ParseServicingState(record->state), ParseReleaseType(record->releaseType),
+                ParseInstallTime(record->installTime));
+        }
+        *record = Record();
+    };
+}
+
+// Fills 'table' from the rows of "dism /Get-Features /Format:Table"
+void CollectFeatures(DismOutputParser& parser, FeatureTable& table) {
+    parser.onTableRow = [&table](const std::vector<std::string>& cells) { // "TFTP | Disabled"
+        if (cells.size() >= 2 && !cells[0].empty()) {
+            table.Add(cells[0], ParseServicingState(cells[1]));
+        }
+    };
+}
+
+// Function to order the rows of any table by name
+template <typename Table>
+static std::vector<uint32_t> SortRowsByName(const Table& table) {
+    std::vector<uint32_t> rows = SelectRows(table, [](uint32_t) { return true; });
+    std::sort(rows.begin(), rows.end(), [&table](uint32_t a, uint32_t b) { return table.Name(a) < table.Name(b); });
+    return rows;
+}
+
+std::vector<uint32_t> SortedByName(const AppxPackageTable& table) { return SortRowsByName(table); }
+std::vector<uint32_t> SortedByName(const PackageTable& table) { return SortRowsByName(table); }
+std::vector<uint32_t> SortedByName(const FeatureTable& table) { return SortRowsByName(table); }
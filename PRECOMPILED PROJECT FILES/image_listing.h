@@ -0,0 +1,132 @@
+#pragma once
+// Typed listings of the apps, packages and features of a mounted image. Each listing is a table with one column
+// per field (structure of arrays) and all of its text in one shared buffer, so filtering or sorting thousands of
+// entries touches a few small contiguous arrays instead of one heap string per field.
+#include <cstdint>     // Fixed width integer types for the packed columns
+#include <string>      // std::string for the text buffer and formatted values
+#include <string_view> // std::string_view for reading text back out of a table
+#include <vector>      // std::vector for the columns
+
+class DismOutputParser;
+
+// State of a package or feature. The numbers match DismPackageFeatureState from the DISM API.
+enum class ServicingState : uint8_t {
+    NotPresent = 0,
+    UninstallPending = 1,   // Features: "Disable Pending"
+    Staged = 2,             // Features: "Disabled"
+    Removed = 3,            // Features: "Disabled with Payload Removed"
+    Installed = 4,          // Features: "Enabled"
+    InstallPending = 5,     // Features: "Enable Pending"
+    Superseded = 6,
+    PartiallyInstalled = 7,
+    Unknown = 255
+};
+
+// Release type of a package. The numbers match DismReleaseType from the DISM API.
+enum class ReleaseType : uint8_t {
+    CriticalUpdate = 0, Driver, FeaturePack, Hotfix, SecurityUpdate, SoftwareUpdate, Update, UpdateRollup,
+    LanguagePack, Foundation, ServicePack, Product, LocalPack, Other, OnDemandPack,
+    Unknown = 255
+};
+
+// Processor architecture of an app or package
+enum class ProcessorArchitecture : uint8_t { Unknown, Neutral, X86, X64, Arm, Arm64 };
+
+// Position of a string in a StringPool
+struct PooledString {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+// All strings of a table stored back to back in one buffer
+class StringPool {
+public:
+    PooledString Add(std::string_view text) {
+        PooledString pooled{ static_cast<uint32_t>(text.size() ? buffer.size() : 0), static_cast<uint32_t>(text.size()) };
+        buffer.append(text.data(), text.size());
+        return pooled;
+    }
+    std::string_view Get(PooledString pooled) const { return std::string_view(buffer).substr(pooled.offset, pooled.length); }
+    void Clear() { buffer.clear(); }
+
+private:
+    std::string buffer;
+};
+
+// Provisioned app packages (/Get-ProvisionedAppxPackages)
+struct AppxPackageTable {
+    StringPool strings;
+    std::vector<PooledString> packageNames;  // e.g. "Microsoft.BingNews_4.55.62231.0_x64__8wekyb3d8bbwe"
+    std::vector<PooledString> displayNames;  // e.g. "Microsoft.BingNews"
+    std::vector<uint64_t> versions;          // Packed with PackVersion
+    std::vector<ProcessorArchitecture> architectures;
+
+    size_t Size() const { return packageNames.size(); }
+    std::string_view Name(size_t i) const { return strings.Get(packageNames[i]); }
+    std::string_view DisplayName(size_t i) const { return strings.Get(displayNames[i]); }
+    void Add(std::string_view packageName, std::string_view displayName, uint64_t version, ProcessorArchitecture architecture);
+    void Clear();
+};
+
+// Packages (/Get-Packages)
+struct PackageTable {
+    StringPool strings;
+    std::vector<PooledString> identities;    // e.g. "Microsoft-Windows-WordPad-FoD-Package~31bf3856ad364e35~amd64~~10.0.22621.1"
+    std::vector<uint64_t> versions;          // Version field of the identity, packed with PackVersion
+    std::vector<ProcessorArchitecture> architectures; // Architecture field of the identity
+    std::vector<ServicingState> states;
+    std::vector<ReleaseType> releaseTypes;
+    std::vector<uint64_t> installTimes;      // YYYYMMDDhhmm, 0 when unknown
+
+    size_t Size() const { return identities.size(); }
+    std::string_view Name(size_t i) const { return strings.Get(identities[i]); }
+    void Add(std::string_view identity, ServicingState state, ReleaseType releaseType, uint64_t installTime);
+    void Clear();
+};
+
+// Optional features (/Get-Features)
+struct FeatureTable {
+    StringPool strings;
+    std::vector<PooledString> names;         // e.g. "TFTP"
+    std::vector<ServicingState> states;
+
+    size_t Size() const { return names.size(); }
+    std::string_view Name(size_t i) const { return strings.Get(names[i]); }
+    void Add(std::string_view name, ServicingState state);
+    void Clear();
+};
+
+// Function declarations for reading and writing the typed fields
+uint64_t PackVersion(std::string_view text);
+std::string FormatVersion(uint64_t version);
+ProcessorArchitecture ParseArchitecture(std::string_view text);
+const char* ArchitectureName(ProcessorArchitecture architecture);
+ServicingState ParseServicingState(std::string_view text);
+const char* PackageStateName(ServicingState state);
+const char* FeatureStateName(ServicingState state);
+ReleaseType ParseReleaseType(std::string_view text);
+const char* ReleaseTypeName(ReleaseType releaseType);
+uint64_t ParseInstallTime(std::string_view text);
+std::string FormatInstallTime(uint64_t installTime);
+
+// Function declarations for filling tables from dism.exe output
+void CollectAppxPackages(DismOutputParser& parser, AppxPackageTable& table);
+void CollectPackages(DismOutputParser& parser, PackageTable& table);
+void CollectFeatures(DismOutputParser& parser, FeatureTable& table);
+
+// Returns the rows of 'table' for which keep(row) is true, in table order
+template <typename Table, typename Predicate>
+std::vector<uint32_t> SelectRows(const Table& table, Predicate keep) {
+    std::vector<uint32_t> rows;
+    for (uint32_t i = 0; i < table.Size(); i++) {
+        if (keep(i)) {
+            rows.push_back(i);
+        }
+    }
+    return rows;
+}
+
+// Returns all rows of 'table' ordered by name
+std::vector<uint32_t> SortedByName(const AppxPackageTable& table);
+std::vector<uint32_t> SortedByName(const PackageTable& table);
+std::vector<uint32_t> SortedByName(const FeatureTable& table);
@@ -0,0 +1,383 @@
+#include "image_servicing.h"
+#include "dism_output.h"    // Streaming parser for DISM listings
+#include "process_runner.h" // Runs dism.exe and PowerShell with their output captured through a pipe
+#include <algorithm> // std::remove for dropping names from the scripted image
+#include <cstdio>    // std::remove for the batch files
+#include <cstdlib>   // std::system for running dism.exe
+#include <filesystem> // std::filesystem::path for naming the batch files
+#include <fstream>   // std::ifstream for reading scripts, std::ofstream for writing the batch files
+#include <sstream>   // std::istringstream for splitting script and result lines
+
+// Function to cut spaces, tabs and carriage returns off both ends of a string
+static std::string Trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+std::vector<ServicingBatchItem> ImageServicing::RemoveProvisionedApps(const std::vector<std::string>& packageNames) {
+    std::vector<ServicingBatchItem> items;
+    for (const std::string& packageName : packageNames) {
+        items.push_back({ packageName, RemoveProvisionedApp(packageName) });
+    }
+    return items;
+}
+
+std::vector<ServicingBatchItem> ImageServicing::RemovePackages(const std::vector<std::string>& packageIdentities) {
+    std::vector<ServicingBatchItem> items;
+    for (const std::string& packageIdentity : packageIdentities) {
+        items.push_back({ packageIdentity, RemovePackage(packageIdentity) });
+    }
+    return items;
+}
+
+DismCommandServicing::DismCommandServicing(const std::string& imageDir, const std::string& scratchDir)
+    : imageDir(imageDir), scratchDir(scratchDir) {
+}
+
+// Runs "dism /Image:<imageDir> <arguments>" and turns its exit code into a result
+ServicingResult DismCommandServicing::Run(const std::string& arguments) {
+    std::string command = "dism /Image:\"" + imageDir + "\" " + arguments;
+    ServicingResult result;
+    result.code = std::system(command.c_str());
+    result.ok = result.code == 0;
+    if (!result.ok) {
+        result.message = "dism.exe exited with code " + std::to_string(result.code);
+    }
+    return result;
+}
+
+// Runs a dism.exe listing and feeds its output to 'parser' as it arrives. /English keeps the field names the
+// same on every system language.
+bool DismCommandServicing::RunListing(const std::string& arguments, DismOutputParser& parser) {
+    std::string command = "dism.exe /English /Image:\"" + imageDir + "\" " + arguments;
+    int exitCode = RunProcess(command, [&](const char* data, size_t size) { parser.Feed(data, size); });
+    parser.Finish();
+    return exitCode == 0;
+}
+
+bool DismCommandServicing::ListProvisionedApps(AppxPackageTable& apps) {
+    apps.Clear();
+    DismOutputParser parser;
+    CollectAppxPackages(parser, apps);
+    return RunListing("/Get-ProvisionedAppxPackages", parser);
+}
+
+bool DismCommandServicing::ListPackages(PackageTable& packages) {
+    packages.Clear();
+    DismOutputParser parser;
+    CollectPackages(parser, packages);
+    return RunListing("/Get-Packages", parser);
+}
+
+bool DismCommandServicing::ListFeatures(FeatureTable& features) {
+    features.Clear();
+    DismOutputParser parser;
+    CollectFeatures(parser, features);
+    return RunListing("/Get-Features /Format:Table", parser);
+}
+
+ServicingResult DismCommandServicing::AddProvisionedApp(const std::string& appPath) {
+    return Run("/Add-ProvisionedAppxPackage /PackagePath:\"" + appPath + "\" /SkipLicense");
+}
+
+ServicingResult DismCommandServicing::RemoveProvisionedApp(const std::string& packageName) {
+    return Run("/Remove-ProvisionedAppxPackage /PackageName:\"" + packageName + "\"");
+}
+
+ServicingResult DismCommandServicing::AddPackage(const std::string& packagePath) {
+    return Run("/Add-Package /PackagePath:\"" + packagePath + "\"");
+}
+
+ServicingResult DismCommandServicing::RemovePackage(const std::string& packageIdentity) {
+    return Run("/Remove-Package /PackageName:\"" + packageIdentity + "\"");
+}
+
+ServicingResult DismCommandServicing::EnableFeature(const std::string& featureName) {
+    return Run("/Enable-Feature /FeatureName:\"" + featureName + "\"");
+}
+
+ServicingResult DismCommandServicing::DisableFeature(const std::string& featureName) {
+    return Run("/Disable-Feature /FeatureName:\"" + featureName + "\"");
+}
+
+// Removes every app from one PowerShell process. The script prints a line per app, "OK<tab>name" or
+// "FAIL<tab>name<tab>code<tab>message", which is read from its output into the results.
+std::vector<ServicingBatchItem> DismCommandServicing::RemoveProvisionedApps(const std::vector<std::string>& packageNames) {
+    std::vector<ServicingBatchItem> items;
+    if (packageNames.empty()) {
+        return items;
+    }
+    std::filesystem::path listFile = std::filesystem::path(scratchDir) / "remove_apps.list";
+    std::filesystem::path scriptFile = std::filesystem::path(scratchDir) / "remove_apps.ps1";
+    std::ofstream list(listFile);
+    for (const std::string& packageName : packageNames) {
+        list << packageName << '\n';
+    }
+    list.close();
+    std::ofstream script(scriptFile);
+    script << "foreach ($name in Get-Content -LiteralPath '" << listFile.string() << "') {\n"
+        << "    try {\n"
+        << "        Remove-AppxProvisionedPackage -Path '" << imageDir << "' -PackageName $name -ErrorAction Stop | Out-Null\n"
+        << "        \"OK`t$name\"\n"
+        << "    }\n"
+        << "    catch {\n"
+        << "        \"FAIL`t$name`t$($_.Exception.HResult)`t$($_.Exception.Message -replace '\\s+', ' ')\"\n"
+        << "    }\n"
+        << "}\n";
+    script.close();
+    std::string command = "powershell.exe -NoProfile -ExecutionPolicy Bypass -File \"" + scriptFile.string() + "\"";
+    std::string outputText;
+    int exitCode = RunProcess(command, [&](const char* data, size_t size) { outputText.append(data, size); });
+
+    std::map<std::string, ServicingResult> reported;
+    std::istringstream output(outputText);
+    std::string line;
+    while (std::getline(output, line)) {
+        std::istringstream fields(Trim(line));
+        std::string status, name, code, message;
+        std::getline(fields, status, '\t');
+        std::getline(fields, name, '\t');
+        ServicingResult result;
+        result.ok = status == "OK";
+        if (status == "FAIL") {
+            std::getline(fields, code, '\t');
+            std::getline(fields, message);
+            result.code = std::strtol(code.c_str(), nullptr, 10);
+            result.message = message;
+        }
+        else if (!result.ok) {
+            continue; // Not a result line
+        }
+        reported[name] = result;
+    }
+    std::remove(listFile.string().c_str());
+    std::remove(scriptFile.string().c_str());
+
+    for (const std::string& packageName : packageNames) {
+        auto found = reported.find(packageName);
+        if (found != reported.end()) {
+            items.push_back({ packageName, found->second });
+        }
+        else { // PowerShell stopped before reaching this app, or could not start at all
+            ServicingResult result;
+            result.code = exitCode;
+            result.message = "No result reported by PowerShell";
+            items.push_back({ packageName, result });
+        }
+    }
+    return items;
+}
+
+// Removes the packages with one dism.exe per command line full of /PackageName options. dism.exe only reports one
+// exit code for all of them, so when a run fails the image is listed again: packages that are gone succeeded, and
+// the ones still there are removed one at a time to get their own error.
+std::vector<ServicingBatchItem> DismCommandServicing::RemovePackages(const std::vector<std::string>& packageIdentities) {
+    const size_t maxArguments = 7000; // cmd.exe stops at 8191 characters, less the rest of the command
+    std::vector<ServicingBatchItem> items;
+    size_t first = 0;
+    while (first < packageIdentities.size()) {
+        std::string arguments = "/Remove-Package";
+        size_t last = first;
+        while (last < packageIdentities.size() &&
+            (last == first || arguments.size() + packageIdentities[last].size() + 16 < maxArguments)) {
+            arguments += " /PackageName:\"" + packageIdentities[last] + "\"";
+            last++;
+        }
+        ServicingResult result = Run(arguments);
+        PackageTable remaining;
+        if (!result.ok && ListPackages(remaining)) {
+            for (size_t i = first; i < last; i++) {
+                bool present = !SelectRows(remaining, [&](uint32_t row) {
+                    return remaining.Name(row) == packageIdentities[i] && remaining.states[row] == ServicingState::Installed;
+                }).empty();
+                ServicingResult gone;
+                gone.ok = true;
+                items.push_back({ packageIdentities[i], present ? RemovePackage(packageIdentities[i]) : gone });
+            }
+        }
+        else {
+            for (size_t i = first; i < last; i++) {
+                items.push_back({ packageIdentities[i], result });
+            }
+        }
+        first = last;
+    }
+    return items;
+}
+
+// Function to read the image content and the scripted failures from a file
+bool ScriptedImageServicing::LoadScript(const std::string& scriptPath) {
+    std::ifstream script(scriptPath);
+    if (!script) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(script, line)) {
+        std::istringstream fields(line);
+        std::string kind;
+        fields >> kind;
+        if (kind == "app" || kind == "package") {
+            std::string name;
+            std::getline(fields, name);
+            (kind == "app" ? apps : packages).push_back(Trim(name));
+        }
+        else if (kind == "feature") {
+            std::string state, name;
+            fields >> state;
+            std::getline(fields, name);
+            features.emplace_back(Trim(name), ParseServicingState(state));
+        }
+        else if (kind == "fail") {
+            std::string operation, name, message;
+            long code = 0;
+            fields >> operation >> name >> code;
+            std::getline(fields, message);
+            FailOn(operation, name, code, Trim(message));
+        }
+    }
+    return true;
+}
+
+void ScriptedImageServicing::FailOn(const std::string& operation, const std::string& name, long code, const std::string& message) {
+    ServicingResult result;
+    result.code = code;
+    result.message = message.empty() ? "Scripted failure" : message;
+    failures[operation + " " + name] = result;
+}
+
+// Returns the scripted result of a call, success unless a failure was scripted for it
+ServicingResult ScriptedImageServicing::Lookup(const std::string& operation, const std::string& name) const {
+    auto failure = failures.find(operation + " " + name);
+    if (failure != failures.end()) {
+        return failure->second;
+    }
+    ServicingResult result;
+    result.ok = true;
+    return result;
+}
+
+// Logs a call and returns its scripted result
+ServicingResult ScriptedImageServicing::Record(const std::string& operation, const std::string& name) {
+    calls.push_back(operation + " " + name);
+    return Lookup(operation, name);
+}
+
+bool ScriptedImageServicing::ListProvisionedApps(AppxPackageTable& apps) {
+    calls.push_back("ListProvisionedApps");
+    apps.Clear();
+    for (const std::string& packageName : this->apps) {
+        apps.Add(packageName, packageName.substr(0, packageName.find('_')), 0, ProcessorArchitecture::Neutral);
+    }
+    return true;
+}
+
+bool ScriptedImageServicing::ListPackages(PackageTable& packages) {
+    calls.push_back("ListPackages");
+    packages.Clear();
+    for (const std::string& identity : this->packages) {
+        packages.Add(identity, ServicingState::Installed, ReleaseType::Unknown, 0);
+    }
+    return true;
+}
+
+bool ScriptedImageServicing::ListFeatures(FeatureTable& features) {
+    calls.push_back("ListFeatures");
+    features.Clear();
+    for (const auto& feature : this->features) {
+        features.Add(feature.first, feature.second);
+    }
+    return true;
+}
+
+ServicingResult ScriptedImageServicing::AddProvisionedApp(const std::string& appPath) {
+    ServicingResult result = Record("AddProvisionedApp", appPath);
+    if (result.ok) {
+        apps.push_back(appPath);
+    }
+    return result;
+}
+
+ServicingResult ScriptedImageServicing::RemoveProvisionedApp(const std::string& packageName) {
+    ServicingResult result = Record("RemoveProvisionedApp", packageName);
+    if (result.ok) {
+        apps.erase(std::remove(apps.begin(), apps.end(), packageName), apps.end());
+    }
+    return result;
+}
+
+// Logged as a single "RemoveProvisionedApps <count>" call, each app failing as scripted for RemoveProvisionedApp
+std::vector<ServicingBatchItem> ScriptedImageServicing::RemoveProvisionedApps(const std::vector<std::string>& packageNames) {
+    calls.push_back("RemoveProvisionedApps " + std::to_string(packageNames.size()));
+    std::vector<ServicingBatchItem> items;
+    for (const std::string& packageName : packageNames) {
+        ServicingResult result = Lookup("RemoveProvisionedApp", packageName);
+        if (result.ok) {
+            apps.erase(std::remove(apps.begin(), apps.end(), packageName), apps.end());
+        }
+        items.push_back({ packageName, result });
+    }
+    return items;
+}
+
+// Logged as a single "RemovePackages <count>" call, each package failing as scripted for RemovePackage
+std::vector<ServicingBatchItem> ScriptedImageServicing::RemovePackages(const std::vector<std::string>& packageIdentities) {
+    calls.push_back("RemovePackages " + std::to_string(packageIdentities.size()));
+    std::vector<ServicingBatchItem> items;
+    for (const std::string& packageIdentity : packageIdentities) {
+        ServicingResult result = Lookup("RemovePackage", packageIdentity);
+        if (result.ok) {
+            packages.erase(std::remove(packages.begin(), packages.end(), packageIdentity), packages.end());
+        }
+        items.push_back({ packageIdentity, result });
+    }
+    return items;
+}
+
+ServicingResult ScriptedImageServicing::AddPackage(const std::string& packagePath) {
+    ServicingResult result = Record("AddPackage", packagePath);
+    if (result.ok) {
+        packages.push_back(packagePath);
+    }
+    return result;
+}
+
+ServicingResult ScriptedImageServicing::RemovePackage(const std::string& packageIdentity) {
+    ServicingResult result = Record("RemovePackage", packageIdentity);
+    if (result.ok) {
+        packages.erase(std::remove(packages.begin(), packages.end(), packageIdentity), packages.end());
+    }
+    return result;
+}
+
+ServicingResult ScriptedImageServicing::EnableFeature(const std::string& featureName) {
+    ServicingResult result = Record("EnableFeature", featureName);
+    for (auto& feature : features) {
+        if (result.ok && feature.first == featureName) {
+            feature.second = ServicingState::Installed;
+        }
+    }
+    return result;
+}
+
+ServicingResult ScriptedImageServicing::DisableFeature(const std::string& featureName) {
+    ServicingResult result = Record("DisableFeature", featureName);
+    for (auto& feature : features) {
+        if (result.ok && feature.first == featureName) {
+            feature.second = ServicingState::Staged;
+        }
+    }
+    return result;
+}
+
+// Function to open the best available servicing backend on a mounted image: the DISM API session when it can open
+// the image, otherwise dism.exe
+std::unique_ptr<ImageServicing> OpenImageServicing(const std::string& imageDir, const std::string& scratchDir) {
+    std::unique_ptr<ImageServicing> servicing = CreateDismApiServicing(imageDir, scratchDir);
+    if (servicing) {
+        return servicing;
+    }
+    return std::make_unique<DismCommandServicing>(imageDir, scratchDir);
+}
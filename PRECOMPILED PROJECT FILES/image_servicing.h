@@ -0,0 +1,126 @@
+#pragma once
+// Offline image servicing (apps, packages and features of the mounted WIM) behind one interface.
+// The DISM API backend opens a single session on the mount folder and runs every operation through it, so the
+// servicing stack is loaded once instead of once per dism.exe. dism.exe is kept as a fallback backend, and a
+// scripted in-memory backend stands in for DISM on machines without it.
+#include "image_listing.h" // Typed tables the listings are returned in
+#include <map>     // std::map for scripted results
+#include <memory>  // std::unique_ptr returned by OpenImageServicing
+#include <string>  // std::string for names and messages
+#include <vector>  // std::vector for listings
+
+class DismOutputParser;
+
+// Outcome of one servicing operation
+struct ServicingResult {
+    bool ok = false;      // The operation succeeded
+    long code = 0;        // HRESULT from the DISM API, or the exit code of dism.exe
+    std::string message;  // Error text reported by DISM, empty on success
+};
+
+// Outcome of one package of a batch
+struct ServicingBatchItem {
+    std::string name;        // Package the result belongs to
+    ServicingResult result;
+};
+
+// Servicing operations on one mounted image. Every call goes to the same open session.
+class ImageServicing {
+public:
+    virtual ~ImageServicing() = default;
+
+    // Short name of the backend, shown to the user
+    virtual const char* Name() const = 0;
+
+    // Listings replace the content of the table, false if DISM could not list the image
+    virtual bool ListProvisionedApps(AppxPackageTable& apps) = 0;
+    virtual bool ListPackages(PackageTable& packages) = 0;
+    virtual bool ListFeatures(FeatureTable& features) = 0;
+
+    // Changes to the image
+    virtual ServicingResult AddProvisionedApp(const std::string& appPath) = 0; // Same as /SkipLicense
+    virtual ServicingResult RemoveProvisionedApp(const std::string& packageName) = 0;
+    virtual ServicingResult AddPackage(const std::string& packagePath) = 0;
+    virtual ServicingResult RemovePackage(const std::string& packageIdentity) = 0;
+    virtual ServicingResult EnableFeature(const std::string& featureName) = 0;
+    virtual ServicingResult DisableFeature(const std::string& featureName) = 0;
+
+    // Removes several provisioned apps in one servicing pass and returns one result per name, in the same order.
+    // The default runs every removal back to back on the open session.
+    virtual std::vector<ServicingBatchItem> RemoveProvisionedApps(const std::vector<std::string>& packageNames);
+    // Same for packages, which should not depend on each other (see PlanPackageRemoval)
+    virtual std::vector<ServicingBatchItem> RemovePackages(const std::vector<std::string>& packageIdentities);
+};
+
+// Backend that runs one dism.exe per operation, used when the DISM API cannot open the image
+class DismCommandServicing : public ImageServicing {
+public:
+    // 'imageDir' is the mount folder, 'scratchDir' holds the files handed to PowerShell for batches
+    DismCommandServicing(const std::string& imageDir, const std::string& scratchDir);
+
+    const char* Name() const override { return "dism.exe"; }
+    bool ListProvisionedApps(AppxPackageTable& apps) override;
+    bool ListPackages(PackageTable& packages) override;
+    bool ListFeatures(FeatureTable& features) override;
+    ServicingResult AddProvisionedApp(const std::string& appPath) override;
+    ServicingResult RemoveProvisionedApp(const std::string& packageName) override;
+    ServicingResult AddPackage(const std::string& packagePath) override;
+    ServicingResult RemovePackage(const std::string& packageIdentity) override;
+    ServicingResult EnableFeature(const std::string& featureName) override;
+    ServicingResult DisableFeature(const std::string& featureName) override;
+    // Runs all removals in one PowerShell process instead of starting dism.exe once per app
+    std::vector<ServicingBatchItem> RemoveProvisionedApps(const std::vector<std::string>& packageNames) override;
+    // Passes as many packages as fit on one dism.exe command line
+    std::vector<ServicingBatchItem> RemovePackages(const std::vector<std::string>& packageIdentities) override;
+
+private:
+    ServicingResult Run(const std::string& arguments);
+    bool RunListing(const std::string& arguments, DismOutputParser& parser);
+
+    std::string imageDir;
+    std::string scratchDir;
+};
+
+// In-memory backend that behaves like a mounted image without touching one. The image content and the results
+// of individual operations come from a script, and every call is recorded, so code driving ImageServicing can
+// be checked on any platform.
+//
+// Script lines:
+//   app <package name>
+//   package <package identity>
+//   feature <Enabled|Disabled> <feature name>
+//   fail <Operation> <name> <code> [message]    e.g. "fail RemovePackage Foo~31bf3856ad364e35~amd64~~1.0 5"
+class ScriptedImageServicing : public ImageServicing {
+public:
+    bool LoadScript(const std::string& scriptPath);
+    // Makes Operation(name) fail with 'code', Operation being the method name, e.g. "RemoveProvisionedApp"
+    void FailOn(const std::string& operation, const std::string& name, long code, const std::string& message = "");
+
+    const char* Name() const override { return "scripted"; }
+    bool ListProvisionedApps(AppxPackageTable& apps) override;
+    bool ListPackages(PackageTable& packages) override;
+    bool ListFeatures(FeatureTable& features) override;
+    ServicingResult AddProvisionedApp(const std::string& appPath) override;
+    ServicingResult RemoveProvisionedApp(const std::string& packageName) override;
+    ServicingResult AddPackage(const std::string& packagePath) override;
+    ServicingResult RemovePackage(const std::string& packageIdentity) override;
+    ServicingResult EnableFeature(const std::string& featureName) override;
+    ServicingResult DisableFeature(const std::string& featureName) override;
+    std::vector<ServicingBatchItem> RemoveProvisionedApps(const std::vector<std::string>& packageNames) override;
+    std::vector<ServicingBatchItem> RemovePackages(const std::vector<std::string>& packageIdentities) override;
+
+    std::vector<std::string> apps;          // Provisioned app package names
+    std::vector<std::string> packages;      // Package identities
+    std::vector<std::pair<std::string, ServicingState>> features; // Feature names and their states
+    std::vector<std::string> calls;         // "Operation name" for every call made, in order
+
+private:
+    ServicingResult Lookup(const std::string& operation, const std::string& name) const;
+    ServicingResult Record(const std::string& operation, const std::string& name);
+
+    std::map<std::string, ServicingResult> failures; // Keyed by "Operation name"
+};
+
+// Function declarations for image servicing
+std::unique_ptr<ImageServicing> CreateDismApiServicing(const std::string& imageDir, const std::string& scratchDir);
+std::unique_ptr<ImageServicing> OpenImageServicing(const std::string& imageDir, const std::string& scratchDir);
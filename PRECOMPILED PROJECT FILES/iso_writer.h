@@ -0,0 +1,30 @@
+#pragma once
+// Native ISO image writer that replaces the bundled Cygwin xorriso.
+// Images carry ISO 9660 level 3, Joliet and UDF 1.02 directory trees over the same file data, plus an El Torito
+// boot catalog, which is the layout Windows install media use.
+#include <cstdint> // Fixed width integer types
+#include <string>  // std::string for paths and the volume label
+
+// Settings for BuildIsoImage
+struct IsoBuildOptions {
+    std::string volumeLabel = "MODWIN";                                   // Volume name shown by Windows
+    std::string efiBootImage = "efi/microsoft/boot/efisys_noprompt.bin";  // UEFI boot image, relative to the source folder
+    std::string biosBootImage = "boot/etfsboot.com";                      // BIOS boot image, used when the source folder has one
+    bool unbufferedIo = true;                                             // Write the image past the file cache when the disk allows it
+    bool showProgress = true;                                             // Print a percentage while writing
+};
+
+// Numbers collected while building an image
+struct IsoBuildStats {
+    uint64_t files = 0;            // Number of files in the image
+    uint64_t directories = 0;      // Number of directories, including the root
+    uint64_t fileBytes = 0;        // Bytes of file data copied into the image
+    uint64_t imageBytes = 0;       // Size of the finished image
+    double seconds = 0.0;          // Wall clock time of the build
+    bool unbufferedOutput = false; // The image was written past the file cache
+};
+
+// Function declarations for building ISO images
+bool BuildIsoImage(const std::string& sourceDir, const std::string& isoPath, const IsoBuildOptions& options,
+    IsoBuildStats* stats = nullptr);
+bool BenchmarkIsoBuild(const std::string& sourceDir, const std::string& scratchDir);
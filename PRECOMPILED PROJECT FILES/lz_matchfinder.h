@@ -0,0 +1,92 @@
+#pragma once
+// Hash chain match finder shared by MODWIN's LZ77 based compressors (LZX, XPRESS and LZMS).
+#include <algorithm> // std::min
+#include <cstddef> // size_t
+#include <cstdint> // Fixed width integer types
+#include <vector>  // std::vector for the hash heads and chains
+
+class LzMatchFinder {
+public:
+    // Prepares the match finder for a new buffer (at most 2 GiB). 'windowOrder' limits how far back matches may reach (1 << windowOrder).
+    void Reset(const uint8_t* buffer, size_t bufferSize, unsigned windowOrder, unsigned searchDepth) {
+        data = buffer;
+        size = bufferSize;
+        windowMask = (size_t(1) << windowOrder) - 1;
+        depth = searchDepth;
+        head.assign(HASH_SIZE, -1);
+        size_t chainSize = std::min(bufferSize, windowMask + 1);
+        if (prev.size() < chainSize) {
+            prev.resize(chainSize);
+        }
+    }
+
+    // Finds the longest match for 'pos' (at least minLen bytes, at most maxLen bytes) and inserts 'pos' into the chains.
+    // Returns the match length (0 if none) and stores the match distance in 'offset'.
+    unsigned FindMatch(size_t pos, unsigned minLen, unsigned maxLen, unsigned niceLen, size_t maxOffset, uint32_t& offset) {
+        if (pos + 3 > size) { // Not enough bytes left to hash
+            return 0;
+        }
+        if (maxLen > size - pos) {
+            maxLen = static_cast<unsigned>(size - pos);
+        }
+        if (maxLen < minLen) { // Too close to the end for a useful match, but still record the position
+            Skip(pos);
+            return 0;
+        }
+        uint32_t h = Hash(pos);
+        int32_t candidate = head[h];
+        head[h] = static_cast<int32_t>(pos);
+        prev[pos & windowMask] = candidate;
+        unsigned bestLen = minLen - 1;
+        const uint8_t* cur = data + pos;
+        for (unsigned tries = depth; candidate >= 0 && tries > 0; tries--) {
+            size_t distance = pos - static_cast<size_t>(candidate);
+            if (distance > maxOffset || distance > windowMask) {
+                break; // Everything further down the chain is even older
+            }
+            const uint8_t* match = data + candidate;
+            if (match[bestLen] == cur[bestLen] && match[0] == cur[0]) { // Cheap checks before the full compare
+                unsigned len = 0;
+                while (len < maxLen && match[len] == cur[len]) {
+                    len++;
+                }
+                if (len > bestLen) {
+                    bestLen = len;
+                    offset = static_cast<uint32_t>(distance);
+                    if (len >= niceLen || len == maxLen) {
+                        break; // Good enough, stop searching
+                    }
+                }
+            }
+            candidate = prev[static_cast<size_t>(candidate) & windowMask];
+        }
+        return (bestLen >= minLen) ? bestLen : 0;
+    }
+
+    // Inserts 'pos' into the hash chains without searching (used for bytes covered by a match)
+    void Skip(size_t pos) {
+        if (pos + 3 > size) {
+            return;
+        }
+        uint32_t h = Hash(pos);
+        prev[pos & windowMask] = head[h];
+        head[h] = static_cast<int32_t>(pos);
+    }
+
+private:
+    static constexpr unsigned HASH_BITS = 16;
+    static constexpr size_t HASH_SIZE = size_t(1) << HASH_BITS;
+
+    // Hashes the three bytes at 'pos'
+    uint32_t Hash(size_t pos) const {
+        uint32_t v = uint32_t(data[pos]) | (uint32_t(data[pos + 1]) << 8) | (uint32_t(data[pos + 2]) << 16);
+        return (v * 0x9E3779B1U) >> (32 - HASH_BITS);
+    }
+
+    const uint8_t* data = nullptr; // Buffer being compressed
+    size_t size = 0;               // Size of the buffer
+    size_t windowMask = 0;         // Mask applied to positions when indexing 'prev'
+    unsigned depth = 0;            // Maximum number of chain entries examined per search
+    std::vector<int32_t> head;     // Most recent position for every hash value
+    std::vector<int32_t> prev;     // Previous position with the same hash, indexed by position
+};
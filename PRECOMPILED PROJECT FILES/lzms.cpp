@@ -0,0 +1,823 @@
+#include "lzms.h"
+#include "huffman.h"
+#include "lz_matchfinder.h"
+#include <algorithm> // std::upper_bound and std::min
+#include <cstring>   // std::memcpy
+#include <memory>    // std::unique_ptr for the large coder states
+#include <vector>    // std::vector for the work buffers
+
+// Constants of the LZMS format
+static constexpr unsigned LZMS_NUM_LITERAL_SYMS = 256;
+static constexpr unsigned LZMS_NUM_LENGTH_SYMS = 54;
+static constexpr unsigned LZMS_NUM_DELTA_POWER_SYMS = 8;
+static constexpr unsigned LZMS_MAX_NUM_OFFSET_SYMS = 799;
+static constexpr unsigned LZMS_MAX_CODEWORD_LEN = 15;
+static constexpr unsigned LZMS_NUM_REPS = 3;               // Size of the LZ and delta repeat queues
+
+// Number of states (and probabilities) of each range coded decision
+static constexpr unsigned LZMS_NUM_MAIN_PROBS = 16;
+static constexpr unsigned LZMS_NUM_MATCH_PROBS = 32;
+static constexpr unsigned LZMS_NUM_LZ_PROBS = 64;
+static constexpr unsigned LZMS_NUM_LZ_REP_PROBS = 64;
+static constexpr unsigned LZMS_NUM_DELTA_PROBS = 64;
+static constexpr unsigned LZMS_NUM_DELTA_REP_PROBS = 64;
+
+// Probabilities are the share of zeros among the last 64 bits coded in the same state
+static constexpr unsigned LZMS_PROBABILITY_BITS = 6;
+static constexpr uint32_t LZMS_INITIAL_PROBABILITY = 48;
+static constexpr uint64_t LZMS_INITIAL_RECENT_BITS = 0x0000000055555555ULL;
+
+// Number of symbols after which each adaptive Huffman code is rebuilt
+static constexpr unsigned LZMS_LITERAL_CODE_REBUILD_FREQ = 1024;
+static constexpr unsigned LZMS_LZ_OFFSET_CODE_REBUILD_FREQ = 1024;
+static constexpr unsigned LZMS_LENGTH_CODE_REBUILD_FREQ = 512;
+static constexpr unsigned LZMS_DELTA_OFFSET_CODE_REBUILD_FREQ = 1024;
+static constexpr unsigned LZMS_DELTA_POWER_CODE_REBUILD_FREQ = 512;
+
+// Limits of the x86 machine code filter
+static constexpr int32_t LZMS_X86_MAX_TRANSLATION_OFFSET = 1023;
+static constexpr int32_t LZMS_X86_ID_WINDOW_SIZE = 65535;
+
+// Parser settings
+static constexpr unsigned LZMS_MIN_MATCH = 3;          // Shortest explicit-offset match the parser sends
+static constexpr unsigned LZMS_MAX_MATCH = 65535;      // Longest match the parser looks for
+static constexpr unsigned LZMS_NICE_MATCH = 48;        // Stop searching once a match is this long
+static constexpr unsigned LZMS_SEARCH_DEPTH = 24;      // Hash chain entries examined per position
+static constexpr unsigned LZMS_MAX_WINDOW_ORDER = 24;  // Matches reach back at most 16 MiB
+
+// Offset and length slots. LZMS describes both tables as runs of slots whose bases are 1, 2, 4, ... apart.
+struct LzmsSlotTables {
+    uint32_t offsetBase[LZMS_MAX_NUM_OFFSET_SYMS + 1];
+    uint8_t offsetExtraBits[LZMS_MAX_NUM_OFFSET_SYMS];
+    uint32_t lengthBase[LZMS_NUM_LENGTH_SYMS + 1];
+    uint8_t lengthExtraBits[LZMS_NUM_LENGTH_SYMS];
+};
+
+// Expands a run length description of slot bases into the base and extra bit tables
+static void DecodeSlotRuns(const uint8_t runs[], size_t numRuns, uint32_t finalBase, uint32_t base[], uint8_t extraBits[]) {
+    uint32_t value = 0;
+    unsigned slot = 0;
+    for (unsigned order = 0; order < numRuns; order++) {
+        for (unsigned i = 0; i < runs[order]; i++) {
+            value += uint32_t(1) << order;
+            if (slot > 0) {
+                extraBits[slot - 1] = static_cast<uint8_t>(order);
+            }
+            base[slot++] = value;
+        }
+    }
+    base[slot] = finalBase;
+    uint32_t span = finalBase - base[slot - 1];
+    uint8_t lastBits = 0;
+    while (span >>= 1) {
+        lastBits++;
+    }
+    extraBits[slot - 1] = lastBits;
+}
+
+static const LzmsSlotTables& GetLzmsSlotTables() {
+    static const LzmsSlotTables tables = [] {
+        static const uint8_t offsetRuns[] = {
+            9, 0, 9, 7, 10, 15, 15, 20, 20, 30, 33, 40, 42, 45, 60, 73, 80, 85, 95, 105, 6
+        };
+        static const uint8_t lengthRuns[] = {
+            27, 4, 6, 4, 5, 2, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 1
+        };
+        LzmsSlotTables t;
+        DecodeSlotRuns(offsetRuns, sizeof(offsetRuns), 0x7FFFFFFF, t.offsetBase, t.offsetExtraBits);
+        DecodeSlotRuns(lengthRuns, sizeof(lengthRuns), 0x400108AB, t.lengthBase, t.lengthExtraBits);
+        return t;
+    }();
+    return tables;
+}
+
+// Returns the slot whose range holds 'value'
+static unsigned FindSlot(const uint32_t base[], unsigned numSlots, uint32_t value) {
+    return static_cast<unsigned>(std::upper_bound(base, base + numSlots, value) - base) - 1;
+}
+
+// Number of offset slots needed for a buffer of the given size (offsets never exceed size - 1)
+static unsigned NumOffsetSlots(size_t size) {
+    const LzmsSlotTables& slots = GetLzmsSlotTables();
+    return 1 + FindSlot(slots.offsetBase, LZMS_MAX_NUM_OFFSET_SYMS, static_cast<uint32_t>(size - 1));
+}
+
+// Checks for an instruction with a relative address at 'p' and returns its opcode length, or 0
+static int LzmsX86Opcode(const uint8_t* p, int32_t& maxTranslationOffset, int32_t& skip) {
+    maxTranslationOffset = LZMS_X86_MAX_TRANSLATION_OFFSET;
+    skip = 1;
+    switch (p[0]) {
+    case 0x48:
+        if (p[1] == 0x8B && (p[2] == 0x05 || p[2] == 0x0D)) {
+            return 3; // Load relative (x86-64)
+        }
+        if (p[1] == 0x8D && (p[2] & 0x07) == 0x05) {
+            return 3; // Load effective address relative (x86-64)
+        }
+        break;
+    case 0x4C:
+        if (p[1] == 0x8D && (p[2] & 0x07) == 0x05) {
+            return 3; // Load effective address relative (x86-64)
+        }
+        break;
+    case 0xE8:
+        maxTranslationOffset /= 2; // Call relative
+        return 1;
+    case 0xE9:
+        skip = 5; // Jump relative, skipped without translating
+        break;
+    case 0xF0:
+        if (p[1] == 0x83 && p[2] == 0x05) {
+            return 3; // Lock add relative
+        }
+        break;
+    case 0xFF:
+        if (p[1] == 0x15) {
+            return 2; // Call indirect
+        }
+        break;
+    }
+    return 0;
+}
+
+// Turns relative addresses in what looks like x86 code into absolute ones (or back when 'undo' is set).
+// LZMS always runs this filter, so the compressor must apply it for the decompressor's undo to be a no-op.
+static void LzmsX86Filter(uint8_t* data, size_t size, bool undo) {
+    thread_local std::vector<int32_t> lastTargetUsages(65536);
+    std::fill(lastTargetUsages.begin(), lastTargetUsages.end(), -LZMS_X86_ID_WINDOW_SIZE - 1);
+    int32_t closestTargetUsage = -LZMS_X86_MAX_TRANSLATION_OFFSET - 1;
+    int32_t end = static_cast<int32_t>(size) - 16; // The last 16 bytes are never touched
+    for (int32_t i = 0; i < end;) {
+        int32_t maxTranslationOffset, skip;
+        int opcodeBytes = LzmsX86Opcode(data + i, maxTranslationOffset, skip);
+        if (opcodeBytes == 0) {
+            i += skip;
+            continue;
+        }
+        uint8_t* operand = data + i + opcodeBytes;
+        uint16_t target;
+        if (undo) {
+            if (i - closestTargetUsage <= maxTranslationOffset) {
+                uint32_t n = uint32_t(operand[0]) | (uint32_t(operand[1]) << 8) | (uint32_t(operand[2]) << 16) | (uint32_t(operand[3]) << 24);
+                n -= static_cast<uint32_t>(i);
+                operand[0] = static_cast<uint8_t>(n);
+                operand[1] = static_cast<uint8_t>(n >> 8);
+                operand[2] = static_cast<uint8_t>(n >> 16);
+                operand[3] = static_cast<uint8_t>(n >> 24);
+            }
+            target = static_cast<uint16_t>(i + (operand[0] | (operand[1] << 8)));
+        }
+        else {
+            target = static_cast<uint16_t>(i + (operand[0] | (operand[1] << 8)));
+            if (i - closestTargetUsage <= maxTranslationOffset) {
+                uint32_t n = uint32_t(operand[0]) | (uint32_t(operand[1]) << 8) | (uint32_t(operand[2]) << 16) | (uint32_t(operand[3]) << 24);
+                n += static_cast<uint32_t>(i);
+                operand[0] = static_cast<uint8_t>(n);
+                operand[1] = static_cast<uint8_t>(n >> 8);
+                operand[2] = static_cast<uint8_t>(n >> 16);
+                operand[3] = static_cast<uint8_t>(n >> 24);
+            }
+        }
+        i += opcodeBytes + 3; // Position of the last operand byte
+        if (i - lastTargetUsages[target] <= LZMS_X86_ID_WINDOW_SIZE) {
+            closestTargetUsage = i; // Same target seen recently, this really looks like code
+        }
+        lastTargetUsages[target] = i;
+        i++;
+    }
+}
+
+// Adaptive probability of a zero bit, based on the last 64 bits coded with it
+struct LzmsProbability {
+    uint32_t zeros = LZMS_INITIAL_PROBABILITY;
+    uint64_t recentBits = LZMS_INITIAL_RECENT_BITS;
+
+    uint32_t Get() const {
+        if (zeros == 0) {
+            return 1; // Never let a bit value become impossible
+        }
+        if (zeros == 64) {
+            return 63;
+        }
+        return zeros;
+    }
+
+    void Update(int bit) {
+        zeros = zeros + static_cast<uint32_t>(recentBits >> 63) - static_cast<uint32_t>(bit);
+        recentBits = (recentBits << 1) | static_cast<uint64_t>(bit);
+    }
+};
+
+// One range coded decision: its state (the last few bits) picks the probability to use
+template <unsigned NumProbs>
+struct LzmsDecision {
+    unsigned state = 0;
+    LzmsProbability probs[NumProbs];
+
+    LzmsProbability& Current() { return probs[state]; }
+    void Advance(int bit) { state = ((state << 1) | static_cast<unsigned>(bit)) & (NumProbs - 1); }
+};
+
+// Huffman code rebuilt from the symbol frequencies every 'rebuildFreq' symbols
+struct LzmsAdaptiveCode {
+    unsigned numSyms = 0;
+    unsigned rebuildFreq = 0;
+    unsigned untilRebuild = 0;
+    uint32_t freqs[LZMS_MAX_NUM_OFFSET_SYMS];
+    uint8_t lens[LZMS_MAX_NUM_OFFSET_SYMS];
+    uint32_t codewords[LZMS_MAX_NUM_OFFSET_SYMS];
+
+    void Init(unsigned symbols, unsigned frequency) {
+        numSyms = symbols;
+        rebuildFreq = frequency;
+        std::fill(freqs, freqs + numSyms, 1U);
+        Rebuild();
+    }
+
+    void Rebuild() {
+        MakeHuffmanCode(numSyms, LZMS_MAX_CODEWORD_LEN, freqs, lens, codewords);
+        untilRebuild = rebuildFreq;
+    }
+
+    // Counts a coded symbol, returns true when the code was rebuilt
+    bool Count(unsigned sym) {
+        freqs[sym]++;
+        if (--untilRebuild != 0) {
+            return false;
+        }
+        Rebuild();
+        for (unsigned i = 0; i < numSyms; i++) { // Halve the history so the code keeps adapting
+            freqs[i] = (freqs[i] >> 1) + 1;
+        }
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------------------------
+// Compressor
+// ---------------------------------------------------------------------------------------------
+
+// Range encoder writing 16-bit little-endian units from the front of the output
+class LzmsRangeEncoder {
+public:
+    explicit LzmsRangeEncoder(std::vector<uint8_t>& output) : out(output) {}
+
+    template <unsigned N>
+    void EncodeBit(LzmsDecision<N>& decision, int bit) {
+        LzmsProbability& prob = decision.Current();
+        if ((range & 0xFFFF0000) == 0) { // Same normalization point as the decoder
+            range <<= 16;
+            ShiftLow();
+        }
+        uint32_t bound = (range >> LZMS_PROBABILITY_BITS) * prob.Get();
+        if (bit == 0) {
+            range = bound;
+        }
+        else {
+            low += bound;
+            range -= bound;
+        }
+        prob.Update(bit);
+        decision.Advance(bit);
+    }
+
+    void Flush() {
+        for (int i = 0; i < 4; i++) {
+            ShiftLow();
+        }
+    }
+
+private:
+    // Moves the top 16 bits of 'low' out, holding back units that a later carry could still change
+    void ShiftLow() {
+        if (static_cast<uint32_t>(low) < 0xFFFF0000 || (low >> 32) != 0) {
+            uint16_t carry = static_cast<uint16_t>(low >> 32);
+            uint16_t unit = cache;
+            do {
+                PutUnit(static_cast<uint16_t>(unit + carry));
+                unit = 0xFFFF;
+            } while (--cacheSize != 0);
+            cache = static_cast<uint16_t>(static_cast<uint32_t>(low) >> 16);
+        }
+        cacheSize++;
+        low = (low & 0xFFFF) << 16;
+    }
+
+    void PutUnit(uint16_t unit) {
+        if (first) { // The very first unit only exists to catch a carry, which cannot happen
+            first = false;
+            return;
+        }
+        out.push_back(static_cast<uint8_t>(unit));
+        out.push_back(static_cast<uint8_t>(unit >> 8));
+    }
+
+    std::vector<uint8_t>& out;
+    uint64_t low = 0;
+    uint32_t range = 0xFFFFFFFF;
+    uint16_t cache = 0;
+    uint64_t cacheSize = 1;
+    bool first = true;
+};
+
+// Bit writer for the Huffman codes and extra bits. The decoder reads these from the end of the
+// compressed data backwards, so the words are collected here and placed in reverse order at the end.
+class LzmsBitWriter {
+public:
+    explicit LzmsBitWriter(std::vector<uint16_t>& output) : words(output) {}
+
+    void Write(uint32_t bits, unsigned count) {
+        bitbuf = (bitbuf << count) | bits;
+        bitcount += count;
+        while (bitcount >= 16) {
+            bitcount -= 16;
+            words.push_back(static_cast<uint16_t>(bitbuf >> bitcount));
+        }
+    }
+
+    void Flush() {
+        if (bitcount > 0) {
+            words.push_back(static_cast<uint16_t>(bitbuf << (16 - bitcount)));
+            bitcount = 0;
+        }
+    }
+
+private:
+    std::vector<uint16_t>& words;
+    uint64_t bitbuf = 0;
+    unsigned bitcount = 0;
+};
+
+// Holds the adaptive state of the compressor and mirrors every state change the decompressor makes
+class LzmsEncoder {
+public:
+    LzmsEncoder(std::vector<uint8_t>& rangeOut, std::vector<uint16_t>& bitsOut, unsigned numOffsetSlots)
+        : rc(rangeOut), bits(bitsOut), slots(GetLzmsSlotTables()), offsetSlots(numOffsetSlots) {
+        literalCode.Init(LZMS_NUM_LITERAL_SYMS, LZMS_LITERAL_CODE_REBUILD_FREQ);
+        lzOffsetCode.Init(numOffsetSlots, LZMS_LZ_OFFSET_CODE_REBUILD_FREQ);
+        lengthCode.Init(LZMS_NUM_LENGTH_SYMS, LZMS_LENGTH_CODE_REBUILD_FREQ);
+        for (unsigned i = 0; i <= LZMS_NUM_REPS; i++) {
+            recentOffsets[i] = i + 1;
+        }
+    }
+
+    void Literal(uint8_t value) {
+        rc.EncodeBit(mainDecision, 0);
+        EncodeSymbol(literalCode, value);
+    }
+
+    // Fills 'reps' with the offsets a match starting at 'pos' could send as repeat offsets
+    void RepeatOffsets(size_t pos, uint32_t reps[LZMS_NUM_REPS]) const {
+        if (pendingOffset != 0 && pos != pendingEnd) { // The previous match's offset joins the queue first
+            reps[0] = pendingOffset;
+            reps[1] = recentOffsets[0];
+            reps[2] = recentOffsets[1];
+        }
+        else {
+            for (unsigned i = 0; i < LZMS_NUM_REPS; i++) {
+                reps[i] = recentOffsets[i];
+            }
+        }
+    }
+
+    void Match(size_t pos, uint32_t length, uint32_t offset) {
+        rc.EncodeBit(mainDecision, 1);
+        rc.EncodeBit(matchDecision, 0); // LZ match, this compressor never sends delta matches
+        // The offset of a match only enters the queue once another item has been coded after it
+        if (pendingOffset != 0 && pos != pendingEnd) {
+            PushOffset(pendingOffset);
+            pendingOffset = 0;
+        }
+        unsigned rep = 0;
+        while (rep < LZMS_NUM_REPS && recentOffsets[rep] != offset) {
+            rep++;
+        }
+        if (rep == LZMS_NUM_REPS) { // Explicit offset
+            rc.EncodeBit(lzDecision, 0);
+            unsigned slot = FindSlot(slots.offsetBase, offsetSlots, offset);
+            EncodeSymbol(lzOffsetCode, slot);
+            bits.Write(offset - slots.offsetBase[slot], slots.offsetExtraBits[slot]);
+        }
+        else { // Repeat offset, taken out of the queue
+            rc.EncodeBit(lzDecision, 1);
+            rc.EncodeBit(lzRepDecisions[0], rep > 0);
+            if (rep > 0) {
+                rc.EncodeBit(lzRepDecisions[1], rep > 1);
+            }
+            for (unsigned i = rep; i < LZMS_NUM_REPS; i++) {
+                recentOffsets[i] = recentOffsets[i + 1];
+            }
+        }
+        if (pendingOffset != 0) {
+            PushOffset(pendingOffset);
+        }
+        pendingOffset = offset;
+        pendingEnd = pos + length;
+        unsigned slot = FindSlot(slots.lengthBase, LZMS_NUM_LENGTH_SYMS, length);
+        EncodeSymbol(lengthCode, slot);
+        bits.Write(length - slots.lengthBase[slot], slots.lengthExtraBits[slot]);
+    }
+
+    void Finish() {
+        rc.Flush();
+        bits.Flush();
+    }
+
+private:
+    void EncodeSymbol(LzmsAdaptiveCode& code, unsigned sym) {
+        bits.Write(code.codewords[sym], code.lens[sym]);
+        code.Count(sym);
+    }
+
+    void PushOffset(uint32_t offset) {
+        for (unsigned i = LZMS_NUM_REPS; i > 0; i--) {
+            recentOffsets[i] = recentOffsets[i - 1];
+        }
+        recentOffsets[0] = offset;
+    }
+
+    LzmsRangeEncoder rc;
+    LzmsBitWriter bits;
+    const LzmsSlotTables& slots;
+    unsigned offsetSlots;
+    LzmsDecision<LZMS_NUM_MAIN_PROBS> mainDecision;
+    LzmsDecision<LZMS_NUM_MATCH_PROBS> matchDecision;
+    LzmsDecision<LZMS_NUM_LZ_PROBS> lzDecision;
+    LzmsDecision<LZMS_NUM_LZ_REP_PROBS> lzRepDecisions[LZMS_NUM_REPS - 1];
+    LzmsAdaptiveCode literalCode;
+    LzmsAdaptiveCode lzOffsetCode;
+    LzmsAdaptiveCode lengthCode;
+    uint32_t recentOffsets[LZMS_NUM_REPS + 1];
+    uint32_t pendingOffset = 0; // Offset of the last match, not yet in the queue
+    size_t pendingEnd = 0;      // Position right after the last match
+};
+
+// Function to compress a buffer (one solid chunk) with LZMS. Returns the compressed size, or 0 if the
+// data did not get smaller (the chunk is then stored uncompressed).
+size_t LzmsCompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outCapacity) {
+    if (inSize < 4 || inSize > LZMS_MAX_BUFFER_SIZE) {
+        return 0;
+    }
+    thread_local std::vector<uint8_t> data;
+    thread_local std::vector<uint8_t> rangeOut;
+    thread_local std::vector<uint16_t> bitWords;
+    thread_local LzMatchFinder matchFinder;
+    data.assign(in, in + inSize);
+    LzmsX86Filter(data.data(), inSize, false);
+    rangeOut.clear();
+    bitWords.clear();
+    const size_t limit = std::min(inSize - 1, outCapacity); // Give up once the output is no smaller
+    const uint8_t* p = data.data();
+    std::unique_ptr<LzmsEncoder> encoder(new LzmsEncoder(rangeOut, bitWords, NumOffsetSlots(inSize)));
+    unsigned windowOrder = 16;
+    while (windowOrder < LZMS_MAX_WINDOW_ORDER && (size_t(1) << windowOrder) < inSize) {
+        windowOrder++;
+    }
+    matchFinder.Reset(p, inSize, windowOrder, LZMS_SEARCH_DEPTH);
+
+    // Returns how many bytes at 'pos' match the bytes 'offset' back
+    auto matchLength = [&](size_t pos, uint32_t offset, unsigned maxLen) {
+        if (offset == 0 || offset > pos) {
+            return 0U;
+        }
+        unsigned len = 0;
+        while (len < maxLen && p[pos + len] == p[pos + len - offset]) {
+            len++;
+        }
+        return len;
+    };
+
+    // Greedy parse with one step of lazy evaluation, repeat offsets are tried first
+    size_t pos = 0;
+    size_t nextSizeCheck = 1 << 16;
+    uint32_t offset = 0;
+    unsigned len = matchFinder.FindMatch(pos, LZMS_MIN_MATCH, LZMS_MAX_MATCH, LZMS_NICE_MATCH, inSize, offset);
+    while (pos < inSize) {
+        unsigned maxLen = static_cast<unsigned>(std::min<size_t>(LZMS_MAX_MATCH, inSize - pos));
+        uint32_t reps[LZMS_NUM_REPS];
+        encoder->RepeatOffsets(pos, reps);
+        for (uint32_t rep : reps) {
+            unsigned repLen = matchLength(pos, rep, maxLen);
+            if (repLen >= 2 && repLen + 1 >= len && (repLen > len || offset != rep)) {
+                len = repLen;
+                offset = rep;
+            }
+        }
+        if (len >= 2 && len < LZMS_NICE_MATCH && pos + 1 < inSize) {
+            uint32_t nextOffset = 0;
+            unsigned nextLen = matchFinder.FindMatch(pos + 1, LZMS_MIN_MATCH, LZMS_MAX_MATCH, LZMS_NICE_MATCH, inSize, nextOffset);
+            if (nextLen > len + 1) { // A clearly better match starts one byte later, send a literal instead
+                encoder->Literal(p[pos]);
+                pos++;
+                len = nextLen;
+                offset = nextOffset;
+                continue;
+            }
+            encoder->Match(pos, len, offset);
+            for (size_t i = pos + 2; i < pos + len; i++) {
+                matchFinder.Skip(i);
+            }
+        }
+        else if (len >= 2) {
+            encoder->Match(pos, len, offset);
+            for (size_t i = pos + 1; i < pos + len; i++) {
+                matchFinder.Skip(i);
+            }
+        }
+        else {
+            encoder->Literal(p[pos]);
+            len = 1;
+        }
+        pos += len;
+        if (pos >= nextSizeCheck) {
+            if (rangeOut.size() + bitWords.size() * 2 >= limit) {
+                return 0;
+            }
+            nextSizeCheck = pos + (1 << 16);
+        }
+        len = (pos < inSize) ? matchFinder.FindMatch(pos, LZMS_MIN_MATCH, LZMS_MAX_MATCH, LZMS_NICE_MATCH, inSize, offset) : 0;
+    }
+    encoder->Finish();
+
+    // Range coded data first, then the bitstream words in reverse order
+    size_t outSize = rangeOut.size() + bitWords.size() * 2;
+    if (outSize > limit) {
+        return 0;
+    }
+    if (!rangeOut.empty()) {
+        std::memcpy(out, rangeOut.data(), rangeOut.size());
+    }
+    uint8_t* q = out + rangeOut.size();
+    for (size_t i = bitWords.size(); i > 0; i--) {
+        *q++ = static_cast<uint8_t>(bitWords[i - 1]);
+        *q++ = static_cast<uint8_t>(bitWords[i - 1] >> 8);
+    }
+    return outSize;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Decompressor
+// ---------------------------------------------------------------------------------------------
+
+// Range decoder reading 16-bit little-endian units from the front of the input
+class LzmsRangeDecoder {
+public:
+    LzmsRangeDecoder(const uint8_t* in, size_t size) : next(in), end(in + size) {
+        code = static_cast<uint32_t>(NextUnit()) << 16;
+        code |= NextUnit();
+    }
+
+    template <unsigned N>
+    int DecodeBit(LzmsDecision<N>& decision) {
+        LzmsProbability& prob = decision.Current();
+        if ((range & 0xFFFF0000) == 0) {
+            range <<= 16;
+            code = (code << 16) | NextUnit();
+        }
+        uint32_t bound = (range >> LZMS_PROBABILITY_BITS) * prob.Get();
+        int bit;
+        if (code < bound) {
+            range = bound;
+            bit = 0;
+        }
+        else {
+            range -= bound;
+            code -= bound;
+            bit = 1;
+        }
+        prob.Update(bit);
+        decision.Advance(bit);
+        return bit;
+    }
+
+private:
+    uint16_t NextUnit() {
+        if (end - next < 2) {
+            return 0;
+        }
+        uint16_t unit = static_cast<uint16_t>(next[0] | (next[1] << 8));
+        next += 2;
+        return unit;
+    }
+
+    const uint8_t* next;
+    const uint8_t* end;
+    uint32_t range = 0xFFFFFFFF;
+    uint32_t code = 0;
+};
+
+// Reads the Huffman codes and extra bits from the end of the input backwards
+class LzmsBitReader {
+public:
+    LzmsBitReader(const uint8_t* in, size_t size) : begin(in), next(in + (size & ~size_t(1))) {}
+
+    uint32_t Peek(unsigned count) {
+        while (bitsLeft < static_cast<int>(count)) {
+            uint64_t word = 0;
+            if (next - begin >= 2) {
+                next -= 2;
+                word = uint64_t(next[0]) | (uint64_t(next[1]) << 8);
+            }
+            else {
+                paddingBits += 16; // Reading past the start gives zeros
+            }
+            bitbuf |= word << (48 - bitsLeft);
+            bitsLeft += 16;
+        }
+        return count == 0 ? 0 : static_cast<uint32_t>(bitbuf >> (64 - count));
+    }
+
+    void Skip(unsigned count) {
+        bitbuf <<= count;
+        bitsLeft -= count;
+    }
+
+    uint32_t Read(unsigned count) {
+        uint32_t value = Peek(count);
+        Skip(count);
+        return value;
+    }
+
+    // True once bits past the start of the input have been consumed
+    bool Overrun() const { return paddingBits > bitsLeft; }
+
+private:
+    const uint8_t* begin;
+    const uint8_t* next;
+    uint64_t bitbuf = 0;
+    int bitsLeft = 0;
+    int paddingBits = 0;
+};
+
+// Adaptive Huffman code together with its decode tables
+struct LzmsDecodeCode {
+    LzmsAdaptiveCode code;
+    HuffmanDecoder decoder;
+
+    void Init(unsigned symbols, unsigned frequency) {
+        code.Init(symbols, frequency);
+        decoder.Build(code.lens, code.numSyms, LZMS_MAX_CODEWORD_LEN, 10);
+    }
+
+    int Decode(LzmsBitReader& bits) {
+        int sym = decoder.Decode(bits);
+        if (sym >= 0 && code.Count(static_cast<unsigned>(sym))) {
+            decoder.Build(code.lens, code.numSyms, LZMS_MAX_CODEWORD_LEN, 10);
+        }
+        return sym;
+    }
+};
+
+// State of the decompressor
+struct LzmsDecoderState {
+    LzmsDecision<LZMS_NUM_MAIN_PROBS> mainDecision;
+    LzmsDecision<LZMS_NUM_MATCH_PROBS> matchDecision;
+    LzmsDecision<LZMS_NUM_LZ_PROBS> lzDecision;
+    LzmsDecision<LZMS_NUM_LZ_REP_PROBS> lzRepDecisions[LZMS_NUM_REPS - 1];
+    LzmsDecision<LZMS_NUM_DELTA_PROBS> deltaDecision;
+    LzmsDecision<LZMS_NUM_DELTA_REP_PROBS> deltaRepDecisions[LZMS_NUM_REPS - 1];
+    LzmsDecodeCode literalCode;
+    LzmsDecodeCode lzOffsetCode;
+    LzmsDecodeCode lengthCode;
+    LzmsDecodeCode deltaOffsetCode;
+    LzmsDecodeCode deltaPowerCode;
+};
+
+// Reads a value sent as a slot symbol plus extra bits, returns false on a bad symbol
+static bool DecodeSlotValue(LzmsDecodeCode& code, LzmsBitReader& bits, const uint32_t base[], const uint8_t extraBits[], uint32_t& value) {
+    int slot = code.Decode(bits);
+    if (slot < 0) {
+        return false;
+    }
+    value = base[slot] + bits.Read(extraBits[slot]);
+    return true;
+}
+
+// Function to decompress an LZMS buffer into exactly 'outSize' bytes
+bool LzmsDecompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+    if (inSize < 4 || outSize > LZMS_MAX_BUFFER_SIZE) {
+        return false;
+    }
+    if (outSize < 2) { // Too small for any offset, cannot be valid LZMS data
+        return false;
+    }
+    const LzmsSlotTables& slots = GetLzmsSlotTables();
+    unsigned numOffsetSlots = NumOffsetSlots(outSize);
+    std::unique_ptr<LzmsDecoderState> state(new LzmsDecoderState());
+    state->literalCode.Init(LZMS_NUM_LITERAL_SYMS, LZMS_LITERAL_CODE_REBUILD_FREQ);
+    state->lzOffsetCode.Init(numOffsetSlots, LZMS_LZ_OFFSET_CODE_REBUILD_FREQ);
+    state->lengthCode.Init(LZMS_NUM_LENGTH_SYMS, LZMS_LENGTH_CODE_REBUILD_FREQ);
+    state->deltaOffsetCode.Init(numOffsetSlots, LZMS_DELTA_OFFSET_CODE_REBUILD_FREQ);
+    state->deltaPowerCode.Init(LZMS_NUM_DELTA_POWER_SYMS, LZMS_DELTA_POWER_CODE_REBUILD_FREQ);
+    LzmsRangeDecoder rc(in, inSize);
+    LzmsBitReader bits(in, inSize);
+    uint32_t recentLz[LZMS_NUM_REPS + 1];
+    uint64_t recentDelta[LZMS_NUM_REPS + 1];
+    for (unsigned i = 0; i <= LZMS_NUM_REPS; i++) {
+        recentLz[i] = i + 1;
+        recentDelta[i] = i + 1;
+    }
+    uint32_t pendingLz = 0;
+    uint64_t pendingDelta = 0;
+    size_t lzPendingEnd = 0;
+    size_t deltaPendingEnd = 0;
+
+    size_t pos = 0;
+    while (pos < outSize) {
+        if (!rc.DecodeBit(state->mainDecision)) { // Literal
+            int sym = state->literalCode.Decode(bits);
+            if (sym < 0) {
+                return false;
+            }
+            out[pos++] = static_cast<uint8_t>(sym);
+            continue;
+        }
+        uint32_t length;
+        if (!rc.DecodeBit(state->matchDecision)) { // LZ match
+            if (pendingLz != 0 && pos != lzPendingEnd) {
+                std::copy_backward(recentLz, recentLz + LZMS_NUM_REPS, recentLz + LZMS_NUM_REPS + 1);
+                recentLz[0] = pendingLz;
+                pendingLz = 0;
+            }
+            uint32_t offset;
+            if (!rc.DecodeBit(state->lzDecision)) {
+                if (!DecodeSlotValue(state->lzOffsetCode, bits, slots.offsetBase, slots.offsetExtraBits, offset)) {
+                    return false;
+                }
+            }
+            else {
+                unsigned rep = 0;
+                if (rc.DecodeBit(state->lzRepDecisions[0])) {
+                    rep = rc.DecodeBit(state->lzRepDecisions[1]) ? 2 : 1;
+                }
+                offset = recentLz[rep];
+                std::copy(recentLz + rep + 1, recentLz + LZMS_NUM_REPS + 1, recentLz + rep);
+            }
+            if (pendingLz != 0) {
+                std::copy_backward(recentLz, recentLz + LZMS_NUM_REPS, recentLz + LZMS_NUM_REPS + 1);
+                recentLz[0] = pendingLz;
+            }
+            pendingLz = offset;
+            if (!DecodeSlotValue(state->lengthCode, bits, slots.lengthBase, slots.lengthExtraBits, length)) {
+                return false;
+            }
+            if (offset == 0 || offset > pos || length > outSize - pos) {
+                return false; // Match reaches outside the buffer
+            }
+            for (uint32_t i = 0; i < length; i++) { // Byte by byte, the source may overlap the destination
+                out[pos + i] = out[pos + i - offset];
+            }
+            pos += length;
+            lzPendingEnd = pos;
+        }
+        else { // Delta match: bytes are predicted from the same position in earlier, equally spaced records
+            if (pendingDelta != 0 && pos != deltaPendingEnd) {
+                std::copy_backward(recentDelta, recentDelta + LZMS_NUM_REPS, recentDelta + LZMS_NUM_REPS + 1);
+                recentDelta[0] = pendingDelta;
+                pendingDelta = 0;
+            }
+            uint32_t power, rawOffset;
+            if (!rc.DecodeBit(state->deltaDecision)) {
+                int powerSym = state->deltaPowerCode.Decode(bits);
+                if (powerSym < 0 || !DecodeSlotValue(state->deltaOffsetCode, bits, slots.offsetBase, slots.offsetExtraBits, rawOffset)) {
+                    return false;
+                }
+                power = static_cast<uint32_t>(powerSym);
+            }
+            else {
+                unsigned rep = 0;
+                if (rc.DecodeBit(state->deltaRepDecisions[0])) {
+                    rep = rc.DecodeBit(state->deltaRepDecisions[1]) ? 2 : 1;
+                }
+                uint64_t pair = recentDelta[rep];
+                std::copy(recentDelta + rep + 1, recentDelta + LZMS_NUM_REPS + 1, recentDelta + rep);
+                power = static_cast<uint32_t>(pair >> 32);
+                rawOffset = static_cast<uint32_t>(pair);
+            }
+            if (pendingDelta != 0) {
+                std::copy_backward(recentDelta, recentDelta + LZMS_NUM_REPS, recentDelta + LZMS_NUM_REPS + 1);
+                recentDelta[0] = pendingDelta;
+            }
+            pendingDelta = (static_cast<uint64_t>(power) << 32) | rawOffset;
+            if (!DecodeSlotValue(state->lengthCode, bits, slots.lengthBase, slots.lengthExtraBits, length)) {
+                return false;
+            }
+            uint64_t span = uint64_t(1) << power;
+            uint64_t offset = static_cast<uint64_t>(rawOffset) << power;
+            if (offset + span > pos || length > outSize - pos) {
+                return false;
+            }
+            for (uint32_t i = 0; i < length; i++) {
+                size_t at = pos + i;
+                out[at] = static_cast<uint8_t>(out[at - span] + out[at - offset] - out[at - offset - span]);
+            }
+            pos += length;
+            deltaPendingEnd = pos;
+        }
+    }
+    if (bits.Overrun()) {
+        return false;
+    }
+    LzmsX86Filter(out, outSize, true);
+    return true;
+}
@@ -0,0 +1,12 @@
+#pragma once
+// LZMS compression as used by ESD files (DISM's /Compress:recovery).
+// ESD files keep file data in large solid chunks, each compressed on its own with these functions.
+#include <cstddef> // size_t
+#include <cstdint> // Fixed width integer types
+
+// Largest buffer LZMS can compress in one go
+constexpr size_t LZMS_MAX_BUFFER_SIZE = size_t(1) << 30;
+
+// Function declarations for LZMS
+size_t LzmsCompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outCapacity);
+bool LzmsDecompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize);
@@ -0,0 +1,573 @@
+#include "lzx.h"
+#include "huffman.h"
+#include "lz_matchfinder.h"
+#include <algorithm> // std::min and std::swap
+#include <cstring>   // std::memcpy
+#include <vector>    // std::vector for the parsed items
+
+// Constants of the WIM flavour of LZX (32 KiB window, one chunk per window)
+static constexpr unsigned LZX_NUM_CHARS = 256;            // Literal symbols at the start of the main alphabet
+static constexpr unsigned LZX_NUM_OFFSET_SLOTS = 30;      // Offset slots needed for a 32 KiB window
+static constexpr unsigned LZX_MAIN_SYMS = LZX_NUM_CHARS + LZX_NUM_OFFSET_SLOTS * 8;
+static constexpr unsigned LZX_LENGTH_SYMS = 249;          // Symbols of the length tree
+static constexpr unsigned LZX_PRECODE_SYMS = 20;          // Symbols of the pretree used to send code lengths
+static constexpr unsigned LZX_ALIGNED_SYMS = 8;           // Symbols of the aligned offset tree
+static constexpr unsigned LZX_MAX_MAIN_LEN = 16;          // Longest main/length codeword
+static constexpr unsigned LZX_MAX_PRE_LEN = 15;           // Longest pretree codeword (lengths are sent in 4 bits)
+static constexpr unsigned LZX_MAX_ALIGNED_LEN = 7;        // Longest aligned codeword (lengths are sent in 3 bits)
+static constexpr unsigned LZX_MIN_MATCH = 2;
+static constexpr unsigned LZX_MAX_MATCH = 257;
+static constexpr unsigned LZX_OFFSET_ADJUSTMENT = 2;      // Explicit offsets are sent as offset + 2, 0-2 mean "repeat offset"
+static constexpr int32_t LZX_E8_FILE_SIZE = 12000000;     // Translation size WIM always uses for the E8 call filter
+
+enum LzxBlockType { LZX_BLOCK_VERBATIM = 1, LZX_BLOCK_ALIGNED = 2, LZX_BLOCK_UNCOMPRESSED = 3 };
+
+// First formatted offset covered by each offset slot
+static const uint32_t lzxOffsetSlotBase[LZX_NUM_OFFSET_SLOTS + 1] = {
+    0, 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768,
+    1024, 1536, 2048, 3072, 4096, 6144, 8192, 12288, 16384, 24576, 32768
+};
+
+// Number of extra bits that follow each offset slot
+static const uint8_t lzxExtraOffsetBits[LZX_NUM_OFFSET_SLOTS] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8,
+    9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static int32_t GetLe32s(const uint8_t* p) {
+    return static_cast<int32_t>(uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24));
+}
+
+static void PutLe32s(uint8_t* p, int32_t value) {
+    uint32_t v = static_cast<uint32_t>(value);
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+// Converts the relative targets of x86 CALL instructions (0xE8) to absolute ones (or back when 'undo' is set).
+// Absolute targets repeat more often, which helps compression of executables.
+static void LzxE8Filter(uint8_t* data, size_t size, bool undo) {
+    if (size <= 10) {
+        return;
+    }
+    for (size_t i = 0; i < size - 10; i++) {
+        if (data[i] != 0xE8) {
+            continue;
+        }
+        int32_t pos = static_cast<int32_t>(i);
+        int32_t value = GetLe32s(data + i + 1);
+        if (!undo) {
+            if (value >= -pos && value < LZX_E8_FILE_SIZE) {
+                PutLe32s(data + i + 1, (value < LZX_E8_FILE_SIZE - pos) ? value + pos : value - LZX_E8_FILE_SIZE);
+            }
+        }
+        else if (value >= 0) {
+            if (value < LZX_E8_FILE_SIZE) {
+                PutLe32s(data + i + 1, value - pos);
+            }
+        }
+        else if (value >= -pos) {
+            PutLe32s(data + i + 1, value + LZX_E8_FILE_SIZE);
+        }
+        i += 4; // The four target bytes are never checked for another opcode
+    }
+}
+
+// Returns the offset slot of a formatted offset
+static unsigned LzxOffsetSlot(uint32_t formattedOffset) {
+    unsigned slot = 0;
+    while (lzxOffsetSlotBase[slot + 1] <= formattedOffset) {
+        slot++;
+    }
+    return slot;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Compressor
+// ---------------------------------------------------------------------------------------------
+
+// Writes bits most significant first into 16-bit little-endian words, the way LZX expects them
+class LzxBitWriter {
+public:
+    LzxBitWriter(uint8_t* buffer, size_t capacity) : out(buffer), end(buffer + capacity) {}
+
+    void Write(uint32_t bits, unsigned count) {
+        bitbuf = (bitbuf << count) | bits;
+        bitcount += count;
+        while (bitcount >= 16) {
+            bitcount -= 16;
+            PutWord(static_cast<uint16_t>(bitbuf >> bitcount));
+        }
+    }
+
+    // Pads the last word with zero bits and returns the number of bytes written, 0 on overflow
+    size_t Finish() {
+        if (bitcount > 0) {
+            PutWord(static_cast<uint16_t>(bitbuf << (16 - bitcount)));
+            bitcount = 0;
+        }
+        return overflow ? 0 : static_cast<size_t>(next - out);
+    }
+
+private:
+    void PutWord(uint16_t word) {
+        if (end - next < 2) {
+            overflow = true;
+            return;
+        }
+        next[0] = static_cast<uint8_t>(word);
+        next[1] = static_cast<uint8_t>(word >> 8);
+        next += 2;
+    }
+
+    uint8_t* out;
+    uint8_t* next = out;
+    uint8_t* end;
+    uint64_t bitbuf = 0;
+    unsigned bitcount = 0;
+    bool overflow = false;
+};
+
+// One parsed item: a literal byte, or a match with its main symbol and length/offset details
+struct LzxItem {
+    uint16_t mainSym;        // Symbol sent with the main tree
+    uint16_t lengthSym;      // Symbol sent with the length tree, 0xFFFF if none
+    uint32_t extraBits;      // Value of the extra offset bits
+    uint8_t numExtraBits;    // Number of extra offset bits
+};
+
+// Makes sure a code has at least two symbols so that it is a complete prefix code
+static void EnsureTwoSymbols(uint32_t freqs[], unsigned numSyms) {
+    unsigned used = 0;
+    for (unsigned i = 0; i < numSyms && used < 2; i++) {
+        used += (freqs[i] != 0);
+    }
+    for (unsigned i = 0; i < numSyms && used < 2; i++) {
+        if (freqs[i] == 0) {
+            freqs[i] = 1;
+            used++;
+        }
+    }
+}
+
+// Sends a run of code lengths with the pretree, delta coded against all-zero previous lengths
+static void LzxWriteLens(LzxBitWriter& bits, const uint8_t lens[], unsigned numLens) {
+    // First turn the lengths into pretree symbols (with their extra bits)
+    std::vector<std::pair<uint8_t, uint8_t>> presyms; // (symbol, extra bits value)
+    uint32_t freqs[LZX_PRECODE_SYMS] = {};
+    for (unsigned i = 0; i < numLens;) {
+        if (lens[i] == 0) {
+            unsigned run = 1;
+            while (i + run < numLens && lens[i + run] == 0 && run < 51) {
+                run++;
+            }
+            if (run >= 20) { // Long run of zeros
+                presyms.push_back({ 18, static_cast<uint8_t>(run - 20) });
+                freqs[18]++;
+                i += run;
+                continue;
+            }
+            if (run >= 4) { // Short run of zeros
+                presyms.push_back({ 17, static_cast<uint8_t>(run - 4) });
+                freqs[17]++;
+                i += run;
+                continue;
+            }
+        }
+        uint8_t presym = static_cast<uint8_t>((17 - lens[i]) % 17); // Difference from the previous length (0)
+        presyms.push_back({ presym, 0 });
+        freqs[presym]++;
+        i++;
+    }
+    EnsureTwoSymbols(freqs, LZX_PRECODE_SYMS);
+    uint8_t preLens[LZX_PRECODE_SYMS];
+    uint32_t preCodes[LZX_PRECODE_SYMS];
+    MakeHuffmanCode(LZX_PRECODE_SYMS, LZX_MAX_PRE_LEN, freqs, preLens, preCodes);
+    for (unsigned i = 0; i < LZX_PRECODE_SYMS; i++) {
+        bits.Write(preLens[i], 4);
+    }
+    for (const auto& item : presyms) {
+        bits.Write(preCodes[item.first], preLens[item.first]);
+        if (item.first == 17) {
+            bits.Write(item.second, 4);
+        }
+        else if (item.first == 18) {
+            bits.Write(item.second, 5);
+        }
+    }
+}
+
+// Function to compress one chunk with LZX. Returns the compressed size, or 0 if the chunk
+// did not get smaller (the WIM then stores the chunk uncompressed).
+size_t LzxCompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outCapacity) {
+    if (inSize == 0 || inSize > LZX_MAX_CHUNK_SIZE) {
+        return 0;
+    }
+    thread_local std::vector<uint8_t> data;
+    thread_local std::vector<LzxItem> items;
+    thread_local LzMatchFinder matchFinder;
+    data.assign(in, in + inSize);
+    LzxE8Filter(data.data(), inSize, false); // Compress the translated data, the decompressor undoes it
+    items.clear();
+
+    uint32_t mainFreqs[LZX_MAIN_SYMS] = {};
+    uint32_t lengthFreqs[LZX_LENGTH_SYMS] = {};
+    uint32_t recent[3] = { 1, 1, 1 }; // Repeat offset queue, reset for every chunk
+    const size_t maxOffset = lzxOffsetSlotBase[LZX_NUM_OFFSET_SLOTS] - 1 - LZX_OFFSET_ADJUSTMENT;
+    const uint8_t* p = data.data();
+    matchFinder.Reset(p, inSize, 15, 48);
+
+    // Adds a match to the item list, preferring the repeat offset queue when it holds the offset
+    auto addMatch = [&](unsigned len, uint32_t offset) {
+        uint32_t formatted;
+        if (offset == recent[0]) {
+            formatted = 0;
+        }
+        else if (offset == recent[1]) {
+            formatted = 1;
+            std::swap(recent[0], recent[1]);
+        }
+        else if (offset == recent[2]) {
+            formatted = 2;
+            std::swap(recent[0], recent[2]);
+        }
+        else {
+            formatted = offset + LZX_OFFSET_ADJUSTMENT;
+            recent[2] = recent[1];
+            recent[1] = recent[0];
+            recent[0] = offset;
+        }
+        unsigned slot = LzxOffsetSlot(formatted);
+        unsigned lenHeader = std::min(len - LZX_MIN_MATCH, 7U);
+        LzxItem item;
+        item.mainSym = static_cast<uint16_t>(LZX_NUM_CHARS + slot * 8 + lenHeader);
+        item.lengthSym = (lenHeader == 7) ? static_cast<uint16_t>(len - LZX_MIN_MATCH - 7) : 0xFFFF;
+        item.numExtraBits = lzxExtraOffsetBits[slot];
+        item.extraBits = formatted - lzxOffsetSlotBase[slot];
+        mainFreqs[item.mainSym]++;
+        if (item.lengthSym != 0xFFFF) {
+            lengthFreqs[item.lengthSym]++;
+        }
+        items.push_back(item);
+    };
+
+    // Returns how many bytes at 'pos' match the bytes 'offset' back
+    auto matchLength = [&](size_t pos, uint32_t offset, unsigned maxLen) {
+        unsigned len = 0;
+        if (offset > pos) {
+            return 0U;
+        }
+        while (len < maxLen && p[pos + len] == p[pos + len - offset]) {
+            len++;
+        }
+        return len;
+    };
+
+    // Greedy parse with one step of lazy evaluation
+    size_t pos = 0;
+    uint32_t offset = 0;
+    unsigned len = matchFinder.FindMatch(pos, 3, LZX_MAX_MATCH, 96, maxOffset, offset);
+    while (pos < inSize) {
+        unsigned maxLen = static_cast<unsigned>(std::min<size_t>(LZX_MAX_MATCH, inSize - pos));
+        unsigned repLen = matchLength(pos, recent[0], maxLen); // Repeat offset 0 is the cheapest match of all
+        if (repLen >= 2 && repLen + 1 >= len) {
+            len = repLen;
+            offset = recent[0];
+        }
+        if (len >= LZX_MIN_MATCH && len < 96 && pos + 1 < inSize) {
+            uint32_t nextOffset = 0;
+            unsigned nextLen = matchFinder.FindMatch(pos + 1, 3, LZX_MAX_MATCH, 96, maxOffset, nextOffset);
+            if (nextLen > len + 1) { // A clearly better match starts one byte later, send a literal instead
+                items.push_back({ p[pos], 0xFFFF, 0, 0 });
+                mainFreqs[p[pos]]++;
+                pos++;
+                len = nextLen;
+                offset = nextOffset;
+                continue;
+            }
+            addMatch(len, offset);
+            for (size_t i = pos + 2; i < pos + len; i++) {
+                matchFinder.Skip(i);
+            }
+        }
+        else if (len >= LZX_MIN_MATCH) {
+            addMatch(len, offset);
+            for (size_t i = pos + 1; i < pos + len; i++) {
+                matchFinder.Skip(i);
+            }
+        }
+        else {
+            items.push_back({ p[pos], 0xFFFF, 0, 0 });
+            mainFreqs[p[pos]]++;
+            len = 1;
+        }
+        pos += len;
+        len = (pos < inSize) ? matchFinder.FindMatch(pos, 3, LZX_MAX_MATCH, 96, maxOffset, offset) : 0;
+    }
+
+    // Build the Huffman codes for this chunk (a single verbatim block)
+    EnsureTwoSymbols(mainFreqs, LZX_MAIN_SYMS);
+    EnsureTwoSymbols(lengthFreqs, LZX_LENGTH_SYMS);
+    uint8_t mainLens[LZX_MAIN_SYMS];
+    uint32_t mainCodes[LZX_MAIN_SYMS];
+    uint8_t lengthLens[LZX_LENGTH_SYMS];
+    uint32_t lengthCodes[LZX_LENGTH_SYMS];
+    MakeHuffmanCode(LZX_MAIN_SYMS, LZX_MAX_MAIN_LEN, mainFreqs, mainLens, mainCodes);
+    MakeHuffmanCode(LZX_LENGTH_SYMS, LZX_MAX_MAIN_LEN, lengthFreqs, lengthLens, lengthCodes);
+
+    LzxBitWriter bits(out, outCapacity);
+    bits.Write(LZX_BLOCK_VERBATIM, 3);
+    if (inSize == LZX_MAX_CHUNK_SIZE) {
+        bits.Write(1, 1); // Block has the default size
+    }
+    else {
+        bits.Write(0, 1);
+        bits.Write(static_cast<uint32_t>(inSize), 16);
+    }
+    LzxWriteLens(bits, mainLens, LZX_NUM_CHARS);
+    LzxWriteLens(bits, mainLens + LZX_NUM_CHARS, LZX_MAIN_SYMS - LZX_NUM_CHARS);
+    LzxWriteLens(bits, lengthLens, LZX_LENGTH_SYMS);
+    for (const LzxItem& item : items) {
+        bits.Write(mainCodes[item.mainSym], mainLens[item.mainSym]);
+        if (item.lengthSym != 0xFFFF) {
+            bits.Write(lengthCodes[item.lengthSym], lengthLens[item.lengthSym]);
+        }
+        if (item.numExtraBits != 0) {
+            bits.Write(item.extraBits, item.numExtraBits);
+        }
+    }
+    size_t outSize = bits.Finish();
+    return (outSize != 0 && outSize < inSize) ? outSize : 0;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Decompressor
+// ---------------------------------------------------------------------------------------------
+
+// Reads bits most significant first out of 16-bit little-endian words
+class LzxBitReader {
+public:
+    LzxBitReader(const uint8_t* buffer, size_t size) : next(buffer), end(buffer + size) {}
+
+    uint32_t Peek(unsigned count) {
+        Fill(count);
+        return count == 0 ? 0 : static_cast<uint32_t>(bitbuf >> (64 - count));
+    }
+
+    void Skip(unsigned count) {
+        bitbuf <<= count;
+        bitsLeft -= count;
+    }
+
+    uint32_t Read(unsigned count) {
+        uint32_t value = Peek(count);
+        Skip(count);
+        return value;
+    }
+
+    // Moves to the next 16-bit boundary (skipping a whole word if already aligned) and returns the byte position
+    const uint8_t* AlignForBytes() {
+        unsigned partial = bitsLeft % 16;
+        Skip(partial == 0 ? 16 : partial);
+        if (bitsLeft < 0) {
+            next += 2; // The skipped word had not been loaded yet
+            bitsLeft = 0;
+        }
+        const uint8_t* pos = next - bitsLeft / 8; // Words loaded but not yet consumed go back to the byte stream
+        Restart(pos);
+        return pos;
+    }
+
+    // Restarts bit reading at a byte position (after the raw bytes of an uncompressed block)
+    void Restart(const uint8_t* pos) {
+        next = pos;
+        bitbuf = 0;
+        bitsLeft = 0;
+        paddingBits = 0;
+    }
+
+    // True once bits past the end of the input have been consumed (peeking ahead is fine)
+    bool Overrun() const { return paddingBits > bitsLeft; }
+    const uint8_t* End() const { return end; }
+
+private:
+    void Fill(unsigned count) {
+        while (bitsLeft < static_cast<int>(count)) {
+            uint64_t word = 0;
+            if (end - next >= 2) {
+                word = uint64_t(next[0]) | (uint64_t(next[1]) << 8);
+                next += 2;
+            }
+            else {
+                paddingBits += 16; // Reading past the end gives zeros
+                next = end;
+            }
+            bitbuf |= word << (48 - bitsLeft);
+            bitsLeft += 16;
+        }
+    }
+
+    const uint8_t* next;
+    const uint8_t* end;
+    uint64_t bitbuf = 0; // Unread bits, left aligned
+    int bitsLeft = 0;    // Number of valid bits in bitbuf
+    int paddingBits = 0; // Number of zero bits in bitbuf that lie past the end of the input
+};
+
+// Reads a run of code lengths sent with a pretree, delta coded against 'lens'
+static bool LzxReadLens(LzxBitReader& bits, uint8_t lens[], unsigned numLens) {
+    uint8_t preLens[LZX_PRECODE_SYMS];
+    for (unsigned i = 0; i < LZX_PRECODE_SYMS; i++) {
+        preLens[i] = static_cast<uint8_t>(bits.Read(4));
+    }
+    HuffmanDecoder pretree;
+    if (!pretree.Build(preLens, LZX_PRECODE_SYMS, LZX_MAX_PRE_LEN, 8)) {
+        return false;
+    }
+    for (unsigned i = 0; i < numLens;) {
+        int presym = pretree.Decode(bits);
+        if (presym < 0) {
+            return false;
+        }
+        unsigned run = 1;
+        int len;
+        if (presym < 17) {
+            len = (lens[i] - presym + 17) % 17;
+        }
+        else if (presym == 17) {
+            run = 4 + bits.Read(4);
+            len = 0;
+        }
+        else if (presym == 18) {
+            run = 20 + bits.Read(5);
+            len = 0;
+        }
+        else {
+            run = 4 + bits.Read(1);
+            int sym = pretree.Decode(bits);
+            if (sym < 0 || sym > 16) {
+                return false;
+            }
+            len = (lens[i] - sym + 17) % 17;
+        }
+        if (i + run > numLens) {
+            return false;
+        }
+        for (; run > 0; run--) {
+            lens[i++] = static_cast<uint8_t>(len);
+        }
+    }
+    return true;
+}
+
+// Function to decompress one LZX chunk of a WIM resource into exactly 'outSize' bytes
+bool LzxDecompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+    if (outSize > LZX_MAX_CHUNK_SIZE) {
+        return false;
+    }
+    LzxBitReader bits(in, inSize);
+    uint8_t mainLens[LZX_MAIN_SYMS] = {};
+    uint8_t lengthLens[LZX_LENGTH_SYMS] = {};
+    uint32_t recent[3] = { 1, 1, 1 };
+    HuffmanDecoder mainCode, lengthCode, alignedCode;
+    size_t pos = 0;
+    while (pos < outSize) {
+        unsigned blockType = bits.Read(3);
+        size_t blockSize = bits.Read(1) ? LZX_MAX_CHUNK_SIZE : bits.Read(16);
+        if (blockSize == 0 || blockSize > outSize - pos) {
+            blockSize = outSize - pos; // The last block may claim the default size
+        }
+        if (blockType == LZX_BLOCK_UNCOMPRESSED) {
+            const uint8_t* raw = bits.AlignForBytes();
+            if (bits.End() - raw < static_cast<ptrdiff_t>(12 + blockSize)) {
+                return false;
+            }
+            for (int i = 0; i < 3; i++) {
+                recent[i] = static_cast<uint32_t>(GetLe32s(raw + 4 * i));
+            }
+            std::memcpy(out + pos, raw + 12, blockSize);
+            pos += blockSize;
+            bits.Restart(raw + 12 + blockSize + (blockSize & 1)); // Odd sized blocks are padded to a word
+            continue;
+        }
+        if (blockType != LZX_BLOCK_VERBATIM && blockType != LZX_BLOCK_ALIGNED) {
+            return false;
+        }
+        if (blockType == LZX_BLOCK_ALIGNED) {
+            uint8_t alignedLens[LZX_ALIGNED_SYMS];
+            for (unsigned i = 0; i < LZX_ALIGNED_SYMS; i++) {
+                alignedLens[i] = static_cast<uint8_t>(bits.Read(3));
+            }
+            if (!alignedCode.Build(alignedLens, LZX_ALIGNED_SYMS, LZX_MAX_ALIGNED_LEN, 7)) {
+                return false;
+            }
+        }
+        if (!LzxReadLens(bits, mainLens, LZX_NUM_CHARS) ||
+            !LzxReadLens(bits, mainLens + LZX_NUM_CHARS, LZX_MAIN_SYMS - LZX_NUM_CHARS) ||
+            !LzxReadLens(bits, lengthLens, LZX_LENGTH_SYMS) ||
+            !mainCode.Build(mainLens, LZX_MAIN_SYMS, LZX_MAX_MAIN_LEN, 11) ||
+            !lengthCode.Build(lengthLens, LZX_LENGTH_SYMS, LZX_MAX_MAIN_LEN, 9)) {
+            return false;
+        }
+        size_t blockEnd = pos + blockSize;
+        while (pos < blockEnd) {
+            int mainSym = mainCode.Decode(bits);
+            if (mainSym < 0) {
+                return false;
+            }
+            if (mainSym < static_cast<int>(LZX_NUM_CHARS)) { // Literal byte
+                out[pos++] = static_cast<uint8_t>(mainSym);
+                continue;
+            }
+            mainSym -= LZX_NUM_CHARS;
+            unsigned len = (mainSym & 7) + LZX_MIN_MATCH;
+            if ((mainSym & 7) == 7) {
+                int lengthSym = lengthCode.Decode(bits);
+                if (lengthSym < 0) {
+                    return false;
+                }
+                len += static_cast<unsigned>(lengthSym);
+            }
+            unsigned slot = static_cast<unsigned>(mainSym) >> 3;
+            uint32_t offset;
+            if (slot < 3) { // Repeat offset, move it to the front of the queue
+                offset = recent[slot];
+                recent[slot] = recent[0];
+                recent[0] = offset;
+            }
+            else {
+                unsigned numExtra = lzxExtraOffsetBits[slot];
+                uint32_t formatted = lzxOffsetSlotBase[slot];
+                if (blockType == LZX_BLOCK_ALIGNED && numExtra >= 3) {
+                    formatted += bits.Read(numExtra - 3) << 3;
+                    int alignedSym = alignedCode.Decode(bits);
+                    if (alignedSym < 0) {
+                        return false;
+                    }
+                    formatted += static_cast<uint32_t>(alignedSym);
+                }
+                else {
+                    formatted += bits.Read(numExtra);
+                }
+                offset = formatted - LZX_OFFSET_ADJUSTMENT;
+                recent[2] = recent[1];
+                recent[1] = recent[0];
+                recent[0] = offset;
+            }
+            if (offset > pos || len > outSize - pos) {
+                return false; // Match reaches outside the chunk
+            }
+            for (unsigned i = 0; i < len; i++) { // Byte by byte, the source may overlap the destination
+                out[pos + i] = out[pos + i - offset];
+            }
+            pos += len;
+        }
+        if (bits.Overrun()) {
+            return false;
+        }
+    }
+    LzxE8Filter(out, outSize, true); // Turn the absolute CALL targets back into relative ones
+    return true;
+}
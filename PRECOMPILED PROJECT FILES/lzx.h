@@ -0,0 +1,12 @@
+#pragma once
+// LZX compression as used by WIM files created with /Compress:max.
+// WIM resources are split into independent 32 KiB chunks, so these functions work on one chunk at a time.
+#include <cstddef> // size_t
+#include <cstdint> // Fixed width integer types
+
+// Largest chunk the WIM flavour of LZX can hold
+constexpr size_t LZX_MAX_CHUNK_SIZE = 32768;
+
+// Function declarations for LZX
+size_t LzxCompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outCapacity);
+bool LzxDecompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize);
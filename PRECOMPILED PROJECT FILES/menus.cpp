@@ -0,0 +1,48 @@
+#include "menus.h"
+#include <limits> // std::numeric_limits for skipping bad input
+
+// Function to find what typing 'choice' in the menu 'state' does, nullptr when it is not one of its options
+const MenuTransition* FindMenuTransition(MenuState state, int choice) {
+    for (const MenuTransition& transition : MENU_TRANSITIONS) {
+        if (transition.from == state && transition.choice == choice) {
+            return &transition;
+        }
+    }
+    return nullptr;
+}
+
+// Function to prompt until one of the options of 'state' is typed, false when the input ends first
+bool ReadMenuChoice(std::istream& input, std::ostream& output, MenuState state, int& choice) {
+    while (true) {
+        output << "Type a number above and press enter: ";
+        if (!(input >> choice)) { // Not a number
+            if (input.eof()) {
+                return false;
+            }
+            output << "Invalid input. Please enter a number.\n";
+            input.clear(); // Clear the error state
+            input.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore the rest of the current input line
+            continue;
+        }
+        if (FindMenuTransition(state, choice) != nullptr) {
+            return true;
+        }
+        output << "Invalid option. Please try again.\n";
+    }
+}
+
+// Function to run the menus from 'start' until the Exit state is reached. Shows each menu, reads a choice, runs its
+// action and moves on, all in this one loop. False when the input ends before Exit.
+bool RunMenus(MenuState start, std::istream& input, std::ostream& output, const MenuScreen& show, const MenuActionHandler& act) {
+    MenuState state = start;
+    while (state != MenuState::Exit) {
+        show(state);
+        int choice = 0;
+        if (!ReadMenuChoice(input, output, state, choice)) {
+            return false;
+        }
+        const MenuTransition& transition = *FindMenuTransition(state, choice);
+        state = act(transition) ? transition.to : transition.from;
+    }
+    return true;
+}
@@ -0,0 +1,109 @@
+#pragma once
+// MODWIN's menus as a state machine. Each menu is a state, and MENU_TRANSITIONS maps the number typed in a menu to
+// the action it runs and the menu shown next. Actions return to the one loop in RunMenus instead of calling the next
+// menu themselves, so the call stack stays as deep as it was on the first menu however long a session runs.
+// Nothing here depends on Windows: the screens and actions are passed in, so modwin_tests drives the real table
+// with scripted input on any platform.
+#include <cstddef>    // size_t for the transition counts
+#include <functional> // std::function for the screen and action callbacks
+#include <istream>    // std::istream the choices are read from
+#include <ostream>    // std::ostream for the prompts
+
+// The menus, Exit ends RunMenus
+enum class MenuState { Main, Apps, Packages, Features, Registry, BuildOptions, Exit };
+
+// Number of states, including Exit
+constexpr size_t MENU_STATE_COUNT = static_cast<size_t>(MenuState::Exit) + 1;
+
+// What picking a menu option does before the next menu is shown
+enum class MenuAction {
+    None,
+    Back,          // Clears the screen on the way back to the main menu
+    Exit,
+    ExtractWim,
+    MountWim,
+    EnterRegistry, // Checks that the WIM is mounted before the registry menu is shown
+    PushUserFolder,
+    Credits,
+    RemoveApps,
+    RemoveAllApps,
+    AddApps,
+    RemovePackage,
+    RemoveAllPackages,
+    AddPackages,
+    DisableFeature,
+    DisableAllFeatures,
+    EnableFeature,
+    OpenHive,      // Opens the hive named by the transition's argument
+    ApplyTweaks,
+    SearchRegistry,
+    SaveChanges,
+    DiscardChanges,
+    UnmountWim,
+    BuildIso,
+    AddUnattendSupport
+};
+
+// One menu option: typing 'choice' in 'from' runs 'action' and shows 'to'. An action that fails keeps the user in
+// 'from'.
+struct MenuTransition {
+    MenuState from;
+    int choice;
+    MenuAction action;
+    MenuState to;
+    const char* argument; // Hive name for OpenHive
+};
+
+// Inline, so FindMenuTransition and every file including this header share one table and its addresses
+inline constexpr MenuTransition MENU_TRANSITIONS[] = {
+    { MenuState::Main, 1, MenuAction::ExtractWim, MenuState::Main, nullptr },
+    { MenuState::Main, 2, MenuAction::MountWim, MenuState::Main, nullptr },
+    { MenuState::Main, 3, MenuAction::None, MenuState::Apps, nullptr },
+    { MenuState::Main, 4, MenuAction::None, MenuState::Packages, nullptr },
+    { MenuState::Main, 5, MenuAction::None, MenuState::Features, nullptr },
+    { MenuState::Main, 6, MenuAction::EnterRegistry, MenuState::Registry, nullptr },
+    { MenuState::Main, 7, MenuAction::PushUserFolder, MenuState::Main, nullptr },
+    { MenuState::Main, 8, MenuAction::None, MenuState::BuildOptions, nullptr },
+    { MenuState::Main, 9, MenuAction::Exit, MenuState::Exit, nullptr },
+    { MenuState::Main, 0, MenuAction::Credits, MenuState::Main, nullptr },
+
+    { MenuState::Apps, 1, MenuAction::RemoveApps, MenuState::Apps, nullptr },
+    { MenuState::Apps, 2, MenuAction::RemoveAllApps, MenuState::Main, nullptr },
+    { MenuState::Apps, 3, MenuAction::AddApps, MenuState::Apps, nullptr },
+    { MenuState::Apps, 4, MenuAction::Back, MenuState::Main, nullptr },
+
+    { MenuState::Packages, 1, MenuAction::RemovePackage, MenuState::Packages, nullptr },
+    { MenuState::Packages, 2, MenuAction::RemoveAllPackages, MenuState::Packages, nullptr },
+    { MenuState::Packages, 3, MenuAction::AddPackages, MenuState::Packages, nullptr },
+    { MenuState::Packages, 4, MenuAction::Back, MenuState::Main, nullptr },
+
+    { MenuState::Features, 1, MenuAction::DisableFeature, MenuState::Features, nullptr },
+    { MenuState::Features, 2, MenuAction::DisableAllFeatures, MenuState::Features, nullptr },
+    { MenuState::Features, 3, MenuAction::EnableFeature, MenuState::Features, nullptr },
+    { MenuState::Features, 4, MenuAction::Back, MenuState::Main, nullptr },
+
+    { MenuState::Registry, 1, MenuAction::OpenHive, MenuState::Registry, "SYSTEM" },
+    { MenuState::Registry, 2, MenuAction::OpenHive, MenuState::Registry, "SOFTWARE" },
+    { MenuState::Registry, 3, MenuAction::OpenHive, MenuState::Registry, "DEFAULT" },
+    { MenuState::Registry, 4, MenuAction::OpenHive, MenuState::Registry, "DRIVERS" },
+    { MenuState::Registry, 5, MenuAction::OpenHive, MenuState::Registry, "SAM" },
+    { MenuState::Registry, 6, MenuAction::ApplyTweaks, MenuState::Registry, nullptr },
+    { MenuState::Registry, 7, MenuAction::SearchRegistry, MenuState::Registry, nullptr },
+    { MenuState::Registry, 8, MenuAction::Back, MenuState::Main, nullptr },
+
+    { MenuState::BuildOptions, 1, MenuAction::SaveChanges, MenuState::Main, nullptr },
+    { MenuState::BuildOptions, 2, MenuAction::DiscardChanges, MenuState::Main, nullptr },
+    { MenuState::BuildOptions, 3, MenuAction::UnmountWim, MenuState::Main, nullptr },
+    { MenuState::BuildOptions, 4, MenuAction::BuildIso, MenuState::Main, nullptr },
+    { MenuState::BuildOptions, 5, MenuAction::AddUnattendSupport, MenuState::Main, nullptr },
+};
+
+// Shows the screen of a menu
+using MenuScreen = std::function<void(MenuState state)>;
+// Runs the action of an option, false when it failed
+using MenuActionHandler = std::function<bool(const MenuTransition& transition)>;
+
+// Function declarations for the menu state machine
+const MenuTransition* FindMenuTransition(MenuState state, int choice);
+bool ReadMenuChoice(std::istream& input, std::ostream& output, MenuState state, int& choice);
+bool RunMenus(MenuState start, std::istream& input, std::ostream& output, const MenuScreen& show, const MenuActionHandler& act);
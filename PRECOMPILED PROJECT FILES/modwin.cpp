@@ -5,32 +5,51 @@
 #include <cstdlib> // Includes the C standard library for general-purpose functions like memory allocation, process control, conversions, etc.
 #include <fstream> // Includes the file stream library for file input/output operations (e.g., std::ifstream, std::ofstream)
 #include <limits> // Includes the limits library which provides ways to query properties of fundamental arithmetic types (e.g., min/max values)
+#include <algorithm> // Includes the algorithms library for searching and sorting (e.g., std::find)
 #include <vector>    // Includes the standard vector class, a dynamic array that allows elements to be added or removed and automatically manages storage
 #include <filesystem>// Includes the filesystem library to work with files and directories, such as file manipulation and path information
 #include <regex>     // Includes the regular expression library for pattern matching and text searching/manipulating using regex patterns
 #include <set>
 #include <sstream>  // Includes the string stream library for string-based streams (e.g., std::stringstream)
-// Includes generated header files for the xorriso binary to be able to be unpacked to user's system. 
-#include "gitignore.h" // Xorriso is our iso builder
-#include "LICENSE.h" // these files were converted from file format to arrays
-#include "README_md.h" // so that we can build the files on user's computer using only code
-#include "cygiconv_2_dll.h"
-#include "cygwin1_dll.h"
-#include "resources_rc.h"
-#include "xorriso_exe.h"
-
-// Includes generated header files for a tpm bypass file and a basic unattend.xml file to be able to be unpacked to user's system.
-#include "TPM_fix_cmd.h"
-#include "autounattend_xml.h"
+
+// Includes MODWIN's own modules
+#include "wim.h" // Native WIM reader used to list the images without starting DISM
+#include "wim_export.h" // Native multi-threaded WIM export used instead of "dism /export-image"
+#include "sha1.h" // SHA-1 of WIM resources and integrity tables, for --benchmark-sha1
+#include "wim_verify.h" // Integrity table check of install.wim without DISM, for --verify
+#include "iso_writer.h" // Native ISO writer used instead of the bundled Cygwin xorriso
+#include "image_servicing.h" // Apps, packages and features of the mounted WIM through one DISM session
+#include "image_inventory.h" // Cached listings of the mounted WIM
+#include "package_rules.h" // Safe list and rule files deciding which packages "Remove all packages" removes
+#include "package_graph.h" // Removal order of packages from their manifests
+#include "registry_hive.h" // Native registry hive editor used instead of "reg load" and regedit
+#include "registry_tweaks.h" // .reg tweak files applied to the offline hives
+#include "registry_search.h" // Indexed search across the offline hives
+#include "folder_push.h" // Copies only the changed files of the USER folder into the WIM
+#include "payloads.h" // TPM_fix.cmd and autounattend.xml packed into the executable, unpacked on first use
+#include "menus.h" // Table of the menus and the one loop running them
 
 namespace fs = std::filesystem;
 
+// Settings for compressing install.wim to install.esd, can be changed with --esd-block-size and --esd-threads
+static EsdExportOptions esdOptions;
+
+// Servicing session on the image mounted in C:\MODWIN\PATH, opened on first use and closed before the image is unmounted
+static std::unique_ptr<ImageServicing> servicing;
+
+// Packages "Remove all packages" may remove: the built-in safe list plus the rule files in C:\MODWIN\RULES
+static PackageRuleSet packageRules;
+
 // Function declarations to help compilers, as well as the code in this script is constructed as ordered below
-int main();
+int main(int argc, char* argv[]);
 bool IsUserAdmin();
 bool FileExists(const std::string& filename);
 bool DirectoryExists(const std::string& dirName);
 void BuildModwinFolder(const fs::path& exePath);
+ImageServicing& Servicing();
+void CloseServicing();
+void ShowMenuScreen(MenuState state);
+bool RunMenuAction(const MenuTransition& transition);
 void ShowMenu();
 void SourceWIM();
 void HandleWIM();
@@ -40,6 +59,7 @@ void Apps();
 void AddApp();
 void RemoveApp();
 void RemoveAllApps();
+void PrintBatchReport(const std::vector<ServicingBatchItem>& items, const char* noun);
 void Packages();
 void RemovePackage();
 void RemoveAllPackages();
@@ -48,8 +68,11 @@ void Features();
 void RemoveFeature();
 void RemoveAllFeatures();
 void EnableFeature();
+bool RegistryMounted();
 void MountWIMRegistry();
 void OpenRegistryHive(const std::string& hiveName);
+void EditRegistryHive(const std::string& hiveName);
+void SearchRegistry();
 void UnloadRegistryHive();
 void PushUserFolderToWIM();
 void BuildOptions();
@@ -62,13 +85,74 @@ void AddUnattendSupport();
 void Credits();
 
 // Main Function for MODWIN
-int main() {
+int main(int argc, char* argv[]) {
+    // "MODWIN.exe --verify <wim>" checks a WIM against its integrity table before it goes into an ISO
+    if (argc == 3 && std::string(argv[1]) == "--verify") {
+        return VerifyWim(argv[2]) ? 0 : 1;
+    }
+    // "MODWIN.exe --benchmark-export <wim> <index>" times the WIM export with one thread and with every core
+    if (argc == 4 && std::string(argv[1]) == "--benchmark-export") {
+        return BenchmarkWimExport(argv[2], std::atoi(argv[3]), "C:\\MODWIN\\benchmark.wim") ? 0 : 1;
+    }
+    // "MODWIN.exe --benchmark-esd <wim> <index>" compares ESD compression speed and size for several solid block sizes
+    if (argc == 4 && std::string(argv[1]) == "--benchmark-esd") {
+        return BenchmarkEsdExport(argv[2], std::atoi(argv[3]), "C:\\MODWIN\\benchmark.esd") ? 0 : 1;
+    }
+    // "MODWIN.exe --benchmark-iso <folder>" compares the ISO build speed with a plain copy of the folder
+    if (argc == 3 && std::string(argv[1]) == "--benchmark-iso") {
+        return BenchmarkIsoBuild(argv[2], "C:\\MODWIN") ? 0 : 1;
+    }
+    // "MODWIN.exe --benchmark-sha1 [MiB]" compares the SHA-1 paths used for WIM hashes with the plain C++ one
+    if ((argc == 2 || argc == 3) && std::string(argv[1]) == "--benchmark-sha1") {
+        return BenchmarkSha1(argc == 3 ? static_cast<size_t>(std::atoi(argv[2])) : 1024) ? 0 : 1;
+    }
+    // "MODWIN.exe --benchmark-payloads [rounds]" times unpacking the payloads packed into MODWIN with one thread and with every core
+    if ((argc == 2 || argc == 3) && std::string(argv[1]) == "--benchmark-payloads") {
+        return BenchmarkPayloadExtraction("C:\\MODWIN", argc == 3 ? static_cast<size_t>(std::atoi(argv[2])) : 20) ? 0 : 1;
+    }
+    // "MODWIN.exe --apply-tweaks <mounted image> <.reg file or folder>" applies registry tweaks without the menus
+    if (argc == 4 && std::string(argv[1]) == "--apply-tweaks") {
+        return ApplyRegistryTweakFiles(argv[2], argv[3]) ? 0 : 1;
+    }
+    // "MODWIN.exe --search-registry <mounted image> <text>" lists the keys and values of the image's hives containing the text
+    if (argc == 4 && std::string(argv[1]) == "--search-registry") {
+        return SearchRegistryHives(argv[2], argv[3]) ? 0 : 1;
+    }
+    // "--esd-block-size <MiB>" and "--esd-threads <count>" tune the ESD compression in SaveChanges
+    std::string arguments;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if ((option == "--esd-block-size" || option == "--esd-threads") && i + 1 < argc) {
+            // Only plain decimal numbers are taken, so "-1" or "32MB" are not silently read as something else
+            const char* text = argv[i + 1];
+            char* end = nullptr;
+            unsigned long value = (*text >= '0' && *text <= '9') ? std::strtoul(text, &end, 10) : 0;
+            bool isNumber = end && *end == '\0';
+            if (option == "--esd-block-size") {
+                if (!isNumber || value > 1024 || !IsValidSolidChunkSize(static_cast<uint64_t>(value) * 1024 * 1024)) {
+                    std::cerr << "Error: --esd-block-size takes a power of 2 between 1 and 1024 (MiB), not \"" << text << "\".\n";
+                    return 1;
+                }
+                esdOptions.solidChunkSize = static_cast<uint32_t>(value) * 1024 * 1024;
+            }
+            else {
+                if (!isNumber) {
+                    std::cerr << "Error: --esd-threads takes a number of threads, not \"" << text << "\".\n";
+                    return 1;
+                }
+                esdOptions.threadCount = static_cast<unsigned>(std::min(std::max(value, 1UL), 256UL)); // Kept between 1 and 256 threads
+            }
+        }
+        arguments += "\"" + option + "\" ";
+    }
+
     // Checks if user is Admin
     if (!IsUserAdmin()) {
         std::cout << "Administrative privileges required.\n";
         SHELLEXECUTEINFO sei = { sizeof(sei) };
         sei.lpVerb = "runas";
         sei.lpFile = "MODWIN.exe";
+        sei.lpParameters = arguments.c_str(); // Keeps the command line options for the elevated instance
         sei.hwnd = NULL;
         sei.nShow = SW_NORMAL;
         if (!ShellExecuteEx(&sei)) {
@@ -80,14 +164,17 @@ int main() {
     // Obtain the absolute path of the executable
     fs::path exePath = fs::absolute(fs::current_path() / "MODWIN.exe");
 
+    packageRules.LoadFolder("C:\\MODWIN\\RULES"); // Adds the user's package rules to the built-in safe list
+
     // Checks if the C:/MODWIN directory exists
     if (!DirectoryExists("C:\\MODWIN")) {
         BuildModwinFolder(exePath); // Pass the executable path to BuildModwinFolder
     }
     else {
+        SyncPayloads("C:\\MODWIN\\BIN", false); // Replaces files an older MODWIN or a crash left behind, checking only their attributes when unchanged
         system("explorer C:\\MODWIN\\ISO"); // Open File Explorer to C:\MODWIN\ISO
-        ShowMenu(); // Takes user to the main menu
     }
+    RunMenus(MenuState::Main, std::cin, std::cout, ShowMenuScreen, RunMenuAction); // Shows the main menu and every menu picked from there until the user exits
     return 0;
 }
 
@@ -130,66 +217,144 @@ void BuildModwinFolder(const std::filesystem::path& exePath) {
     std::filesystem::create_directory("C:\\MODWIN");
     std::filesystem::create_directory("C:\\MODWIN\\APPS");
     std::filesystem::create_directory("C:\\MODWIN\\BIN");
-    std::filesystem::create_directory("C:\\MODWIN\\BIN\\xorriso");
     std::filesystem::create_directory("C:\\MODWIN\\ISO");
     std::filesystem::create_directory("C:\\MODWIN\\MOD");
     std::filesystem::create_directory("C:\\MODWIN\\PACKAGES");
     std::filesystem::create_directory("C:\\MODWIN\\PATH");
+    std::filesystem::create_directory("C:\\MODWIN\\RULES");
+    std::filesystem::create_directory("C:\\MODWIN\\TWEAKS");
     std::filesystem::create_directory("C:\\MODWIN\\USER");
 
-    // Defines the output directory for general BIN files and the xorriso directory
-    const std::filesystem::path binDir = "C:\\MODWIN\\BIN";
-    const std::filesystem::path xorrisoDir = "C:\\MODWIN\\BIN\\xorriso";
-
-    // List of all header files with arrays to unpack
-    std::vector<std::pair<const unsigned char*, size_t>> files = {
-        {TPM_fix_cmd, TPM_fix_cmd_len},
-        {autounattend_xml, autounattend_xml_len},
-        {_gitignore, _gitignore_len},
-        {LICENSE, LICENSE_len},
-        {README_md, README_md_len},
-        {cygiconv_2_dll, cygiconv_2_dll_len},
-        {cygwin1_dll, cygwin1_dll_len},
-        {resources_rc, resources_rc_len},
-        {xorriso_exe, xorriso_exe_len}
-    };
-
-    // The names of the files to be created
-    std::vector<std::string> filenames = {
-        "TPM_fix.cmd",
-        "autounattend.xml",
-        ".gitignore",
-        "LICENSE",
-        "README.md",
-        "cygiconv-2.dll",
-        "cygwin1.dll",
-        "resources.rc",
-        "xorriso.exe"
-    };
-
-    // Iterate over the arrays and write them to files
-    for (size_t i = 0; i < files.size(); ++i) {
-        // Define the directory path based on file type
-        std::filesystem::path targetDirectory = (i < 2) ? binDir : xorrisoDir;
-
-        // Create and write to file
-        std::ofstream outFile(targetDirectory / filenames[i], std::ios::binary);
-        if (outFile.is_open()) {
-            outFile.write(reinterpret_cast<const char*>(files[i].first), files[i].second);
-            outFile.close();
-            std::cout << filenames[i] << " has been unpacked successfully." << std::endl;
-        }
-        else {
-            std::cerr << "Error: Unable to open " << filenames[i] << " for writing." << std::endl;
-        }
-    }
+    // The files packed into MODWIN are unpacked to C:\MODWIN\BIN by the features using them, see payloads.h
     system("explorer C:\\MODWIN\\ISO"); // Opens file explorer to the ISO folder of MODWIN so they can paste their files in
     system("cls"); // Clear the console screen
-    ShowMenu(); // Takes user to Main Menu
 }
 
+// Function to get the servicing session on the mounted image, opening it the first time it is needed
+ImageServicing& Servicing() {
+    if (!servicing) {
+        // Uses the DISM API when it can open the image, dism.exe otherwise, and keeps the listings until the image changes
+        servicing = std::make_unique<CachedImageServicing>(OpenImageServicing("C:\\MODWIN\\PATH", "C:\\MODWIN"), "C:\\MODWIN\\PATH");
+    }
+    return *servicing;
+}
+
+// Function to close the servicing session so DISM can unmount or clean up the image
+void CloseServicing() {
+    servicing.reset();
+}
+
+// Function to show the screen of a menu, called by RunMenus before it reads the user's choice
+void ShowMenuScreen(MenuState state) {
+    switch (state) {
+    case MenuState::Main:
+        ShowMenu();
+        break;
+    case MenuState::Apps:
+        Apps();
+        break;
+    case MenuState::Packages:
+        Packages();
+        break;
+    case MenuState::Features:
+        Features();
+        break;
+    case MenuState::Registry:
+        MountWIMRegistry();
+        break;
+    case MenuState::BuildOptions:
+        BuildOptions();
+        break;
+    case MenuState::Exit:
+        break;
+    }
+}
 
-// Function for MODWIN's Main Menu
+// Function to run the option picked in a menu. RunMenus shows the menu the option leads to once this returns, or
+// the menu it was picked from when this returns false.
+bool RunMenuAction(const MenuTransition& transition) {
+    switch (transition.action) {
+    case MenuAction::None:
+        break;
+    case MenuAction::Back:
+        system("cls"); // Clear the console screen
+        break;
+    case MenuAction::Exit:
+        std::cout << "Exiting program.\n";
+        break;
+    case MenuAction::ExtractWim:
+        SourceWIM();
+        break;
+    case MenuAction::MountWim:
+        MountWIM();
+        break;
+    case MenuAction::EnterRegistry:
+        return RegistryMounted();
+    case MenuAction::PushUserFolder:
+        PushUserFolderToWIM();
+        break;
+    case MenuAction::Credits:
+        Credits();
+        break;
+    case MenuAction::RemoveApps:
+        RemoveApp();
+        break;
+    case MenuAction::RemoveAllApps:
+        RemoveAllApps();
+        break;
+    case MenuAction::AddApps:
+        AddApp();
+        break;
+    case MenuAction::RemovePackage:
+        RemovePackage();
+        break;
+    case MenuAction::RemoveAllPackages:
+        RemoveAllPackages();
+        break;
+    case MenuAction::AddPackages:
+        AddPackage();
+        break;
+    case MenuAction::DisableFeature:
+        RemoveFeature();
+        break;
+    case MenuAction::DisableAllFeatures:
+        RemoveAllFeatures();
+        break;
+    case MenuAction::EnableFeature:
+        EnableFeature();
+        break;
+    case MenuAction::OpenHive:
+        OpenRegistryHive(transition.argument);
+        break;
+    case MenuAction::ApplyTweaks:
+        system("cls"); // Clear the console screen
+        ApplyRegistryTweakFiles("C:\\MODWIN\\PATH", "C:\\MODWIN\\TWEAKS"); // Opens each hive once and writes all of its tweaks
+        std::cout << "Press any key to continue.\n"; // Prints message to screen
+        system("pause>nul"); // Pause the program
+        break;
+    case MenuAction::SearchRegistry:
+        SearchRegistry();
+        break;
+    case MenuAction::SaveChanges:
+        SaveChanges();
+        break;
+    case MenuAction::DiscardChanges:
+        DiscardChanges();
+        break;
+    case MenuAction::UnmountWim:
+        UnmountWIM();
+        break;
+    case MenuAction::BuildIso:
+        BuildISO();
+        break;
+    case MenuAction::AddUnattendSupport:
+        AddUnattendSupport();
+        break;
+    }
+    return true;
+}
+
+// Function to show MODWIN's Main Menu, RunMenus reads the choice and runs it
 void ShowMenu() {
     HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE); // Get the console handle
     // Banner for MODWIN ASCII art and version
@@ -224,65 +389,6 @@ Main Menu Options:
     std::cout << modwinBanner; // Output the MODWIN banner
     SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE); // Reset to default color
     std::cout << menuBanner << std::endl; // Output the menu banner
-    int choice; // Variable to store the user's menu selection
-    int validChoices[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }; // Allowed choices
-    int numberOfChoices = sizeof(validChoices) / sizeof(validChoices[0]); // Number of valid choices
-    while (true) { // Use a while loop to continuously prompt for input until a valid choice is made
-        std::cout << "Type a number above and press enter: "; // Prints message to screen
-        if (!(std::cin >> choice)) { // Check if the input is not an integer
-            std::cout << "Invalid input. Please enter a number.\n";
-            std::cin.clear(); // Clear the error state of the cin object
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore the rest of the current input line
-            continue; // Continue to the next iteration of the loop
-        }
-        bool isValidChoice = false; // Initialize a flag to track if the user's choice is valid
-        for (int i = 0; i < numberOfChoices; i++) { // Loop through all the valid choices to see if the user's choice matches one of them
-            if (choice == validChoices[i]) { // Check if the user's choice matches the current valid choice
-                isValidChoice = true; // If it matches, set isValidChoice to true
-                break; // Break out of the loop as we've found a valid choice
-            }
-        }
-        if (!isValidChoice) { // Not a valid choice
-            std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-        }
-        else {
-            break; // Exit the loop if a valid choice is made
-        }
-    }
-    switch (choice) { // Switch cases for user choice, takes user to selected menu.
-    case 1:
-        SourceWIM();
-        break;
-    case 2:
-        MountWIM();
-        break;
-    case 3:
-        Apps();
-        break;
-    case 4:
-        Packages();
-        break;
-    case 5:
-        Features();
-        break;
-    case 6:
-        MountWIMRegistry();
-        break;
-    case 7:
-        PushUserFolderToWIM();
-        break;
-    case 8:
-        BuildOptions();
-        break;
-    case 9:
-        std::cout << "Exiting program.\n";
-        exit(0); // Closes the program
-    case 0:
-        Credits();
-        break;
-    default:
-        std::cout << "Invalid option. Please try again.\n";
-    }
 }
 
 // Function to check if our unpacked iso contains a wim or an esd install file
@@ -308,13 +414,14 @@ void SourceWIM() {
         std::cout << "Press any key to return to the Main Menu.\n"; // Prints message to the screen
         system("pause>nul"); // Pause the program
         system("cls"); // Clear the console screen
-        ShowMenu(); // Return to the main menu
     }
 }
 
 // Function for the WIM extraction menu, for extracting a WIM from a WIM of the user's choosing
 void HandleWIM() {
-    system("Dism /Get-WimInfo /WimFile:\"C:\\MODWIN\\ISO\\sources\\install.wim\""); // Runs the DISM command to retrieve the sources in the WIM for extraction.
+    if (!PrintWimInfo("C:\\MODWIN\\ISO\\sources\\install.wim")) { // Reads the list of images straight from the WIM file
+        system("Dism /Get-WimInfo /WimFile:\"C:\\MODWIN\\ISO\\sources\\install.wim\""); // Falls back to DISM if the WIM could not be read
+    }
     int sourceIndex; // Declares an integer variable 'sourceIndex' to store the user's choice of image index for extraction.
     std::cout << "\nType an Index Number and press enter: ";  // Prints message to the screen, prompting the user to enter the index number of the source image they want to extract.
     std::cin >> sourceIndex; // Reads the user's input into sourceIndex
@@ -322,20 +429,41 @@ void HandleWIM() {
     std::cout << "============================\n"; // Prints message to the screen
     std::cout << "Preparing to extract the WIM\n"; // Prints message to the screen
     std::cout << "============================\n"; // Prints message to the screen
-    // Constructs a DISM command to export a specific image from the WIM file into another WIM file with maximum compression
-    std::string dismExportCommand = "dism /export-image /SourceImageFile:\"C:\\MODWIN\\ISO\\sources\\install.wim\" /SourceIndex:" + std::to_string(sourceIndex) + " /DestinationImageFile:\"C:\\MODWIN\\ISO\\sources\\install1.wim\" /Compress:max /CheckIntegrity";
-    system(dismExportCommand.c_str()); // Executes the constructed DISM command
-    std::cout << "\nPress any key to continue.\n"; // Prints message to the screen, informing the user that the extraction process is complete
+    // Exports the chosen image into a new WIM with maximum (LZX) compression, spreading the work over every CPU core
+    WimExportOptions exportOptions; // Defaults match /Compress:max /CheckIntegrity
+    WimExportStats exportStats;
+    bool exported = ExportWimImage("C:\\MODWIN\\ISO\\sources\\install.wim", sourceIndex, "C:\\MODWIN\\ISO\\sources\\install1.wim", exportOptions, &exportStats);
+    if (exported) {
+        double mbPerSecond = exportStats.seconds > 0 ? exportStats.bytesProcessed / (1024.0 * 1024.0) / exportStats.seconds : 0.0;
+        std::cout << "Exported " << exportStats.bytesProcessed / (1024 * 1024) << " MB in " << static_cast<int>(exportStats.seconds) << " seconds (" << static_cast<int>(mbPerSecond) << " MB/s, " << exportStats.threads << " threads)\n";
+    }
+    else { // Falls back to DISM if the native export could not handle this WIM
+        // Constructs a DISM command to export a specific image from the WIM file into another WIM file with maximum compression
+        std::string dismExportCommand = "dism /export-image /SourceImageFile:\"C:\\MODWIN\\ISO\\sources\\install.wim\" /SourceIndex:" + std::to_string(sourceIndex) + " /DestinationImageFile:\"C:\\MODWIN\\ISO\\sources\\install1.wim\" /Compress:max /CheckIntegrity";
+        exported = system(dismExportCommand.c_str()) == 0; // Executes the constructed DISM command
+    }
+    exported = exported && fs::is_regular_file("C:\\MODWIN\\ISO\\sources\\install1.wim");
+    if (exported) {
+        std::cout << "\nPress any key to continue.\n"; // Prints message to the screen, informing the user that the extraction process is complete
+    }
+    else { // The original WIM is only replaced by a finished export
+        std::error_code removeError;
+        fs::remove("C:\\MODWIN\\ISO\\sources\\install1.wim", removeError); // Drops whatever a failed export left behind
+        std::cerr << "\nError: The image could not be exported, install.wim was left as it was. Press any key to continue.\n";
+    }
     system("pause>nul"); // Pause the program
-    system("del \"C:\\MODWIN\\ISO\\sources\\install.wim\""); // Deletes the original WIM file
-    system("ren \"C:\\MODWIN\\ISO\\sources\\install1.wim\" install.wim"); // Renames the extracted WIM file from 'install1.wim' to 'install.wim'
+    if (exported) {
+        system("del \"C:\\MODWIN\\ISO\\sources\\install.wim\""); // Deletes the original WIM file
+        system("ren \"C:\\MODWIN\\ISO\\sources\\install1.wim\" install.wim"); // Renames the extracted WIM file from 'install1.wim' to 'install.wim'
+    }
     system("cls"); // Clear the console screen
-    ShowMenu(); // Takes the user back to the main menu
 }
 
 // Function for the ESD extraction menu, for extracting a WIM from the ESD of the user's choosing
 void HandleESD() {
-    system("Dism /Get-WimInfo /WimFile:\"C:\\MODWIN\\ISO\\sources\\install.esd\""); // Runs the DISM command to retrieve the sources in the ESD for extraction to WIM format.
+    if (!PrintWimInfo("C:\\MODWIN\\ISO\\sources\\install.esd")) { // Reads the list of images straight from the ESD file
+        system("Dism /Get-WimInfo /WimFile:\"C:\\MODWIN\\ISO\\sources\\install.esd\""); // Falls back to DISM if the ESD could not be read
+    }
     int sourceIndex; // Declares an integer variable 'sourceIndex' to store the user's choice of image index for extraction.
     std::cout << "\nType an Index Number and Press Enter: "; // Prints message to the screen, prompting the user to enter the index number of the source image they want to extract.
     std::cin >> sourceIndex; // Reads the user's input into sourceIndex
@@ -350,7 +478,6 @@ void HandleESD() {
     system("pause>nul"); // Pause the program
     system("del \"C:\\MODWIN\\ISO\\sources\\install.esd\""); // Deletes the original ESD file
     system("cls"); // Clear the console screen
-    ShowMenu(); // Takes the user back to the Main Menu
 }
 
 // Function to mount the WIM using DISM
@@ -362,18 +489,17 @@ void MountWIM() {
         std::cout << "==========================\n"; // Prints message to the screen
         std::cout << "Preparing to mount the WIM\n"; // Prints message to the screen
         std::cout << "==========================\n"; // Prints message to the screen
+        CloseServicing(); // Drops any session left on a previously mounted image
         system("dism.exe /mount-wim /wimfile:\"C:\\MODWIN\\ISO\\sources\\install.wim\" /mountdir:\"C:\\MODWIN\\PATH\" /index:1"); // Mounts the WIM file and exposes it's contents in the PATH folder of MODWIN
         std::cout << "\nPress any key to continue.\n"; // Prints success message
         system("pause>nul"); // Pause the program
         system("cls"); // Clear the console screen
-        ShowMenu(); // Takes the user back to the Main Menu
     }
     else { // If the WIM file does not exist
         std::cout << "Error: WIM file not found at " << mountWimPath << ". Please ensure the file exists and try again.\n";
         std::cout << "Press any key to return to the Main Menu.\n"; // Prints message to the screen
         system("pause>nul"); // Pause the program
         system("cls"); // Clear the console screen
-        ShowMenu(); // Return to the main menu  
     }
 }
 
@@ -386,116 +512,83 @@ void Apps() {
     std::cout << "\n1. Remove Applications \n"; // Prints message to screen
     std::cout << "2. Remove All Applications \n"; // Prints message to screen
     std::cout << "3. Install Applications \n"; // Prints message to screen
-    std::cout << "4. Return to Main Menu\n"; // Prints message to screen
-    int choice; // Variable to store the user's menu selection
-    int validChoices[] = { 1, 2, 3, 4 }; // Allowed choices
-    int numberOfChoices = sizeof(validChoices) / sizeof(validChoices[0]); // Number of valid choices
-    while (true) { // Use a while loop to continuously prompt for input until a valid choice is made
-        std::cout << "\nType a number above and press enter: ";
-        if (!(std::cin >> choice)) { // Check if the input is not an integer
-            std::cout << "Invalid input. Please enter a number.\n";
-            std::cin.clear(); // Clear the error state of the cin object
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore the rest of the current input line
-            continue; // Continue to the next iteration of the loop
-        }
-        bool isValidChoice = false; // Initialize a flag to track if the user's choice is valid
-        for (int i = 0; i < numberOfChoices; i++) { // Loop through all the valid choices to see if the user's choice matches one of them
-            if (choice == validChoices[i]) { // Check if the user's choice matches the current valid choice
-                isValidChoice = true; // If it matches, set isValidChoice to true
-                break; // Break out of the loop as we've found a valid choice
-            }
-        }
-        if (!isValidChoice) { // Not a valid choice
-            std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-        }
-        else {
-            break; // Exit the loop if a valid choice is made
-        }
-    }
-    switch (choice) {
-    case 1:
-        RemoveApp(); // Takes user to the RemoveApp menu
-        break;
-    case 2:
-        RemoveAllApps(); // Takes user to Remove All Apps
-        break;
-    case 3:
-        AddApp(); // Takes user to the AddApp menu
-        break;
-    case 4:
-        system("cls"); // Clear the console screen
-        ShowMenu(); // Return to the main menu
-        break;
-    default:
-        std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-    }
+    std::cout << "4. Return to Main Menu\n\n"; // Prints message to screen
 }
 
 // Function for the Remove Application menu
 void RemoveApp() {
     system("cls"); // Clear the console screen
-    // Dism command to get and list provisioned application packages, who's output is saved to a text file called apps.txt
-    system("C:\\Windows\\System32\\dism.exe /Image:C:\\MODWIN\\PATH /Get-ProvisionedAppxPackages > C:\\MODWIN\\apps.txt");
-    system("find \"PackageName : \" C:\\MODWIN\\apps.txt > C:\\MODWIN\\newapps.txt"); // Searchs for "PackageName : " and prints only those lines to newapps.txt
-    std::ifstream inFile("C:\\MODWIN\\newapps.txt");// Open the newapps.txt file
-    if (!inFile) { // if file not available
-        std::cerr << "Failed to open C:\\MODWIN\\newapps.txt\n"; // Prints message to screen
-        Apps(); // Exit the function if file opening fails
-    }
-    std::string line; // Declare a string to hold each line read from the file
-    while (std::getline(inFile, line)) { // Read lines from inFile one by one into 'line' until the end of the file is reached
-        size_t startPos = line.find("PackageName : "); // Find the start position of "PackageName : " in the line
-        if (startPos != std::string::npos) { // Check if the substring is found
-            // Print the package name, excluding the "PackageName : " part
-            std::cout << line.substr(startPos + std::string("PackageName : ").length()) << '\n';
-        }
+    AppxPackageTable apps; // The provisioned application packages
+    if (!Servicing().ListProvisionedApps(apps)) { // Lists the provisioned application packages of the mounted WIM
+        std::cerr << "Failed to list the applications in C:\\MODWIN\\PATH\n"; // Prints message to screen
+        return;
+    }
+    std::vector<uint32_t> rows = SortedByName(apps); // Lists the applications alphabetically
+    for (size_t i = 0; i < rows.size(); i++) {
+        std::cout << i + 1 << ". " << apps.Name(rows[i]) << '\n'; // Print the number and the package name
     }
-    inFile.close(); // Close the file after reading
-    std::string packageName; // Ask user for the package name to remove
-    std::cout << "\nCopy and paste an application from above to remove: "; // Prints message to screen
+    std::string selection; // Either the numbers of the applications or one pasted package name
+    std::cout << "\nType the numbers of the applications to remove separated by spaces, or paste an application from above: "; // Prints message to screen
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Clear the input buffer
-    std::getline(std::cin, packageName); // Read the full line of input for the package name
-    // Constructs the Dism command to remove the selected application package
-    std::string removeCommand = "dism /Image:C:\\MODWIN\\PATH /Remove-ProvisionedAppxPackage /PackageName:\"" + packageName + "\"";
-    system(removeCommand.c_str()); // Execute the command
+    std::getline(std::cin, selection); // Read the full line of input
+    std::vector<std::string> selectedApps; // Applications to remove in one batch
+    if (!SelectRows(apps, [&](uint32_t row) { return apps.Name(row) == selection; }).empty()) { // A pasted package name
+        selectedApps.push_back(selection);
+    }
+    else {
+        std::istringstream numbers(selection);
+        size_t number;
+        while (numbers >> number) { // Collects every valid number typed
+            if (number >= 1 && number <= rows.size()) {
+                selectedApps.push_back(std::string(apps.Name(rows[number - 1])));
+            }
+        }
+    }
+    if (selectedApps.empty()) {
+        std::cout << "No application selected.\n"; // Prints message to screen
+    }
+    else {
+        PrintBatchReport(Servicing().RemoveProvisionedApps(selectedApps), "applications"); // Removes the selected applications in one pass and reports each one
+    }
     std::cout << "Press any key to continue.\n"; // Prints message to the screen
     system("pause>nul"); // Pauses so the user can verify 
     system("cls"); // Clear the console screen
-    system("del C:\\MODWIN\\apps.txt"); // Removes leftover apps text file
-    system("del C:\\MODWIN\\newapps.txt"); // Removes leftover newapps text file
-    Apps(); // Takes the user back to apps
 }
 
-// Function to remove all applications listed in newapps.txt
+// Function to remove all provisioned applications of the mounted WIM
 void RemoveAllApps() {
     system("cls"); // Clear the console screen
-    // Dism command to get and list provisioned application packages, who's output is saved to a text file called apps.txt
-    system("C:\\Windows\\System32\\dism.exe /Image:C:\\MODWIN\\PATH /Get-ProvisionedAppxPackages > C:\\MODWIN\\apps.txt");
-    system("find \"PackageName : \" C:\\MODWIN\\apps.txt > C:\\MODWIN\\newapps.txt"); // Searchs for "PackageName : " and prints only those lines to newapps.txt
-    std::ifstream inFile("C:\\MODWIN\\newapps.txt"); // Open the newapps.txt file
-    if (!inFile) { // if file not available
-        std::cerr << "Failed to open C:\\MODWIN\\newapps.txt\n"; // Prints message to screen
-        return; // Exit the function if file opening fails
-    }
-    std::string line; // Variable to hold each line
-    while (std::getline(inFile, line)) { // Read lines from inFile one by one
-        size_t startPos = line.find("PackageName : "); // Find the start position of "PackageName : " in the line
-        if (startPos != std::string::npos) {
-            std::string packageName = line.substr(startPos + std::string("PackageName : ").length()); // Extract the package name
-            // Constructs the DISM command to remove the application package
-            std::string removeCommand = "C:\\Windows\\System32\\dism.exe /Image:C:\\MODWIN\\PATH /Remove-ProvisionedAppxPackage /PackageName:\"" + packageName + "\"";
-            system(removeCommand.c_str()); // Execute the command
-            std::cout << packageName << " removed.\n"; // Inform user of removal
-        }
+    AppxPackageTable apps; // The provisioned application packages
+    if (!Servicing().ListProvisionedApps(apps)) { // Lists the provisioned application packages of the mounted WIM
+        std::cerr << "Failed to list the applications in C:\\MODWIN\\PATH\n"; // Prints message to screen
+        return; // Exit the function if the listing fails
+    }
+    std::vector<std::string> appNames; // Names of every application, removed in one batch
+    for (size_t i = 0; i < apps.Size(); i++) {
+        appNames.push_back(std::string(apps.Name(i)));
     }
-    inFile.close(); // Close the file after processing
+    std::cout << "Removing " << appNames.size() << " applications...\n"; // Prints message to the screen
+    PrintBatchReport(Servicing().RemoveProvisionedApps(appNames), "applications"); // Removes every application in one pass and reports each one
 
-    std::cout << "\nAll applications removed. Press any key to continue.\n"; // Prints message to the screen
+    std::cout << "\nPress any key to continue.\n"; // Prints message to the screen
     system("pause>nul"); // Pauses so the user can see the output
     system("cls"); // Clear the console screen
-    system("del C:\\MODWIN\\apps.txt"); // Removes leftover apps text file
-    system("del C:\\MODWIN\\newapps.txt"); // Removes leftover newapps text file
-    ShowMenu();
+}
+
+// Function to print the outcome of a batch removal, one line per package followed by a summary counting 'noun',
+// e.g. "applications"
+void PrintBatchReport(const std::vector<ServicingBatchItem>& items, const char* noun) {
+    size_t removed = 0;
+    for (const auto& item : items) {
+        if (item.result.ok) {
+            std::cout << item.name << " removed.\n"; // Inform user of removal
+            removed++;
+        }
+        else {
+            std::cerr << "Failed to remove " << item.name << ": " << item.result.message << '\n'; // Prints DISM's error
+        }
+    }
+    std::cout << "\n" << removed << " of " << items.size() << " " << noun << " removed.\n"; // Prints the summary
 }
 
 // Function for the Add Application menu
@@ -516,18 +609,18 @@ void AddApp() {
     std::cin >> choice; // Read user's choice
     if (tolower(choice) == 'y') { // If user selects the yes option
         for (const auto& appPath : appFiles) { // Install all items
-            // Constructs Dism command to add application packages to the WIM
-            std::string addCommand = "dism /Image:C:\\MODWIN\\PATH /Add-ProvisionedAppxPackage /PackagePath:" + appPath + " /SkipLicense";
-            system(addCommand.c_str()); // Execute the command for each app
+            ServicingResult result = Servicing().AddProvisionedApp(appPath); // Adds the application package to the WIM without a license file
+            if (!result.ok) {
+                std::cerr << "Failed to add " << appPath << ": " << result.message << '\n'; // Prints DISM's error
+            }
         }
     }
     else { // If user selects anything other than 'y' or 'Y' 
-        Apps(); // Takes user back to the Application Menu
+        return; // Takes user back to the Application Menu
     }
     std::cout << "App(s) added. Press any key to continue.\n"; // Prints message to screen
     system("pause>nul"); // Pause the program
     system("cls"); // Clear the console screen
-    Apps(); // Takes user back to the Application Package Menu
 }
 
 // Function for the Packages Menu
@@ -539,169 +632,74 @@ void Packages() {
     std::cout << "\n1. Remove installed packages\n"; // Prints message to screen
     std::cout << "2. Remove all packages\n"; // Prints message to screen
     std::cout << "3. Install custom packages\n"; // Prints message to screen
-    std::cout << "4. Return to Main Menu\n"; // Prints message to screen
-    int choice; // Variable to store the user's menu selection
-    int validChoices[] = { 1, 2, 3, 4 }; // Allowed choices
-    int numberOfChoices = sizeof(validChoices) / sizeof(validChoices[0]); // Number of valid choices
-    while (true) { // Use a while loop to continuously prompt for input until a valid choice is made
-        std::cout << "\nType a number above and press enter: "; // Prints message to screen
-        if (!(std::cin >> choice)) { // Check if the input is not an integer
-            std::cout << "Invalid input. Please enter a number.\n"; // Prints message to screen
-            std::cin.clear(); // Clear the error state of the cin object
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore the rest of the current input line
-            continue; // Continue to the next iteration of the loop
-        }
-        bool isValidChoice = false; // Initialize a flag to track if the user's choice is valid
-        for (int i = 0; i < numberOfChoices; i++) { // Loop through all the valid choices to see if the user's choice matches one of them
-            if (choice == validChoices[i]) { // Check if the user's choice matches the current valid choice
-                isValidChoice = true; // If it matches, set isValidChoice to true
-                break; // Break out of the loop as we've found a valid choice
-            }
-        }
-        if (!isValidChoice) { // Not a valid choice
-            std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-        }
-        else {
-            break; // Exit the loop if a valid choice is made
-        }
-    }
-    switch (choice) { // Switch cases for the user selection, takes user to selected option
-    case 1:
-        RemovePackage();
-        break;
-    case 2:
-        RemoveAllPackages();
-        break;
-    case 3:
-        AddPackage();
-        break;
-    case 4:
-        system("cls"); // Clear the console screen
-        ShowMenu(); // Return to the main menu
-        break;
-    default:
-        std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-    }
+    std::cout << "4. Return to Main Menu\n\n"; // Prints message to screen
 }
 
 // Function for the Remove Package menu
 void RemovePackage() {
     system("cls"); // Clear the console screen
-    // Dism command to get the list of packages installed on the wim and save it to a text file
-    system("dism /Image:C:\\MODWIN\\PATH /Get-Packages > C:\\MODWIN\\packages.txt");
-    // Command to search packages.txt for lines containing 'Package Identity : ' and prints those to a new text file.
-    system("find \"Package Identity : \" C:\\MODWIN\\packages.txt > C:\\MODWIN\\newpackages.txt");
-    std::ifstream inFile("C:\\MODWIN\\newpackages.txt"); // Open the newpackages.txt file
-    if (!inFile) { // If the file fails to open
-        std::cerr << "Failed to open C:\\MODWIN\\newpackages.txt\n"; // Display error message
-        Packages(); // Take user back to packages
-    }
-    std::string line; // Declare a string to hold each line read from the file
-    while (std::getline(inFile, line)) { // Read lines from inFile one by one into 'line' until the end of the file is reached
-        size_t startPos = line.find("Package Identity : "); // Search for the start position of the substring "Package Identity : " in the line
-        if (startPos != std::string::npos) {
-            // If the substring is found, extract and print the part of the line following it
-            std::cout << line.substr(startPos + std::string("Package Identity : ").length()) << '\n';
-        }
+    PackageTable packages; // The packages of the WIM
+    if (!Servicing().ListPackages(packages)) { // Lists the packages of the mounted WIM
+        std::cerr << "Failed to list the packages in C:\\MODWIN\\PATH\n"; // Display error message
+        return;
+    }
+    for (uint32_t row : SortedByName(packages)) { // Lists the packages alphabetically
+        std::cout << packages.Name(row) << '\n'; // Print the package identity
     }
-    inFile.close(); // Close the file after reading all lines
     std::string packageName; // Declare a string to store the package name entered by the user
     std::cout << "\nCopy and paste a package from above to remove: "; // Prompt user to enter a package name
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Clear the input buffer before reading new input
     std::getline(std::cin, packageName); // Use getline to handle spaces in package names
-    // Constructs the Dism command to remove packages
-    std::string removeCommand = "dism /Image:C:\\MODWIN\\PATH /Remove-Package /PackageName:" + packageName;
-    system(removeCommand.c_str()); // Executes the command
-    std::cout << "Package removed. Press any key to continue.\n"; // Prints message to screen
+    ServicingResult result = Servicing().RemovePackage(packageName); // Removes the selected package
+    if (result.ok) {
+        std::cout << "Package removed. Press any key to continue.\n"; // Prints message to screen
+    }
+    else {
+        std::cerr << "Failed to remove package: " << packageName << ": " << result.message << "\nPress any key to continue.\n"; // Prints DISM's error
+    }
     system("pause>nul"); // Pause the program
     system("cls"); // Clear the console screen
-    system("del C:\\MODWIN\\newpackages.txt"); // Removes leftover newpackages text file
-    system("del C:\\MODWIN\\packages.txt"); // Removes leftover packages text file
-    Packages(); // Takes user back to the Packages Menu
 }
 
-// Function to remove all "safe" packages listed in newpackages.txt
+// Function to remove all "safe" packages of the mounted WIM
 void RemoveAllPackages() {
     system("cls"); // Clear the console screen
-    system("dism /Image:C:\\MODWIN\\PATH /Get-Packages > C:\\MODWIN\\packages.txt");
-    system("find \"Package Identity : \" C:\\MODWIN\\packages.txt > C:\\MODWIN\\newpackages.txt");
-
-    std::ifstream inFile("C:\\MODWIN\\newpackages.txt");
-    std::ofstream safeFile("C:\\MODWIN\\safe.txt");
-    if (!inFile) {
-        std::cerr << "Failed to open C:\\MODWIN\\newpackages.txt\n";
-        Packages();
-        return;
-    }
-    if (!safeFile) {
-        std::cerr << "Failed to open or create C:\\MODWIN\\safe.txt\n";
-        Packages();
+    PackageTable packages;
+    if (!Servicing().ListPackages(packages)) {
+        std::cerr << "Failed to list the packages in C:\\MODWIN\\PATH\n";
         return;
     }
 
-    std::vector<std::string> safePackagePrefixes = {
-        "Microsoft-OneCore-ApplicationModel",
-        "Microsoft-OneCore-DirectX",
-        "Microsoft-Windows-Hello",
-        "Microsoft-Windows-InternetExplorer",
-        "Microsoft-Windows-LanguageFeatures-Handwriting",
-        "Microsoft-Windows-LanguageFeatures-OCR",
-        "Microsoft-Windows-LanguageFeatures-Speech",
-        "Microsoft-Windows-LanguageFeatures-TextToSpeech",
-        "Microsoft-Windows-MSPaint",
-        "Microsoft-Windows-MediaPlayer",
-        "Microsoft-Windows-PowerShell",
-        "Microsoft-Windows-Printing",
-        "Microsoft-Windows-QuickAssist",
-        "Microsoft-Windows-StepsRecorder",
-        "Microsoft-Windows-TabletPCMath",
-        "Microsoft-Windows-WMIC",
-        "Microsoft-Windows-Wallpaper",
-        "Microsoft-Windows-WordPad",
-        "OpenSSH-Client-Package"
-    };
-
-    std::string line;
+    std::vector<std::string> safePackages;
     std::cout << "Identifying safe packages to remove...\n";
 
-    while (std::getline(inFile, line)) {
-        for (const auto& prefix : safePackagePrefixes) {
-            if (line.find(prefix) != std::string::npos) {
-                safeFile << line << '\n';
-                break;
-            }
+    for (size_t i = 0; i < packages.Size(); i++) {
+        if (packages.states[i] != ServicingState::Installed) {
+            continue; // Staged and superseded packages cannot be removed
+        }
+        if (packageRules.Classify(packages.Name(i)) == PackageVerdict::Remove) { // The longest matching rule decides
+            safePackages.push_back(std::string(packages.Name(i)));
         }
     }
 
-    inFile.close();
-    safeFile.close();
+    // Orders the removals from the package manifests, so no package is removed while another one still needs it
+    PackageRemovalPlan plan = PlanPackageRemoval("C:\\MODWIN\\PATH", safePackages);
+    for (const auto& packageIdentity : plan.cyclic) {
+        plan.batches.push_back({ packageIdentity }); // Packages depending on each other are tried one at a time
+    }
+    if (!plan.contained.empty()) {
+        std::cout << plan.contained.size() << " packages are removed along with the packages containing them.\n";
+    }
 
-    std::ifstream safePackagesFile("C:\\MODWIN\\safe.txt");
     std::cout << "Removing safe packages...\n";
-    while (std::getline(safePackagesFile, line)) {
-        size_t startPos = line.find("Package Identity : ");
-        if (startPos != std::string::npos) {
-            std::string packageIdentity = line.substr(startPos + std::string("Package Identity : ").length());
-            std::string removeCommand = "dism /Image:C:\\MODWIN\\PATH /Remove-Package /PackageName:" + packageIdentity;
-            if (system(removeCommand.c_str()) != 0) {
-                std::cerr << "Failed to remove package: " << packageIdentity << '\n';
-            }
-            else {
-                std::cout << "Removed package: " << packageIdentity << '\n';
-            }
-        }
+    for (size_t i = 0; i < plan.batches.size(); i++) {
+        std::cout << "Batch " << i + 1 << " of " << plan.batches.size() << " (" << plan.batches[i].size() << " packages)\n";
+        PrintBatchReport(Servicing().RemovePackages(plan.batches[i]), "packages"); // Removes the batch in one servicing pass and reports each package
     }
 
-    safePackagesFile.close();
-    std::cout << "\nAll safe packages have been removed. Press any key to continue.\n";
+    std::cout << "\nPress any key to continue.\n";
     system("pause>nul");
     system("cls");
-
-    system("del C:\\MODWIN\\newpackages.txt");
-    system("del C:\\MODWIN\\packages.txt");
-    system("del C:\\MODWIN\\safe.txt");
-
-    Packages();
 }
 
 void AddPackage() {
@@ -728,12 +726,10 @@ void AddPackage() {
             std::string fullPath = packagesDirectory + "\\" + packageName;
             std::ifstream file(fullPath);
             if (file) {
-                // Constructs Dism command to add packages to the WIM
-                std::string addCommand = "dism /Image:C:\\MODWIN\\PATH /Add-Package /PackagePath:\"" + fullPath + "\"";
-                std::cout << "Executing command: " << addCommand << std::endl;
-                int result = system(addCommand.c_str()); // Execute the command for each package
-                if (result != 0) {
-                    std::cout << "Error: DISM command failed with error code " << result << std::endl;
+                std::cout << "Adding package: " << fullPath << std::endl;
+                ServicingResult result = Servicing().AddPackage(fullPath); // Adds each package to the WIM through the open session
+                if (!result.ok) {
+                    std::cout << "Error: DISM failed with error code " << result.code << ": " << result.message << std::endl;
                 }
             }
             else {
@@ -743,14 +739,12 @@ void AddPackage() {
         }
     }
     else { // If user selects anything other than 'y' or 'Y'
-        Packages(); // Takes the user back to the Package Menu
         return; // Exit the function
     }
 
     std::cout << "\nPackage(s) added. Press any key to continue.\n"; // Prints message to screen
     system("pause>nul"); // Pause the program
     system("cls"); // Clear the console screen
-    Packages(); // Takes the user back to the Package Menu
 }
 
 
@@ -763,239 +757,108 @@ void Features() {
     std::cout << "\n1. Disable Features\n";
     std::cout << "2. Disable All Features\n";
     std::cout << "3. Enable Features\n";
-    std::cout << "4. Return to Main Menu\n";
-    int choice; // Variable to store the user's menu selection
-    int validChoices[] = { 1, 2, 3, 4 }; // Allowed choices
-    int numberOfChoices = sizeof(validChoices) / sizeof(validChoices[0]); // Number of valid choices
-    while (true) { // Use a while loop to continuously prompt for input until a valid choice is made
-        std::cout << "\nType a number above and press enter: "; // Prints message to screen
-        if (!(std::cin >> choice)) { // Check if the input is not an integer
-            std::cout << "Invalid input. Please enter a number.\n"; // Prints message to screen
-            std::cin.clear(); // Clear the error state of the cin object
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore the rest of the current input line
-            continue; // Continue to the next iteration of the loop
-        }
-        bool isValidChoice = false; // Initialize a flag to track if the user's choice is valid
-        for (int i = 0; i < numberOfChoices; i++) { // Loop through all the valid choices to see if the user's choice matches one of them
-            if (choice == validChoices[i]) { // Check if the user's choice matches the current valid choice
-                isValidChoice = true; // If it matches, set isValidChoice to true
-                break; // Break out of the loop as we've found a valid choice
-            }
-        }
-        if (!isValidChoice) { // Not a valid choice
-            std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-        }
-        else {
-            break; // Exit the loop if a valid choice is made
-        }
-    }
-    switch (choice) { // Switch cases for user selection, takes user to selected menu
-    case 1:
-        RemoveFeature(); // Takes user to the RemoveFeature menu
-        break;
-    case 2:
-        RemoveAllFeatures(); // Takes user to the RemoveAllFeatures menu
-        break;
-    case 3:
-        EnableFeature(); // Takes user to the EnableFeature menu
-        break;
-    case 4:
-        system("cls"); // Clear the console screen
-        ShowMenu(); // Takes user back to Main Menu
-        break;
-    default:
-        std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-    }
+    std::cout << "4. Return to Main Menu\n\n";
 }
 
 // Function that provides a menu to allow user to remove features
 void RemoveFeature() {
     system("cls"); // Clear the console screen
-    system("Dism /Image:C:\\MODWIN\\PATH /Get-Features /Format:Table > C:\\MODWIN\\features.txt");
-    system("findstr \"Enabled\" C:\\MODWIN\\features.txt > C:\\MODWIN\\enabledFeatures.txt");
-
-    std::ifstream inFile("C:\\MODWIN\\enabledFeatures.txt");
-    if (!inFile) {
-        std::cerr << "Failed to open C:\\MODWIN\\enabledFeatures.txt\n";
-        Features();
+    FeatureTable features;
+    if (!Servicing().ListFeatures(features)) {
+        std::cerr << "Failed to list the features in C:\\MODWIN\\PATH\n";
         return;
     }
 
-    std::string line;
     std::cout << "=========================\n";
     std::cout << "List of Enabled Features:\n";
     std::cout << "=========================\n";
-    while (std::getline(inFile, line)) {
-        // Skip header lines
-        if (line.find("Version") != std::string::npos ||
-            line.find("Features listing for package") != std::string::npos) {
-            continue;
+    for (uint32_t row : SortedByName(features)) {
+        if (features.states[row] == ServicingState::Installed) {
+            std::cout << features.Name(row) << '\n';
         }
-
-        // Remove "| Enabled"
-        size_t enabledPos = line.find("| Enabled");
-        if (enabledPos != std::string::npos) {
-            line.erase(enabledPos, std::string("| Enabled").length());
-        }
-
-        // Trim leading and trailing spaces from the line
-        line.erase(0, line.find_first_not_of(" \t")); // Leading spaces
-        line.erase(line.find_last_not_of(" \t") + 1); // Trailing spaces
-
-        std::cout << line << '\n';
     }
 
-    inFile.close();
-
     std::string featureName;
     std::cout << "\nEnter the feature name to disable: ";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore characters in the input buffer up to the maximum stream size or until a newline character is encountered.
     std::getline(std::cin, featureName); // Use getline to handle spaces in feature names
-    // Construct and execute the Dism command to disable the feature
-    std::string removeCommand = "Dism /Image:C:\\MODWIN\\PATH /Disable-Feature /FeatureName:" + featureName;
-    system(removeCommand.c_str()); // Executes the command
-    std::cout << "\nFeature disabled. Press any key to continue.\n"; // Prints to screen
+    ServicingResult result = Servicing().DisableFeature(featureName); // Disables the feature
+    if (result.ok) {
+        std::cout << "\nFeature disabled. Press any key to continue.\n"; // Prints to screen
+    }
+    else {
+        std::cerr << "\nFailed to disable " << featureName << ": " << result.message << "\nPress any key to continue.\n"; // Prints DISM's error
+    }
     system("pause>nul"); // Pauses
     system("cls"); // Clear the console screen
-    std::remove("C:\\MODWIN\\features.txt"); // Removes the features text file
-    std::remove("C:\\MODWIN\\enabledFeatures.txt"); // Removes the enabledFeatures text file
-    Features(); // Returns user to Features menu
 }
 // Function that provides a menu to allow user to remove all features
 void RemoveAllFeatures() {
     system("cls"); // Clear the console screen
-    // Run DISM command and output to a text file
-    system("Dism /Image:C:\\MODWIN\\PATH /Get-Features /Format:Table > C:\\MODWIN\\features.txt");
-    // Extract only the lines that contain "Enabled" to a new file
-    system("findstr /c:\"Enabled\" C:\\MODWIN\\features.txt > C:\\MODWIN\\enabledFeatures.txt");
-
-    std::ifstream inFile("C:\\MODWIN\\enabledFeatures.txt");
-    if (!inFile) {
-        std::cerr << "Failed to open C:\\MODWIN\\enabledFeatures.txt\n";
-        Features(); // Return to the features menu if the file can't be opened
+    FeatureTable features;
+    if (!Servicing().ListFeatures(features)) {
+        std::cerr << "Failed to list the features in C:\\MODWIN\\PATH\n";
         return;
     }
 
-    std::string line;
     std::cout << "Disabling all enabled features...\n";
 
-    // Read each line from the file
-    while (std::getline(inFile, line)) {
-        // Skip header lines
-        if (line.find("Feature Name") != std::string::npos ||
-            line.find("State") != std::string::npos ||
-            line.find("----") != std::string::npos ||
-            line.find("Deployment Image Servicing and Management tool") != std::string::npos) {
-            continue; // Skip the current iteration
+    for (uint32_t row : SelectRows(features, [&](uint32_t i) { return features.states[i] == ServicingState::Installed; })) {
+        std::string featureName(features.Name(row));
+        ServicingResult result = Servicing().DisableFeature(featureName);
+        if (result.ok) {
+            std::cout << "Disabled feature: " << featureName << '\n';
         }
-
-        // Remove all occurrences of the vertical bar and "Enabled"
-        line.erase(std::remove(line.begin(), line.end(), '|'), line.end());
-        size_t enabledPos = line.find("Enabled");
-        if (enabledPos != std::string::npos) {
-            line.erase(enabledPos, std::string("Enabled").length());
-        }
-
-        // Trim leading and trailing whitespace
-        line.erase(0, line.find_first_not_of(" \t"));
-        line.erase(line.find_last_not_of(" \t") + 1);
-
-        if (!line.empty()) {
-            // Construct and execute the DISM command to disable the feature
-            std::string disableCommand = "Dism /Image:C:\\MODWIN\\PATH /Disable-Feature /FeatureName:" + line;
-            system(disableCommand.c_str());
-            std::cout << "Disabled feature: " << line << '\n';
+        else {
+            std::cerr << "Failed to disable feature: " << featureName << " (" << result.message << ")\n";
         }
     }
 
-    inFile.close(); // Close the file stream
-
     std::cout << "\nAll features have been disabled. Press any key to continue.\n";
     system("pause>nul"); // Pause the console without displaying any message
     system("cls"); // Clear the console screen after resuming
-
-    // Cleanup by deleting the temporary text files
-    std::remove("C:\\MODWIN\\features.txt");
-    std::remove("C:\\MODWIN\\enabledFeatures.txt");
-
-    Features(); // Return to the features menu
 }
 
 
 // Function to Enable Features on the WIM
 void EnableFeature() {
     system("cls"); // Clear the console screen
-    // Run DISM command and output to a text file
-    system("Dism /Image:C:\\MODWIN\\PATH /Get-Features /Format:Table > C:\\MODWIN\\features.txt");
-    // Extract only the lines that contain "Disabled" to a new file
-    system("findstr /c:\"Disabled\" C:\\MODWIN\\features.txt > C:\\MODWIN\\disabledFeatures.txt");
-
-    std::ifstream inFile("C:\\MODWIN\\disabledFeatures.txt");
-    if (!inFile) {
-        std::cerr << "Failed to open C:\\MODWIN\\disabledFeatures.txt\n";
-        ShowMenu(); // Return to the menu if the file can't be opened
+    FeatureTable features;
+    if (!Servicing().ListFeatures(features)) {
+        std::cerr << "Failed to list the features in C:\\MODWIN\\PATH\n";
         return;
     }
 
-    std::string line;
     std::cout << "==========================\n";
     std::cout << "List of Disabled Features:\n";
     std::cout << "==========================\n";
 
-    while (std::getline(inFile, line)) {
-        // Check for unwanted lines and phrases and skip them
-        if (line.find("Feature Name") != std::string::npos ||
-            line.find("State") != std::string::npos ||
-            line.find("----") != std::string::npos ||
-            line.find("Deployment Image Servicing and Management tool") != std::string::npos ||
-            line.find("with Payload Removed") != std::string::npos) {
-            continue; // Skip the current iteration
-        }
-
-        // Remove all occurrences of the vertical bar
-        line.erase(std::remove(line.begin(), line.end(), '|'), line.end());
-
-        // Remove the word "Disabled" from the line if present
-        size_t disabledPos = line.find("Disabled");
-        if (disabledPos != std::string::npos) {
-            line.replace(disabledPos, std::string("Disabled").length(), ""); // Replace with empty string
-        }
-
-        // Trim leading and trailing whitespace
-        line.erase(0, line.find_first_not_of(" \t"));
-        line.erase(line.find_last_not_of(" \t") + 1);
-
-        if (!line.empty()) {
-            std::cout << line << '\n'; // Print the line if it's not empty
+    for (uint32_t row : SortedByName(features)) {
+        if (features.states[row] == ServicingState::Staged) { // Features with their payload removed cannot be enabled offline, so they are left out
+            std::cout << features.Name(row) << '\n';
         }
     }
 
-    inFile.close(); // Close the file stream
-
     std::string featureName;
     std::cout << "\nEnter the feature name to enable: ";
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Clear the input buffer
     std::getline(std::cin, featureName); // Get the user input for the feature name
 
-    // Construct and execute the DISM command to enable the feature
-    std::string enableCommand = "Dism /Image:C:\\MODWIN\\PATH /Enable-Feature /FeatureName:" + featureName;
-    system(enableCommand.c_str()); // Execute the command
-
-    std::cout << "\nFeature enabled. Press any key to continue.\n";
+    ServicingResult result = Servicing().EnableFeature(featureName); // Enables the feature
+    if (result.ok) {
+        std::cout << "\nFeature enabled. Press any key to continue.\n";
+    }
+    else {
+        std::cerr << "\nFailed to enable " << featureName << ": " << result.message << "\nPress any key to continue.\n"; // Prints DISM's error
+    }
     system("pause>nul"); // Pause the console without displaying any message
     system("cls"); // Clear the console screen after resuming
-
-    // Cleanup by deleting the temporary text files
-    std::remove("C:\\MODWIN\\features.txt");
-    std::remove("C:\\MODWIN\\disabledFeatures.txt");
-
-    Features(); // Return to the features menu
 }
 
 
 
-// Function for the WIM Registry Hive Menu
-void MountWIMRegistry() {
+// Function to check the WIM is mounted before the WIM Registry Hive Menu is shown
+bool RegistryMounted() {
     // Check if C:\MODWIN\PATH\Windows exists
     if (!DirectoryExists("C:\\MODWIN\\PATH\\Windows")) { // If PATH/Windows does Not exist
         system("cls"); // Clear the console screen
@@ -1003,8 +866,13 @@ void MountWIMRegistry() {
         std::cout << "Press any key to return to the main menu.\n"; // Prints message to screen
         system("pause>nul"); // Pause the program
         system("cls"); // Clear the console screen
-        ShowMenu(); // Returns user to Main Menu
+        return false; // Keeps the user in the Main Menu
     }
+    return true;
+}
+
+// Function for the WIM Registry Hive Menu
+void MountWIMRegistry() {
     system("cls"); // Clear the console screen
     std::cout << "======================\n"; // Prints message to screen
     std::cout << "WIM Registry Hive Menu\n"; // Prints message to screen
@@ -1014,59 +882,27 @@ void MountWIMRegistry() {
     std::cout << "Press 3 to open the DEFAULT Registry Hive\n"; // Prints message to screen
     std::cout << "Press 4 to open the DRIVERS Registry Hive\n"; // Prints message to screen
     std::cout << "Press 5 to open the SAM Registry Hive\n"; // Prints message to screen
-    std::cout << "Press 6 to return to the main MENU\n"; // Prints message to screen
-    std::cout << "\nType a number and press enter: "; // Prints message to screen
-    int choice; // Variable to store the user's menu selection
-    int validChoices[] = { 1, 2, 3, 4, 5, 6 }; // Allowed choices
-    int numberOfChoices = sizeof(validChoices) / sizeof(validChoices[0]); // Number of valid choices
-    while (true) { // Use a while loop to continuously prompt for input until a valid choice is made
-        std::cout << "Type a number above and press enter: "; // Prints message to screen
-        if (!(std::cin >> choice)) { // Check if the input is not an integer
-            std::cout << "Invalid input. Please enter a number.\n"; // Prints message to screen
-            std::cin.clear(); // Clear the error state of the cin object
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore the rest of the current input line
-            continue; // Continue to the next iteration of the loop
-        }
-        bool isValidChoice = false; // Initialize a flag to track if the user's choice is valid
-        for (int i = 0; i < numberOfChoices; i++) { // Loop through all the valid choices to see if the user's choice matches one of them
-            if (choice == validChoices[i]) { // Check if the user's choice matches the current valid choice
-                isValidChoice = true; // If it matches, set isValidChoice to true
-                break; // Break out of the loop as we've found a valid choice
-            }
-        }
-        if (!isValidChoice) { // Not a valid choice
-            std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-        }
-        else {
-            break; // Exit the loop if a valid choice is made
-        }
-    }
-    switch (choice) { // Switch case for user selection, takes user to selected menu
-    case 1:
-        OpenRegistryHive("SYSTEM");
-        break;
-    case 2:
-        OpenRegistryHive("SOFTWARE");
-        break;
-    case 3:
-        OpenRegistryHive("DEFAULT");
-        break;
-    case 4:
-        OpenRegistryHive("DRIVERS");
-        break;
-    case 5:
-        OpenRegistryHive("SAM");
-        break;
-    case 6:
-        system("cls"); // Clear the console screen
-        ShowMenu(); // Return to the main menu
-    default:
-        std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-    }
+    std::cout << "Press 6 to apply the .reg tweak files in C:\\MODWIN\\TWEAKS\n"; // Prints message to screen
+    std::cout << "Press 7 to search all Registry Hives of the WIM\n"; // Prints message to screen
+    std::cout << "Press 8 to return to the main MENU\n\n"; // Prints message to screen
 }
 
 // Function for the WIM Registry Hive Menu
 void OpenRegistryHive(const std::string& hiveName) {
+    system("cls"); // Clear the console screen
+    std::cout << "Press 1 to edit the " << hiveName << " hive in MODWIN\n"; // Prints message to screen
+    std::cout << "Press 2 to open the " << hiveName << " hive in Registry Editor\n"; // Prints message to screen
+    std::cout << "\nType a number and press enter: "; // Prints message to screen
+    int choice = 0; // Variable to store the user's menu selection
+    while (!(std::cin >> choice) || (choice != 1 && choice != 2)) { // Prompts until 1 or 2 is typed
+        std::cin.clear(); // Clear the error state of the cin object
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore the rest of the current input line
+        std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
+    }
+    if (choice == 1) {
+        EditRegistryHive(hiveName); // Edits the hive file directly, without loading it into the registry
+        return;
+    }
     // Load the registry hive
     std::string command = "reg load HKLM\\OFFLINE C:\\MODWIN\\PATH\\Windows\\System32\\Config\\" + hiveName;
     system(command.c_str());
@@ -1079,11 +915,115 @@ void OpenRegistryHive(const std::string& hiveName) {
     UnloadRegistryHive(); // Starts the UnloadRegistryHive function
 }
 
+// Function to browse and edit a hive of the WIM from the console, reading and writing the hive file itself
+void EditRegistryHive(const std::string& hiveName) {
+    RegistryHive hive;
+    if (!hive.Open("C:\\MODWIN\\PATH\\Windows\\System32\\Config\\" + hiveName)) {
+        std::cout << "Press any key to continue.\n"; // Prints message to screen
+        system("pause>nul"); // Pause the program
+        return;
+    }
+    std::string keyPath; // Path of the current key below the root of the hive
+    std::string line;
+    std::getline(std::cin, line); // Drops the rest of the menu input
+    while (true) {
+        system("cls"); // Clear the console screen
+        uint32_t key = hive.OpenKey(keyPath);
+        std::cout << hiveName << "\\" << keyPath << (hive.Modified() ? "  (not saved)" : "") << "\n\n";
+        for (uint32_t subkey : hive.Subkeys(key)) {
+            std::cout << "  [" << hive.KeyName(subkey) << "]\n"; // Prints each subkey
+        }
+        for (uint32_t value : hive.Values(key)) {
+            std::string name = hive.ValueName(value);
+            std::cout << "  " << (name.empty() ? "(Default)" : name) << " = " << FormatHiveValue(hive, value) << '\n'; // Prints each value
+        }
+        std::cout << "\nCommands: cd <key> | cd .. | mkdir <key> | set <name> dword|qword|sz|expand_sz <data> | del <name> | save | exit\n> ";
+        if (!std::getline(std::cin, line)) {
+            break;
+        }
+        std::istringstream words(line);
+        std::string command, name;
+        words >> command >> name;
+        if (command == "cd" && name == "..") {
+            size_t slash = keyPath.find_last_of('\\');
+            keyPath = slash == std::string::npos ? "" : keyPath.substr(0, slash);
+        }
+        else if (command == "cd" && !name.empty()) {
+            std::getline(words, line); // Key names may contain spaces
+            std::string childPath = (keyPath.empty() ? "" : keyPath + "\\") + name + line;
+            if (hive.OpenKey(childPath) != HIVE_NO_CELL) {
+                keyPath = childPath;
+            }
+        }
+        else if (command == "mkdir" && !name.empty()) {
+            std::getline(words, line);
+            hive.CreateKey(key, name + line);
+        }
+        else if (command == "set" && !name.empty()) {
+            std::string type, text;
+            words >> type;
+            std::getline(words >> std::ws, text);
+            if (type == "dword" || type == "qword") {
+                uint64_t number = std::strtoull(text.c_str(), nullptr, 0); // Decimal, or hex with 0x
+                uint8_t bytes[8];
+                for (int i = 0; i < 8; i++) bytes[i] = static_cast<uint8_t>(number >> (8 * i));
+                hive.SetValue(key, name, type == "dword" ? HIVE_REG_DWORD : HIVE_REG_QWORD, bytes, type == "dword" ? 4 : 8);
+            }
+            else if (type == "sz" || type == "expand_sz") {
+                std::vector<uint8_t> bytes = EncodeHiveString(text);
+                hive.SetValue(key, name, type == "sz" ? HIVE_REG_SZ : HIVE_REG_EXPAND_SZ, bytes.data(), bytes.size());
+            }
+        }
+        else if (command == "del" && !name.empty()) {
+            hive.DeleteValue(key, name);
+        }
+        else if (command == "save") {
+            if (hive.Save()) {
+                std::cout << "Saved " << hiveName << ". Press any key to continue.\n"; // Prints message to screen
+            }
+            system("pause>nul"); // Pause the program
+        }
+        else if (command == "exit") {
+            break;
+        }
+    }
+    system("cls"); // Clear the console screen
+    if (hive.Modified()) {
+        std::cout << "Changes to " << hiveName << " were not saved.\n"; // Prints message to screen
+    }
+}
+
+// Function to search the key paths, value names and optionally the value data of every hive of the WIM
+void SearchRegistry() {
+    system("cls"); // Clear the console screen
+    std::cout << "Also search the text data of values? Indexing takes longer and uses more memory. (y/n): "; // Prints message to screen
+    std::string answer;
+    std::cin >> answer;
+    std::string line;
+    std::getline(std::cin, line); // Drops the rest of the input
+    std::cout << "Indexing the Registry Hives of the WIM...\n"; // Prints message to screen
+    RegistrySearchIndex index; // Built once, then every search reuses it
+    std::vector<std::string> hiveNames(std::begin(REGISTRY_SEARCH_HIVES), std::end(REGISTRY_SEARCH_HIVES));
+    if (!index.Build("C:\\MODWIN\\PATH\\Windows\\System32\\Config", hiveNames, answer == "y" || answer == "Y")) {
+        std::cout << "No Registry Hive could be read. Press any key to continue.\n"; // Prints message to screen
+        system("pause>nul"); // Pause the program
+        return;
+    }
+    std::cout << "Indexed " << index.KeyCount() << " keys and " << index.ValueCount() << " values in " << index.BuildSeconds() << " s.\n"; // Prints message to screen
+    while (true) {
+        std::cout << "\nSearch for (press enter to return): "; // Prints message to screen
+        if (!std::getline(std::cin, line) || line.empty()) {
+            break;
+        }
+        PrintRegistrySearchResult(index.Find(line, 50)); // Lists the first 50 keys and values containing the text
+    }
+    system("cls"); // Clear the console screen
+}
+
 // Function to Unload the WIM's registry hive when user closes regedit
 void UnloadRegistryHive() {
     system("reg unload HKLM\\OFFLINE"); // Command to execute the registry unload
     system("cls"); // Clear the console screen
-    MountWIMRegistry(); // Returns user to the WIM Registry menu
 }
 
 // Function to push the /Contents/ of the USER folder in MODWIN to the C:\ on the WIM. So pack USER like it is the C folder
@@ -1092,11 +1032,17 @@ void PushUserFolderToWIM() {
     std::cout << "=================================\n"; // Prints message to screen
     std::cout << "Copying the USER folder to WIM...\n"; // Print message to screen
     std::cout << "=================================\n"; // Prints message to screen
-    system("xcopy C:\\MODWIN\\USER C:\\MODWIN\\PATH /h /i /c /k /e /r /y"); // Execute the xcopy command to copy the files
+    FolderPushStats stats; // Files copied and skipped, filled in by PushFolder
+    PushFolder("C:\\MODWIN\\USER", "C:\\MODWIN\\PATH", "C:\\MODWIN\\BIN\\USER.manifest", stats); // Copies what changed since the last push
+    std::cout << "Copied " << stats.copied << " files (" << stats.bytesCopied / (1024 * 1024) << " MB), linked " << stats.linked
+        << " duplicates (" << stats.bytesLinked / (1024 * 1024) << " MB), " << stats.skipped << " unchanged files skipped, in "
+        << stats.seconds << " s.\n"; // Print message to screen
+    if (stats.failed > 0) {
+        std::cout << stats.failed << " files could not be copied.\n"; // Print message to screen
+    }
     std::cout << "Copy operation completed. Press any key to continue.\n"; // Print message to screen
     system("pause>nul"); // Pause the program
     system("cls"); // Clear the console screen
-    ShowMenu(); // Return to the main menu
 }
 
 // Function for the Unmount WIM and Build ISO menu
@@ -1109,51 +1055,7 @@ void BuildOptions() {
     std::cout << "2. Unmount WIM and Discard Changes (if you make a mistake)\n";  // Print message to screen
     std::cout << "3. Unmount WIM Only and Save Changes (Keeps WIM in WIM format)\n";  // Print message to screen
     std::cout << "4. Build ISO Only\n";  // Print message to screen
-    std::cout << "5. Add Unattend Support\n";  // Print new option message to screen
-    int choice; // Variable to store the user's menu selection
-    int validChoices[] = { 1, 2, 3, 4, 5 }; // Allowed choices
-    int numberOfChoices = sizeof(validChoices) / sizeof(validChoices[0]); // Number of valid choices
-    while (true) { // Use a while loop to continuously prompt for input until a valid choice is made
-        std::cout << "\nType a number above and press enter: ";  // Print message to screen
-        if (!(std::cin >> choice)) { // Check if the input is not an integer
-            std::cout << "Invalid input. Please enter a number.\n";  // Print message to screen
-            std::cin.clear(); // Clear the error state of the cin object
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore the rest of the current input line
-            continue; // Continue to the next iteration of the loop
-        }
-        bool isValidChoice = false; // Initialize a flag to track if the user's choice is valid
-        for (int i = 0; i < numberOfChoices; i++) { // Loop through all the valid choices to see if the user's choice matches one of them
-            if (choice == validChoices[i]) { // Check if the user's choice matches the current valid choice
-                isValidChoice = true; // If it matches, set isValidChoice to true
-                break; // Break out of the loop as we've found a valid choice
-            }
-        }
-        if (!isValidChoice) { // Not a valid choice
-            std::cout << "Invalid option. Please try again.\n"; // Prints message to the screen
-        }
-        else {
-            break; // Exit the loop if a valid choice is made
-        }
-    }
-    switch (choice) {
-    case 1:
-        SaveChanges();
-        break;
-    case 2:
-        DiscardChanges();
-        break;
-    case 3:
-        UnmountWIM();
-        break;
-    case 4:
-        BuildISO();
-        break;
-    case 5:
-        AddUnattendSupport();
-        break;
-    default:
-        std::cout << "Invalid option. Please try again.\n"; // Prints message to screen
-    }
+    std::cout << "5. Add Unattend Support\n\n";  // Print new option message to screen
 }
 
 // This function adds unattended support to an ISO, modifying certain files and handling user inputs.
@@ -1169,14 +1071,13 @@ void AddUnattendSupport() {
     fs::path sourceDir = "C:\\MODWIN\\BIN";
     fs::path targetDir = "C:\\MODWIN\\ISO";
 
-    // List of files to copy from source to target directory
-    std::vector<std::string> filesToCopy = {
-        "TPM_fix.cmd",
-        "autounattend.xml"
-    };
+    // Payloads to copy from source to target directory
+    const std::vector<Payload> filesToCopy = { Payload::TPM_fix_cmd, Payload::autounattend_xml };
+    UnpackPayloads(filesToCopy, sourceDir); // Unpacks the files from MODWIN in parallel the first time they are needed, or again when they are stale
 
     // Iterate through each file in the list to copy it
-    for (const auto& fileName : filesToCopy) {
+    for (Payload payload : filesToCopy) {
+        std::string fileName = PayloadInfo(payload).name;
         fs::path sourceFile = sourceDir / fileName;
         fs::path targetFile = targetDir / fileName;
 
@@ -1215,7 +1116,7 @@ void AddUnattendSupport() {
     case 2: windowsVersion = "Windows 10 Pro"; break;
     case 3: windowsVersion = "Windows 11 Home"; break;
     case 4: windowsVersion = "Windows 11 Pro"; break;
-    default: std::cerr << "Invalid choice. Exiting."; return;
+    default: std::cerr << "Invalid choice. Returning to the main menu.\n"; return;
     }
 
     // Prompt user for additional information
@@ -1229,7 +1130,7 @@ void AddUnattendSupport() {
     std::getline(std::cin, password);
 
     // Define the full path to the XML file to modify
-    std::string xmlFilePath = (targetDir / "autounattend.xml").string();
+    std::string xmlFilePath = (targetDir / PayloadInfo(Payload::autounattend_xml).name).string();
 
     // Attempt to open the XML file for modification
     std::ifstream fileIn(xmlFilePath);
@@ -1282,7 +1183,6 @@ void AddUnattendSupport() {
 
     // Clear the console screen and show the main menu
     system("cls");
-    ShowMenu(); 
 }
 
 // Function to Unmount the WIM while saving all changes made to the WIM
@@ -1291,11 +1191,28 @@ void SaveChanges() {
     std::cout << "==============================================================\n";  // Print message to screen
     std::cout << "Saving Changes to the WIM, Cleaning Up, and Compressing to ESD\n";  // Print message to screen
     std::cout << "==============================================================\n";  // Print message to screen
+    CloseServicing(); // DISM cannot clean up or unmount the image while MODWIN holds a session on it
     system("dism /Image:\"C:\\MODWIN\\PATH\" /cleanup-image /StartComponentCleanup /ResetBase"); // Used to reduce the size of the component store.
     system("dism /Unmount-Image /MountDir:\"C:\\MODWIN\\PATH\" /Commit"); // Dism command to unmount the WIM and Save the changes
-    // Dism command to compress the WIM into an ESD 
-    system("dism /export-image /SourceImageFile:\"C:\\MODWIN\\ISO\\sources\\install.wim\" /SourceIndex:1 /DestinationImageFile:\"C:\\MODWIN\\ISO\\sources\\install.esd\" /Compress:recovery /CheckIntegrity");
-    system("del \"C:\\MODWIN\\ISO\\sources\\install.wim\""); // Deletes the old install.wim 
+    // Compresses the WIM into a solid LZMS ESD on every CPU core, reading, compressing and writing at the same time
+    WimExportStats esdStats;
+    bool compressed = ExportWimImageToEsd("C:\\MODWIN\\ISO\\sources\\install.wim", 1, "C:\\MODWIN\\ISO\\sources\\install.esd", esdOptions, &esdStats);
+    if (compressed) {
+        double mbPerSecond = esdStats.seconds > 0 ? esdStats.bytesProcessed / (1024.0 * 1024.0) / esdStats.seconds : 0.0;
+        double ratio = esdStats.bytesProcessed ? 100.0 * esdStats.bytesWritten / esdStats.bytesProcessed : 0.0;
+        std::cout << "Compressed " << esdStats.bytesProcessed / (1024 * 1024) << " MB to " << esdStats.bytesWritten / (1024 * 1024) << " MB (" << static_cast<int>(ratio) << "%) in " << static_cast<int>(esdStats.seconds) << " seconds (" << static_cast<int>(mbPerSecond) << " MB/s, " << esdStats.threads << " threads, " << esdOptions.solidChunkSize / (1024 * 1024) << " MB blocks)\n";
+    }
+    else { // Falls back to DISM if the native compression could not handle this WIM
+        compressed = system("dism /export-image /SourceImageFile:\"C:\\MODWIN\\ISO\\sources\\install.wim\" /SourceIndex:1 /DestinationImageFile:\"C:\\MODWIN\\ISO\\sources\\install.esd\" /Compress:recovery /CheckIntegrity") == 0;
+    }
+    if (compressed && fs::is_regular_file("C:\\MODWIN\\ISO\\sources\\install.esd")) {
+        system("del \"C:\\MODWIN\\ISO\\sources\\install.wim\""); // Deletes the old install.wim 
+    }
+    else { // The ISO can still be built from install.wim
+        std::error_code removeError;
+        fs::remove("C:\\MODWIN\\ISO\\sources\\install.esd", removeError); // Drops whatever a failed compression left behind
+        std::cerr << "\nError: The image could not be compressed to install.esd, install.wim was kept.\n";
+    }
     std::cout << "\n"; // Adds a new line for aesthetics
     system("pause"); // Wait for user to return and press any key
     BuildISO(); // Takes user to the build iso menu
@@ -1314,27 +1231,22 @@ void BuildISO() {
 
     std::string isoFilePath = "C:\\MODWIN\\MOD\\" + isoFileName + ".iso";
 
-    // Build the xorriso command
-    std::string xorrisoCommand = R"(C:\MODWIN\BIN\xorriso\xorriso )";
-    xorrisoCommand += "-as mkisofs ";
-    xorrisoCommand += "-iso-level 3 "; // Using ISO Level 3 for large file support
-    xorrisoCommand += "-R ";
-    xorrisoCommand += "-D ";
-    xorrisoCommand += "-b efi/microsoft/boot/efisys_noprompt.bin ";
-    xorrisoCommand += "-e efi/microsoft/boot/efisys_noprompt.bin ";
-    xorrisoCommand += "-no-emul-boot ";
-    xorrisoCommand += "-boot-load-size 4 ";
-    xorrisoCommand += "-o " + isoFilePath + " ";
-    xorrisoCommand += "/cygdrive/c/MODWIN/ISO"; // Adjusted path for Cygwin
-
-    system(xorrisoCommand.c_str());
+    // Build the ISO natively: ISO 9660 level 3 (large file support), Joliet and UDF trees, booting UEFI from efisys_noprompt.bin
+    IsoBuildOptions isoOptions;
+    IsoBuildStats isoStats;
+    if (BuildIsoImage("C:\\MODWIN\\ISO", isoFilePath, isoOptions, &isoStats)) {
+        double mbPerSecond = isoStats.seconds > 0 ? isoStats.imageBytes / (1024.0 * 1024.0) / isoStats.seconds : 0.0;
+        std::cout << "Wrote " << isoStats.files << " files in " << isoStats.directories << " folders (" << isoStats.imageBytes / (1024 * 1024) << " MB) in " << static_cast<int>(isoStats.seconds) << " seconds (" << static_cast<int>(mbPerSecond) << " MB/s)\n";
+    }
+    else {
+        std::cout << "Error: The ISO could not be built, check that C:\\MODWIN\\ISO holds your Windows files.\n";
+    }
     std::cout << "============================================\n";
     std::cout << "Check " << isoFilePath << " to find your ISO\n";
     std::cout << "============================================\n";
     system("explorer C:\\MODWIN\\MOD");
     system("pause");
     system("cls");
-    ShowMenu(); // Return to the main menu
 }
 
 // Function to unmount the WIM, discard changes, and clean-up the mount path
@@ -1343,11 +1255,11 @@ void DiscardChanges() {
     std::cout << "================================================\n"; // Print message to scree
     std::cout << "Unmounting and discarding the changes to the WIM\n"; // Print message to screen
     std::cout << "================================================\n"; // Print message to screen
+    CloseServicing(); // DISM cannot unmount the image while MODWIN holds a session on it
     system("dism /Cleanup-mountpoints"); // DISM command to cleanup the mount points
     system("dism /Unmount-Image /MountDir:\"C:\\MODWIN\\PATH\" /discard"); // DISM command to discard the changes to the WIM 
     system("pause"); // Wait for user to press any key
     system("cls"); // Clear the console screen
-    ShowMenu(); // Takes user back to the Main Menu
 }
 
 // Function to unmount the WIM, Cleanup, and Save
@@ -1356,10 +1268,10 @@ void UnmountWIM() {
     std::cout << "=======================================================\n"; // Print message to scree
     std::cout << "Unmounting the Wim, Cleaning Up, and Saving the changes\n"; // Print message to screen
     std::cout << "=======================================================\n"; // Print message to screen
+    CloseServicing(); // DISM cannot clean up or unmount the image while MODWIN holds a session on it
     system("dism /Image:\"C:\\MODWIN\\PATH\" /cleanup-image /StartComponentCleanup /ResetBase"); // Used to reduce the size of the component store.
     system("dism /Unmount-Image /MountDir:\"C:\\MODWIN\\PATH\" /Commit"); // Unmounts the WIM and Saves the changes
     system("cls"); // Clear the console screen
-    ShowMenu(); // Takes user back to the Main Menu
 }
 
 // Credits function
@@ -1372,7 +1284,7 @@ void Credits() {
     std::cout << "\nThe first thanks goes to Persona78, we learned how to build the iso in Oscdimg.exe originally  \n"; // Print message to screen
     std::cout << "\nThanks also goes to james28909, P414DIN, knigge111, Indospot, Xazac, elong7681 and Ro Kappa\n"; // Print message to screen
     std::cout << "a lot of bugs were worked out and features added to MODWIN thanks to their input \n"; // Print message to screen
-    std::cout << "\nThanks to PeyTy for xorriso, an open source alternative to oscdimg\n"; // Print message to screen
+    std::cout << "\nThanks to PeyTy for xorriso, which built MODWIN's ISOs before it had its own ISO writer\n"; // Print message to screen
     std::cout << "https://github.com/PeyTy/xorriso-exe-for-windows\n"; // Print message to screen
     std::cout << "\nThanks to Asheroto for their gist code teaching us how to add the tpm bypass to the unattend file\n"; // Print message to screen
     std::cout << "https://gist.github.com/asheroto/c4a9fb4e5e5bdad10bcb831e3a3daee6\n"; // Print message to screen
@@ -1382,5 +1294,4 @@ void Credits() {
     std::cout << "\nPress any key to return to the main menu...\n"; // Print message to screen
     system("pause>nul"); // Pauses so the user has time to read the credits 
     system("cls"); // Clear the console screen
-    ShowMenu(); // Takes user back to the Main Menu
 }
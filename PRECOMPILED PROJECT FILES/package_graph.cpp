@@ -0,0 +1,217 @@
+#include "package_graph.h"
+#include <algorithm>     // std::sort for ordering each batch
+#include <cctype>        // std::tolower for the keys
+#include <cstdint>       // SIZE_MAX for packages not reached yet
+#include <filesystem>    // std::filesystem::path for the manifest paths
+#include <fstream>       // std::ifstream for reading manifests
+#include <iterator>      // std::istreambuf_iterator for reading a whole manifest
+#include <map>           // std::map from keys to the packages of the set
+#include <set>           // std::set for the edges of the graph
+
+// Function to lowercase a string
+static std::string Lower(std::string text) {
+    for (char& c : text) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return text;
+}
+
+// Function to build the key "name~architecture" of a package identity "Name~PublicKeyToken~Arch~Language~Version"
+std::string PackageKey(const std::string& packageIdentity) {
+    size_t first = packageIdentity.find('~');
+    if (first == std::string::npos) {
+        return Lower(packageIdentity);
+    }
+    size_t second = packageIdentity.find('~', first + 1);
+    size_t third = second == std::string::npos ? std::string::npos : packageIdentity.find('~', second + 1);
+    std::string architecture = second == std::string::npos ? "" : packageIdentity.substr(second + 1, third - second - 1);
+    return Lower(packageIdentity.substr(0, first) + "~" + architecture);
+}
+
+// Function to read the value of attribute 'name' from the text of a tag, empty if it is missing
+static std::string Attribute(const std::string& tag, const std::string& name) {
+    size_t pos = 0;
+    while ((pos = tag.find(name, pos)) != std::string::npos) {
+        size_t end = pos + name.size();
+        bool wholeName = pos > 0 && std::isspace(static_cast<unsigned char>(tag[pos - 1]));
+        while (end < tag.size() && std::isspace(static_cast<unsigned char>(tag[end]))) end++;
+        if (wholeName && end < tag.size() && tag[end] == '=') {
+            end++;
+            while (end < tag.size() && std::isspace(static_cast<unsigned char>(tag[end]))) end++;
+            if (end < tag.size() && (tag[end] == '"' || tag[end] == '\'')) {
+                size_t close = tag.find(tag[end], end + 1);
+                if (close != std::string::npos) {
+                    return tag.substr(end + 1, close - end - 1);
+                }
+            }
+        }
+        pos += name.size();
+    }
+    return "";
+}
+
+// Reads the <assemblyIdentity> of the manifest itself and of the packages under <parent> and <update><package>.
+// The manifests are plain XML without entities in the parts read here, so a tag scanner is enough.
+bool ReadPackageManifest(const std::string& manifestPath, PackageManifest& manifest) {
+    std::ifstream file(manifestPath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    manifest = PackageManifest();
+    std::vector<std::string> open; // Elements enclosing the current tag
+    size_t pos = 0;
+    while ((pos = text.find('<', pos)) != std::string::npos) {
+        size_t end = text.find('>', pos);
+        if (end == std::string::npos) {
+            break;
+        }
+        std::string tag = text.substr(pos + 1, end - pos - 1);
+        pos = end + 1;
+        if (tag.empty() || tag[0] == '?' || tag[0] == '!') {
+            continue; // Declaration or comment
+        }
+        if (tag[0] == '/') {
+            if (!open.empty()) {
+                open.pop_back();
+            }
+            continue;
+        }
+        bool selfClosing = tag.back() == '/';
+        std::string name = tag.substr(0, tag.find_first_of(" \t\r\n/"));
+        if (name == "assemblyIdentity") {
+            std::string key = Lower(Attribute(tag, "name") + "~" + Attribute(tag, "processorArchitecture"));
+            bool inParent = std::find(open.begin(), open.end(), "parent") != open.end();
+            auto update = std::find(open.begin(), open.end(), "update");
+            if (inParent) {
+                manifest.parents.push_back(key);
+            }
+            else if (update != open.end() && std::find(update, open.end(), "package") != open.end()) {
+                manifest.children.push_back(key);
+            }
+            else if (open.size() == 1 && manifest.key.empty()) { // Directly under <assembly>
+                manifest.key = key;
+            }
+        }
+        if (!selfClosing) {
+            open.push_back(name);
+        }
+    }
+    return !manifest.key.empty();
+}
+
+// Function to order the removal of 'packageIdentities' from the manifests of the image at 'imageDir'. A package is
+// removed before the packages it needs (its parents). A package contained in another package of the set is not
+// removed on its own, since removing its container removes it and removing it first would fail; whatever it needs
+// waits for its container instead. Packages without a readable manifest have no dependencies and go in the first batch.
+PackageRemovalPlan PlanPackageRemoval(const std::string& imageDir, const std::vector<std::string>& packageIdentities) {
+    const size_t count = packageIdentities.size();
+    std::multimap<std::string, size_t> byKey;
+    for (size_t i = 0; i < count; i++) {
+        byKey.emplace(PackageKey(packageIdentities[i]), i);
+    }
+
+    std::vector<PackageManifest> manifests(count);
+    std::vector<std::vector<size_t>> contains(count); // Packages of the set inside package i
+    std::vector<size_t> containers(count, 0);         // Number of packages of the set package i is inside
+    std::filesystem::path packagesDir = std::filesystem::path(imageDir) / "Windows" / "servicing" / "Packages";
+    for (size_t i = 0; i < count; i++) {
+        if (!ReadPackageManifest((packagesDir / (packageIdentities[i] + ".mum")).string(), manifests[i])) {
+            manifests[i] = PackageManifest();
+            continue;
+        }
+        for (const std::string& child : manifests[i].children) {
+            auto range = byKey.equal_range(child);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second != i) {
+                    contains[i].push_back(it->second);
+                    containers[it->second]++;
+                }
+            }
+        }
+    }
+
+    // removedWith[i] is the package whose removal takes package i along, itself unless it is inside another one.
+    // Walks down from the packages inside no other one, so packages only inside each other are still removed.
+    const size_t NOT_REACHED = SIZE_MAX;
+    std::vector<size_t> removedWith(count, NOT_REACHED);
+    std::vector<size_t> walk;
+    for (size_t i = 0; i < count; i++) {
+        if (containers[i] == 0) {
+            removedWith[i] = i;
+            walk.push_back(i);
+        }
+    }
+    while (!walk.empty()) {
+        size_t container = walk.back();
+        walk.pop_back();
+        for (size_t child : contains[container]) {
+            if (removedWith[child] == NOT_REACHED) {
+                removedWith[child] = removedWith[container];
+                walk.push_back(child);
+            }
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (removedWith[i] == NOT_REACHED) {
+            removedWith[i] = i;
+        }
+    }
+
+    // before[i] holds the packages that have to be removed before package i
+    std::vector<std::set<size_t>> before(count);
+    for (size_t i = 0; i < count; i++) {
+        for (const std::string& parent : manifests[i].parents) { // i needs parent, so i goes first
+            auto range = byKey.equal_range(parent);
+            for (auto it = range.first; it != range.second; ++it) {
+                size_t first = removedWith[i];
+                size_t second = removedWith[it->second];
+                if (first != second) before[second].insert(first);
+            }
+        }
+        if (removedWith[i] != i) {
+            continue;
+        }
+        for (size_t child : contains[i]) { // Only packages inside each other get here, the child is tried first
+            if (removedWith[child] == child) before[i].insert(child);
+        }
+    }
+
+    // Peels the graph in layers: each batch is every package with nothing left to remove before it
+    PackageRemovalPlan plan;
+    std::vector<size_t> waiting(count);
+    std::vector<std::vector<size_t>> after(count);
+    std::vector<bool> planned(count, false);
+    for (size_t i = 0; i < count; i++) {
+        waiting[i] = before[i].size();
+        for (size_t first : before[i]) {
+            after[first].push_back(i);
+        }
+        if (removedWith[i] != i) {
+            planned[i] = true;
+            plan.contained.push_back(packageIdentities[i]);
+        }
+    }
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < count; i++) {
+        if (!planned[i] && waiting[i] == 0) ready.push_back(i);
+    }
+    while (!ready.empty()) {
+        std::sort(ready.begin(), ready.end());
+        std::vector<std::string> batch;
+        std::vector<size_t> next;
+        for (size_t i : ready) {
+            planned[i] = true;
+            batch.push_back(packageIdentities[i]);
+            for (size_t j : after[i]) {
+                if (--waiting[j] == 0) next.push_back(j);
+            }
+        }
+        plan.batches.push_back(batch);
+        ready.swap(next);
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!planned[i]) plan.cyclic.push_back(packageIdentities[i]);
+    }
+    return plan;
+}
@@ -0,0 +1,27 @@
+#pragma once
+// Dependencies between the packages of a mounted image, read from the package manifests (.mum files) in
+// Windows\servicing\Packages, and the order in which a set of packages can be removed without a removal failing
+// because another package of the set still depends on it.
+#include <string> // std::string for identities and paths
+#include <vector> // std::vector for references and batches
+
+// What a package manifest says about the packages around it. References are keyed "name~architecture" in lowercase,
+// since a manifest names the packages it refers to without the exact version installed.
+struct PackageManifest {
+    std::string key;                  // Key of the package itself
+    std::vector<std::string> parents; // Packages this one needs installed (<parent>)
+    std::vector<std::string> children; // Packages this one contains (<update><package>), removed along with it
+};
+
+// Removal order for a set of packages. Every package of a batch can be removed once the batches before it are
+// removed, and packages of the same batch do not depend on each other.
+struct PackageRemovalPlan {
+    std::vector<std::vector<std::string>> batches;
+    std::vector<std::string> cyclic;    // Packages whose dependencies loop, removed last one by one
+    std::vector<std::string> contained; // Packages of the set inside another one of the set, removed along with it
+};
+
+// Function declarations for the package dependency graph
+std::string PackageKey(const std::string& packageIdentity);
+bool ReadPackageManifest(const std::string& manifestPath, PackageManifest& manifest);
+PackageRemovalPlan PlanPackageRemoval(const std::string& imageDir, const std::vector<std::string>& packageIdentities);
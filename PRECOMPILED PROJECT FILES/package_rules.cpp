@@ -0,0 +1,88 @@
+#include "package_rules.h"
+#include <algorithm>  // std::sort for loading rule files in name order
+#include <filesystem> // std::filesystem for listing the rule folder
+#include <fstream>    // std::ifstream for reading rule files
+#include <iostream>   // std::cerr for reporting bad rule lines
+
+// The built-in safe list as a trie, built by the compiler
+static constexpr auto SAFE_PACKAGE_TRIE =
+    BuildPrefixTrie<TotalLength(SAFE_PACKAGE_PREFIXES) + 1>(SAFE_PACKAGE_PREFIXES, PackageVerdict::Remove);
+static_assert(SAFE_PACKAGE_TRIE.size <= SAFE_PACKAGE_TRIE.nodes.size(), "Safe package trie overflow");
+
+PackageRuleSet::PackageRuleSet()
+    : nodes(SAFE_PACKAGE_TRIE.nodes.begin(), SAFE_PACKAGE_TRIE.nodes.begin() + SAFE_PACKAGE_TRIE.size),
+      size(SAFE_PACKAGE_TRIE.size), ruleCount(SAFE_PACKAGE_PREFIXES.size()) {
+}
+
+void PackageRuleSet::Add(std::string_view prefix, PackageVerdict verdict) {
+    nodes.resize(size + prefix.size());
+    if (InsertPrefix(nodes, size, prefix, verdict)) {
+        ruleCount++;
+    }
+    nodes.resize(size);
+}
+
+// Function to read one rule file, skipping and reporting lines it does not understand
+bool PackageRuleSet::LoadFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: Cannot open rule file " << path << ".\n";
+        return false;
+    }
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(file, line); lineNumber++) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        size_t space = line.find_first_of(" \t", first);
+        size_t start = space == std::string::npos ? std::string::npos : line.find_first_not_of(" \t\r", space);
+        size_t end = line.find_last_not_of(" \t\r");
+        std::string kind = line.substr(first, space == std::string::npos ? std::string::npos : space - first);
+        if (start == std::string::npos || (kind != "remove" && kind != "keep")) {
+            std::cerr << "Warning: Ignoring line " << lineNumber << " of " << path << ": " << line << '\n';
+            continue;
+        }
+        Add(std::string_view(line).substr(start, end - start + 1), kind == "remove" ? PackageVerdict::Remove : PackageVerdict::Keep);
+    }
+    return true;
+}
+
+size_t PackageRuleSet::LoadFolder(const std::string& folder) {
+    std::error_code error;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(folder, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    size_t loaded = 0;
+    for (const auto& file : files) {
+        if (LoadFile(file.string())) {
+            loaded++;
+        }
+    }
+    return loaded;
+}
+
+// Walks the trie along the identity and returns the verdict of the longest rule that is a prefix of it
+PackageVerdict PackageRuleSet::Classify(std::string_view packageIdentity) const {
+    PackageVerdict verdict = PackageVerdict::None;
+    uint32_t node = 0;
+    for (char c : packageIdentity) {
+        c = LowerAscii(c);
+        uint32_t child = nodes[node].firstChild;
+        while (child != 0 && nodes[child].c != c) {
+            child = nodes[child].nextSibling;
+        }
+        if (child == 0) {
+            break;
+        }
+        node = child;
+        if (nodes[node].verdict != PackageVerdict::None) {
+            verdict = nodes[node].verdict;
+        }
+    }
+    return verdict;
+}
@@ -0,0 +1,131 @@
+#pragma once
+// Rules deciding which packages "Remove all packages" may remove. Every rule is a package name prefix marked
+// "remove" or "keep", stored in a prefix trie so a package identity is classified in one walk over its characters,
+// however many rules there are. The built-in safe list is turned into a trie at compile time, and rule files from
+// C:\MODWIN\RULES are added to it at startup.
+#include <array>       // std::array for the compile-time trie
+#include <cstdint>     // Fixed width integer types for the trie nodes
+#include <string>      // std::string for file paths
+#include <string_view> // std::string_view for prefixes and identities
+#include <vector>      // std::vector for the trie grown at run time
+
+// What a rule says about the packages it matches
+enum class PackageVerdict : uint8_t {
+    None,   // No rule matches, the package is left alone
+    Remove, // Safe to remove
+    Keep    // Never removed, even when a shorter "remove" prefix matches
+};
+
+// One character of the trie. Children are kept as a linked list through nextSibling, node 0 is the root.
+struct PrefixTrieNode {
+    char c = 0;                  // Lowercase character leading to this node
+    uint32_t firstChild = 0;     // 0 when the node has no children
+    uint32_t nextSibling = 0;    // 0 for the last child
+    PackageVerdict verdict = PackageVerdict::None; // Set when a rule ends at this node
+};
+
+// Function to lowercase ASCII letters, so rules match regardless of case
+constexpr char LowerAscii(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Function to add a prefix to the trie held in nodes[0, size). 'nodes' must have room for prefix.size() more nodes.
+// Used on a std::array at compile time and on a std::vector at run time. Returns false when the prefix already had a
+// rule, which 'verdict' replaces.
+template <typename Nodes>
+constexpr bool InsertPrefix(Nodes& nodes, uint32_t& size, std::string_view prefix, PackageVerdict verdict) {
+    uint32_t node = 0;
+    for (char c : prefix) {
+        c = LowerAscii(c);
+        uint32_t child = nodes[node].firstChild;
+        while (child != 0 && nodes[child].c != c) {
+            child = nodes[child].nextSibling;
+        }
+        if (child == 0) { // New branch, linked in front of the existing children
+            child = size++;
+            nodes[child].c = c;
+            nodes[child].firstChild = 0;
+            nodes[child].nextSibling = nodes[node].firstChild;
+            nodes[child].verdict = PackageVerdict::None;
+            nodes[node].firstChild = child;
+        }
+        node = child;
+    }
+    bool added = nodes[node].verdict == PackageVerdict::None;
+    nodes[node].verdict = verdict;
+    return added;
+}
+
+// Trie built from a fixed list of prefixes at compile time
+template <size_t Capacity>
+struct StaticPrefixTrie {
+    std::array<PrefixTrieNode, Capacity> nodes{};
+    uint32_t size = 1; // The root
+};
+
+template <size_t Capacity, size_t Count>
+constexpr StaticPrefixTrie<Capacity> BuildPrefixTrie(const std::array<std::string_view, Count>& prefixes, PackageVerdict verdict) {
+    StaticPrefixTrie<Capacity> trie{};
+    for (std::string_view prefix : prefixes) {
+        InsertPrefix(trie.nodes, trie.size, prefix, verdict);
+    }
+    return trie;
+}
+
+// Function to count the characters of a list of prefixes, an upper bound on the trie nodes they need
+template <size_t Count>
+constexpr size_t TotalLength(const std::array<std::string_view, Count>& prefixes) {
+    size_t total = 0;
+    for (std::string_view prefix : prefixes) {
+        total += prefix.size();
+    }
+    return total;
+}
+
+// The built-in safe list, removed by "Remove all packages" unless a rule file says otherwise
+constexpr std::array<std::string_view, 19> SAFE_PACKAGE_PREFIXES = {
+    "Microsoft-OneCore-ApplicationModel",
+    "Microsoft-OneCore-DirectX",
+    "Microsoft-Windows-Hello",
+    "Microsoft-Windows-InternetExplorer",
+    "Microsoft-Windows-LanguageFeatures-Handwriting",
+    "Microsoft-Windows-LanguageFeatures-OCR",
+    "Microsoft-Windows-LanguageFeatures-Speech",
+    "Microsoft-Windows-LanguageFeatures-TextToSpeech",
+    "Microsoft-Windows-MSPaint",
+    "Microsoft-Windows-MediaPlayer",
+    "Microsoft-Windows-PowerShell",
+    "Microsoft-Windows-Printing",
+    "Microsoft-Windows-QuickAssist",
+    "Microsoft-Windows-StepsRecorder",
+    "Microsoft-Windows-TabletPCMath",
+    "Microsoft-Windows-WMIC",
+    "Microsoft-Windows-Wallpaper",
+    "Microsoft-Windows-WordPad",
+    "OpenSSH-Client-Package"
+};
+
+// Package rules: the built-in safe list plus any rules loaded from files. The longest matching prefix decides,
+// and a rule added later replaces an earlier rule with the same prefix.
+//
+// Rule file lines:
+//   remove <prefix>    e.g. "remove Microsoft-Windows-Notepad"
+//   keep <prefix>      e.g. "keep Microsoft-Windows-Printing-PMCPPC"
+//   # comment
+class PackageRuleSet {
+public:
+    PackageRuleSet(); // Starts with the built-in safe list
+
+    void Add(std::string_view prefix, PackageVerdict verdict);
+    bool LoadFile(const std::string& path);
+    // Loads every .txt file of 'folder' in name order, returns the number of files loaded
+    size_t LoadFolder(const std::string& folder);
+
+    PackageVerdict Classify(std::string_view packageIdentity) const;
+    size_t RuleCount() const { return ruleCount; } // Distinct prefixes
+
+private:
+    std::vector<PrefixTrieNode> nodes;
+    uint32_t size = 0;
+    size_t ruleCount = 0;
+};
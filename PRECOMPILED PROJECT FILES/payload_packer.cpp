@@ -0,0 +1,115 @@
+// Build tool that packs the files of the payloads folder into MODWIN. It runs before MODWIN is compiled (see the
+// PackPayloads target in modwin.vcxproj) and writes two files to the build folder:
+//   payloads.bin     every payload, LZMS compressed, one after the other; linked in by payloads.rc
+//   payload_table.h  a Payload id per file and the constexpr table of names, offsets, sizes and SHA-1s
+// Usage: payload_packer <payloads folder> <output folder>
+#include "lzms.h"
+#include "sha1.h"
+#include <algorithm>  // std::sort for a stable payload order
+#include <cctype>     // std::isalnum for the Payload ids
+#include <cstdint>    // Fixed width integer types
+#include <filesystem> // std::filesystem for the folders
+#include <fstream>    // std::ifstream and std::ofstream for the files
+#include <iostream>   // std::cout and std::cerr for output
+#include <iterator>   // std::istreambuf_iterator for reading whole files
+#include <string>     // std::string for the table text
+#include <vector>     // std::vector for the payloads and the blob
+
+namespace fs = std::filesystem;
+
+// Function to turn a file name into a C++ identifier for its Payload id, "TPM_fix.cmd" becomes TPM_fix_cmd
+static std::string PayloadId(const std::string& fileName) {
+    std::string id;
+    for (char c : fileName) {
+        id += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    }
+    if (id.empty() || std::isdigit(static_cast<unsigned char>(id[0]))) {
+        id.insert(0, "_");
+    }
+    return id;
+}
+
+// Function to write a file only when its content changed, so MSBuild does not rebuild what depends on it
+static bool WriteIfChanged(const fs::path& path, const std::string& content) {
+    std::ifstream oldFile(path, std::ios::binary);
+    std::string old((std::istreambuf_iterator<char>(oldFile)), std::istreambuf_iterator<char>());
+    if (oldFile.is_open() && old == content) {
+        return true;
+    }
+    oldFile.close();
+    std::ofstream outFile(path, std::ios::binary | std::ios::trunc);
+    if (!outFile.write(content.data(), static_cast<std::streamsize>(content.size()))) {
+        std::cerr << "Error: Unable to write " << path.string() << ".\n";
+        return false;
+    }
+    return true;
+}
+
+// Function to pack every file of 'sourceDir' into payloads.bin and payload_table.h in 'outputDir'
+static bool PackPayloads(const fs::path& sourceDir, const fs::path& outputDir) {
+    std::vector<fs::path> files;
+    std::error_code error;
+    for (const fs::directory_entry& entry : fs::directory_iterator(sourceDir, error)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    if (error || files.empty()) {
+        std::cerr << "Error: No payloads were found in " << sourceDir.string() << ".\n";
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+
+    std::string ids;
+    std::string index;
+    std::string blob;
+    uint64_t totalSize = 0;
+    for (const fs::path& file : files) {
+        std::ifstream inFile(file, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+        if (!inFile.good() && !inFile.eof()) {
+            std::cerr << "Error: Unable to read " << file.string() << ".\n";
+            return false;
+        }
+        // Payloads that LZMS cannot shrink are stored as they are
+        std::vector<uint8_t> packed(data.size());
+        size_t packedSize = data.empty() ? 0 : LzmsCompress(data.data(), data.size(), packed.data(), packed.size());
+        if (packedSize == 0 || packedSize >= data.size()) {
+            packed = data;
+            packedSize = data.size();
+        }
+        uint8_t digest[SHA1_DIGEST_SIZE];
+        Sha1Buffer(data.data(), data.size(), digest);
+        std::string name = file.filename().u8string();
+        ids += "    " + PayloadId(name) + ",\r\n";
+        index += "    { \"" + name + "\", " + std::to_string(blob.size()) + ", " + std::to_string(packedSize) + ", " +
+            std::to_string(data.size()) + ", \"" + Sha1ToHex(digest) + "\" },\r\n";
+        blob.append(reinterpret_cast<const char*>(packed.data()), packedSize);
+        totalSize += data.size();
+        std::cout << name << ": " << data.size() << " -> " << packedSize << " bytes\n";
+    }
+
+    std::string table = "#pragma once\r\n"
+        "// Generated at build time by payload_packer from the payloads folder, do not edit\r\n\r\n"
+        "// Payloads packed into MODWIN, named after their files\r\n"
+        "enum class Payload {\r\n" + ids + "};\r\n\r\n"
+        "// Number of payloads and size of the blob holding them (payloads.bin)\r\n"
+        "inline constexpr size_t PAYLOAD_COUNT = " + std::to_string(files.size()) + ";\r\n"
+        "inline constexpr uint32_t PAYLOAD_BLOB_SIZE = " + std::to_string(blob.size()) + ";\r\n\r\n"
+        "// Where each payload sits in the blob, in the order of Payload\r\n"
+        "inline constexpr EmbeddedPayload EMBEDDED_PAYLOADS[PAYLOAD_COUNT] = {\r\n" + index + "};\r\n";
+    fs::create_directories(outputDir, error);
+    if (!WriteIfChanged(outputDir / "payloads.bin", blob) || !WriteIfChanged(outputDir / "payload_table.h", table)) {
+        return false;
+    }
+    std::cout << "Packed " << files.size() << " payload(s), " << totalSize << " -> " << blob.size() << " bytes\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: payload_packer <payloads folder> <output folder>\n";
+        return 1;
+    }
+    return PackPayloads(argv[1], argv[2]) ? 0 : 1;
+}
@@ -0,0 +1,328 @@
+#include "payloads.h"
+#include "lzms.h"
+#include "sha1.h"
+#include "direct_io.h"
+#include "thread_pool.h"
+#include "tsv_manifest.h"
+#ifdef _WIN32
+#define NOMINMAX // Prevents the Windows headers from defining the min() and max() macros
+#include <windows.h> // FindResourceW and LockResource for the payload blob
+#endif
+#include <algorithm> // std::copy, std::min and std::max
+#include <chrono>    // std::chrono::steady_clock for the benchmark
+#include <cstring>   // std::memset for the padding of unbuffered writes
+#include <fstream>   // std::ifstream for hashing the copies
+#include <iostream>  // std::cout and std::cerr for output
+#include <thread>    // std::thread::hardware_concurrency for the thread count
+
+namespace fs = std::filesystem;
+
+#if !defined(_WIN32)
+// Without Windows resources the blob is linked with .incbin, the folder holding payloads.bin must be given to the
+// assembler (-Wa,-I<folder>)
+__asm__(".section .rodata\n"
+    ".global modwinPayloadBlob\n"
+    ".hidden modwinPayloadBlob\n"
+    ".balign 16\n"
+    "modwinPayloadBlob:\n"
+    ".incbin \"payloads.bin\"\n"
+    ".previous\n");
+extern "C" const uint8_t modwinPayloadBlob[];
+#endif
+
+// First line of the sidecar manifest
+static constexpr const char* PAYLOAD_MANIFEST_HEADER = "MODWIN payload manifest 1";
+
+// Payloads from this size on are written straight to the disk, smaller ones go through the file cache
+static constexpr size_t PAYLOAD_UNBUFFERED_SIZE = 1024 * 1024;
+
+// Function to find the blob of packed payloads linked into the executable (payloads.rc), nullptr when it is missing
+static const uint8_t* PayloadBlob() {
+#ifdef _WIN32
+    HRSRC resource = FindResourceW(nullptr, L"PAYLOADS", MAKEINTRESOURCEW(10)); // RT_RCDATA
+    if (resource == nullptr || SizeofResource(nullptr, resource) != PAYLOAD_BLOB_SIZE) {
+        return nullptr;
+    }
+    HGLOBAL loaded = LoadResource(nullptr, resource);
+    return loaded ? static_cast<const uint8_t*>(LockResource(loaded)) : nullptr;
+#else
+    return modwinPayloadBlob;
+#endif
+}
+
+// Function to unpack a payload into 'out', which holds at least its size
+static bool UnpackPayloadTo(const EmbeddedPayload& payload, uint8_t* out) {
+    const uint8_t* blob = PayloadBlob();
+    if (blob == nullptr) {
+        std::cerr << "Error: The payloads are missing from MODWIN.exe.\n";
+        return false;
+    }
+    const uint8_t* packed = blob + payload.offset;
+    if (payload.packedSize == payload.size) {
+        std::copy(packed, packed + payload.size, out);
+        return true;
+    }
+    if (!LzmsDecompress(packed, payload.packedSize, out, payload.size)) {
+        std::cerr << "Error: The packed copy of " << payload.name << " is damaged.\n";
+        return false;
+    }
+    return true;
+}
+
+// Function to unpack a payload into memory
+bool ReadPayload(Payload id, std::vector<uint8_t>& data) {
+    const EmbeddedPayload& payload = PayloadInfo(id);
+    data.resize(payload.size);
+    return UnpackPayloadTo(payload, data.data());
+}
+
+// Manifest lines are "sha1 <tab> size <tab> time <tab> name"
+bool LoadPayloadManifest(const fs::path& manifestPath, PayloadManifest& manifest) {
+    manifest.clear();
+    std::vector<TsvManifestLine> lines;
+    if (!LoadTsvManifest(manifestPath, PAYLOAD_MANIFEST_HEADER, 3, lines)) {
+        return false;
+    }
+    for (const TsvManifestLine& line : lines) {
+        PayloadCopyState state;
+        state.sha1 = line.fields[0];
+        if (ParseTsvField(line.fields[1], state.size) && ParseTsvField(line.fields[2], state.writeTime)) {
+            manifest[line.name] = state;
+        }
+    }
+    return true;
+}
+
+bool SavePayloadManifest(const fs::path& manifestPath, const PayloadManifest& manifest) {
+    std::vector<TsvManifestLine> lines;
+    for (const auto& [name, state] : manifest) {
+        lines.push_back({ { state.sha1, std::to_string(state.size), std::to_string(state.writeTime) }, name });
+    }
+    return SaveTsvManifest(manifestPath, PAYLOAD_MANIFEST_HEADER, lines);
+}
+
+// Function to read the size and write time of a copy, false when there is none
+static bool CopyState(const fs::path& path, PayloadCopyState& state) {
+    std::error_code error;
+    if (!fs::is_regular_file(path, error)) {
+        return false;
+    }
+    state.size = fs::file_size(path, error);
+    state.writeTime = static_cast<int64_t>(fs::last_write_time(path, error).time_since_epoch().count());
+    return !error;
+}
+
+// Function to hash a copy on disk
+static bool HashCopy(const fs::path& path, std::string& sha1) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    Sha1Context context;
+    Sha1Init(context);
+    char buffer[65536];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        Sha1Update(context, buffer, static_cast<size_t>(file.gcount()));
+    }
+    uint8_t digest[SHA1_DIGEST_SIZE];
+    Sha1Final(context, digest);
+    sha1 = Sha1ToHex(digest);
+    return true;
+}
+
+// Function to unpack a payload next to its copy and rename it over the copy, so the copy is either the old one or
+// the whole new one, never a partial file. The payload is unpacked into a sector aligned buffer and written in one
+// go, large payloads straight to the disk.
+static bool WritePayloadCopy(Payload id, const fs::path& target) {
+    const EmbeddedPayload& payload = PayloadInfo(id);
+    size_t padded = (payload.size + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT; // Unbuffered writes take whole sectors
+    AlignedBuffer buffer = AllocateAligned(std::max<size_t>(padded, IO_ALIGNMENT));
+    if (!UnpackPayloadTo(payload, buffer.get())) {
+        return false;
+    }
+    std::memset(buffer.get() + payload.size, 0, padded - payload.size);
+    fs::path temporary = target;
+    temporary += ".tmp";
+    SequentialFileWriter writer;
+    if (!writer.Open(temporary, payload.size >= PAYLOAD_UNBUFFERED_SIZE) || (padded > 0 && !writer.Write(buffer.get(), padded)) ||
+        !writer.Close(payload.size)) {
+        writer.Discard();
+        std::cerr << "Error: Unable to write " << temporary.string() << ".\n";
+        std::error_code error;
+        fs::remove(temporary, error);
+        return false;
+    }
+    std::error_code error;
+    fs::rename(temporary, target, error);
+    if (error) {
+        std::cerr << "Error: Unable to replace " << target.string() << ": " << error.message() << "\n";
+        fs::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+// What checking one payload copy found. The payloads are checked on several threads, so each one only reads the
+// manifest, and the results go into it and into the totals once every payload is done.
+struct PayloadSyncOutcome {
+    bool existed = false;
+    bool recorded = false;  // 'state' goes into the manifest
+    PayloadCopyState state;
+    PayloadSyncStats stats;
+};
+
+// Function to make the copy of one payload in 'dir' match the packed one. A copy the manifest recorded with the
+// payload's hash and the same size and write time is trusted without reading it; any other copy of the right size
+// is hashed, and copies that are missing or differ are written again.
+static void SyncPayload(Payload id, const fs::path& dir, bool unpackMissing, const PayloadManifest& manifest, PayloadSyncOutcome& outcome) {
+    const EmbeddedPayload& payload = PayloadInfo(id);
+    fs::path target = dir / fs::u8path(payload.name);
+    PayloadCopyState& state = outcome.state;
+    outcome.existed = CopyState(target, state);
+    if (outcome.existed) {
+        outcome.stats.checked++;
+        auto recorded = manifest.find(payload.name);
+        if (recorded != manifest.end() && recorded->second.sha1 == payload.sha1 && recorded->second.size == state.size &&
+            recorded->second.writeTime == state.writeTime) {
+            return;
+        }
+        if (state.size == payload.size) {
+            outcome.stats.hashed++;
+            if (HashCopy(target, state.sha1) && state.sha1 == payload.sha1) {
+                outcome.recorded = true;
+                return;
+            }
+        }
+    }
+    else if (!unpackMissing) {
+        return;
+    }
+    if (!WritePayloadCopy(id, target) || !CopyState(target, state)) {
+        outcome.stats.failed++;
+        return;
+    }
+    state.sha1 = payload.sha1;
+    outcome.recorded = true;
+    outcome.stats.rewritten++;
+}
+
+// Function to sync the payloads 'ids' in 'dir', one payload per thread, so unpacking one overlaps with writing the
+// others and a first run is limited by the disk rather than by LZMS
+static bool SyncPayloadSet(const std::vector<Payload>& ids, const fs::path& dir, bool unpackMissing, unsigned threadCount,
+    PayloadSyncStats& totals) {
+    PayloadManifest manifest;
+    LoadPayloadManifest(dir / PAYLOAD_MANIFEST_NAME, manifest);
+    std::vector<PayloadSyncOutcome> outcomes(ids.size());
+    if (threadCount == 0) {
+        threadCount = std::max(1U, std::thread::hardware_concurrency());
+    }
+    WorkerPool pool(static_cast<unsigned>(std::min<size_t>(threadCount, std::max<size_t>(ids.size(), 1))));
+    pool.ParallelFor(ids.size(), [&](size_t i) { SyncPayload(ids[i], dir, unpackMissing, manifest, outcomes[i]); });
+
+    totals = PayloadSyncStats();
+    for (size_t i = 0; i < ids.size(); i++) {
+        const PayloadSyncOutcome& outcome = outcomes[i];
+        const char* name = PayloadInfo(ids[i]).name;
+        totals.checked += outcome.stats.checked;
+        totals.hashed += outcome.stats.hashed;
+        totals.rewritten += outcome.stats.rewritten;
+        totals.failed += outcome.stats.failed;
+        if (outcome.recorded) {
+            manifest[name] = outcome.state;
+        }
+        if (outcome.stats.rewritten > 0) {
+            std::cout << name << (outcome.existed ? " was out of date and has been replaced.\n" : " has been unpacked successfully.\n");
+        }
+    }
+    // The manifest only changes when a copy was read or written
+    if (totals.hashed + totals.rewritten > 0 && !SavePayloadManifest(dir / PAYLOAD_MANIFEST_NAME, manifest)) {
+        std::cerr << "Warning: Unable to save " << (dir / PAYLOAD_MANIFEST_NAME).string() << ".\n";
+    }
+    return totals.failed == 0;
+}
+
+// Function to unpack a payload to 'dir' the first time it is needed, or again when the copy there is stale
+bool UnpackPayload(Payload id, const fs::path& dir) {
+    return UnpackPayloads({ id }, dir);
+}
+
+// Function to unpack the payloads a feature needs at once, in parallel
+bool UnpackPayloads(const std::vector<Payload>& ids, const fs::path& dir) {
+    PayloadSyncStats stats;
+    return SyncPayloadSet(ids, dir, true, 0, stats);
+}
+
+// Function to check every payload copy in 'dir' against the packed payloads, run at each start. Missing copies are
+// only unpacked when 'unpackMissing' is set, the others are left for the features that need them.
+bool SyncPayloads(const fs::path& dir, bool unpackMissing, PayloadSyncStats* stats, unsigned threadCount) {
+    std::vector<Payload> ids;
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        ids.push_back(static_cast<Payload>(i));
+    }
+    PayloadSyncStats totals;
+    bool synced = SyncPayloadSet(ids, dir, unpackMissing, threadCount, totals);
+    if (stats) {
+        *stats = totals;
+    }
+    return synced;
+}
+
+// Function to time unpacking every payload into an empty folder, the work of a first run, with one thread and with
+// every core. Unpacking in memory alone shows how much of it is LZMS and how much the disk.
+bool BenchmarkPayloadExtraction(const fs::path& scratchDir, size_t rounds) {
+    rounds = std::max<size_t>(rounds, 1);
+    const fs::path unpackDir = scratchDir / "benchmark_payloads";
+    uint64_t totalBytes = 0;
+    for (const EmbeddedPayload& payload : EMBEDDED_PAYLOADS) {
+        totalBytes += payload.size;
+    }
+    std::cout << "Unpacking " << PAYLOAD_COUNT << " payloads, " << totalBytes << " bytes, " << rounds << " times\n";
+    auto rate = [&](double seconds) { return seconds > 0 ? rounds * totalBytes / (1024.0 * 1024.0) / seconds : 0.0; };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> data;
+    for (size_t round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+            if (!ReadPayload(static_cast<Payload>(i), data)) {
+                return false;
+            }
+        }
+    }
+    double memorySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  In memory, one thread: " << memorySeconds << " s, " << rate(memorySeconds) << " MB/s\n";
+
+    double serialSeconds = 0;
+    for (unsigned threads : { 1U, 0U }) {
+        double seconds = 0;
+        unsigned used = threads == 1 ? 1 : static_cast<unsigned>(std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), PAYLOAD_COUNT));
+        for (size_t round = 0; round < rounds; round++) {
+            std::error_code error;
+            fs::remove_all(unpackDir, error);
+            fs::create_directories(unpackDir, error);
+            if (error) {
+                std::cerr << "Error: Unable to create " << unpackDir.string() << ": " << error.message() << "\n";
+                return false;
+            }
+            std::streambuf* output = std::cout.rdbuf(nullptr); // Silences the "has been unpacked" lines while timing
+            PayloadSyncStats stats;
+            start = std::chrono::steady_clock::now();
+            bool synced = SyncPayloads(unpackDir, true, &stats, threads);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout.rdbuf(output);
+            if (!synced || stats.rewritten != PAYLOAD_COUNT) {
+                std::cerr << "Error: Unable to unpack the payloads to " << unpackDir.string() << ".\n";
+                fs::remove_all(unpackDir, error);
+                return false;
+            }
+        }
+        std::cout << "  To disk, " << used << (used == 1 ? " thread: " : " threads: ") << seconds << " s, " << rate(seconds) << " MB/s";
+        if (threads == 0 && seconds > 0) {
+            std::cout << ", " << serialSeconds / seconds << "x one thread";
+        }
+        std::cout << "\n";
+        serialSeconds = threads == 1 ? seconds : serialSeconds;
+    }
+    std::error_code error;
+    fs::remove_all(unpackDir, error);
+    return true;
+}
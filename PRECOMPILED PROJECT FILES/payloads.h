@@ -0,0 +1,60 @@
+#pragma once
+// Files MODWIN carries inside its executable, such as TPM_fix.cmd and autounattend.xml for unattended installs.
+// At build time payload_packer packs the payloads folder into one LZMS compressed blob, linked in as a resource
+// (payloads.rc), and generates payload_table.h, the typed table of the payloads. Payloads are only unpacked to disk
+// when a feature first needs them, one payload per thread, each unpacked into a sector aligned buffer and written
+// in one go, so unpacking one payload overlaps with writing the others.
+// The index holds the SHA-1 of every payload, so copies on disk left by an older MODWIN or cut short by a crash are
+// found and rewritten. A sidecar manifest next to them records the size, write time and SHA-1 of each copy MODWIN
+// wrote or checked, so checking an unchanged copy reads nothing but its file attributes.
+#include <cstddef>     // size_t for the payload count
+#include <cstdint>     // Fixed width integer types for the index
+#include <filesystem>  // std::filesystem::path for the unpack folder
+#include <map>         // std::map for the sidecar manifest
+#include <string>      // std::string for hashes
+#include <vector>      // std::vector for unpacked data
+
+// Where one payload sits in the blob
+struct EmbeddedPayload {
+    const char* name;    // File name it is unpacked as
+    uint32_t offset;     // Start of its packed bytes in the blob
+    uint32_t packedSize; // LZMS compressed size, the same as 'size' when it is stored as is
+    uint32_t size;
+    const char* sha1;    // Hex SHA-1 of the unpacked payload
+};
+
+// Generated at build time: the Payload ids and EMBEDDED_PAYLOADS, the table of every payload
+#include "payload_table.h"
+
+// Where the payload 'id' sits in the blob
+constexpr const EmbeddedPayload& PayloadInfo(Payload id) {
+    return EMBEDDED_PAYLOADS[static_cast<size_t>(id)];
+}
+
+// What the sidecar manifest recorded about one unpacked copy, keyed by the payload name
+struct PayloadCopyState {
+    uint64_t size = 0;
+    int64_t writeTime = 0; // std::filesystem::file_time_type ticks
+    std::string sha1;      // SHA-1 of the copy when it was written or last checked
+};
+using PayloadManifest = std::map<std::string, PayloadCopyState>;
+
+// Totals of a payload check
+struct PayloadSyncStats {
+    size_t checked = 0;   // Copies found on disk
+    size_t hashed = 0;    // Copies read because the manifest did not vouch for them
+    size_t rewritten = 0; // Copies that were missing, stale or damaged and were written again
+    size_t failed = 0;
+};
+
+// Name of the sidecar manifest in the folder payloads are unpacked to
+constexpr const char* PAYLOAD_MANIFEST_NAME = "payloads.manifest";
+
+// Function declarations for embedded payloads
+bool ReadPayload(Payload id, std::vector<uint8_t>& data);
+bool UnpackPayload(Payload id, const std::filesystem::path& dir);
+bool UnpackPayloads(const std::vector<Payload>& ids, const std::filesystem::path& dir);
+bool SyncPayloads(const std::filesystem::path& dir, bool unpackMissing, PayloadSyncStats* stats = nullptr, unsigned threadCount = 0);
+bool BenchmarkPayloadExtraction(const std::filesystem::path& scratchDir, size_t rounds);
+bool LoadPayloadManifest(const std::filesystem::path& manifestPath, PayloadManifest& manifest);
+bool SavePayloadManifest(const std::filesystem::path& manifestPath, const PayloadManifest& manifest);
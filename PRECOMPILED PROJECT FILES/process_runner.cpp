@@ -0,0 +1,79 @@
+#include "process_runner.h"
+#ifdef _WIN32
+#define NOMINMAX // Prevents the Windows headers from defining the min() and max() macros
+#include <windows.h> // CreatePipe, CreateProcessA and ReadFile
+#else
+#include <cstdio>     // popen and fread
+#include <sys/wait.h> // WIFEXITED and WEXITSTATUS
+#endif
+
+// Size of the reads from the pipe
+static constexpr size_t PROCESS_READ_SIZE = 64 * 1024;
+
+#ifdef _WIN32
+
+// Function to run a command line with its standard output and error sent through a pipe to 'onOutput'.
+// Returns the exit code of the process, or -1 if it could not be started.
+int RunProcess(const std::string& commandLine, const ProcessOutputCallback& onOutput) {
+    SECURITY_ATTRIBUTES security = {};
+    security.nLength = sizeof(security);
+    security.bInheritHandle = TRUE; // The child writes to this end of the pipe
+    HANDLE readPipe = nullptr;
+    HANDLE writePipe = nullptr;
+    if (!CreatePipe(&readPipe, &writePipe, &security, 0)) {
+        return -1;
+    }
+    SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0); // Only the write end goes to the child
+
+    STARTUPINFOA startup = {};
+    startup.cb = sizeof(startup);
+    startup.dwFlags = STARTF_USESTDHANDLES;
+    startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    startup.hStdOutput = writePipe;
+    startup.hStdError = writePipe;
+    PROCESS_INFORMATION process = {};
+    std::string command = commandLine; // CreateProcessA may write into the command line
+    BOOL started = CreateProcessA(nullptr, &command[0], nullptr, nullptr, TRUE, 0, nullptr, nullptr, &startup, &process);
+    CloseHandle(writePipe); // Closing our copy lets ReadFile report the end once the child exits
+    if (!started) {
+        CloseHandle(readPipe);
+        return -1;
+    }
+
+    char buffer[PROCESS_READ_SIZE];
+    DWORD bytesRead = 0;
+    while (ReadFile(readPipe, buffer, sizeof(buffer), &bytesRead, nullptr) && bytesRead > 0) {
+        onOutput(buffer, bytesRead);
+    }
+    CloseHandle(readPipe);
+
+    WaitForSingleObject(process.hProcess, INFINITE);
+    DWORD exitCode = 0;
+    GetExitCodeProcess(process.hProcess, &exitCode);
+    CloseHandle(process.hThread);
+    CloseHandle(process.hProcess);
+    return static_cast<int>(exitCode);
+}
+
+#else
+
+// Function to run a command line through the shell with its standard output and error sent to 'onOutput'.
+// Returns the exit code of the process, or -1 if it could not be started.
+int RunProcess(const std::string& commandLine, const ProcessOutputCallback& onOutput) {
+    FILE* pipe = popen((commandLine + " 2>&1").c_str(), "r");
+    if (!pipe) {
+        return -1;
+    }
+    char buffer[PROCESS_READ_SIZE];
+    size_t bytesRead;
+    while ((bytesRead = fread(buffer, 1, sizeof(buffer), pipe)) > 0) {
+        onOutput(buffer, bytesRead);
+    }
+    int status = pclose(pipe);
+    if (status == -1 || !WIFEXITED(status)) {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+
+#endif
@@ -0,0 +1,11 @@
+#pragma once
+// Runs a command line and hands its output to the caller while it runs, through a pipe instead of a temporary file.
+#include <cstddef>    // size_t
+#include <functional> // std::function for the output callback
+#include <string>     // std::string for the command line
+
+// Receives the output of the process in the pieces it arrives in
+using ProcessOutputCallback = std::function<void(const char* data, size_t size)>;
+
+// Function declarations for running processes
+int RunProcess(const std::string& commandLine, const ProcessOutputCallback& onOutput);
@@ -0,0 +1,1317 @@
+#include "registry_hive.h"
+#include "direct_io.h" // PatchFileWriter for writing pages in place
+#include <algorithm> // std::lower_bound for keeping subkey lists sorted
+#include <chrono>    // std::chrono::system_clock for key write times
+#include <cstring>   // std::memcpy and std::memcmp for the hive structures
+#include <fstream>   // std::ifstream and std::ofstream for the hive file
+#include <iostream>  // std::cerr for errors
+#include <iterator>  // std::istreambuf_iterator for reading the hive file
+
+// Layout of the hive structures used here, offsets from the start of each structure (of the cell data for cells)
+// Base block
+static constexpr size_t BASE_PRIMARY_SEQUENCE = 4;
+static constexpr size_t BASE_SECONDARY_SEQUENCE = 8;
+static constexpr size_t BASE_TIMESTAMP = 12;
+static constexpr size_t BASE_MINOR_VERSION = 24;
+static constexpr size_t BASE_FILE_TYPE = 28;
+static constexpr size_t BASE_ROOT_CELL = 36;
+static constexpr size_t BASE_BINS_SIZE = 40;
+static constexpr size_t BASE_CHECKSUM = 508;
+static constexpr uint32_t FILE_TYPE_PRIMARY = 0;
+static constexpr uint32_t FILE_TYPE_LOG = 6; // Transaction log in the format of Windows 8.1 and later
+// Hive bin header
+static constexpr uint32_t BIN_HEADER_SIZE = 32;
+// Key node (nk)
+static constexpr size_t NK_FLAGS = 2;
+static constexpr size_t NK_WRITE_TIME = 4;
+static constexpr size_t NK_PARENT = 16;
+static constexpr size_t NK_SUBKEY_COUNT = 20;
+static constexpr size_t NK_SUBKEY_LIST = 28;
+static constexpr size_t NK_VOLATILE_SUBKEY_LIST = 32;
+static constexpr size_t NK_VALUE_COUNT = 36;
+static constexpr size_t NK_VALUE_LIST = 40;
+static constexpr size_t NK_SECURITY = 44;
+static constexpr size_t NK_CLASS = 48;
+static constexpr size_t NK_MAX_SUBKEY_NAME = 52;
+static constexpr size_t NK_MAX_VALUE_NAME = 60;
+static constexpr size_t NK_MAX_VALUE_DATA = 64;
+static constexpr size_t NK_NAME_LENGTH = 72;
+static constexpr size_t NK_CLASS_LENGTH = 74;
+static constexpr size_t NK_NAME = 76;
+static constexpr uint16_t KEY_HIVE_ENTRY = 0x0004;
+static constexpr uint16_t KEY_NO_DELETE = 0x0008;
+static constexpr uint16_t KEY_COMP_NAME = 0x0020;
+// Value (vk)
+static constexpr size_t VK_NAME_LENGTH = 2;
+static constexpr size_t VK_DATA_SIZE = 4;
+static constexpr size_t VK_DATA = 8;
+static constexpr size_t VK_TYPE = 12;
+static constexpr size_t VK_FLAGS = 16;
+static constexpr size_t VK_NAME = 20;
+static constexpr uint16_t VALUE_COMP_NAME = 0x0001;
+static constexpr uint32_t DATA_INLINE = 0x80000000;
+// Security (sk)
+static constexpr size_t SK_REFERENCES = 12;
+// Subkey lists: leaves (lf, lh, li) hold keys, an index (ri) holds leaves. A leaf is split in two past this many
+// keys, so it stays within one page like the leaves Windows writes, and adding a key rewrites only that leaf.
+static constexpr uint16_t LEAF_MAX_KEYS = 500;
+// Data above this size is split into big data (db) segments, in hives of version 1.4 and later
+static constexpr uint32_t BIG_DATA_SEGMENT = 16344;
+// Transaction log: the first 512 bytes of a base block, then log entries ("HvLE") each holding a run of pages
+static constexpr size_t HIVE_PAGE_SIZE = 4096;
+static constexpr size_t LOG_BASE_BLOCK_SIZE = 512;
+static constexpr size_t LOG_ENTRY_HEADER_SIZE = 40;
+static constexpr size_t LOG_ENTRY_SIZE = 4;
+static constexpr size_t LOG_ENTRY_SEQUENCE = 12;
+static constexpr size_t LOG_ENTRY_BINS_SIZE = 16;
+static constexpr size_t LOG_ENTRY_PAGE_COUNT = 20;
+static constexpr size_t LOG_ENTRY_DATA_HASH = 24;
+static constexpr size_t LOG_ENTRY_HEADER_HASH = 32;
+static constexpr uint64_t MARVIN32_SEED = 0x82EF4D887A4E55C5;
+
+static uint16_t Read16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+static uint32_t Read32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24); }
+static uint64_t Read64(const uint8_t* p) { return Read32(p) | (uint64_t(Read32(p + 4)) << 32); }
+static void Write16(uint8_t* p, uint16_t v) { p[0] = uint8_t(v); p[1] = uint8_t(v >> 8); }
+static void Write32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; i++) p[i] = uint8_t(v >> (8 * i)); }
+static void Write64(uint8_t* p, uint64_t v) { Write32(p, uint32_t(v)); Write32(p + 4, uint32_t(v >> 32)); }
+
+static uint32_t Rotl(uint32_t v, int n) { return (v << n) | (v >> (32 - n)); }
+
+// Function to compute the Marvin32 hash that log entries are checked with
+static uint64_t Marvin32(const uint8_t* bytes, size_t size, uint64_t seed = MARVIN32_SEED) {
+    uint32_t lo = uint32_t(seed);
+    uint32_t hi = uint32_t(seed >> 32);
+    auto mix = [&lo, &hi]() {
+        hi ^= lo; lo = Rotl(lo, 20);
+        lo += hi; hi = Rotl(hi, 9);
+        hi ^= lo; lo = Rotl(lo, 27);
+        lo += hi; hi = Rotl(hi, 19);
+    };
+    for (; size >= 4; bytes += 4, size -= 4) {
+        lo += Read32(bytes);
+        mix();
+    }
+    uint32_t last = 0x80; // The remaining bytes followed by a 0x80 byte
+    for (size_t i = size; i-- > 0;) last = (last << 8) | bytes[i];
+    lo += last;
+    mix();
+    mix();
+    return (uint64_t(hi) << 32) | lo;
+}
+
+// Function to compute the checksum of a base block, the XOR of its first 127 dwords
+static uint32_t BaseBlockChecksum(const uint8_t* base) {
+    uint32_t checksum = 0;
+    for (size_t i = 0; i < BASE_CHECKSUM; i += 4) {
+        checksum ^= Read32(base + i);
+    }
+    return checksum == 0xFFFFFFFF ? 0xFFFFFFFE : checksum == 0 ? 1 : checksum;
+}
+
+// Function to get the current time as a FILETIME (100 ns units since 1601)
+static uint64_t FileTimeNow() {
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+    return (uint64_t(sinceEpoch.count()) + 11644473600ULL * 1000000) * 10;
+}
+
+// Function to convert UTF-8 into UTF-16 code units
+static std::u16string ToUtf16(std::string_view text) {
+    std::u16string wide;
+    for (size_t i = 0; i < text.size();) {
+        uint32_t c = static_cast<uint8_t>(text[i]);
+        size_t extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+        c = extra == 3 ? c & 0x07 : extra == 2 ? c & 0x0F : extra == 1 ? c & 0x1F : c;
+        for (size_t j = 1; j <= extra && i + j < text.size(); j++) {
+            c = (c << 6) | (static_cast<uint8_t>(text[i + j]) & 0x3F);
+        }
+        i += extra + 1;
+        if (c >= 0x10000) {
+            c -= 0x10000;
+            wide.push_back(char16_t(0xD800 + (c >> 10)));
+            wide.push_back(char16_t(0xDC00 + (c & 0x3FF)));
+        }
+        else {
+            wide.push_back(char16_t(c));
+        }
+    }
+    return wide;
+}
+
+// Function to convert UTF-16 code units into UTF-8
+static std::string ToUtf8(const std::u16string& wide) {
+    std::string text;
+    for (size_t i = 0; i < wide.size(); i++) {
+        uint32_t c = wide[i];
+        if (c >= 0xD800 && c < 0xDC00 && i + 1 < wide.size() && wide[i + 1] >= 0xDC00 && wide[i + 1] < 0xE000) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (wide[++i] - 0xDC00);
+        }
+        if (c < 0x80) {
+            text.push_back(char(c));
+        }
+        else if (c < 0x800) {
+            text.push_back(char(0xC0 | (c >> 6)));
+            text.push_back(char(0x80 | (c & 0x3F)));
+        }
+        else if (c < 0x10000) {
+            text.push_back(char(0xE0 | (c >> 12)));
+            text.push_back(char(0x80 | ((c >> 6) & 0x3F)));
+            text.push_back(char(0x80 | (c & 0x3F)));
+        }
+        else {
+            text.push_back(char(0xF0 | (c >> 18)));
+            text.push_back(char(0x80 | ((c >> 12) & 0x3F)));
+            text.push_back(char(0x80 | ((c >> 6) & 0x3F)));
+            text.push_back(char(0x80 | (c & 0x3F)));
+        }
+    }
+    return text;
+}
+
+// Function to read a stored name, Latin-1 when 'compressed' and UTF-16LE otherwise
+static std::u16string StoredName(const uint8_t* bytes, size_t size, bool compressed) {
+    std::u16string name;
+    if (compressed) {
+        for (size_t i = 0; i < size; i++) name.push_back(bytes[i]);
+    }
+    else {
+        for (size_t i = 0; i + 1 < size; i += 2) name.push_back(char16_t(Read16(bytes + i)));
+    }
+    return name;
+}
+
+// Function to turn a name into the bytes stored in the hive, compressed to one byte per character when it is ASCII
+static std::vector<uint8_t> StoreName(std::string_view name, bool& compressed) {
+    std::u16string wide = ToUtf16(name);
+    compressed = std::all_of(wide.begin(), wide.end(), [](char16_t c) { return c < 0x80; });
+    std::vector<uint8_t> bytes;
+    for (char16_t c : wide) {
+        if (compressed) {
+            bytes.push_back(uint8_t(c));
+        }
+        else {
+            bytes.push_back(uint8_t(c));
+            bytes.push_back(uint8_t(c >> 8));
+        }
+    }
+    return bytes;
+}
+
+// Function to uppercase a name the way the registry compares names
+static std::u16string Upcase(std::u16string name) {
+    for (char16_t& c : name) {
+        if ((c >= 'a' && c <= 'z') || (c >= 0xE0 && c <= 0xFE && c != 0xF7)) c = char16_t(c - 0x20);
+    }
+    return name;
+}
+
+// Function to compute the hash stored for each key of an "lh" list
+static uint32_t NameHash(const std::u16string& upcased) {
+    uint32_t hash = 0;
+    for (char16_t c : upcased) hash = hash * 37 + c;
+    return hash;
+}
+
+std::vector<uint8_t> EncodeHiveString(std::string_view text) {
+    std::u16string wide = ToUtf16(text);
+    std::vector<uint8_t> bytes;
+    for (char16_t c : wide) {
+        bytes.push_back(uint8_t(c));
+        bytes.push_back(uint8_t(c >> 8));
+    }
+    bytes.push_back(0);
+    bytes.push_back(0);
+    return bytes;
+}
+
+// Reads REG_SZ data, stopping at the terminating zero
+std::string DecodeHiveString(const uint8_t* bytes, size_t size) {
+    std::u16string wide;
+    for (size_t i = 0; i + 1 < size; i += 2) {
+        char16_t c = char16_t(Read16(bytes + i));
+        if (c == 0) break;
+        wide.push_back(c);
+    }
+    return ToUtf8(wide);
+}
+
+// Function to show value data the way regedit lists it: text, numbers in hex and decimal, other data as hex bytes
+std::string FormatHiveValue(const RegistryHive& hive, uint32_t value) {
+    static const char* const hex = "0123456789abcdef";
+    std::vector<uint8_t> bytes = hive.ReadValueData(value);
+    uint32_t type = hive.ValueType(value);
+    if ((type == HIVE_REG_SZ || type == HIVE_REG_EXPAND_SZ) && bytes.size() % 2 == 0) {
+        return DecodeHiveString(bytes.data(), bytes.size());
+    }
+    if (type == HIVE_REG_MULTI_SZ && bytes.size() % 2 == 0) {
+        std::string text;
+        for (size_t start = 0; start + 2 < bytes.size();) {
+            std::string part = DecodeHiveString(bytes.data() + start, bytes.size() - start);
+            if (part.empty()) break;
+            text += (text.empty() ? "" : " | ") + part;
+            start += EncodeHiveString(part).size();
+        }
+        return text;
+    }
+    if ((type == HIVE_REG_DWORD && bytes.size() == 4) || (type == HIVE_REG_QWORD && bytes.size() == 8)) {
+        uint64_t number = 0;
+        for (size_t i = bytes.size(); i-- > 0;) number = (number << 8) | bytes[i];
+        std::string text = "0x";
+        for (int shift = static_cast<int>(bytes.size()) * 8 - 4; shift >= 0; shift -= 4) text.push_back(hex[(number >> shift) & 0xF]);
+        return text + " (" + std::to_string(number) + ")";
+    }
+    std::string text;
+    for (size_t i = 0; i < bytes.size() && i < 64; i++) {
+        text += (i ? " " : "") + std::string{ hex[bytes[i] >> 4], hex[bytes[i] & 0xF] };
+    }
+    return bytes.size() > 64 ? text + " ..." : text;
+}
+
+bool RegistryHive::Open(const std::filesystem::path& hivePath) {
+    std::ifstream file(hivePath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open hive " << hivePath.string() << ".\n";
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (data.size() < HIVE_BASE_BLOCK_SIZE + BIN_HEADER_SIZE || std::memcmp(data.data(), "regf", 4) != 0) {
+        std::cerr << "Error: " << hivePath.string() << " is not a registry hive.\n";
+        data.clear();
+        return false;
+    }
+    uint32_t binsSize = Read32(&data[BASE_BINS_SIZE]);
+    if (binsSize > data.size() - HIVE_BASE_BLOCK_SIZE) {
+        std::cerr << "Error: Hive " << hivePath.string() << " is truncated.\n";
+        data.clear();
+        return false;
+    }
+    data.resize(HIVE_BASE_BLOCK_SIZE + binsSize); // Drops any padding after the last bin
+    path = hivePath;
+    savedSize = data.size();
+    dirtyPages.clear();
+    modified = false;
+    bool checksumValid = Read32(&data[BASE_CHECKSUM]) == BaseBlockChecksum(data.data());
+    dirty = !checksumValid || Read32(&data[BASE_PRIMARY_SEQUENCE]) != Read32(&data[BASE_SECONDARY_SEQUENCE]);
+    if (dirty && RecoverFromLogs()) { // The last write was cut short, the recovered pages are written by the next Save
+        std::cerr << "Warning: " << hivePath.string() << " was not written completely, recovered it from its transaction log.\n";
+        dirty = false;
+    }
+    else if (!checksumValid) { // A damaged base block with no log to repair it, its root and sizes cannot be trusted
+        std::cerr << "Error: The base block of hive " << hivePath.string() << " is corrupt.\n";
+        data.clear();
+        return false;
+    }
+    IndexFreeCells();
+    return true;
+}
+
+// Function to replay the transaction log (.LOG1 or .LOG2, whichever is newer) of a hive whose last write did not
+// finish. Each log entry holds pages of the hive bins; entries are applied in sequence until one is missing or
+// fails its hashes, as a write cut short leaves a partial entry at the end.
+bool RegistryHive::RecoverFromLogs() {
+    uint32_t hiveSequence = Read32(&data[BASE_SECONDARY_SEQUENCE]);
+    std::vector<uint8_t> log;
+    uint32_t logSequence = 0;
+    for (const char* suffix : { ".LOG1", ".LOG2" }) {
+        std::ifstream file(path.string() + suffix, std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (bytes.size() < LOG_BASE_BLOCK_SIZE || std::memcmp(bytes.data(), "regf", 4) != 0 ||
+            Read32(&bytes[BASE_CHECKSUM]) != BaseBlockChecksum(bytes.data()) || Read32(&bytes[BASE_FILE_TYPE]) != FILE_TYPE_LOG) {
+            continue;
+        }
+        uint32_t sequence = Read32(&bytes[BASE_PRIMARY_SEQUENCE]);
+        if (sequence == Read32(&bytes[BASE_SECONDARY_SEQUENCE]) && sequence >= hiveSequence && (log.empty() || sequence > logSequence)) {
+            log.swap(bytes);
+            logSequence = sequence;
+        }
+    }
+    if (log.empty()) {
+        return false;
+    }
+
+    uint32_t expected = logSequence;
+    for (size_t pos = LOG_BASE_BLOCK_SIZE; pos + LOG_ENTRY_HEADER_SIZE <= log.size();) {
+        const uint8_t* entry = &log[pos];
+        uint32_t size = Read32(entry + LOG_ENTRY_SIZE);
+        if (std::memcmp(entry, "HvLE", 4) != 0 || size < LOG_ENTRY_HEADER_SIZE || size % LOG_BASE_BLOCK_SIZE != 0 ||
+            size > log.size() - pos || Read32(entry + LOG_ENTRY_SEQUENCE) != expected ||
+            Read64(entry + LOG_ENTRY_DATA_HASH) != Marvin32(entry + LOG_ENTRY_HEADER_SIZE, size - LOG_ENTRY_HEADER_SIZE) ||
+            Read64(entry + LOG_ENTRY_HEADER_HASH) != Marvin32(entry, LOG_ENTRY_HEADER_HASH)) {
+            break;
+        }
+        uint32_t binsSize = Read32(entry + LOG_ENTRY_BINS_SIZE);
+        uint32_t count = Read32(entry + LOG_ENTRY_PAGE_COUNT);
+        if (binsSize % HIVE_PAGE_SIZE != 0 || count > (size - LOG_ENTRY_HEADER_SIZE) / 8) {
+            break;
+        }
+        // Checks every page reference before changing anything
+        size_t pages = LOG_ENTRY_HEADER_SIZE + size_t(count) * 8;
+        size_t end = pages;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t offset = Read32(entry + LOG_ENTRY_HEADER_SIZE + i * 8);
+            uint32_t length = Read32(entry + LOG_ENTRY_HEADER_SIZE + i * 8 + 4);
+            end += length;
+            if (size_t(offset) + length > binsSize || end > size) {
+                end = SIZE_MAX;
+                break;
+            }
+        }
+        if (end == SIZE_MAX) {
+            break;
+        }
+        data.resize(HIVE_BASE_BLOCK_SIZE + binsSize, 0);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t offset = Read32(entry + LOG_ENTRY_HEADER_SIZE + i * 8);
+            uint32_t length = Read32(entry + LOG_ENTRY_HEADER_SIZE + i * 8 + 4);
+            std::memcpy(&data[HIVE_BASE_BLOCK_SIZE + offset], entry + pages, length);
+            MarkDirty(HIVE_BASE_BLOCK_SIZE + offset, length);
+            pages += length;
+        }
+        expected++;
+        pos += size;
+    }
+    if (expected == logSequence) {
+        return false;
+    }
+    // The hive takes the base block of the log, with the sequence of the last entry applied
+    std::memcpy(data.data(), log.data(), LOG_BASE_BLOCK_SIZE);
+    Write32(&data[BASE_PRIMARY_SEQUENCE], expected - 1);
+    Write32(&data[BASE_SECONDARY_SEQUENCE], expected - 1);
+    Write32(&data[BASE_FILE_TYPE], FILE_TYPE_PRIMARY);
+    Write32(&data[BASE_BINS_SIZE], static_cast<uint32_t>(data.size() - HIVE_BASE_BLOCK_SIZE));
+    MarkDirty(0, HIVE_BASE_BLOCK_SIZE);
+    return true;
+}
+
+void RegistryHive::Create(const std::filesystem::path& hivePath) {
+    path = hivePath;
+    savedSize = 0;
+    dirtyPages.clear();
+    data.assign(HIVE_BASE_BLOCK_SIZE, 0);
+    std::memcpy(data.data(), "regf", 4);
+    Write32(&data[BASE_PRIMARY_SEQUENCE], 1);
+    Write32(&data[BASE_SECONDARY_SEQUENCE], 1);
+    Write64(&data[BASE_TIMESTAMP], FileTimeNow());
+    Write32(&data[20], 1); // Major version
+    Write32(&data[BASE_MINOR_VERSION], 5);
+    Write32(&data[32], 1); // Direct memory load format
+    Write32(&data[44], 1); // Clustering factor
+    freeCells.clear();
+    freeCellStarts.clear();
+    bins.clear();
+    AddBin(4096);
+    dirty = false;
+    modified = true;
+
+    // Security descriptor shared by every key: self-relative, no owner, group or ACLs
+    uint32_t security = AllocateCell(20 + 20);
+    uint8_t* sk = WritableCell(security);
+    std::memcpy(sk, "sk", 2);
+    Write32(sk + 4, security); // The only security cell links to itself both ways
+    Write32(sk + 8, security);
+    Write32(sk + SK_REFERENCES, 1);
+    Write32(sk + 16, 20);
+    sk[20] = 1; // Revision
+    Write16(sk + 22, 0x8000); // SE_SELF_RELATIVE
+
+    uint32_t root = AllocateCell(NK_NAME + 4);
+    uint8_t* nk = WritableCell(root);
+    std::memcpy(nk, "nk", 2);
+    Write16(nk + NK_FLAGS, KEY_HIVE_ENTRY | KEY_NO_DELETE | KEY_COMP_NAME);
+    Write64(nk + NK_WRITE_TIME, FileTimeNow());
+    Write32(nk + NK_PARENT, 0);
+    Write32(nk + NK_SUBKEY_LIST, HIVE_NO_CELL);
+    Write32(nk + NK_VOLATILE_SUBKEY_LIST, HIVE_NO_CELL);
+    Write32(nk + NK_VALUE_LIST, HIVE_NO_CELL);
+    Write32(nk + NK_SECURITY, security);
+    Write32(nk + NK_CLASS, HIVE_NO_CELL);
+    Write16(nk + NK_NAME_LENGTH, 4);
+    std::memcpy(nk + NK_NAME, "ROOT", 4);
+    Write32(&data[BASE_ROOT_CELL], root);
+}
+
+// Function to write the changed pages to the hive file. As Windows does, the pages go to the transaction log first,
+// then the primary sequence number is raised to mark the file as being written, the pages are written in place and
+// the secondary sequence number is raised to match. A crash in between leaves the numbers unequal, and Open
+// replays the log.
+bool RegistryHive::Save() {
+    if (dirty) {
+        std::cerr << "Error: " << path.string() << " has changes in its transaction logs that MODWIN could not recover.\n";
+        return false;
+    }
+    uint32_t sequence = Read32(&data[BASE_SECONDARY_SEQUENCE]) + 1;
+    Write64(&data[BASE_TIMESTAMP], FileTimeNow());
+    Write32(&data[BASE_BINS_SIZE], static_cast<uint32_t>(data.size() - HIVE_BASE_BLOCK_SIZE));
+    Write32(&data[BASE_FILE_TYPE], FILE_TYPE_PRIMARY);
+
+    // Runs of dirty pages, as offsets from the first hive bin
+    std::vector<std::pair<uint32_t, uint32_t>> runs;
+    dirtyPages.resize((data.size() + HIVE_PAGE_SIZE - 1) / HIVE_PAGE_SIZE, false);
+    for (size_t page = 1; page < dirtyPages.size(); page++) {
+        if (!dirtyPages[page]) {
+            continue;
+        }
+        uint32_t offset = static_cast<uint32_t>(page * HIVE_PAGE_SIZE - HIVE_BASE_BLOCK_SIZE);
+        uint32_t length = static_cast<uint32_t>(std::min(HIVE_PAGE_SIZE, data.size() - page * HIVE_PAGE_SIZE));
+        if (!runs.empty() && runs.back().first + runs.back().second == offset) {
+            runs.back().second += length;
+        }
+        else {
+            runs.emplace_back(offset, length);
+        }
+    }
+
+    bool newFile = savedSize == 0; // Nothing on disk to protect, so no log
+    if (!newFile && !WriteLog(runs, sequence)) {
+        std::cerr << "Error: Failed to write the transaction log of hive " << path.string() << ".\n";
+        return false;
+    }
+    PatchFileWriter file;
+    bool ok = file.Open(path, newFile);
+    if (ok) {
+        Write32(&data[BASE_PRIMARY_SEQUENCE], sequence);
+        Write32(&data[BASE_CHECKSUM], BaseBlockChecksum(data.data()));
+        ok = file.WriteAt(0, data.data(), HIVE_BASE_BLOCK_SIZE) && file.Flush();
+    }
+    for (size_t i = 0; ok && i < runs.size(); i++) {
+        ok = file.WriteAt(HIVE_BASE_BLOCK_SIZE + runs[i].first, &data[HIVE_BASE_BLOCK_SIZE + runs[i].first], runs[i].second);
+    }
+    if (ok) {
+        Write32(&data[BASE_SECONDARY_SEQUENCE], sequence);
+        Write32(&data[BASE_CHECKSUM], BaseBlockChecksum(data.data()));
+        ok = file.Flush() && file.WriteAt(0, data.data(), HIVE_BASE_BLOCK_SIZE) && file.Flush();
+    }
+    if (!ok) {
+        std::cerr << "Error: Failed to write hive " << path.string() << ".\n";
+        return false;
+    }
+    dirtyPages.assign(dirtyPages.size(), false);
+    savedSize = data.size();
+    modified = false;
+    return true;
+}
+
+// Function to write the transaction log for a save: a base block with the sequence number of the save, then one
+// log entry with the pages in 'runs'
+bool RegistryHive::WriteLog(const std::vector<std::pair<uint32_t, uint32_t>>& runs, uint32_t sequence) {
+    size_t size = LOG_ENTRY_HEADER_SIZE + runs.size() * 8;
+    for (const auto& run : runs) {
+        size += run.second;
+    }
+    size = (size + LOG_BASE_BLOCK_SIZE - 1) / LOG_BASE_BLOCK_SIZE * LOG_BASE_BLOCK_SIZE;
+    std::vector<uint8_t> log(LOG_BASE_BLOCK_SIZE + size, 0);
+    std::memcpy(log.data(), data.data(), LOG_BASE_BLOCK_SIZE);
+    Write32(&log[BASE_PRIMARY_SEQUENCE], sequence);
+    Write32(&log[BASE_SECONDARY_SEQUENCE], sequence);
+    Write32(&log[BASE_FILE_TYPE], FILE_TYPE_LOG);
+    Write32(&log[BASE_CHECKSUM], BaseBlockChecksum(log.data()));
+
+    uint8_t* entry = &log[LOG_BASE_BLOCK_SIZE];
+    std::memcpy(entry, "HvLE", 4);
+    Write32(entry + LOG_ENTRY_SIZE, static_cast<uint32_t>(size));
+    Write32(entry + LOG_ENTRY_SEQUENCE, sequence);
+    Write32(entry + LOG_ENTRY_BINS_SIZE, static_cast<uint32_t>(data.size() - HIVE_BASE_BLOCK_SIZE));
+    Write32(entry + LOG_ENTRY_PAGE_COUNT, static_cast<uint32_t>(runs.size()));
+    size_t pos = LOG_ENTRY_HEADER_SIZE + runs.size() * 8;
+    for (size_t i = 0; i < runs.size(); i++) {
+        Write32(entry + LOG_ENTRY_HEADER_SIZE + i * 8, runs[i].first);
+        Write32(entry + LOG_ENTRY_HEADER_SIZE + i * 8 + 4, runs[i].second);
+        std::memcpy(entry + pos, &data[HIVE_BASE_BLOCK_SIZE + runs[i].first], runs[i].second);
+        pos += runs[i].second;
+    }
+    Write64(entry + LOG_ENTRY_DATA_HASH, Marvin32(entry + LOG_ENTRY_HEADER_SIZE, size - LOG_ENTRY_HEADER_SIZE));
+    Write64(entry + LOG_ENTRY_HEADER_HASH, Marvin32(entry, LOG_ENTRY_HEADER_HASH));
+
+    PatchFileWriter file;
+    return file.Open(path.string() + ".LOG1", true) && file.WriteAt(0, log.data(), log.size()) && file.Flush();
+}
+
+// Function to get a cell for changing it, marking the pages it spans as dirty
+uint8_t* RegistryHive::WritableCell(uint32_t offset) {
+    int32_t size = static_cast<int32_t>(Read32(&data[HIVE_BASE_BLOCK_SIZE + offset]));
+    MarkDirty(HIVE_BASE_BLOCK_SIZE + offset, size < 0 ? uint32_t(-size) : uint32_t(size));
+    return data.data() + HIVE_BASE_BLOCK_SIZE + offset + 4;
+}
+
+// Function to mark the pages holding 'size' bytes at 'fileOffset' as changed
+void RegistryHive::MarkDirty(size_t fileOffset, size_t size) {
+    size_t pages = (data.size() + HIVE_PAGE_SIZE - 1) / HIVE_PAGE_SIZE;
+    dirtyPages.resize(pages, false);
+    for (size_t page = fileOffset / HIVE_PAGE_SIZE; size > 0 && page < pages && page * HIVE_PAGE_SIZE < fileOffset + size; page++) {
+        dirtyPages[page] = true;
+    }
+    modified = true;
+}
+
+// True when 'offset' is an allocated cell with at least 'minSize' bytes of data
+bool RegistryHive::ValidCell(uint32_t offset, uint32_t minSize) const {
+    if (offset == HIVE_NO_CELL || size_t(offset) + HIVE_BASE_BLOCK_SIZE + 4 > data.size()) {
+        return false;
+    }
+    int32_t size = static_cast<int32_t>(Read32(&data[HIVE_BASE_BLOCK_SIZE + offset]));
+    return size < 0 && uint32_t(-size) >= minSize + 4 && size_t(offset) + HIVE_BASE_BLOCK_SIZE + uint32_t(-size) <= data.size();
+}
+
+// Function to list the bins and the free cells in them, so new cells can reuse free space
+void RegistryHive::IndexFreeCells() {
+    freeCells.clear();
+    freeCellStarts.clear();
+    bins.clear();
+    uint32_t binStart = 0;
+    uint32_t binsSize = static_cast<uint32_t>(data.size() - HIVE_BASE_BLOCK_SIZE);
+    while (binStart + BIN_HEADER_SIZE <= binsSize) {
+        const uint8_t* bin = &data[HIVE_BASE_BLOCK_SIZE + binStart];
+        uint32_t binSize = Read32(bin + 8);
+        if (std::memcmp(bin, "hbin", 4) != 0 || binSize < BIN_HEADER_SIZE || binSize > binsSize - binStart) {
+            break;
+        }
+        bins[binStart] = binStart + binSize;
+        uint32_t cell = binStart + BIN_HEADER_SIZE;
+        while (cell + 4 <= binStart + binSize) {
+            int32_t size = static_cast<int32_t>(Read32(&data[HIVE_BASE_BLOCK_SIZE + cell]));
+            uint32_t length = size < 0 ? uint32_t(-size) : uint32_t(size);
+            if (length < 8 || cell + length > binStart + binSize) {
+                break;
+            }
+            if (size > 0) {
+                AddFreeCell(cell, length);
+            }
+            cell += length;
+        }
+        binStart += binSize;
+    }
+}
+
+// Function to append a hive bin of 'size' bytes (a multiple of 4096) holding one free cell
+void RegistryHive::AddBin(uint32_t size) {
+    uint32_t binStart = static_cast<uint32_t>(data.size() - HIVE_BASE_BLOCK_SIZE);
+    data.resize(data.size() + size, 0);
+    uint8_t* bin = &data[HIVE_BASE_BLOCK_SIZE + binStart];
+    std::memcpy(bin, "hbin", 4);
+    Write32(bin + 4, binStart);
+    Write32(bin + 8, size);
+    Write64(bin + 20, FileTimeNow());
+    Write32(bin + BIN_HEADER_SIZE, size - BIN_HEADER_SIZE);
+    bins[binStart] = binStart + size;
+    AddFreeCell(binStart + BIN_HEADER_SIZE, size - BIN_HEADER_SIZE);
+    MarkDirty(HIVE_BASE_BLOCK_SIZE + binStart, size);
+    Write32(&data[BASE_BINS_SIZE], static_cast<uint32_t>(data.size() - HIVE_BASE_BLOCK_SIZE));
+}
+
+// Function to allocate a cell for 'size' bytes of data, taking the smallest free cell that fits or a new bin.
+// Returns the offset of the cell; pointers into the hive are invalid afterwards.
+uint32_t RegistryHive::AllocateCell(uint32_t size) {
+    uint32_t length = (size + 4 + 7) & ~7u;
+    auto fit = freeCells.lower_bound(length);
+    if (fit == freeCells.end()) {
+        AddBin((length + BIN_HEADER_SIZE + 4095) & ~4095u);
+        fit = freeCells.lower_bound(length);
+    }
+    uint32_t cell = fit->second;
+    uint32_t freeLength = fit->first;
+    RemoveFreeCell(cell, freeLength);
+    if (freeLength - length >= 16) { // Splits off the rest as a new free cell
+        Write32(&data[HIVE_BASE_BLOCK_SIZE + cell + length], freeLength - length);
+        AddFreeCell(cell + length, freeLength - length);
+        MarkDirty(HIVE_BASE_BLOCK_SIZE + cell + length, 4);
+    }
+    else {
+        length = freeLength;
+    }
+    Write32(&data[HIVE_BASE_BLOCK_SIZE + cell], static_cast<uint32_t>(-static_cast<int32_t>(length)));
+    std::fill(data.begin() + HIVE_BASE_BLOCK_SIZE + cell + 4, data.begin() + HIVE_BASE_BLOCK_SIZE + cell + length, 0);
+    MarkDirty(HIVE_BASE_BLOCK_SIZE + cell, length);
+    return cell;
+}
+
+// Function to free a cell, merging it with the free cells right before and after it in the same bin, so space
+// freed piece by piece can hold a larger cell again
+void RegistryHive::FreeCell(uint32_t offset) {
+    if (!ValidCell(offset, 0)) {
+        return;
+    }
+    uint32_t length = uint32_t(-static_cast<int32_t>(Read32(&data[HIVE_BASE_BLOCK_SIZE + offset])));
+    auto bin = bins.upper_bound(offset);
+    uint32_t binStart = bin == bins.begin() ? 0 : std::prev(bin)->first;
+    uint32_t binEnd = bin == bins.begin() ? 0 : std::prev(bin)->second;
+    auto next = freeCellStarts.find(offset + length);
+    if (next != freeCellStarts.end() && next->first < binEnd) {
+        length += next->second;
+        RemoveFreeCell(next->first, next->second);
+    }
+    auto previous = freeCellStarts.lower_bound(offset);
+    if (previous != freeCellStarts.begin() && (--previous)->first >= binStart && previous->first + previous->second == offset) {
+        offset = previous->first;
+        length += previous->second;
+        RemoveFreeCell(previous->first, previous->second);
+    }
+    Write32(&data[HIVE_BASE_BLOCK_SIZE + offset], length);
+    AddFreeCell(offset, length);
+    MarkDirty(HIVE_BASE_BLOCK_SIZE + offset, 4);
+}
+
+// Functions to keep a free cell in both indexes, by size for allocating and by offset for merging
+void RegistryHive::AddFreeCell(uint32_t offset, uint32_t length) {
+    freeCells.emplace(length, offset);
+    freeCellStarts[offset] = length;
+}
+
+void RegistryHive::RemoveFreeCell(uint32_t offset, uint32_t length) {
+    auto range = freeCells.equal_range(length);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == offset) {
+            freeCells.erase(it);
+            break;
+        }
+    }
+    freeCellStarts.erase(offset);
+}
+
+uint32_t RegistryHive::Root() const {
+    uint32_t root = data.size() > BASE_ROOT_CELL ? Read32(&data[BASE_ROOT_CELL]) : HIVE_NO_CELL;
+    return ValidCell(root, NK_NAME) ? root : HIVE_NO_CELL;
+}
+
+std::string RegistryHive::KeyName(uint32_t key) const {
+    if (!ValidCell(key, NK_NAME)) {
+        return "";
+    }
+    const uint8_t* nk = Cell(key);
+    uint16_t length = Read16(nk + NK_NAME_LENGTH);
+    if (!ValidCell(key, NK_NAME + length)) {
+        return "";
+    }
+    return ToUtf8(StoredName(nk + NK_NAME, length, Read16(nk + NK_FLAGS) & KEY_COMP_NAME));
+}
+
+uint64_t RegistryHive::KeyWriteTime(uint32_t key) const {
+    return ValidCell(key, NK_NAME) ? Read64(Cell(key) + NK_WRITE_TIME) : 0;
+}
+
+// Function to collect the keys of a subkey list of any kind: lf and lh (offset and hint), li (offsets) and ri
+// (a list of lists)
+std::vector<uint32_t> RegistryHive::ReadSubkeyList(uint32_t list) const {
+    std::vector<uint32_t> keys;
+    if (!ValidCell(list, 4)) {
+        return keys;
+    }
+    const uint8_t* cell = Cell(list);
+    uint16_t count = Read16(cell + 2);
+    bool wide = cell[0] == 'l' && (cell[1] == 'f' || cell[1] == 'h');
+    bool index = cell[0] == 'r' && cell[1] == 'i';
+    if (!(wide || index || (cell[0] == 'l' && cell[1] == 'i')) || !ValidCell(list, 4 + count * (wide ? 8u : 4u))) {
+        return keys;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        uint32_t entry = Read32(cell + 4 + i * (wide ? 8 : 4));
+        if (index) {
+            std::vector<uint32_t> part = ReadSubkeyList(entry);
+            keys.insert(keys.end(), part.begin(), part.end());
+        }
+        else {
+            keys.push_back(entry);
+        }
+    }
+    return keys;
+}
+
+std::vector<uint32_t> RegistryHive::Subkeys(uint32_t key) const {
+    if (!ValidCell(key, NK_NAME)) {
+        return {};
+    }
+    return ReadSubkeyList(Read32(Cell(key) + NK_SUBKEY_LIST));
+}
+
+// Function to get the name of a key uppercased, the order subkey lists are sorted in
+std::u16string RegistryHive::SortName(uint32_t key) const {
+    if (!ValidCell(key, NK_NAME)) {
+        return std::u16string();
+    }
+    const uint8_t* nk = Cell(key);
+    uint16_t length = Read16(nk + NK_NAME_LENGTH);
+    if (!ValidCell(key, NK_NAME + length)) {
+        return std::u16string();
+    }
+    return Upcase(StoredName(nk + NK_NAME, length, Read16(nk + NK_FLAGS) & KEY_COMP_NAME));
+}
+
+// Binary search, since subkey lists are kept sorted; keys with thousands of subkeys (CLSID) stay fast
+uint32_t RegistryHive::FindSubkey(uint32_t key, std::string_view name) const {
+    std::u16string wanted = Upcase(ToUtf16(name));
+    std::vector<uint32_t> subkeys = Subkeys(key);
+    auto found = std::lower_bound(subkeys.begin(), subkeys.end(), wanted, [this](uint32_t subkey, const std::u16string& target) {
+        return SortName(subkey) < target;
+    });
+    return found != subkeys.end() && SortName(*found) == wanted ? *found : HIVE_NO_CELL;
+}
+
+uint32_t RegistryHive::OpenKey(std::string_view keyPath) const {
+    uint32_t key = Root();
+    size_t start = 0;
+    while (key != HIVE_NO_CELL && start < keyPath.size()) {
+        size_t end = keyPath.find('\\', start);
+        std::string_view part = keyPath.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        if (!part.empty()) {
+            key = FindSubkey(key, part);
+        }
+        start = end == std::string_view::npos ? keyPath.size() : end + 1;
+    }
+    return key;
+}
+
+std::vector<uint32_t> RegistryHive::Values(uint32_t key) const {
+    std::vector<uint32_t> values;
+    if (!ValidCell(key, NK_NAME)) {
+        return values;
+    }
+    uint32_t count = Read32(Cell(key) + NK_VALUE_COUNT);
+    uint32_t list = Read32(Cell(key) + NK_VALUE_LIST);
+    if (count == 0 || !ValidCell(list, count * 4)) {
+        return values;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        values.push_back(Read32(Cell(list) + i * 4));
+    }
+    return values;
+}
+
+std::string RegistryHive::ValueName(uint32_t value) const {
+    if (!ValidCell(value, VK_NAME)) {
+        return "";
+    }
+    const uint8_t* vk = Cell(value);
+    uint16_t length = Read16(vk + VK_NAME_LENGTH);
+    if (!ValidCell(value, VK_NAME + length)) {
+        return "";
+    }
+    return ToUtf8(StoredName(vk + VK_NAME, length, Read16(vk + VK_FLAGS) & VALUE_COMP_NAME));
+}
+
+uint32_t RegistryHive::FindValue(uint32_t key, std::string_view name) const {
+    std::u16string wanted = Upcase(ToUtf16(name));
+    for (uint32_t value : Values(key)) {
+        if (ValidCell(value, VK_NAME) && Upcase(ToUtf16(ValueName(value))) == wanted) {
+            return value;
+        }
+    }
+    return HIVE_NO_CELL;
+}
+
+uint32_t RegistryHive::ValueType(uint32_t value) const {
+    return ValidCell(value, VK_NAME) ? Read32(Cell(value) + VK_TYPE) : HIVE_REG_NONE;
+}
+
+HiveData RegistryHive::ValueDataView(uint32_t value) const {
+    HiveData view;
+    if (!ValidCell(value, VK_NAME)) {
+        return view;
+    }
+    const uint8_t* vk = Cell(value);
+    uint32_t size = Read32(vk + VK_DATA_SIZE);
+    if (size & DATA_INLINE) { // Up to 4 bytes kept in the value itself
+        view.data = vk + VK_DATA;
+        view.size = std::min<uint32_t>(size & ~DATA_INLINE, 4);
+        return view;
+    }
+    uint32_t cell = Read32(vk + VK_DATA);
+    if (size == 0 || !ValidCell(cell, std::min(size, BIG_DATA_SEGMENT))) {
+        return view;
+    }
+    if (size > BIG_DATA_SEGMENT && Cell(cell)[0] == 'd' && Cell(cell)[1] == 'b') {
+        return view; // Split into segments
+    }
+    view.data = Cell(cell);
+    view.size = size;
+    return ValidCell(cell, size) ? view : HiveData();
+}
+
+std::vector<uint8_t> RegistryHive::ReadValueData(uint32_t value) const {
+    HiveData view = ValueDataView(value);
+    if (view.data) {
+        return std::vector<uint8_t>(view.data, view.data + view.size);
+    }
+    std::vector<uint8_t> bytes;
+    if (!ValidCell(value, VK_NAME)) {
+        return bytes;
+    }
+    uint32_t size = Read32(Cell(value) + VK_DATA_SIZE);
+    uint32_t db = Read32(Cell(value) + VK_DATA);
+    if ((size & DATA_INLINE) || !ValidCell(db, 8) || Cell(db)[0] != 'd' || Cell(db)[1] != 'b') {
+        return bytes;
+    }
+    uint16_t count = Read16(Cell(db) + 2);
+    uint32_t list = Read32(Cell(db) + 4);
+    if (!ValidCell(list, count * 4u)) {
+        return bytes;
+    }
+    for (uint16_t i = 0; i < count && bytes.size() < size; i++) {
+        uint32_t segment = Read32(Cell(list) + i * 4);
+        uint32_t part = std::min<uint32_t>(BIG_DATA_SEGMENT, size - static_cast<uint32_t>(bytes.size()));
+        if (!ValidCell(segment, part)) {
+            return std::vector<uint8_t>();
+        }
+        bytes.insert(bytes.end(), Cell(segment), Cell(segment) + part);
+    }
+    return bytes;
+}
+
+// Function to get the bytes per entry of a subkey list: 8 for lf and lh (offset and hint), 4 for li and ri, 0 when
+// 'list' is not a subkey list
+static uint32_t ListEntrySize(const uint8_t* cell) {
+    if (cell[0] == 'l' && (cell[1] == 'f' || cell[1] == 'h')) {
+        return 8;
+    }
+    return (cell[0] == 'l' && cell[1] == 'i') || (cell[0] == 'r' && cell[1] == 'i') ? 4 : 0;
+}
+
+// Function to check that a key can be added to the subkey list 'list' in place: none yet, a leaf, or an index of
+// leaves, none of them full
+bool RegistryHive::SubkeyListEditable(uint32_t list) const {
+    if (list == HIVE_NO_CELL) {
+        return true;
+    }
+    if (!ValidCell(list, 4) || ListEntrySize(Cell(list)) == 0 || Read16(Cell(list) + 2) == 0xFFFF ||
+        !ValidCell(list, 4 + Read16(Cell(list) + 2) * ListEntrySize(Cell(list)))) {
+        return false;
+    }
+    if (Cell(list)[0] != 'r') {
+        return true;
+    }
+    if (Read16(Cell(list) + 2) == 0) {
+        return false;
+    }
+    for (uint16_t i = 0; i < Read16(Cell(list) + 2); i++) {
+        uint32_t leaf = Read32(Cell(list) + 4 + i * 4);
+        if (!ValidCell(leaf, 4) || ListEntrySize(Cell(leaf)) == 0 || Cell(leaf)[0] == 'r' || Read16(Cell(leaf) + 2) == 0xFFFF ||
+            !ValidCell(leaf, 4 + Read16(Cell(leaf) + 2) * ListEntrySize(Cell(leaf)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to write entry 'index' of a subkey list: the offset, and for lh the hash of the key's name or for lf its
+// first four characters
+void RegistryHive::WriteListEntry(uint32_t list, uint16_t index, uint32_t entry) {
+    uint32_t entrySize = ListEntrySize(Cell(list));
+    uint8_t* cell = WritableCell(list);
+    Write32(cell + 4 + index * entrySize, entry);
+    if (entrySize == 8) {
+        const uint8_t* nk = Cell(entry);
+        std::u16string name = StoredName(nk + NK_NAME, Read16(nk + NK_NAME_LENGTH), Read16(nk + NK_FLAGS) & KEY_COMP_NAME);
+        if (cell[1] == 'h') {
+            Write32(cell + 8 + index * 8, NameHash(Upcase(name)));
+        }
+        else {
+            Write32(cell + 8 + index * 8, 0);
+            for (size_t j = 0; j < 4 && j < name.size(); j++) cell[8 + index * 8 + j] = uint8_t(name[j]);
+        }
+    }
+}
+
+// Function to insert 'entry' at 'index' of a subkey list. The entries after it move up within the cell when it has
+// room; otherwise the list moves to a larger cell, with room for a few more entries, and the old one is freed.
+// Returns the offset of the list.
+uint32_t RegistryHive::InsertListEntry(uint32_t list, uint16_t index, uint32_t entry) {
+    uint32_t entrySize = ListEntrySize(Cell(list));
+    uint16_t count = Read16(Cell(list) + 2);
+    uint32_t capacity = (uint32_t(-static_cast<int32_t>(Read32(&data[HIVE_BASE_BLOCK_SIZE + list]))) - 8) / entrySize;
+    if (count >= capacity) {
+        uint32_t grown = std::max<uint32_t>(count + 4u, count * 3u / 2);
+        if (Cell(list)[0] == 'l') { // A leaf only grows until it is split
+            grown = std::max<uint32_t>(std::min<uint32_t>(grown, LEAF_MAX_KEYS + 1u), count + 1u);
+        }
+        uint32_t moved = AllocateCell(4 + std::min<uint32_t>(grown, 0xFFFF) * entrySize);
+        std::memcpy(WritableCell(moved), Cell(list), 4 + count * entrySize);
+        FreeCell(list);
+        list = moved;
+    }
+    uint8_t* cell = WritableCell(list);
+    std::memmove(cell + 4 + (index + 1) * entrySize, cell + 4 + index * entrySize, (count - index) * entrySize);
+    Write16(cell + 2, static_cast<uint16_t>(count + 1));
+    WriteListEntry(list, index, entry);
+    return list;
+}
+
+// Function to remove entry 'index' of a subkey list in place; the cell keeps its size for later inserts
+void RegistryHive::RemoveListEntry(uint32_t list, uint16_t index) {
+    uint32_t entrySize = ListEntrySize(Cell(list));
+    uint16_t count = Read16(Cell(list) + 2);
+    uint8_t* cell = WritableCell(list);
+    std::memmove(cell + 4 + index * entrySize, cell + 4 + (index + 1) * entrySize, (count - index - 1) * entrySize);
+    Write16(cell + 2, static_cast<uint16_t>(count - 1));
+}
+
+// Function to move the upper half of a full leaf into a new leaf of the same kind. Returns the new leaf.
+uint32_t RegistryHive::SplitLeaf(uint32_t leaf) {
+    uint32_t entrySize = ListEntrySize(Cell(leaf));
+    uint16_t count = Read16(Cell(leaf) + 2);
+    uint16_t kept = count / 2;
+    uint32_t upper = AllocateCell(4 + (count - kept + 4u) * entrySize);
+    uint8_t* cell = WritableCell(upper);
+    std::memcpy(cell, Cell(leaf), 2);
+    Write16(cell + 2, static_cast<uint16_t>(count - kept));
+    std::memcpy(cell + 4, Cell(leaf) + 4 + kept * entrySize, (count - kept) * entrySize);
+    Write16(WritableCell(leaf) + 2, kept);
+    return upper;
+}
+
+// Function to find where a key named 'upcased' goes in a sorted leaf
+uint16_t RegistryHive::LeafPosition(uint32_t leaf, const std::u16string& upcased) const {
+    uint32_t entrySize = ListEntrySize(Cell(leaf));
+    uint16_t low = 0;
+    uint16_t high = Read16(Cell(leaf) + 2);
+    while (low < high) {
+        uint16_t middle = static_cast<uint16_t>(low + (high - low) / 2);
+        if (SortName(Read32(Cell(leaf) + 4 + middle * entrySize)) < upcased) {
+            low = static_cast<uint16_t>(middle + 1);
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Function to add 'key' to the subkey list 'list' (checked by SubkeyListEditable), keeping it sorted by uppercased
+// name. Only the leaf the key goes into is rewritten; a leaf that grows past LEAF_MAX_KEYS is split in two under an
+// ri index, made for the purpose when the list was a single leaf. Returns the offset of the list.
+uint32_t RegistryHive::InsertSubkey(uint32_t list, uint32_t key, const std::u16string& upcased) {
+    if (list == HIVE_NO_CELL) { // First subkey, "lh" (or "lf" for hives older than version 1.5)
+        list = AllocateCell(4 + 4 * 8);
+        uint8_t* cell = WritableCell(list);
+        cell[0] = 'l';
+        cell[1] = Read32(&data[BASE_MINOR_VERSION]) >= 5 ? 'h' : 'f';
+        return InsertListEntry(list, 0, key);
+    }
+    if (Cell(list)[0] != 'r') {
+        list = InsertListEntry(list, LeafPosition(list, upcased), key);
+        if (Read16(Cell(list) + 2) <= LEAF_MAX_KEYS) {
+            return list;
+        }
+        uint32_t upper = SplitLeaf(list);
+        uint32_t index = AllocateCell(4 + 4 * 4);
+        uint8_t* cell = WritableCell(index);
+        cell[0] = 'r';
+        cell[1] = 'i';
+        Write16(cell + 2, 2);
+        Write32(cell + 4, list);
+        Write32(cell + 8, upper);
+        return index;
+    }
+
+    // The key goes into the first leaf whose last key sorts after it, or the last leaf
+    uint16_t count = Read16(Cell(list) + 2);
+    uint16_t low = 0;
+    uint16_t high = count - 1;
+    while (low < high) {
+        uint16_t middle = static_cast<uint16_t>(low + (high - low) / 2);
+        uint32_t leaf = Read32(Cell(list) + 4 + middle * 4);
+        uint16_t leafCount = Read16(Cell(leaf) + 2);
+        if (leafCount == 0 || SortName(Read32(Cell(leaf) + 4 + (leafCount - 1) * ListEntrySize(Cell(leaf)))) < upcased) {
+            low = static_cast<uint16_t>(middle + 1);
+        }
+        else {
+            high = middle;
+        }
+    }
+    uint32_t leaf = Read32(Cell(list) + 4 + low * 4);
+    uint32_t grown = InsertListEntry(leaf, LeafPosition(leaf, upcased), key);
+    if (grown != leaf) {
+        Write32(WritableCell(list) + 4 + low * 4, grown);
+    }
+    if (Read16(Cell(grown) + 2) > LEAF_MAX_KEYS) {
+        list = InsertListEntry(list, static_cast<uint16_t>(low + 1), SplitLeaf(grown));
+    }
+    return list;
+}
+
+// Function to take 'key' out of the subkey list 'list' in place. A leaf left empty is freed and dropped from its
+// index. Returns the offset of the list, HIVE_NO_CELL once it is empty.
+uint32_t RegistryHive::RemoveSubkey(uint32_t list, uint32_t key) {
+    if (!ValidCell(list, 4) || ListEntrySize(Cell(list)) == 0) {
+        return list;
+    }
+    bool index = Cell(list)[0] == 'r';
+    uint16_t leaves = index ? Read16(Cell(list) + 2) : 1;
+    for (uint16_t i = 0; i < leaves; i++) {
+        uint32_t leaf = index ? Read32(Cell(list) + 4 + i * 4) : list;
+        if (!ValidCell(leaf, 4) || ListEntrySize(Cell(leaf)) == 0) {
+            continue;
+        }
+        uint32_t entrySize = ListEntrySize(Cell(leaf));
+        uint16_t count = Read16(Cell(leaf) + 2);
+        for (uint16_t j = 0; j < count && ValidCell(leaf, 4 + (j + 1u) * entrySize); j++) {
+            if (Read32(Cell(leaf) + 4 + j * entrySize) != key) {
+                continue;
+            }
+            RemoveListEntry(leaf, j);
+            if (count > 1) {
+                return list;
+            }
+            FreeCell(leaf);
+            if (index && leaves > 1) {
+                RemoveListEntry(list, i);
+                return list;
+            }
+            if (index) {
+                FreeCell(list);
+            }
+            return HIVE_NO_CELL;
+        }
+    }
+    return list;
+}
+
+void RegistryHive::FreeSubkeyList(uint32_t list) {
+    if (!ValidCell(list, 4)) {
+        return;
+    }
+    if (Cell(list)[0] == 'r' && Cell(list)[1] == 'i') {
+        uint16_t count = Read16(Cell(list) + 2);
+        for (uint16_t i = 0; i < count && ValidCell(list, 4 + i * 4u + 4); i++) {
+            FreeCell(Read32(Cell(list) + 4 + i * 4));
+        }
+    }
+    FreeCell(list);
+}
+
+// Function to mark a key as written now
+void RegistryHive::Touch(uint32_t key) {
+    Write64(WritableCell(key) + NK_WRITE_TIME, FileTimeNow());
+}
+
+uint32_t RegistryHive::CreateKey(uint32_t parent, std::string_view name) {
+    if (name.empty() || name.find('\\') != std::string_view::npos || !ValidCell(parent, NK_NAME)) {
+        return HIVE_NO_CELL;
+    }
+    uint32_t existing = FindSubkey(parent, name);
+    if (existing != HIVE_NO_CELL) {
+        return existing;
+    }
+    // Checked before anything is allocated, so a list that cannot take the key leaks no cell
+    if (!SubkeyListEditable(Read32(Cell(parent) + NK_SUBKEY_LIST))) {
+        return HIVE_NO_CELL;
+    }
+    bool compressed = false;
+    std::vector<uint8_t> stored = StoreName(name, compressed);
+    uint32_t key = AllocateCell(static_cast<uint32_t>(NK_NAME + stored.size()));
+    uint32_t security = Read32(Cell(parent) + NK_SECURITY);
+    uint8_t* nk = WritableCell(key);
+    std::memcpy(nk, "nk", 2);
+    Write16(nk + NK_FLAGS, compressed ? KEY_COMP_NAME : 0);
+    Write64(nk + NK_WRITE_TIME, FileTimeNow());
+    Write32(nk + NK_PARENT, parent);
+    Write32(nk + NK_SUBKEY_LIST, HIVE_NO_CELL);
+    Write32(nk + NK_VOLATILE_SUBKEY_LIST, HIVE_NO_CELL);
+    Write32(nk + NK_VALUE_LIST, HIVE_NO_CELL);
+    Write32(nk + NK_SECURITY, security);
+    Write32(nk + NK_CLASS, HIVE_NO_CELL);
+    Write16(nk + NK_NAME_LENGTH, static_cast<uint16_t>(stored.size()));
+    std::memcpy(nk + NK_NAME, stored.data(), stored.size());
+    if (ValidCell(security, 16)) { // The new key shares its parent's security descriptor
+        Write32(WritableCell(security) + SK_REFERENCES, Read32(Cell(security) + SK_REFERENCES) + 1);
+    }
+
+    // Inserts the key into the parent's list, which stays sorted by uppercased name
+    std::u16string upcased = Upcase(ToUtf16(name));
+    uint32_t list = InsertSubkey(Read32(Cell(parent) + NK_SUBKEY_LIST), key, upcased);
+
+    uint8_t* parentNk = WritableCell(parent);
+    Write32(parentNk + NK_SUBKEY_COUNT, Read32(parentNk + NK_SUBKEY_COUNT) + 1);
+    Write32(parentNk + NK_SUBKEY_LIST, list);
+    uint32_t maxName = Read32(parentNk + NK_MAX_SUBKEY_NAME);
+    uint32_t nameBytes = static_cast<uint32_t>(upcased.size() * 2);
+    if (nameBytes > (maxName & 0xFFFF)) { // The upper bits hold flags on newer hives
+        Write32(parentNk + NK_MAX_SUBKEY_NAME, (maxName & 0xFFFF0000) | nameBytes);
+    }
+    Touch(parent);
+    return key;
+}
+
+// Function to free a key and everything below it, without touching its parent
+void RegistryHive::FreeKeyTree(uint32_t key) {
+    for (uint32_t subkey : Subkeys(key)) {
+        if (ValidCell(subkey, NK_NAME)) {
+            FreeKeyTree(subkey);
+        }
+    }
+    for (uint32_t value : Values(key)) {
+        FreeValueData(value);
+        FreeCell(value);
+    }
+    FreeCell(Read32(Cell(key) + NK_VALUE_LIST));
+    FreeSubkeyList(Read32(Cell(key) + NK_SUBKEY_LIST));
+    if (Read16(Cell(key) + NK_CLASS_LENGTH) > 0) {
+        FreeCell(Read32(Cell(key) + NK_CLASS));
+    }
+    uint32_t security = Read32(Cell(key) + NK_SECURITY);
+    if (ValidCell(security, 16)) { // Drops the reference, and the descriptor itself once no key uses it
+        uint32_t references = Read32(Cell(security) + SK_REFERENCES);
+        Write32(WritableCell(security) + SK_REFERENCES, references - 1);
+        uint32_t next = Read32(Cell(security) + 4);
+        uint32_t previous = Read32(Cell(security) + 8);
+        if (references <= 1 && next != security && ValidCell(next, 16) && ValidCell(previous, 16)) {
+            Write32(WritableCell(previous) + 4, next);
+            Write32(WritableCell(next) + 8, previous);
+            FreeCell(security);
+        }
+    }
+    FreeCell(key);
+}
+
+bool RegistryHive::DeleteKey(uint32_t parent, std::string_view name) {
+    uint32_t key = FindSubkey(parent, name);
+    if (key == HIVE_NO_CELL || (Read16(Cell(key) + NK_FLAGS) & (KEY_HIVE_ENTRY | KEY_NO_DELETE))) {
+        return false;
+    }
+    uint32_t list = RemoveSubkey(Read32(Cell(parent) + NK_SUBKEY_LIST), key);
+    FreeKeyTree(key);
+    uint32_t count = Read32(Cell(parent) + NK_SUBKEY_COUNT);
+    Write32(WritableCell(parent) + NK_SUBKEY_COUNT, count > 0 ? count - 1 : 0);
+    Write32(WritableCell(parent) + NK_SUBKEY_LIST, list);
+    Touch(parent);
+    return true;
+}
+
+uint32_t RegistryHive::CreateKeyPath(std::string_view keyPath) {
+    uint32_t key = Root();
+    size_t start = 0;
+    while (key != HIVE_NO_CELL && start < keyPath.size()) {
+        size_t end = keyPath.find('\\', start);
+        std::string_view part = keyPath.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        if (!part.empty()) {
+            key = CreateKey(key, part);
+        }
+        start = end == std::string_view::npos ? keyPath.size() : end + 1;
+    }
+    return key;
+}
+
+// Function to store value data: inline up to 4 bytes, one cell up to 16344 bytes, big data segments above that.
+// Returns the offset to put in the value and sets the size field.
+uint32_t RegistryHive::WriteValueData(const uint8_t* bytes, size_t size, uint32_t& sizeField) {
+    sizeField = static_cast<uint32_t>(size);
+    if (size <= 4) {
+        uint8_t inlineData[4] = {};
+        if (size > 0) {
+            std::memcpy(inlineData, bytes, size);
+        }
+        sizeField |= DATA_INLINE;
+        return Read32(inlineData);
+    }
+    if (size <= BIG_DATA_SEGMENT || Read32(&data[BASE_MINOR_VERSION]) < 4) {
+        uint32_t cell = AllocateCell(static_cast<uint32_t>(size));
+        std::memcpy(WritableCell(cell), bytes, size);
+        return cell;
+    }
+    uint16_t count = static_cast<uint16_t>((size + BIG_DATA_SEGMENT - 1) / BIG_DATA_SEGMENT);
+    std::vector<uint32_t> segments;
+    for (uint16_t i = 0; i < count; i++) {
+        size_t part = std::min<size_t>(BIG_DATA_SEGMENT, size - i * size_t(BIG_DATA_SEGMENT));
+        uint32_t segment = AllocateCell(static_cast<uint32_t>(part));
+        std::memcpy(WritableCell(segment), bytes + i * size_t(BIG_DATA_SEGMENT), part);
+        segments.push_back(segment);
+    }
+    uint32_t list = AllocateCell(count * 4u);
+    uint8_t* listCell = WritableCell(list);
+    for (uint16_t i = 0; i < count; i++) {
+        Write32(listCell + i * 4, segments[i]);
+    }
+    uint32_t db = AllocateCell(8);
+    std::memcpy(WritableCell(db), "db", 2);
+    Write16(WritableCell(db) + 2, count);
+    Write32(WritableCell(db) + 4, list);
+    return db;
+}
+
+void RegistryHive::FreeValueData(uint32_t value) {
+    uint32_t size = Read32(Cell(value) + VK_DATA_SIZE);
+    uint32_t cell = Read32(Cell(value) + VK_DATA);
+    if ((size & DATA_INLINE) || size == 0 || !ValidCell(cell, 0)) {
+        return;
+    }
+    if (size > BIG_DATA_SEGMENT && ValidCell(cell, 8) && Cell(cell)[0] == 'd' && Cell(cell)[1] == 'b') {
+        uint16_t count = Read16(Cell(cell) + 2);
+        uint32_t list = Read32(Cell(cell) + 4);
+        for (uint16_t i = 0; i < count && ValidCell(list, i * 4u + 4); i++) {
+            FreeCell(Read32(Cell(list) + i * 4));
+        }
+        FreeCell(list);
+    }
+    FreeCell(cell);
+}
+
+bool RegistryHive::SetValue(uint32_t key, std::string_view name, uint32_t type, const uint8_t* bytes, size_t size) {
+    if (!ValidCell(key, NK_NAME) || size >= DATA_INLINE) {
+        return false;
+    }
+    uint32_t value = FindValue(key, name);
+    if (value == HIVE_NO_CELL) { // New value, appended to the key's value list
+        bool compressed = false;
+        std::vector<uint8_t> stored = StoreName(name, compressed);
+        value = AllocateCell(static_cast<uint32_t>(VK_NAME + stored.size()));
+        uint8_t* vk = WritableCell(value);
+        std::memcpy(vk, "vk", 2);
+        Write16(vk + VK_NAME_LENGTH, static_cast<uint16_t>(stored.size()));
+        Write16(vk + VK_FLAGS, compressed ? VALUE_COMP_NAME : 0);
+        if (!stored.empty()) { // The default value has no name
+            std::memcpy(vk + VK_NAME, stored.data(), stored.size());
+        }
+        Write32(vk + VK_DATA_SIZE, DATA_INLINE); // No data yet
+
+        std::vector<uint32_t> values = Values(key);
+        uint32_t oldList = Read32(Cell(key) + NK_VALUE_LIST);
+        values.push_back(value);
+        uint32_t list = AllocateCell(static_cast<uint32_t>(values.size() * 4));
+        uint8_t* listCell = WritableCell(list);
+        for (size_t i = 0; i < values.size(); i++) {
+            Write32(listCell + i * 4, values[i]);
+        }
+        FreeCell(oldList);
+        Write32(WritableCell(key) + NK_VALUE_COUNT, static_cast<uint32_t>(values.size()));
+        Write32(WritableCell(key) + NK_VALUE_LIST, list);
+        uint32_t nameBytes = static_cast<uint32_t>(ToUtf16(name).size() * 2);
+        if (nameBytes > Read32(Cell(key) + NK_MAX_VALUE_NAME)) {
+            Write32(WritableCell(key) + NK_MAX_VALUE_NAME, nameBytes);
+        }
+    }
+    else {
+        FreeValueData(value);
+    }
+    uint32_t sizeField = 0;
+    uint32_t dataField = WriteValueData(bytes, size, sizeField);
+    uint8_t* vk = WritableCell(value);
+    Write32(vk + VK_DATA_SIZE, sizeField);
+    Write32(vk + VK_DATA, dataField);
+    Write32(vk + VK_TYPE, type);
+    if (size > Read32(Cell(key) + NK_MAX_VALUE_DATA)) {
+        Write32(WritableCell(key) + NK_MAX_VALUE_DATA, static_cast<uint32_t>(size));
+    }
+    Touch(key);
+    modified = true;
+    return true;
+}
+
+bool RegistryHive::DeleteValue(uint32_t key, std::string_view name) {
+    uint32_t value = FindValue(key, name);
+    if (value == HIVE_NO_CELL) {
+        return false;
+    }
+    std::vector<uint32_t> values = Values(key);
+    values.erase(std::remove(values.begin(), values.end(), value), values.end());
+    const uint8_t* nk = Cell(key);
+    uint32_t list = Read32(nk + NK_VALUE_LIST);
+    for (size_t i = 0; i < values.size(); i++) { // The list only shrinks, so it is rewritten in place
+        Write32(WritableCell(list) + i * 4, values[i]);
+    }
+    if (values.empty()) {
+        FreeCell(list);
+        Write32(WritableCell(key) + NK_VALUE_LIST, HIVE_NO_CELL);
+    }
+    Write32(WritableCell(key) + NK_VALUE_COUNT, static_cast<uint32_t>(values.size()));
+    FreeValueData(value);
+    FreeCell(value);
+    Touch(key);
+    return true;
+}
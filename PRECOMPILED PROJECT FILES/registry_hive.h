@@ -0,0 +1,122 @@
+#pragma once
+// Native reader and editor for registry hive files (regf), such as Windows\System32\Config\SOFTWARE of the mounted
+// image. The hive is edited in memory without loading it into the registry of the host, so it needs no reg.exe, no
+// admin rights and works on any platform. Keys and values are addressed by their cell offset in the hive, and
+// names and data are read straight out of the hive buffer.
+// Saving writes only the 4 KiB pages changed since the last save, after logging them to the hive's transaction log
+// (.LOG1) the way Windows does, so a write cut short by a crash or power loss is repaired from the log on next open.
+#include <cstdint>     // Fixed width integer types for the hive structures
+#include <filesystem>  // std::filesystem::path for the hive file
+#include <map>         // std::map for the free cell index and the bin bounds
+#include <string>      // std::string for names
+#include <string_view> // std::string_view for names and paths
+#include <utility>     // std::pair for runs of dirty pages
+#include <vector>      // std::vector for the hive buffer and listings
+
+// Offset of "no cell" in the hive, returned when a key or value does not exist
+constexpr uint32_t HIVE_NO_CELL = 0xFFFFFFFF;
+
+// Size of the base block in front of the hive bins
+constexpr size_t HIVE_BASE_BLOCK_SIZE = 4096;
+
+// Value types, same numbers as REG_SZ and friends in winnt.h
+constexpr uint32_t HIVE_REG_NONE = 0;
+constexpr uint32_t HIVE_REG_SZ = 1;
+constexpr uint32_t HIVE_REG_EXPAND_SZ = 2;
+constexpr uint32_t HIVE_REG_BINARY = 3;
+constexpr uint32_t HIVE_REG_DWORD = 4;
+constexpr uint32_t HIVE_REG_MULTI_SZ = 7;
+constexpr uint32_t HIVE_REG_QWORD = 11;
+
+// Bytes of value data inside the hive buffer
+struct HiveData {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+// One registry hive file held in memory
+class RegistryHive {
+public:
+    bool Open(const std::filesystem::path& path);
+    // Starts a new hive with an empty root key, written to 'path' by Save
+    void Create(const std::filesystem::path& path);
+    // Writes the changed pages of the hive back to its file
+    bool Save();
+
+    // The hive has changes in its transaction logs (.LOG1/.LOG2) that are not in the file and could not be recovered
+    bool Dirty() const { return dirty; }
+    bool Modified() const { return modified; }
+
+    // Reading keys. Names are UTF-8 and compared without regard to case, like the registry does.
+    uint32_t Root() const;
+    uint32_t FindSubkey(uint32_t key, std::string_view name) const;
+    // Opens a key from a path relative to the root, e.g. "ControlSet001\\Services"
+    uint32_t OpenKey(std::string_view path) const;
+    std::vector<uint32_t> Subkeys(uint32_t key) const;
+    std::string KeyName(uint32_t key) const;
+    uint64_t KeyWriteTime(uint32_t key) const; // FILETIME
+
+    // Reading values. The default value of a key has an empty name.
+    std::vector<uint32_t> Values(uint32_t key) const;
+    uint32_t FindValue(uint32_t key, std::string_view name) const;
+    std::string ValueName(uint32_t value) const;
+    uint32_t ValueType(uint32_t value) const;
+    // Data stored in one piece, without copying. Empty for data split into big data segments, see ReadValueData.
+    HiveData ValueDataView(uint32_t value) const;
+    std::vector<uint8_t> ReadValueData(uint32_t value) const;
+
+    // Editing. Keys that already exist are returned as they are.
+    uint32_t CreateKey(uint32_t parent, std::string_view name);
+    uint32_t CreateKeyPath(std::string_view path);
+    bool SetValue(uint32_t key, std::string_view name, uint32_t type, const uint8_t* data, size_t size);
+    bool DeleteValue(uint32_t key, std::string_view name);
+    // Deletes the subkey 'name' of 'parent' with everything below it
+    bool DeleteKey(uint32_t parent, std::string_view name);
+
+private:
+    bool ValidCell(uint32_t offset, uint32_t minSize) const;
+    const uint8_t* Cell(uint32_t offset) const { return data.data() + HIVE_BASE_BLOCK_SIZE + offset + 4; }
+    // Every change to a cell goes through here, so the pages it spans get written by the next Save
+    uint8_t* WritableCell(uint32_t offset);
+    void MarkDirty(size_t fileOffset, size_t size);
+    uint32_t AllocateCell(uint32_t size);
+    void FreeCell(uint32_t offset);
+    void AddFreeCell(uint32_t offset, uint32_t length);
+    void RemoveFreeCell(uint32_t offset, uint32_t length);
+    void IndexFreeCells();
+    void AddBin(uint32_t size);
+
+    std::vector<uint32_t> ReadSubkeyList(uint32_t list) const;
+    bool SubkeyListEditable(uint32_t list) const;
+    void WriteListEntry(uint32_t list, uint16_t index, uint32_t entry);
+    uint32_t InsertListEntry(uint32_t list, uint16_t index, uint32_t entry);
+    void RemoveListEntry(uint32_t list, uint16_t index);
+    uint32_t SplitLeaf(uint32_t leaf);
+    uint16_t LeafPosition(uint32_t leaf, const std::u16string& upcased) const;
+    uint32_t InsertSubkey(uint32_t list, uint32_t key, const std::u16string& upcased);
+    uint32_t RemoveSubkey(uint32_t list, uint32_t key);
+    void FreeSubkeyList(uint32_t list);
+    void FreeKeyTree(uint32_t key);
+    uint32_t WriteValueData(const uint8_t* bytes, size_t size, uint32_t& sizeField);
+    void FreeValueData(uint32_t value);
+    void Touch(uint32_t key);
+    std::u16string SortName(uint32_t key) const;
+
+    bool RecoverFromLogs();
+    bool WriteLog(const std::vector<std::pair<uint32_t, uint32_t>>& runs, uint32_t sequence);
+
+    std::filesystem::path path;
+    std::vector<uint8_t> data;                    // Base block followed by the hive bins
+    std::multimap<uint32_t, uint32_t> freeCells;  // Size of each free cell to its offset
+    std::map<uint32_t, uint32_t> freeCellStarts;  // Offset of each free cell to its size, for merging neighbours
+    std::map<uint32_t, uint32_t> bins;            // Start of each hive bin to its end
+    std::vector<bool> dirtyPages;                 // Pages of 'data' changed since the last save
+    size_t savedSize = 0;                         // Size of the hive file on disk, 0 for a new hive
+    bool dirty = false;
+    bool modified = false;
+};
+
+// Function declarations for hive values
+std::vector<uint8_t> EncodeHiveString(std::string_view text);
+std::string DecodeHiveString(const uint8_t* bytes, size_t size);
+std::string FormatHiveValue(const RegistryHive& hive, uint32_t value);
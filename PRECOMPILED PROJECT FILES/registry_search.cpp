@@ -0,0 +1,282 @@
+#include "registry_search.h"
+#include "registry_hive.h" // Offline hive reader the index is built with
+#include "thread_pool.h"   // WorkerPool for indexing the hives in parallel
+#include <algorithm>     // std::search, std::sort and std::upper_bound for the index
+#include <chrono>        // std::chrono::steady_clock for timing
+#include <filesystem>    // std::filesystem::path for the hive paths
+#include <functional>    // std::boyer_moore_horspool_searcher for scanning the index text
+#include <iostream>      // std::cout and std::cerr for output
+#include <unordered_set> // std::unordered_set for the keys already visited
+#include <utility>       // std::pair for the keys still to visit
+
+// Deepest key path indexed, the registry itself allows 512 levels
+static constexpr size_t MAX_KEY_DEPTH = 512;
+// Characters of value data shown for a hit
+static constexpr size_t SHOWN_DATA_LENGTH = 120;
+
+// Function to lowercase ASCII letters, leaving every other byte of the UTF-8 text as it is
+static std::string Fold(std::string_view text) {
+    std::string folded(text);
+    for (char& c : folded) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return folded;
+}
+
+// Function to pack three bytes into a trigram
+static uint32_t Trigram(const char* p) {
+    return uint8_t(p[0]) | (uint32_t(uint8_t(p[1])) << 8) | (uint32_t(uint8_t(p[2])) << 16);
+}
+
+// Function to read every key and value of one hive into 'index', visiting the keys depth first in name order
+bool RegistrySearchIndex::IndexHive(const std::string& hivePath, bool indexData, HiveIndex& index) {
+    std::error_code error;
+    RegistryHive hive;
+    if (!std::filesystem::is_regular_file(hivePath, error) || !hive.Open(hivePath)) {
+        return false;
+    }
+    auto addEntry = [&index](std::string_view text, uint32_t key) {
+        Entry entry;
+        entry.text = static_cast<uint32_t>(index.text.size());
+        entry.textLength = static_cast<uint32_t>(text.size());
+        entry.key = key;
+        index.text.append(text);
+        index.text.push_back('\0');
+        index.entries.push_back(entry);
+    };
+
+    struct Pending {
+        uint32_t cell;
+        uint32_t parentEntry; // Entry of the parent key, or none for the keys under the root
+        size_t depth;
+    };
+    constexpr uint32_t NO_ENTRY = 0xFFFFFFFF;
+    std::vector<Pending> pending;
+    std::unordered_set<uint32_t> visited; // Guards against subkey lists that loop in a damaged hive
+    std::vector<uint32_t> rootKeys = hive.Subkeys(hive.Root());
+    for (auto it = rootKeys.rbegin(); it != rootKeys.rend(); ++it) {
+        pending.push_back({ *it, NO_ENTRY, 1 });
+    }
+    while (!pending.empty()) {
+        Pending key = pending.back();
+        pending.pop_back();
+        if (!visited.insert(key.cell).second) {
+            continue;
+        }
+        std::string path = hive.KeyName(key.cell);
+        if (key.parentEntry != NO_ENTRY) {
+            const Entry& parent = index.entries[key.parentEntry];
+            path = index.text.substr(parent.text, parent.textLength) + "\\" + path;
+        }
+        uint32_t keyEntry = static_cast<uint32_t>(index.entries.size());
+        addEntry(path, keyEntry);
+        index.keys++;
+
+        for (uint32_t value : hive.Values(key.cell)) {
+            addEntry(hive.ValueName(value), keyEntry);
+            uint32_t type = hive.ValueType(value);
+            if (indexData && (type == HIVE_REG_SZ || type == HIVE_REG_EXPAND_SZ || type == HIVE_REG_MULTI_SZ)) {
+                std::string shown = FormatHiveValue(hive, value);
+                if (!shown.empty()) {
+                    Entry& entry = index.entries.back();
+                    entry.data = static_cast<uint32_t>(index.data.size());
+                    entry.dataLength = static_cast<uint32_t>(shown.size());
+                    index.data += shown;
+                    index.data.push_back('\0');
+                    index.dataEntries.push_back(static_cast<uint32_t>(index.entries.size() - 1));
+                }
+            }
+        }
+        if (key.depth < MAX_KEY_DEPTH) {
+            std::vector<uint32_t> subkeys = hive.Subkeys(key.cell);
+            for (auto it = subkeys.rbegin(); it != subkeys.rend(); ++it) {
+                pending.push_back({ *it, keyEntry, key.depth + 1 });
+            }
+        }
+    }
+    index.foldedText = Fold(index.text);
+
+    if (indexData) {
+        index.foldedData = Fold(index.data);
+        std::vector<uint32_t> valueTrigrams;
+        for (uint32_t entryIndex : index.dataEntries) {
+            const Entry& entry = index.entries[entryIndex];
+            valueTrigrams.clear();
+            for (uint32_t i = 0; i + 3 <= entry.dataLength; i++) {
+                valueTrigrams.push_back(Trigram(&index.foldedData[entry.data + i]));
+            }
+            std::sort(valueTrigrams.begin(), valueTrigrams.end());
+            valueTrigrams.erase(std::unique(valueTrigrams.begin(), valueTrigrams.end()), valueTrigrams.end());
+            for (uint32_t trigram : valueTrigrams) {
+                index.trigrams.push_back((uint64_t(trigram) << 32) | entryIndex);
+            }
+        }
+        std::sort(index.trigrams.begin(), index.trigrams.end());
+    }
+    return true;
+}
+
+bool RegistrySearchIndex::Build(const std::string& configDir, const std::vector<std::string>& hiveNames, bool indexData) {
+    auto start = std::chrono::steady_clock::now();
+    hives.assign(hiveNames.size(), HiveIndex());
+    std::vector<char> indexed(hiveNames.size(), 0);
+    if (!hiveNames.empty()) {
+        WorkerPool pool(static_cast<unsigned>(hiveNames.size())); // One thread per hive
+        pool.ParallelFor(hiveNames.size(), [&](size_t i) {
+            hives[i].name = hiveNames[i];
+            indexed[i] = IndexHive((std::filesystem::path(configDir) / hiveNames[i]).string(), indexData, hives[i]);
+        });
+    }
+    std::vector<HiveIndex> found;
+    for (size_t i = 0; i < hiveNames.size(); i++) {
+        if (indexed[i]) {
+            found.push_back(std::move(hives[i]));
+        }
+        else {
+            std::cerr << "Warning: The " << hiveNames[i] << " hive could not be read, it is not searched.\n";
+        }
+    }
+    hives.swap(found);
+    buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return !hives.empty();
+}
+
+size_t RegistrySearchIndex::KeyCount() const {
+    size_t count = 0;
+    for (const HiveIndex& index : hives) count += index.keys;
+    return count;
+}
+
+size_t RegistrySearchIndex::ValueCount() const {
+    size_t count = 0;
+    for (const HiveIndex& index : hives) count += index.entries.size() - index.keys;
+    return count;
+}
+
+// Function to fill in a hit from the index text of its hive: the key path, and the value name for a value
+static RegistrySearchHit MakeHit(const std::string& hive, const std::string& text, uint32_t keyOffset, uint32_t keyLength,
+    bool isValue, uint32_t nameOffset, uint32_t nameLength) {
+    RegistrySearchHit hit;
+    hit.hive = hive;
+    hit.keyPath = text.substr(keyOffset, keyLength);
+    hit.isValue = isValue;
+    if (isValue) {
+        hit.valueName = text.substr(nameOffset, nameLength);
+    }
+    return hit;
+}
+
+RegistrySearchResult RegistrySearchIndex::Find(std::string_view query, size_t maxHits) const {
+    auto start = std::chrono::steady_clock::now();
+    RegistrySearchResult result;
+    std::string folded = Fold(query);
+    if (folded.empty()) {
+        return result;
+    }
+    std::boyer_moore_horspool_searcher<std::string::const_iterator> searcher(folded.begin(), folded.end());
+    for (const HiveIndex& index : hives) {
+        auto pos = index.foldedText.begin();
+        while ((pos = std::search(pos, index.foldedText.end(), searcher)) != index.foldedText.end()) {
+            // Entry holding the match, the query has no '\0' so a match never runs into the next entry
+            uint32_t offset = static_cast<uint32_t>(pos - index.foldedText.begin());
+            auto entry = std::upper_bound(index.entries.begin(), index.entries.end(), offset,
+                [](uint32_t wanted, const Entry& e) { return wanted < e.text; }) - 1;
+            bool isValue = entry->key != static_cast<uint32_t>(entry - index.entries.begin());
+            if (!isValue) {
+                // A key path holds the names of its parents, a match that ends before the key's own name belongs
+                // to a parent, found as a hit of its own, and is not counted again for every key below it
+                std::string_view path(index.foldedText.data() + entry->text, entry->textLength);
+                size_t separator = path.rfind('\\');
+                uint32_t ownName = entry->text + (separator == std::string_view::npos ? 0 : static_cast<uint32_t>(separator + 1));
+                if (offset + folded.size() <= ownName) {
+                    pos = index.foldedText.begin() + std::max<size_t>(offset + 1, ownName + 1 - folded.size());
+                    continue;
+                }
+            }
+            result.totalHits++;
+            if (result.hits.size() < maxHits) {
+                const Entry& key = index.entries[entry->key];
+                result.hits.push_back(MakeHit(index.name, index.text, key.text, key.textLength, isValue, entry->text, entry->textLength));
+            }
+            pos = index.foldedText.begin() + entry->text + entry->textLength; // One hit per entry
+        }
+        if (!index.foldedData.empty()) {
+            FindInData(index, folded, maxHits, result);
+        }
+    }
+    result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// Function to find the values whose data contains 'query' (already lowercase) but whose name does not, as those
+// were found by name already. Queries of three or more characters only check the values holding the query's
+// rarest trigram; shorter ones scan the data.
+void RegistrySearchIndex::FindInData(const HiveIndex& index, const std::string& query, size_t maxHits, RegistrySearchResult& result) const {
+    std::vector<uint32_t> candidates;
+    if (query.size() >= 3) {
+        auto rarest = std::make_pair(index.trigrams.end(), index.trigrams.end());
+        for (size_t i = 0; i + 3 <= query.size(); i++) {
+            uint64_t trigram = Trigram(&query[i]);
+            auto range = std::make_pair(std::lower_bound(index.trigrams.begin(), index.trigrams.end(), trigram << 32),
+                std::lower_bound(index.trigrams.begin(), index.trigrams.end(), (trigram + 1) << 32));
+            if (range.first == range.second) {
+                return; // No value holds this part of the query
+            }
+            if (i == 0 || range.second - range.first < rarest.second - rarest.first) {
+                rarest = range;
+            }
+        }
+        for (auto it = rarest.first; it != rarest.second; ++it) {
+            candidates.push_back(static_cast<uint32_t>(*it));
+        }
+    }
+    else {
+        candidates = index.dataEntries;
+    }
+    for (uint32_t entryIndex : candidates) {
+        const Entry& entry = index.entries[entryIndex];
+        std::string_view data(index.foldedData.data() + entry.data, entry.dataLength);
+        std::string_view name(index.foldedText.data() + entry.text, entry.textLength);
+        if (data.find(query) == std::string_view::npos || name.find(query) != std::string_view::npos) {
+            continue;
+        }
+        result.totalHits++;
+        if (result.hits.size() < maxHits) {
+            const Entry& key = index.entries[entry.key];
+            RegistrySearchHit hit = MakeHit(index.name, index.text, key.text, key.textLength, true, entry.text, entry.textLength);
+            hit.data = index.data.substr(entry.data, entry.dataLength);
+            result.hits.push_back(hit);
+        }
+    }
+}
+
+void PrintRegistrySearchResult(const RegistrySearchResult& result) {
+    for (const RegistrySearchHit& hit : result.hits) {
+        std::cout << "  " << hit.hive << "\\" << hit.keyPath;
+        if (hit.isValue) {
+            std::cout << " : " << (hit.valueName.empty() ? "(Default)" : hit.valueName);
+        }
+        if (!hit.data.empty()) {
+            std::cout << " = " << hit.data.substr(0, SHOWN_DATA_LENGTH) << (hit.data.size() > SHOWN_DATA_LENGTH ? " ..." : "");
+        }
+        std::cout << '\n';
+    }
+    std::cout << result.totalHits << " matches in " << result.milliseconds << " ms";
+    if (result.totalHits > result.hits.size()) {
+        std::cout << ", the first " << result.hits.size() << " are shown";
+    }
+    std::cout << ".\n";
+}
+
+// Function to search the hives of the image at 'imageDir' once, including value data
+bool SearchRegistryHives(const std::string& imageDir, const std::string& query) {
+    RegistrySearchIndex index;
+    std::filesystem::path configDir = std::filesystem::path(imageDir) / "Windows" / "System32" / "config";
+    if (!index.Build(configDir.string(), std::vector<std::string>(std::begin(REGISTRY_SEARCH_HIVES), std::end(REGISTRY_SEARCH_HIVES)), true)) {
+        std::cerr << "Error: No registry hive found in " << configDir.string() << ".\n";
+        return false;
+    }
+    std::cout << "Indexed " << index.KeyCount() << " keys and " << index.ValueCount() << " values in " << index.BuildSeconds() << " s.\n";
+    PrintRegistrySearchResult(index.Find(query, 100));
+    return true;
+}
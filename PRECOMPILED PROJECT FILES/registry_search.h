@@ -0,0 +1,73 @@
+#pragma once
+// Search across the registry hives of the mounted image. Each hive is read once, on its own thread, into a flat
+// text index of its key paths and value names, so a query is a scan of that text instead of a walk through the hive
+// and answers in milliseconds. The string data of values can be indexed as well; it is broken into trigrams so a
+// data query only checks the values that contain every trigram of the query.
+#include <cstdint>     // Fixed width integer types for the index entries
+#include <string>      // std::string for names, paths and the index text
+#include <string_view> // std::string_view for queries
+#include <vector>      // std::vector for the index and the results
+
+// Hives of Windows\System32\config searched by default, the same ones the WIM Registry Hive Menu opens
+constexpr const char* REGISTRY_SEARCH_HIVES[] = { "SYSTEM", "SOFTWARE", "DEFAULT", "DRIVERS", "SAM" };
+
+// One key or value whose path, name or data contains the query
+struct RegistrySearchHit {
+    std::string hive;
+    std::string keyPath;
+    bool isValue = false;
+    std::string valueName;  // Empty for the default value
+    std::string data;       // Data of the value as text, set when the data matched
+};
+
+struct RegistrySearchResult {
+    std::vector<RegistrySearchHit> hits; // The first matches, up to the limit given to Find
+    size_t totalHits = 0;
+    double milliseconds = 0;
+};
+
+class RegistrySearchIndex {
+public:
+    // Indexes the hives 'hiveNames' found in 'configDir', one thread per hive. 'indexData' adds the data of
+    // REG_SZ, REG_EXPAND_SZ and REG_MULTI_SZ values. False when none of the hives could be read.
+    bool Build(const std::string& configDir, const std::vector<std::string>& hiveNames, bool indexData);
+    // Finds keys whose path and values whose name or indexed data contain 'query', ignoring case. Each key or value
+    // is one hit at most. A key is only a hit when the match reaches into its own name, so a query matching a parent
+    // key finds that key once rather than again for every key below it.
+    RegistrySearchResult Find(std::string_view query, size_t maxHits) const;
+
+    size_t KeyCount() const;
+    size_t ValueCount() const;
+    double BuildSeconds() const { return buildSeconds; }
+
+private:
+    // A key or a value. Its text is the path below the root for a key and the name for a value.
+    struct Entry {
+        uint32_t text = 0;
+        uint32_t textLength = 0;
+        uint32_t key = 0;       // Entry of the key holding a value, the entry itself for a key
+        uint32_t data = 0;      // Offset of the value's data text, when it has one
+        uint32_t dataLength = 0;
+    };
+    struct HiveIndex {
+        std::string name;
+        std::string text;                  // Texts of the entries in order, each followed by a '\0'
+        std::string foldedText;            // 'text' in lowercase
+        std::vector<Entry> entries;
+        std::string foldedData;            // Lowercase data of the values with string data, each followed by a '\0'
+        std::string data;                  // Same data as shown
+        std::vector<uint32_t> dataEntries; // Entries with data, in order of 'data'
+        std::vector<uint64_t> trigrams;    // Sorted (trigram << 32 | entry) pairs of 'foldedData'
+        size_t keys = 0;
+    };
+
+    static bool IndexHive(const std::string& hivePath, bool indexData, HiveIndex& index);
+    void FindInData(const HiveIndex& index, const std::string& query, size_t maxHits, RegistrySearchResult& result) const;
+
+    std::vector<HiveIndex> hives;
+    double buildSeconds = 0;
+};
+
+// Function declarations for registry search
+bool SearchRegistryHives(const std::string& imageDir, const std::string& query);
+void PrintRegistrySearchResult(const RegistrySearchResult& result);
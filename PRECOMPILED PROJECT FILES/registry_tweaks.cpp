@@ -0,0 +1,359 @@
+#include "registry_tweaks.h"
+#include "registry_hive.h" // Offline hive editor the tweaks are applied with
+#include <algorithm>  // std::sort for the tweak files of a folder, std::all_of for checking dword digits
+#include <cctype>     // std::toupper and std::isxdigit for parsing
+#include <chrono>     // std::chrono::steady_clock for timing
+#include <cstdio>     // std::snprintf for control set names
+#include <cstdlib>    // std::strtoul for dword and hex data
+#include <filesystem> // std::filesystem for the tweak folder and hive paths
+#include <fstream>    // std::ifstream for reading .reg files
+#include <iostream>   // std::cout and std::cerr for output
+#include <iterator>   // std::istreambuf_iterator for reading .reg files
+#include <map>        // std::map for grouping tweaks by hive
+#include <sstream>    // std::istringstream for splitting lines
+
+// Registry roots and the hive file of the image that holds them
+static const struct {
+    const char* root;
+    const char* hiveFile;
+} HIVE_ROOTS[] = {
+    { "HKEY_LOCAL_MACHINE\\SOFTWARE", "Windows\\System32\\config\\SOFTWARE" },
+    { "HKEY_LOCAL_MACHINE\\SYSTEM", "Windows\\System32\\config\\SYSTEM" },
+    { "HKEY_LOCAL_MACHINE\\SAM", "Windows\\System32\\config\\SAM" },
+    { "HKEY_LOCAL_MACHINE\\SECURITY", "Windows\\System32\\config\\SECURITY" },
+    { "HKEY_LOCAL_MACHINE\\DRIVERS", "Windows\\System32\\config\\DRIVERS" },
+    { "HKEY_LOCAL_MACHINE\\COMPONENTS", "Windows\\System32\\config\\COMPONENTS" },
+    { "HKEY_USERS\\.DEFAULT", "Windows\\System32\\config\\DEFAULT" },
+    { "HKEY_CURRENT_USER", "Users\\Default\\NTUSER.DAT" } // The profile new users are created from
+};
+
+// Function to compare two strings ignoring ASCII case
+static bool SameText(const std::string& a, const std::string& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+    });
+}
+
+static std::string Trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+// Function to turn a key path like "HKLM\SOFTWARE\Policies" into the hive file and the path inside it
+bool MapRegistryPath(const std::string& registryPath, std::string& hiveFile, std::string& keyPath) {
+    std::string path = registryPath;
+    size_t slash = path.find('\\');
+    std::string root = path.substr(0, slash);
+    if (SameText(root, "HKLM")) root = "HKEY_LOCAL_MACHINE";
+    else if (SameText(root, "HKCU")) root = "HKEY_CURRENT_USER";
+    else if (SameText(root, "HKU")) root = "HKEY_USERS";
+    path = root + (slash == std::string::npos ? "" : path.substr(slash));
+    for (const auto& hive : HIVE_ROOTS) {
+        std::string prefix = hive.root;
+        if (path.size() >= prefix.size() && SameText(path.substr(0, prefix.size()), prefix) &&
+            (path.size() == prefix.size() || path[prefix.size()] == '\\')) {
+            hiveFile = hive.hiveFile;
+            keyPath = path.size() == prefix.size() ? "" : path.substr(prefix.size() + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Function to read a quoted .reg string starting at 'pos', handling \\ and \" escapes. Moves 'pos' past the closing quote.
+static bool ReadQuoted(const std::string& line, size_t& pos, std::string& text) {
+    if (pos >= line.size() || line[pos] != '"') {
+        return false;
+    }
+    text.clear();
+    for (pos++; pos < line.size(); pos++) {
+        if (line[pos] == '\\' && pos + 1 < line.size()) {
+            text.push_back(line[++pos]);
+        }
+        else if (line[pos] == '"') {
+            pos++;
+            return true;
+        }
+        else {
+            text.push_back(line[pos]);
+        }
+    }
+    return false;
+}
+
+// Function to read comma separated hex bytes ("01,02,ff")
+static bool ReadHexBytes(const std::string& text, std::vector<uint8_t>& bytes) {
+    std::istringstream parts(text);
+    std::string part;
+    while (std::getline(parts, part, ',')) {
+        part = Trim(part);
+        if (part.empty()) continue;
+        if (part.size() > 2 || !std::isxdigit(static_cast<unsigned char>(part[0])) ||
+            (part.size() == 2 && !std::isxdigit(static_cast<unsigned char>(part[1])))) {
+            return false;
+        }
+        bytes.push_back(static_cast<uint8_t>(std::strtoul(part.c_str(), nullptr, 16)));
+    }
+    return true;
+}
+
+// Reads a .reg file into 'tweaks'. Files saved by regedit are UTF-16 with a byte order mark, others are read as UTF-8.
+bool ParseRegFile(const std::string& path, std::vector<RegistryTweak>& tweaks) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << ".\n";
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (text.size() >= 2 && uint8_t(text[0]) == 0xFF && uint8_t(text[1]) == 0xFE) {
+        text = DecodeHiveString(reinterpret_cast<const uint8_t*>(text.data()) + 2, text.size() - 2);
+    }
+    else if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        text.erase(0, 3);
+    }
+
+    std::istringstream lines(text);
+    std::string line;
+    size_t lineNumber = 0;
+    bool headerSeen = false;
+    bool regedit4 = false; // REGEDIT4 files store hex(2) and hex(7) strings as 8-bit text
+    bool inKey = false;    // The current section maps to a hive of the image
+    std::string hiveFile, keyPath;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        size_t firstLine = lineNumber;
+        line = Trim(line);
+        while (!line.empty() && line.back() == '\\' && line.find("=hex") != std::string::npos) { // Wrapped hex data
+            std::string next;
+            if (!std::getline(lines, next)) break;
+            lineNumber++;
+            line = line.substr(0, line.size() - 1) + Trim(next);
+        }
+        if (line.empty() || line[0] == ';') {
+            continue;
+        }
+        std::string source = path + ":" + std::to_string(firstLine);
+        if (!headerSeen) {
+            headerSeen = true;
+            regedit4 = line == "REGEDIT4";
+            if (!regedit4 && line != "Windows Registry Editor Version 5.00") {
+                std::cerr << "Error: " << path << " is not a .reg file.\n";
+                return false;
+            }
+            continue;
+        }
+        RegistryTweak tweak;
+        tweak.source = source;
+        if (line[0] == '[') { // [Key] or [-Key]
+            bool remove = line.size() > 1 && line[1] == '-';
+            std::string registryPath = line.substr(remove ? 2 : 1, line.find_last_of(']') - (remove ? 2 : 1));
+            inKey = MapRegistryPath(registryPath, hiveFile, keyPath);
+            if (!inKey) {
+                std::cerr << "Warning: " << source << ": " << registryPath << " is not in a hive of the image, skipped.\n";
+                continue;
+            }
+            tweak.action = remove ? RegistryTweakAction::DeleteKey : RegistryTweakAction::CreateKey;
+            tweak.hiveFile = hiveFile;
+            tweak.keyPath = keyPath;
+            tweaks.push_back(tweak);
+            inKey = !remove;
+            continue;
+        }
+        if (!inKey) {
+            continue; // Value of a skipped or deleted key
+        }
+        size_t pos = 0;
+        if (line[0] == '@') {
+            pos = 1;
+        }
+        else if (!ReadQuoted(line, pos, tweak.valueName)) {
+            std::cerr << "Warning: " << source << ": cannot read the value name, skipped.\n";
+            continue;
+        }
+        pos = line.find_first_not_of(" \t", pos);
+        if (pos == std::string::npos || line[pos] != '=') {
+            std::cerr << "Warning: " << source << ": missing '=', skipped.\n";
+            continue;
+        }
+        std::string data = Trim(line.substr(pos + 1));
+        tweak.hiveFile = hiveFile;
+        tweak.keyPath = keyPath;
+        tweak.action = RegistryTweakAction::SetValue;
+        bool valid = true;
+        if (data == "-") {
+            tweak.action = RegistryTweakAction::DeleteValue;
+        }
+        else if (!data.empty() && data[0] == '"') {
+            std::string textValue;
+            size_t start = 0;
+            valid = ReadQuoted(data, start, textValue);
+            tweak.type = HIVE_REG_SZ;
+            tweak.data = EncodeHiveString(textValue);
+        }
+        else if (data.compare(0, 6, "dword:") == 0) { // Exactly 1 to 8 hex digits, as regedit writes them
+            std::string digits = data.substr(6);
+            valid = !digits.empty() && digits.size() <= 8 && std::all_of(digits.begin(), digits.end(), [](char c) {
+                return std::isxdigit(static_cast<unsigned char>(c)) != 0;
+            });
+            uint32_t number = valid ? static_cast<uint32_t>(std::strtoul(digits.c_str(), nullptr, 16)) : 0;
+            tweak.type = HIVE_REG_DWORD;
+            tweak.data = { uint8_t(number), uint8_t(number >> 8), uint8_t(number >> 16), uint8_t(number >> 24) };
+        }
+        else if (data.compare(0, 3, "hex") == 0) { // hex:... is REG_BINARY, hex(<type>):... any type
+            size_t colon = data.find(':');
+            tweak.type = HIVE_REG_BINARY;
+            if (data.size() > 4 && data[3] == '(') {
+                tweak.type = static_cast<uint32_t>(std::strtoul(data.c_str() + 4, nullptr, 16));
+            }
+            valid = colon != std::string::npos && ReadHexBytes(data.substr(colon + 1), tweak.data);
+            if (valid && regedit4 && (tweak.type == HIVE_REG_EXPAND_SZ || tweak.type == HIVE_REG_MULTI_SZ)) {
+                std::vector<uint8_t> wide;
+                for (uint8_t c : tweak.data) {
+                    wide.push_back(c);
+                    wide.push_back(0);
+                }
+                tweak.data = wide;
+            }
+        }
+        else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cerr << "Warning: " << source << ": cannot read the value data, skipped.\n";
+            continue;
+        }
+        tweaks.push_back(tweak);
+    }
+    return true;
+}
+
+// Function to apply one tweak to an open hive, true when the hive ends up as the tweak asks
+static bool ApplyTweak(RegistryHive& hive, const RegistryTweak& tweak, const std::string& keyPath) {
+    switch (tweak.action) {
+    case RegistryTweakAction::CreateKey:
+        return hive.CreateKeyPath(keyPath) != HIVE_NO_CELL;
+    case RegistryTweakAction::DeleteKey: {
+        size_t slash = keyPath.find_last_of('\\');
+        uint32_t parent = hive.OpenKey(slash == std::string::npos ? "" : keyPath.substr(0, slash));
+        std::string name = slash == std::string::npos ? keyPath : keyPath.substr(slash + 1);
+        return parent == HIVE_NO_CELL || hive.FindSubkey(parent, name) == HIVE_NO_CELL || hive.DeleteKey(parent, name);
+    }
+    case RegistryTweakAction::SetValue: {
+        uint32_t key = hive.CreateKeyPath(keyPath);
+        return key != HIVE_NO_CELL && hive.SetValue(key, tweak.valueName, tweak.type, tweak.data.data(), tweak.data.size());
+    }
+    case RegistryTweakAction::DeleteValue: {
+        uint32_t key = hive.OpenKey(keyPath);
+        return key == HIVE_NO_CELL || hive.FindValue(key, tweak.valueName) == HIVE_NO_CELL || hive.DeleteValue(key, tweak.valueName);
+    }
+    }
+    return false;
+}
+
+// Applies the tweaks hive by hive: each hive is opened once, gets its tweaks in file order and is saved once
+bool ApplyRegistryTweaks(const std::string& imageDir, const std::vector<RegistryTweak>& tweaks, RegistryTweakStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> hiveOrder;
+    std::map<std::string, std::vector<const RegistryTweak*>> byHive;
+    for (const RegistryTweak& tweak : tweaks) {
+        auto& group = byHive[tweak.hiveFile];
+        if (group.empty()) {
+            hiveOrder.push_back(tweak.hiveFile);
+        }
+        group.push_back(&tweak);
+    }
+
+    for (const std::string& hiveFile : hiveOrder) {
+        const auto& group = byHive[hiveFile];
+        std::filesystem::path hivePath = imageDir;
+        std::istringstream parts(hiveFile);
+        std::string part;
+        while (std::getline(parts, part, '\\')) {
+            hivePath /= part;
+        }
+        RegistryHive hive;
+        if (!hive.Open(hivePath) || hive.Dirty()) {
+            if (hive.Dirty()) {
+                std::cerr << "Error: " << hivePath.string() << " has changes in its transaction logs that MODWIN could not recover.\n";
+            }
+            stats.failed += group.size();
+            continue;
+        }
+        // CurrentControlSet only exists in the running registry, in the hive it is the control set Select\Current names
+        std::string currentControlSet;
+        if (hiveFile == HIVE_ROOTS[1].hiveFile) {
+            uint32_t current = hive.FindValue(hive.OpenKey("Select"), "Current");
+            HiveData number = current == HIVE_NO_CELL ? HiveData() : hive.ValueDataView(current);
+            unsigned set = number.size == 4 ? number.data[0] | (number.data[1] << 8) : 1;
+            char name[16];
+            std::snprintf(name, sizeof(name), "ControlSet%03u", set);
+            currentControlSet = name;
+        }
+        size_t appliedToHive = 0;
+        for (const RegistryTweak* tweak : group) {
+            std::string keyPath = tweak->keyPath;
+            std::string first = keyPath.substr(0, keyPath.find('\\'));
+            if (!currentControlSet.empty() && SameText(first, "CurrentControlSet")) {
+                keyPath = currentControlSet + keyPath.substr(first.size());
+            }
+            if (ApplyTweak(hive, *tweak, keyPath)) {
+                appliedToHive++;
+            }
+            else {
+                std::cerr << "Failed to apply " << tweak->source << '\n';
+                stats.failed++;
+            }
+        }
+        // The tweaks only count as applied once the hive is written. Those that failed to apply are already counted.
+        if (hive.Modified()) {
+            if (!hive.Save()) {
+                stats.failed += appliedToHive;
+                continue;
+            }
+            stats.hivesWritten++;
+        }
+        stats.applied += appliedToHive;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats.failed == 0;
+}
+
+// Function to apply one .reg file, or every .reg file of a folder in name order, to the image at 'imageDir'
+bool ApplyRegistryTweakFiles(const std::string& imageDir, const std::string& fileOrFolder) {
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    if (std::filesystem::is_directory(fileOrFolder, error)) {
+        for (const auto& entry : std::filesystem::directory_iterator(fileOrFolder, error)) {
+            if (entry.is_regular_file() && SameText(entry.path().extension().string(), ".reg")) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+    }
+    else {
+        files.push_back(fileOrFolder);
+    }
+    // A file that cannot be read adds no tweaks, so the readable ones are still applied and the call fails
+    std::vector<RegistryTweak> tweaks;
+    size_t unreadable = 0;
+    for (const auto& file : files) {
+        if (!ParseRegFile(file.string(), tweaks)) {
+            unreadable++;
+        }
+    }
+    RegistryTweakStats stats;
+    bool ok = ApplyRegistryTweaks(imageDir, tweaks, stats);
+    std::cout << "Applied " << stats.applied << " tweaks from " << files.size() - unreadable << " files to " << stats.hivesWritten
+        << " hives in " << stats.seconds << " s";
+    if (stats.failed > 0) {
+        std::cout << ", " << stats.failed << " failed";
+    }
+    if (unreadable > 0) {
+        std::cout << ", " << unreadable << (unreadable == 1 ? " file" : " files") << " could not be read";
+    }
+    std::cout << ".\n";
+    return ok && unreadable == 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+// Registry tweaks for the offline image, written as .reg files ("Windows Registry Editor Version 5.00" or REGEDIT4).
+// All tweaks are read first and grouped by the hive file they land in, then every hive is opened once, gets all of
+// its edits and is written once, instead of a "reg load", regedit session and "reg unload" per tweak.
+#include <cstdint> // Fixed width integer types for value types and data
+#include <string>  // std::string for paths and names
+#include <vector>  // std::vector for the tweaks and value data
+
+// What a tweak does
+enum class RegistryTweakAction {
+    CreateKey,   // [HKEY_...\Key]
+    DeleteKey,   // [-HKEY_...\Key]
+    SetValue,    // "Name"=...
+    DeleteValue  // "Name"=-
+};
+
+// One line of a .reg file, resolved to a hive of the image
+struct RegistryTweak {
+    RegistryTweakAction action = RegistryTweakAction::CreateKey;
+    std::string hiveFile;   // Hive file relative to the image, e.g. "Windows\System32\config\SOFTWARE"
+    std::string keyPath;    // Key path inside the hive
+    std::string valueName;  // Empty for the default value
+    uint32_t type = 0;      // HIVE_REG_* type of the value
+    std::vector<uint8_t> data;
+    std::string source;     // "file:line" for messages
+};
+
+// Totals of one ApplyRegistryTweaks call
+struct RegistryTweakStats {
+    size_t applied = 0;
+    size_t failed = 0;
+    size_t hivesWritten = 0;
+    double seconds = 0;
+};
+
+// Function declarations for registry tweaks
+bool MapRegistryPath(const std::string& registryPath, std::string& hiveFile, std::string& keyPath);
+bool ParseRegFile(const std::string& path, std::vector<RegistryTweak>& tweaks);
+bool ApplyRegistryTweaks(const std::string& imageDir, const std::vector<RegistryTweak>& tweaks, RegistryTweakStats& stats);
+bool ApplyRegistryTweakFiles(const std::string& imageDir, const std::string& fileOrFolder);
@@ -1,7 +0,0 @@
-unsigned char resources_rc[] = {
-  0x49, 0x44, 0x5f, 0x58, 0x4f, 0x52, 0x52, 0x49, 0x53, 0x4f, 0x20, 0x52,
-  0x43, 0x44, 0x41, 0x54, 0x41, 0x20, 0x22, 0x42, 0x49, 0x4e, 0x2f, 0x78,
-  0x6f, 0x72, 0x72, 0x69, 0x73, 0x6f, 0x2f, 0x78, 0x6f, 0x72, 0x72, 0x69,
-  0x73, 0x6f, 0x2e, 0x65, 0x78, 0x65, 0x22, 0x0a
-};
-unsigned int resources_rc_len = 44;
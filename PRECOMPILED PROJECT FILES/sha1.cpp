@@ -0,0 +1,551 @@
+#include "sha1.h"
+#include <algorithm> // std::min
+#include <chrono>    // std::chrono for timing the benchmark
+#include <cstring>   // std::memcpy for buffering partial blocks
+#include <iostream>  // std::cout for the benchmark results
+#include <random>    // std::mt19937 to fill the benchmark buffer
+#include <vector>    // std::vector for the benchmark buffer
+
+// The SHA-NI and AVX2 paths are only built for x64 and picked at run time, so the program still runs on any CPU.
+// GCC and Clang need the instruction set named on each function using it, MSVC accepts the intrinsics anywhere.
+#if defined(_M_X64) || defined(__x86_64__)
+#define SHA1_X64 1
+#include <immintrin.h> // SHA-NI, SSE4.1 and AVX2 intrinsics
+#ifdef _MSC_VER
+#include <intrin.h>    // __cpuidex and _xgetbv to detect the instruction sets
+#define SHA1_TARGET(features)
+#else
+#include <cpuid.h>     // __cpuid_count to detect the instruction sets
+#define SHA1_TARGET(features) __attribute__((target(features)))
+#endif
+#endif
+
+// Rotates a 32-bit value left by 'n' bits
+static inline uint32_t Rol32(uint32_t value, unsigned n) {
+    return (value << n) | (value >> (32 - n));
+}
+
+// Runs the SHA-1 compression function over 'numBlocks' 64 byte blocks. Plain C++, the reference the faster paths
+// are checked against and the fallback on CPUs without them.
+static void Sha1BlocksScalar(uint32_t state[5], const uint8_t* data, size_t numBlocks) {
+    while (numBlocks--) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) { // Load the block as big-endian words
+            w[i] = (uint32_t(data[4 * i]) << 24) | (uint32_t(data[4 * i + 1]) << 16) |
+                (uint32_t(data[4 * i + 2]) << 8) | uint32_t(data[4 * i + 3]);
+        }
+        for (int i = 16; i < 80; i++) { // Expand the message schedule
+            w[i] = Rol32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            }
+            else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            }
+            else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            }
+            else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t temp = Rol32(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = Rol32(b, 30);
+            b = a;
+            a = temp;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        data += 64;
+    }
+}
+
+#ifdef SHA1_X64
+// Same as Sha1BlocksScalar with the SHA-NI instructions, which do four rounds per instruction. Each group of four
+// rounds takes the next four schedule words; the schedule is computed four words at a time with sha1msg1/sha1msg2,
+// three groups ahead of the rounds using it.
+SHA1_TARGET("sha,sse4.1")
+static void Sha1BlocksShaNi(uint32_t state[5], const uint8_t* data, size_t numBlocks) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+    __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+    while (numBlocks--) {
+        const __m128i abcdSave = abcd;
+        const __m128i eSave = e0;
+        __m128i e1;
+        __m128i msg0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), byteSwap);
+        __m128i msg1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), byteSwap);
+        __m128i msg2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), byteSwap);
+        __m128i msg3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), byteSwap);
+
+        // Rounds 0-15 use the block itself
+        e0 = _mm_add_epi32(e0, msg0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 16-63 repeat the same four steps, each schedule register in turn holding the words in use.
+        // The last argument of sha1rnds4 selects the round function and constant of rounds 0-19, 20-39, 40-59, 60-79.
+#define SHA1_NI_STEP(eIn, eOut, current, next, after, last, function) \
+        eIn = _mm_sha1nexte_epu32(eIn, current);                     \
+        eOut = abcd;                                                 \
+        next = _mm_sha1msg2_epu32(next, current);                    \
+        abcd = _mm_sha1rnds4_epu32(abcd, eIn, function);             \
+        last = _mm_sha1msg1_epu32(last, current);                    \
+        after = _mm_xor_si128(after, current);
+        SHA1_NI_STEP(e0, e1, msg0, msg1, msg2, msg3, 0)
+        SHA1_NI_STEP(e1, e0, msg1, msg2, msg3, msg0, 1)
+        SHA1_NI_STEP(e0, e1, msg2, msg3, msg0, msg1, 1)
+        SHA1_NI_STEP(e1, e0, msg3, msg0, msg1, msg2, 1)
+        SHA1_NI_STEP(e0, e1, msg0, msg1, msg2, msg3, 1)
+        SHA1_NI_STEP(e1, e0, msg1, msg2, msg3, msg0, 1)
+        SHA1_NI_STEP(e0, e1, msg2, msg3, msg0, msg1, 2)
+        SHA1_NI_STEP(e1, e0, msg3, msg0, msg1, msg2, 2)
+        SHA1_NI_STEP(e0, e1, msg0, msg1, msg2, msg3, 2)
+        SHA1_NI_STEP(e1, e0, msg1, msg2, msg3, msg0, 2)
+        SHA1_NI_STEP(e0, e1, msg2, msg3, msg0, msg1, 2)
+        SHA1_NI_STEP(e1, e0, msg3, msg0, msg1, msg2, 3)
+#undef SHA1_NI_STEP
+
+        // Rounds 64-79 only need what is left of the schedule
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg3 = _mm_xor_si128(msg3, msg1);
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+        e0 = _mm_sha1nexte_epu32(e0, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+        data += 64;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+// Rotates each 32-bit lane left by 'n' bits
+SHA1_TARGET("avx2")
+static inline __m256i Rol32x8(__m256i value, int n) {
+    return _mm256_or_si256(_mm256_slli_epi32(value, n), _mm256_srli_epi32(value, 32 - n));
+}
+
+// Loads four bytes from each of 8 streams at 'offset' into 8 big-endian lanes, lane i from stream i. Rows of 8
+// words are loaded whole and transposed, which beats gathering the words one by one.
+SHA1_TARGET("avx2")
+static inline void LoadWords8x8(const uint8_t* const data[8], size_t offset, __m256i words[8]) {
+    const __m256i byteSwap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i r[8], t[8];
+    for (int i = 0; i < 8; i++) {
+        r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data[i] + offset));
+    }
+    for (int i = 0; i < 8; i += 2) {
+        t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {
+        r[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+        r[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+        r[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+        r[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; i++) {
+        words[i] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x20), byteSwap);
+        words[i + 4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(r[i], r[i + 4], 0x31), byteSwap);
+    }
+}
+
+// Runs the SHA-1 compression function over 'numBlocks' blocks of 8 independent streams at once, one stream per
+// 32-bit lane of the AVX2 registers. 'state' holds word j of stream i at state[j * 8 + i].
+SHA1_TARGET("avx2")
+static void Sha1Blocks8Avx2(uint32_t state[5 * 8], const uint8_t* const data[8], size_t numBlocks) {
+    __m256i s[5];
+    for (int j = 0; j < 5; j++) {
+        s[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + j * 8));
+    }
+    for (size_t block = 0; block < numBlocks; block++) {
+        __m256i w[16];
+        LoadWords8x8(data, block * 64, w);
+        LoadWords8x8(data, block * 64 + 32, w + 8);
+        __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4];
+        for (int i = 0; i < 80; i++) {
+            if (i >= 16) { // Expand the message schedule in a ring of 16 words
+                w[i & 15] = Rol32x8(_mm256_xor_si256(_mm256_xor_si256(w[(i - 3) & 15], w[(i - 8) & 15]),
+                    _mm256_xor_si256(w[(i - 14) & 15], w[i & 15])), 1);
+            }
+            __m256i f, k;
+            if (i < 20) {
+                f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+                k = _mm256_set1_epi32(0x5A827999);
+            }
+            else if (i < 40) {
+                f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+                k = _mm256_set1_epi32(0x6ED9EBA1);
+            }
+            else if (i < 60) {
+                f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+                k = _mm256_set1_epi32(static_cast<int>(0x8F1BBCDC));
+            }
+            else {
+                f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+                k = _mm256_set1_epi32(static_cast<int>(0xCA62C1D6));
+            }
+            __m256i temp = _mm256_add_epi32(_mm256_add_epi32(Rol32x8(a, 5), f),
+                _mm256_add_epi32(_mm256_add_epi32(e, k), w[i & 15]));
+            e = d;
+            d = c;
+            c = Rol32x8(b, 30);
+            b = a;
+            a = temp;
+        }
+        s[0] = _mm256_add_epi32(s[0], a);
+        s[1] = _mm256_add_epi32(s[1], b);
+        s[2] = _mm256_add_epi32(s[2], c);
+        s[3] = _mm256_add_epi32(s[3], d);
+        s[4] = _mm256_add_epi32(s[4], e);
+    }
+    for (int j = 0; j < 5; j++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + j * 8), s[j]);
+    }
+}
+
+// CPU features the fast paths need, read once with CPUID
+struct Sha1CpuFeatures {
+    bool shaNi = false;
+    bool avx2 = false;
+};
+
+static Sha1CpuFeatures DetectSha1CpuFeatures() {
+    Sha1CpuFeatures features;
+    unsigned int leaf1[4] = {}, leaf7[4] = {};
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuidex(regs, 0, 0);
+    unsigned int maxLeaf = static_cast<unsigned int>(regs[0]);
+    __cpuidex(regs, 1, 0);
+    std::memcpy(leaf1, regs, sizeof(leaf1));
+    if (maxLeaf >= 7) {
+        __cpuidex(regs, 7, 0);
+        std::memcpy(leaf7, regs, sizeof(leaf7));
+    }
+#else
+    unsigned int maxLeaf = __get_cpuid_max(0, nullptr);
+    __cpuid_count(1, 0, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+    if (maxLeaf >= 7) {
+        __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+    }
+#endif
+    bool ssse3 = (leaf1[2] >> 9) & 1;
+    bool sse41 = (leaf1[2] >> 19) & 1;
+    bool osxsave = (leaf1[2] >> 27) & 1;
+    features.shaNi = ssse3 && sse41 && ((leaf7[1] >> 29) & 1);
+    if (osxsave && ((leaf7[1] >> 5) & 1)) { // AVX2 also needs the OS to save the YMM registers
+#ifdef _MSC_VER
+        uint64_t xcr0 = _xgetbv(0);
+#else
+        uint32_t xcr0Low, xcr0High;
+        __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+        uint64_t xcr0 = (uint64_t(xcr0High) << 32) | xcr0Low;
+#endif
+        features.avx2 = (xcr0 & 6) == 6;
+    }
+    return features;
+}
+
+// Read on first use rather than at startup, so hashing from another file's static initializer still works
+static const Sha1CpuFeatures& Sha1Cpu() {
+    static const Sha1CpuFeatures features = DetectSha1CpuFeatures();
+    return features;
+}
+#endif
+
+using Sha1BlocksFunction = void (*)(uint32_t state[5], const uint8_t* data, size_t numBlocks);
+
+// The compression function used by Sha1Update, the fastest one the CPU has
+static Sha1BlocksFunction FastestSha1Blocks() {
+#ifdef SHA1_X64
+    if (Sha1Cpu().shaNi) {
+        return Sha1BlocksShaNi;
+    }
+#endif
+    return Sha1BlocksScalar;
+}
+
+// Function to start a new SHA-1 computation
+void Sha1Init(Sha1Context& ctx) {
+    ctx.state[0] = 0x67452301;
+    ctx.state[1] = 0xEFCDAB89;
+    ctx.state[2] = 0x98BADCFE;
+    ctx.state[3] = 0x10325476;
+    ctx.state[4] = 0xC3D2E1F0;
+    ctx.length = 0;
+    ctx.blockUsed = 0;
+}
+
+// Adds data to a SHA-1 computation with the compression function 'blocks'
+static void Sha1UpdateWith(Sha1BlocksFunction blocks, Sha1Context& ctx, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    ctx.length += size;
+    if (size == 0) { // 'data' may be null when there is nothing to add
+        return;
+    }
+    if (ctx.blockUsed != 0) { // Top up the partial block first
+        size_t take = std::min(size, sizeof(ctx.block) - ctx.blockUsed);
+        std::memcpy(ctx.block + ctx.blockUsed, p, take);
+        ctx.blockUsed += take;
+        p += take;
+        size -= take;
+        if (ctx.blockUsed < sizeof(ctx.block)) {
+            return;
+        }
+        blocks(ctx.state, ctx.block, 1);
+        ctx.blockUsed = 0;
+    }
+    blocks(ctx.state, p, size / 64); // Hash whole blocks straight from the caller's buffer
+    p += size & ~size_t(63);
+    size &= 63;
+    if (size) {
+        std::memcpy(ctx.block, p, size); // Keep the tail for later
+    }
+    ctx.blockUsed = size;
+}
+
+// Pads the message and writes the digest, with the compression function 'blocks'
+static void Sha1FinalWith(Sha1BlocksFunction blocks, Sha1Context& ctx, uint8_t digest[SHA1_DIGEST_SIZE]) {
+    uint64_t bitLength = ctx.length * 8;
+    uint8_t padding[72] = { 0x80 };
+    size_t padSize = (ctx.blockUsed < 56) ? (56 - ctx.blockUsed) : (120 - ctx.blockUsed);
+    for (int i = 0; i < 8; i++) { // Message length in bits, big-endian
+        padding[padSize + i] = static_cast<uint8_t>(bitLength >> (56 - 8 * i));
+    }
+    Sha1UpdateWith(blocks, ctx, padding, padSize + 8);
+    for (int i = 0; i < 5; i++) {
+        digest[4 * i] = static_cast<uint8_t>(ctx.state[i] >> 24);
+        digest[4 * i + 1] = static_cast<uint8_t>(ctx.state[i] >> 16);
+        digest[4 * i + 2] = static_cast<uint8_t>(ctx.state[i] >> 8);
+        digest[4 * i + 3] = static_cast<uint8_t>(ctx.state[i]);
+    }
+}
+
+// Function to add data to a SHA-1 computation
+void Sha1Update(Sha1Context& ctx, const void* data, size_t size) {
+    static const Sha1BlocksFunction blocks = FastestSha1Blocks();
+    Sha1UpdateWith(blocks, ctx, data, size);
+}
+
+// Function to finish a SHA-1 computation and produce the digest
+void Sha1Final(Sha1Context& ctx, uint8_t digest[SHA1_DIGEST_SIZE]) {
+    static const Sha1BlocksFunction blocks = FastestSha1Blocks();
+    Sha1FinalWith(blocks, ctx, digest);
+}
+
+// Function to hash a whole buffer in one call
+void Sha1Buffer(const void* data, size_t size, uint8_t digest[SHA1_DIGEST_SIZE]) {
+    Sha1Context ctx;
+    Sha1Init(ctx);
+    Sha1Update(ctx, data, size);
+    Sha1Final(ctx, digest);
+}
+
+#ifdef SHA1_X64
+// Hashes 8 buffers of 'size' bytes each with one AVX2 stream per buffer. All 8 are the same length, so they pad to
+// the same number of final blocks and stay in step to the end.
+SHA1_TARGET("avx2")
+static void Sha1Buffer8Avx2(const uint8_t* const data[8], size_t size, uint8_t digests[8][SHA1_DIGEST_SIZE]) {
+    static constexpr uint32_t initialState[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    uint32_t state[5 * 8];
+    for (int j = 0; j < 5; j++) {
+        std::fill(state + j * 8, state + j * 8 + 8, initialState[j]);
+    }
+    Sha1Blocks8Avx2(state, data, size / 64);
+
+    // The tail of each buffer, the 0x80 marker and the length, in one or two blocks
+    size_t tailSize = size & 63;
+    size_t tailBlocks = (tailSize < 56) ? 1 : 2;
+    uint64_t bitLength = uint64_t(size) * 8;
+    uint8_t tails[8][128] = {};
+    const uint8_t* tailData[8];
+    for (int i = 0; i < 8; i++) {
+        std::memcpy(tails[i], data[i] + (size - tailSize), tailSize);
+        tails[i][tailSize] = 0x80;
+        for (int b = 0; b < 8; b++) {
+            tails[i][tailBlocks * 64 - 8 + b] = static_cast<uint8_t>(bitLength >> (56 - 8 * b));
+        }
+        tailData[i] = tails[i];
+    }
+    Sha1Blocks8Avx2(state, tailData, tailBlocks);
+
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 5; j++) {
+            uint32_t word = state[j * 8 + i];
+            digests[i][4 * j] = static_cast<uint8_t>(word >> 24);
+            digests[i][4 * j + 1] = static_cast<uint8_t>(word >> 16);
+            digests[i][4 * j + 2] = static_cast<uint8_t>(word >> 8);
+            digests[i][4 * j + 3] = static_cast<uint8_t>(word);
+        }
+    }
+}
+
+// Hashes 'count' buffers of the same size 8 at a time with AVX2. A last group of fewer than 8 fills the spare
+// lanes with its first buffer and drops their digests.
+static void Sha1BufferBatchAvx2(const uint8_t* const* data, size_t count, size_t size, uint8_t (*digests)[SHA1_DIGEST_SIZE]) {
+    for (size_t first = 0; first < count; first += 8) {
+        size_t lanes = std::min<size_t>(8, count - first);
+        const uint8_t* group[8];
+        uint8_t groupDigests[8][SHA1_DIGEST_SIZE];
+        for (size_t i = 0; i < 8; i++) {
+            group[i] = data[first + (i < lanes ? i : 0)];
+        }
+        Sha1Buffer8Avx2(group, size, groupDigests);
+        std::memcpy(digests[first], groupDigests, lanes * SHA1_DIGEST_SIZE);
+    }
+}
+#endif
+
+// Function to hash several buffers of the same size, such as the 10 MiB chunks of a WIM integrity table. SHA-NI
+// hashes one buffer faster than AVX2 hashes 8 side by side, so the AVX2 path is only taken on CPUs without SHA-NI.
+void Sha1BufferBatch(const uint8_t* const* data, size_t count, size_t size, uint8_t (*digests)[SHA1_DIGEST_SIZE]) {
+    size_t done = 0;
+#ifdef SHA1_X64
+    if (Sha1Cpu().avx2 && !Sha1Cpu().shaNi) {
+        done = count;
+        Sha1BufferBatchAvx2(data, done, size, digests);
+    }
+#endif
+    for (size_t i = done; i < count; i++) {
+        Sha1Buffer(data[i], size, digests[i]);
+    }
+}
+
+// Function to turn a digest into the 40 character hex string used in logs and manifests
+std::string Sha1ToHex(const uint8_t digest[SHA1_DIGEST_SIZE]) {
+    static const char hexDigits[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < SHA1_DIGEST_SIZE; i++) {
+        hex += hexDigits[digest[i] >> 4];
+        hex += hexDigits[digest[i] & 15];
+    }
+    return hex;
+}
+
+// Hashes 'size' bytes with the compression function 'blocks' and returns the speed in MB/s
+static double TimeSha1(Sha1BlocksFunction blocks, const uint8_t* data, size_t size, uint8_t digest[SHA1_DIGEST_SIZE]) {
+    auto start = std::chrono::steady_clock::now();
+    Sha1Context ctx;
+    Sha1Init(ctx);
+    Sha1UpdateWith(blocks, ctx, data, size);
+    Sha1FinalWith(blocks, ctx, digest);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds > 0 ? size / (1024.0 * 1024.0) / seconds : 0.0;
+}
+
+// Function to compare the speed of the SHA-1 implementations with the plain C++ one on 'megabytes' of random data,
+// whole and cut into 10 MiB chunks like an integrity table. Every digest is checked against the plain C++ one.
+bool BenchmarkSha1(size_t megabytes) {
+    static constexpr size_t CHUNK_SIZE = 10 * 1024 * 1024;
+    size_t size = std::max<size_t>(megabytes, 10) * 1024 * 1024;
+    std::vector<uint8_t> buffer(size);
+    std::mt19937 random(1);
+    for (size_t i = 0; i + 4 <= size; i += 4) {
+        uint32_t word = random();
+        std::memcpy(buffer.data() + i, &word, 4);
+    }
+    size_t chunks = size / CHUNK_SIZE;
+    std::vector<const uint8_t*> chunkData(chunks);
+    for (size_t i = 0; i < chunks; i++) {
+        chunkData[i] = buffer.data() + i * CHUNK_SIZE;
+    }
+
+    uint8_t reference[SHA1_DIGEST_SIZE];
+    double scalar = TimeSha1(Sha1BlocksScalar, buffer.data(), size, reference);
+    std::vector<uint8_t> referenceChunks(chunks * SHA1_DIGEST_SIZE);
+    for (size_t i = 0; i < chunks; i++) {
+        Sha1Context ctx;
+        Sha1Init(ctx);
+        Sha1UpdateWith(Sha1BlocksScalar, ctx, chunkData[i], CHUNK_SIZE);
+        Sha1FinalWith(Sha1BlocksScalar, ctx, referenceChunks.data() + i * SHA1_DIGEST_SIZE);
+    }
+    std::cout << "Hashing " << size / (1024 * 1024) << " MiB, " << chunks << " chunks of 10 MiB\n";
+    std::cout << "  Scalar reference: " << scalar << " MB/s\n";
+
+    bool matches = true;
+    auto report = [&](const char* name, double mbPerSecond, bool same) {
+        std::cout << "  " << name << ": " << mbPerSecond << " MB/s";
+        if (scalar > 0) {
+            std::cout << ", " << mbPerSecond / scalar << "x the scalar reference";
+        }
+        std::cout << (same ? "\n" : ", DIGEST MISMATCH\n");
+        matches = matches && same;
+    };
+    auto timeBatch = [&](void (*batch)(const uint8_t* const*, size_t, size_t, uint8_t (*)[SHA1_DIGEST_SIZE]), bool& same) {
+        std::vector<uint8_t> digests(chunks * SHA1_DIGEST_SIZE);
+        auto start = std::chrono::steady_clock::now();
+        batch(chunkData.data(), chunks, CHUNK_SIZE, reinterpret_cast<uint8_t (*)[SHA1_DIGEST_SIZE]>(digests.data()));
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        same = digests == referenceChunks;
+        return seconds > 0 ? chunks * (CHUNK_SIZE / (1024.0 * 1024.0)) / seconds : 0.0;
+    };
+#ifdef SHA1_X64
+    if (Sha1Cpu().shaNi) {
+        uint8_t digest[SHA1_DIGEST_SIZE];
+        double speed = TimeSha1(Sha1BlocksShaNi, buffer.data(), size, digest);
+        report("SHA-NI", speed, std::memcmp(digest, reference, SHA1_DIGEST_SIZE) == 0);
+    }
+    else {
+        std::cout << "  SHA-NI: not supported by this CPU\n";
+    }
+    if (Sha1Cpu().avx2) {
+        bool same = false;
+        double speed = timeBatch(Sha1BufferBatchAvx2, same);
+        report("AVX2, 8 chunks at once", speed, same);
+    }
+    else {
+        std::cout << "  AVX2: not supported by this CPU\n";
+    }
+#endif
+    bool same = false;
+    double speed = timeBatch(Sha1BufferBatch, same);
+    report("Integrity table chunks (fastest path)", speed, same);
+    if (!matches) {
+        std::cerr << "Error: A SHA-1 implementation does not match the scalar reference.\n";
+    }
+    return matches;
+}
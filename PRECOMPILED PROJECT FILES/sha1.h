@@ -0,0 +1,27 @@
+#pragma once
+// SHA-1 hashing, used by WIM files to identify every resource and to build integrity tables.
+// Uses the SHA-NI instructions when the CPU has them and plain C++ otherwise. Batches of same-size buffers, such as
+// integrity table chunks, are hashed 8 at a time with AVX2 on CPUs without SHA-NI.
+#include <cstddef> // size_t
+#include <cstdint> // Fixed width integer types
+#include <string>  // std::string for hex output
+
+// Size in bytes of a SHA-1 digest
+constexpr size_t SHA1_DIGEST_SIZE = 20;
+
+// Running state of a SHA-1 computation
+struct Sha1Context {
+    uint32_t state[5];   // The five 32-bit chaining values
+    uint64_t length;     // Number of bytes hashed so far
+    uint8_t block[64];   // Partial block waiting for more data
+    size_t blockUsed;    // Number of bytes used in 'block'
+};
+
+// Function declarations for SHA-1
+void Sha1Init(Sha1Context& ctx);
+void Sha1Update(Sha1Context& ctx, const void* data, size_t size);
+void Sha1Final(Sha1Context& ctx, uint8_t digest[SHA1_DIGEST_SIZE]);
+void Sha1Buffer(const void* data, size_t size, uint8_t digest[SHA1_DIGEST_SIZE]);
+void Sha1BufferBatch(const uint8_t* const* data, size_t count, size_t size, uint8_t (*digests)[SHA1_DIGEST_SIZE]);
+std::string Sha1ToHex(const uint8_t digest[SHA1_DIGEST_SIZE]);
+bool BenchmarkSha1(size_t megabytes);
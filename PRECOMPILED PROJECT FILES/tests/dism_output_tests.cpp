@@ -0,0 +1,167 @@
+// Tests of the DISM output parser and the typed listings it fills, with output fed in pieces of several sizes
+#include "test.h"
+#include "../dism_output.h"
+#include "../image_listing.h"
+#include <algorithm> // std::min for the last piece
+
+// Piece sizes the output is fed in: every byte alone, pieces that split lines and line endings anywhere, and the
+// whole listing at once
+static constexpr size_t CHUNK_SIZES[] = { 1, 7, 4096 };
+
+// Function to feed 'text' to 'parser' in pieces of 'chunkSize' bytes and finish it
+static void FeedInChunks(DismOutputParser& parser, const std::string& text, size_t chunkSize) {
+    for (size_t offset = 0; offset < text.size(); offset += chunkSize) {
+        parser.Feed(text.data() + offset, std::min(chunkSize, text.size() - offset));
+    }
+    parser.Finish();
+}
+
+// Function to record every callback of the parser as one line of text
+static std::vector<std::string> ParseEvents(const std::string& text, size_t chunkSize) {
+    std::vector<std::string> events;
+    DismOutputParser parser;
+    parser.onField = [&](const std::string& key, const std::string& value) { events.push_back("field " + key + "=" + value); };
+    parser.onRecordEnd = [&] { events.push_back("end"); };
+    parser.onTableRow = [&](const std::vector<std::string>& cells) {
+        std::string row = "row";
+        for (const std::string& cell : cells) {
+            row += " [" + cell + "]";
+        }
+        events.push_back(row);
+    };
+    FeedInChunks(parser, text, chunkSize);
+    return events;
+}
+
+TEST(DismOutputSplitsFieldsRecordsAndRows) {
+    const std::string text =
+        "Deployment Image Servicing and Management tool\r\n"
+        "\r\n"
+        "Name : First\r\n"
+        "  Value :  spaced out  \r\n"
+        "\r\n"
+        "\r\n"
+        "[==    4.0%    ]\r[==  100.0%  ]\r\n"
+        "Name : Second\n"
+        "Key | State\r\n"
+        "--- | -----\r\n"
+        "A | On\r\n"
+        "B|Off|Extra\r\n"
+        "Name : Last"; // No line break at the end
+    const std::vector<std::string> expected = {
+        "field Name=First", "field Value=spaced out", "end",
+        "field Name=Second", "row [A] [On]", "row [B] [Off] [Extra]",
+        "field Name=Last", "end"
+    };
+    for (size_t chunkSize : CHUNK_SIZES) {
+        CHECK(ParseEvents(text, chunkSize) == expected);
+    }
+    CHECK(ParseEvents("", 1).empty());
+    CHECK(SplitDismTableRow("a | | c") == (std::vector<std::string>{ "a", "", "c" }));
+}
+
+TEST(DismOutputTableKeepsLastRowWithoutRule) {
+    // A row is only known not to be a header once the next line arrives, so Finish has to flush it
+    for (size_t chunkSize : CHUNK_SIZES) {
+        CHECK(ParseEvents("One | 1\r\nTwo | 2", chunkSize) == (std::vector<std::string>{ "row [One] [1]", "row [Two] [2]" }));
+        CHECK(ParseEvents("Header | Row\n---|---\n", chunkSize).empty());
+    }
+}
+
+TEST(DismListsProvisionedApps) {
+    const std::string text = ReadTestFixture("get_provisioned_appx_packages.txt");
+    REQUIRE(!text.empty());
+    for (size_t chunkSize : CHUNK_SIZES) {
+        AppxPackageTable apps;
+        DismOutputParser parser;
+        CollectAppxPackages(parser, apps);
+        FeedInChunks(parser, text, chunkSize);
+
+        REQUIRE(apps.Size() == 4);
+        CHECK(apps.Name(0) == "Clipchamp.Clipchamp_2.2.8.0_neutral_~_yxz26nhyzhsrt");
+        CHECK(apps.DisplayName(0) == "Clipchamp.Clipchamp");
+        CHECK(apps.architectures[0] == ProcessorArchitecture::Neutral);
+        CHECK(apps.Name(1) == "Microsoft.BingNews_4.2.27001.0_x64__8wekyb3d8bbwe");
+        CHECK(apps.architectures[1] == ProcessorArchitecture::X64);
+        CHECK(FormatVersion(apps.versions[2]) == "2022.310.2333.0");
+        CHECK(apps.DisplayName(3) == "Microsoft.WindowsTerminal");
+        CHECK(apps.architectures[3] == ProcessorArchitecture::Arm64);
+        CHECK(apps.versions[3] == PackVersion("3001.12.10983.0"));
+    }
+}
+
+TEST(DismListsPackages) {
+    const std::string text = ReadTestFixture("get_packages.txt");
+    REQUIRE(!text.empty());
+    for (size_t chunkSize : CHUNK_SIZES) {
+        PackageTable packages;
+        DismOutputParser parser;
+        CollectPackages(parser, packages);
+        FeedInChunks(parser, text, chunkSize);
+
+        REQUIRE(packages.Size() == 4);
+        CHECK(packages.Name(0) == "Microsoft-OneCore-ApplicationModel-Sync-Desktop-FOD-Package~31bf3856ad364e35~amd64~~10.0.22621.1");
+        CHECK(packages.states[0] == ServicingState::Installed);
+        CHECK(packages.releaseTypes[0] == ReleaseType::OnDemandPack);
+        CHECK(packages.installTimes[0] == 202205060534);
+        CHECK(packages.architectures[0] == ProcessorArchitecture::X64);
+        CHECK(FormatVersion(packages.versions[0]) == "10.0.22621.1");
+
+        CHECK(packages.states[1] == ServicingState::Staged);
+        CHECK(packages.architectures[1] == ProcessorArchitecture::X86); // wow64
+        CHECK(packages.installTimes[1] == 202312121205);                // 12:05 PM
+
+        CHECK(packages.releaseTypes[2] == ReleaseType::SecurityUpdate);
+        CHECK(packages.installTimes[2] == 202312122358);
+        CHECK(FormatVersion(packages.versions[2]) == "22621.2861.1.9");
+
+        CHECK(packages.states[3] == ServicingState::Superseded);
+        CHECK(packages.releaseTypes[3] == ReleaseType::Update);
+        CHECK(FormatInstallTime(packages.installTimes[3]) == "2024-01-01 00:00"); // 12:00 AM
+    }
+}
+
+TEST(DismListsFeatures) {
+    const std::string text = ReadTestFixture("get_features_table.txt");
+    REQUIRE(!text.empty());
+    for (size_t chunkSize : CHUNK_SIZES) {
+        FeatureTable features;
+        DismOutputParser parser;
+        CollectFeatures(parser, features);
+        FeedInChunks(parser, text, chunkSize);
+
+        REQUIRE(features.Size() == 5); // The header row is left out
+        CHECK(features.Name(0) == "Printing-PrintToPDFServices-Features");
+        CHECK(features.states[0] == ServicingState::Installed);
+        CHECK(features.Name(1) == "TFTP");
+        CHECK(features.states[1] == ServicingState::Staged);
+        CHECK(features.states[2] == ServicingState::Removed);
+        CHECK(features.states[3] == ServicingState::UninstallPending);
+        CHECK(features.states[4] == ServicingState::InstallPending);
+        CHECK(FeatureStateName(features.states[2]) == std::string("Disabled with Payload Removed"));
+
+        std::vector<uint32_t> sorted = SortedByName(features);
+        REQUIRE(sorted.size() == 5);
+        CHECK(features.Name(sorted[0]) == "Microsoft-Hyper-V-All");
+        CHECK(features.Name(sorted[4]) == "WorkFolders-Client");
+        std::vector<uint32_t> disabled = SelectRows(features, [&](uint32_t row) { return features.states[row] == ServicingState::Staged; });
+        CHECK(disabled == std::vector<uint32_t>{ 1 });
+    }
+}
+
+TEST(ImageListingFieldsRoundTrip) {
+    CHECK(FormatVersion(PackVersion("10.0.22621.1702")) == "10.0.22621.1702");
+    CHECK(PackVersion("10.0.22621.1702") > PackVersion("10.0.22621.999"));
+    CHECK(FormatVersion(PackVersion("4.2")) == "4.2.0.0");
+    CHECK(ParseReleaseType("On Demand Pack") == ReleaseType::OnDemandPack);
+    CHECK(ParseReleaseType("Something New") == ReleaseType::Unknown);
+    CHECK(ReleaseTypeName(ReleaseType::LanguagePack) == std::string("Language Pack"));
+    CHECK(ParseServicingState("Install Pending") == ServicingState::InstallPending);
+    CHECK(PackageStateName(ParseServicingState("partially installed")) == std::string("Partially Installed"));
+    CHECK(ParseArchitecture("ARM64") == ProcessorArchitecture::Arm64);
+    CHECK(ArchitectureName(ParseArchitecture("amd64")) == std::string("x64"));
+    CHECK(ParseInstallTime("13/1/2024 1:00 PM") == 0);
+    CHECK(ParseInstallTime("not a time") == 0);
+    CHECK(FormatInstallTime(ParseInstallTime("2/29/2024 3:07 PM")) == "2024-02-29 15:07");
+    CHECK(FormatInstallTime(0).empty());
+}
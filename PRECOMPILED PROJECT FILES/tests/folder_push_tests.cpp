@@ -0,0 +1,234 @@
+// Tests of folder pushes: the per-file decision, the manifest file, and whole pushes into a folder standing in for
+// the mounted image
+#include "test.h"
+#include "../folder_push.h"
+#include <chrono>   // std::chrono::hours for moving write times
+#include <fstream>  // std::ifstream and std::ofstream for the pushed files and the manifest
+#include <iterator> // std::istreambuf_iterator for reading files back
+
+namespace fs = std::filesystem;
+
+// Function to write 'content' to a file, creating its folder
+static void WriteTestFile(const fs::path& path, const std::string& content) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+}
+
+static std::string ReadTestFile(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Function to move the write time of a file without changing its content
+static void TouchTestFile(const fs::path& path) {
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::hours(1));
+}
+
+// Function to push 'dir'/source into 'dir'/image with the manifest 'dir'/push.manifest
+static FolderPushStats PushTestFolder(const fs::path& dir, bool expectOk = true) {
+    FolderPushStats stats;
+    CHECK(PushFolder((dir / "source").string(), (dir / "image").string(), (dir / "push.manifest").string(), stats, 4) == expectOk);
+    return stats;
+}
+
+TEST(PushDiffDecidesPerFile) {
+    PushManifestEntry last;
+    last.source = { true, 100, 1000 };
+    last.copy = { true, 100, 2000 };
+    last.sha1 = "0123456789abcdef0123456789abcdef01234567";
+    const PushFileState source = last.source;
+    const PushFileState copy = last.copy;
+
+    CHECK(DiffPushFile(source, copy, nullptr) == PushAction::Copy);                      // Never pushed
+    CHECK(DiffPushFile(source, copy, &last) == PushAction::Skip);                        // Unchanged
+    CHECK(DiffPushFile({ true, 101, 1000 }, copy, &last) == PushAction::Copy);           // Resized
+    CHECK(DiffPushFile({ true, 101, 1500 }, copy, &last) == PushAction::Copy);           // Resized and touched
+    CHECK(DiffPushFile({ true, 100, 1500 }, copy, &last) == PushAction::Verify);         // Touched, maybe identical
+    CHECK(DiffPushFile(source, PushFileState(), &last) == PushAction::Copy);             // Removed from the image
+    CHECK(DiffPushFile(source, { true, 100, 2500 }, &last) == PushAction::Copy);         // Changed in the image
+    CHECK(DiffPushFile(source, { true, 99, 2000 }, &last) == PushAction::Copy);
+    CHECK(DiffPushFile({ true, 100, 1500 }, PushFileState(), &last) == PushAction::Copy); // Touched and removed
+}
+
+TEST(PushManifestRoundTrip) {
+    fs::path dir = TestDirectory("push_manifest");
+    std::string path = (dir / "push.manifest").string();
+    PushManifest manifest;
+    manifest["readme.txt"] = { { true, 12, 133500000000000000 }, { true, 12, 133500000000000001 }, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa" };
+    manifest["Program Files/Tool/tool with spaces.exe"] = { { true, 0, -5 }, { true, 0, 7 }, "da39a3ee5e6b4b0d3255bfef95601890afd80709" };
+    manifest["z/\xC3\xA9t\xC3\xA9\tand a tab.dat"] = { { true, 4294967296, 1 }, { true, 4294967296, 2 }, "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb" };
+    REQUIRE(SavePushManifest(path, manifest));
+    CHECK(!fs::exists(path + ".tmp"));
+
+    PushManifest loaded;
+    REQUIRE(LoadPushManifest(path, loaded));
+    REQUIRE(loaded.size() == manifest.size());
+    for (const auto& [name, entry] : manifest) {
+        auto found = loaded.find(name);
+        REQUIRE(found != loaded.end());
+        CHECK(found->second.sha1 == entry.sha1);
+        CHECK(found->second.source.exists && found->second.copy.exists);
+        CHECK(found->second.source.size == entry.source.size);
+        CHECK(found->second.source.writeTime == entry.source.writeTime);
+        CHECK(found->second.copy.size == entry.copy.size);
+        CHECK(found->second.copy.writeTime == entry.copy.writeTime);
+    }
+}
+
+TEST(PushManifestDamagedIsIgnored) {
+    fs::path dir = TestDirectory("push_manifest_damaged");
+    std::string path = (dir / "push.manifest").string();
+    PushManifest manifest;
+    manifest["a.txt"] = { { true, 1, 10 }, { true, 1, 11 }, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa" };
+    manifest["b.txt"] = { { true, 2, 20 }, { true, 2, 21 }, "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb" };
+    REQUIRE(SavePushManifest(path, manifest));
+    std::string text = ReadTestFile(path);
+
+    // Cut off in the middle of the last line: the whole lines are kept, the partial one is dropped
+    WriteTestFile(path, text.substr(0, text.size() - 12));
+    PushManifest loaded;
+    CHECK(LoadPushManifest(path, loaded));
+    CHECK(loaded.size() == 1);
+    CHECK(loaded.count("a.txt") == 1);
+
+    // Lines that do not parse are skipped
+    WriteTestFile(path, text + "not a manifest line\naaaa\tbig\t1\t1\t1\tc.txt\naaaa\t1\t1\t1\t1\t\n");
+    CHECK(LoadPushManifest(path, loaded));
+    CHECK(loaded.size() == 2);
+
+    // Anything without the header is not a manifest at all, and leaves the manifest empty
+    WriteTestFile(path, text.substr(5));
+    CHECK(!LoadPushManifest(path, loaded));
+    CHECK(loaded.empty());
+    WriteTestFile(path, "");
+    CHECK(!LoadPushManifest(path, loaded));
+    CHECK(!LoadPushManifest((dir / "missing.manifest").string(), loaded));
+}
+
+TEST(PushFolderCopiesOnlyWhatChanged) {
+    fs::path dir = TestDirectory("push_changes");
+    std::string big(5 * 1024 * 1024 + 123, '\0'); // Larger than one copy buffer
+    for (size_t i = 0; i < big.size(); i++) {
+        big[i] = static_cast<char>(i * 7 + i / 4096);
+    }
+    WriteTestFile(dir / "source" / "readme.txt", "Pushed by MODWIN\r\n");
+    WriteTestFile(dir / "source" / "Tools" / "big.bin", big);
+    WriteTestFile(dir / "source" / "Tools" / "empty.cfg", "");
+    fs::create_directories(dir / "source" / "Empty Folder");
+
+    FolderPushStats stats = PushTestFolder(dir);
+    CHECK(stats.copied == 3);
+    CHECK(stats.skipped == 0);
+    CHECK(stats.bytesCopied == big.size() + 18);
+    CHECK(ReadTestFile(dir / "image" / "Tools" / "big.bin") == big);
+    CHECK(ReadTestFile(dir / "image" / "readme.txt") == "Pushed by MODWIN\r\n");
+    CHECK(fs::is_regular_file(dir / "image" / "Tools" / "empty.cfg"));
+    CHECK(fs::is_directory(dir / "image" / "Empty Folder"));
+    CHECK(fs::last_write_time(dir / "image" / "readme.txt") == fs::last_write_time(dir / "source" / "readme.txt"));
+
+    stats = PushTestFolder(dir); // Unchanged
+    CHECK(stats.copied == 0);
+    CHECK(stats.skipped == 3);
+    CHECK(stats.verified == 0);
+
+    TouchTestFile(dir / "source" / "Tools" / "big.bin"); // Touched but identical
+    stats = PushTestFolder(dir);
+    CHECK(stats.copied == 0);
+    CHECK(stats.verified == 1);
+    CHECK(stats.skipped == 3);
+    stats = PushTestFolder(dir); // The manifest took the new write time
+    CHECK(stats.verified == 0);
+    CHECK(stats.skipped == 3);
+
+    WriteTestFile(dir / "source" / "readme.txt", "Pushed by MODWIN again\r\n"); // Resized
+    big[1000] ^= 1;
+    WriteTestFile(dir / "source" / "Tools" / "big.bin", big); // Same size, new content
+    TouchTestFile(dir / "source" / "Tools" / "big.bin");
+    stats = PushTestFolder(dir);
+    CHECK(stats.copied == 2);
+    CHECK(stats.verified == 0);
+    CHECK(ReadTestFile(dir / "image" / "readme.txt") == "Pushed by MODWIN again\r\n");
+    CHECK(ReadTestFile(dir / "image" / "Tools" / "big.bin") == big);
+
+    fs::remove(dir / "image" / "Tools" / "empty.cfg"); // Removed from the image
+    WriteTestFile(dir / "image" / "readme.txt", "Edited in the image\r\n"); // Changed in the image
+    stats = PushTestFolder(dir);
+    CHECK(stats.copied == 2);
+    CHECK(fs::is_regular_file(dir / "image" / "Tools" / "empty.cfg"));
+    CHECK(ReadTestFile(dir / "image" / "readme.txt") == "Pushed by MODWIN again\r\n");
+
+    fs::remove(dir / "source" / "readme.txt"); // Removed from the source: stays in the image, leaves the manifest
+    stats = PushTestFolder(dir);
+    CHECK(stats.copied == 0);
+    CHECK(stats.skipped == 2);
+    CHECK(fs::exists(dir / "image" / "readme.txt"));
+    PushManifest manifest;
+    REQUIRE(LoadPushManifest((dir / "push.manifest").string(), manifest));
+    CHECK(manifest.size() == 2);
+    CHECK(manifest.count("readme.txt") == 0);
+    CHECK(manifest.count("Tools/big.bin") == 1);
+
+    WriteTestFile(dir / "push.manifest", "MODWIN push"); // Damaged: everything is copied again
+    stats = PushTestFolder(dir);
+    CHECK(stats.copied == 2);
+    CHECK(stats.skipped == 0);
+}
+
+TEST(PushFolderLinksDuplicates) {
+    fs::path dir = TestDirectory("push_links");
+    const std::string shared = "The same content in several files";
+    WriteTestFile(dir / "source" / "one.txt", shared);
+    WriteTestFile(dir / "source" / "a" / "two.txt", shared);
+    WriteTestFile(dir / "source" / "b" / "three.txt", shared);
+    WriteTestFile(dir / "source" / "other.txt", std::string(shared.size(), 'x')); // Same size, other content
+
+    FolderPushStats stats = PushTestFolder(dir);
+    CHECK(stats.copied == 2);
+    CHECK(stats.linked == 2);
+    CHECK(stats.bytesLinked == 2 * shared.size());
+    for (const char* name : { "one.txt", "a/two.txt", "b/three.txt" }) {
+        CHECK(ReadTestFile(dir / "image" / name) == shared);
+        CHECK(fs::hard_link_count(dir / "image" / name) == 3);
+    }
+    CHECK(ReadTestFile(dir / "image" / "other.txt") == std::string(shared.size(), 'x'));
+    CHECK(fs::hard_link_count(dir / "image" / "other.txt") == 1);
+
+    stats = PushTestFolder(dir); // Links are skipped like copies on the next push
+    CHECK(stats.skipped == 4);
+    CHECK(stats.copied + stats.linked == 0);
+
+    WriteTestFile(dir / "source" / "c" / "four.txt", shared); // New duplicate of a file already in the image
+    stats = PushTestFolder(dir);
+    CHECK(stats.linked == 1);
+    CHECK(stats.copied == 0);
+    CHECK(fs::hard_link_count(dir / "image" / "c" / "four.txt") == 4);
+
+    WriteTestFile(dir / "source" / "a" / "two.txt", "Changed"); // Replacing one name leaves the others alone
+    stats = PushTestFolder(dir);
+    CHECK(stats.copied == 1);
+    CHECK(ReadTestFile(dir / "image" / "a" / "two.txt") == "Changed");
+    CHECK(ReadTestFile(dir / "image" / "one.txt") == shared);
+    CHECK(fs::hard_link_count(dir / "image" / "one.txt") == 3);
+}
+
+TEST(PushFolderKeepsNonAsciiNames) {
+    fs::path dir = TestDirectory("push_non_ascii");
+    const std::string folder = "Caf\xC3\xA9";                              // "Cafe" with an acute e
+    const std::string name = "\xE6\x97\xA5\xE6\x9C\xAC \xE2\x9C\x93.txt"; // Two CJK characters and a check mark
+    WriteTestFile(dir / "source" / fs::u8path(folder) / fs::u8path(name), "Not in any ANSI code page");
+
+    FolderPushStats stats = PushTestFolder(dir);
+    CHECK(stats.copied == 1);
+    CHECK(ReadTestFile(dir / "image" / fs::u8path(folder) / fs::u8path(name)) == "Not in any ANSI code page");
+    PushManifest manifest;
+    REQUIRE(LoadPushManifest((dir / "push.manifest").string(), manifest));
+    CHECK(manifest.count(folder + "/" + name) == 1); // Stored as UTF-8 with '/' separators
+
+    stats = PushTestFolder(dir); // The name read back from the manifest finds the same files
+    CHECK(stats.skipped == 1);
+    CHECK(stats.copied == 0);
+    TouchTestFile(dir / "source" / fs::u8path(folder) / fs::u8path(name));
+    stats = PushTestFolder(dir);
+    CHECK(stats.verified == 1);
+    CHECK(stats.failed == 0);
+}
@@ -0,0 +1,140 @@
+// Tests of the cached image inventory, run against the scripted backend: which listings reach the backend, which
+// tables a change drops, and the servicing logs that show a change made from outside MODWIN
+#include "test.h"
+#include "../image_inventory.h"
+#include <chrono>  // std::chrono::hours for moving write times
+#include <fstream> // std::ofstream for the servicing logs
+
+namespace fs = std::filesystem;
+
+static const std::string TEST_APP = "Microsoft.BingNews_4.55.62231.0_x64__8wekyb3d8bbwe";
+static const std::string TEST_PACKAGE = "Microsoft-Windows-WordPad-FoD-Package~31bf3856ad364e35~amd64~~10.0.22621.1";
+static const std::string TEST_FEATURE = "SMB1Protocol";
+
+// Scripted backend that writes the CBS log of the image while it removes an app, as DISM does
+class LoggingImageServicing : public ScriptedImageServicing {
+public:
+    fs::path imageDir;
+
+    ServicingResult RemoveProvisionedApp(const std::string& packageName) override {
+        fs::path cbsLog = imageDir / "Windows" / "Logs" / "CBS" / "CBS.log";
+        fs::create_directories(cbsLog.parent_path());
+        std::ofstream(cbsLog, std::ios::app) << "Info CBS Appx removal: " << packageName << '\n';
+        return ScriptedImageServicing::RemoveProvisionedApp(packageName);
+    }
+};
+
+// Scripted image with one app, one package and one feature, wrapped in a cache watching the logs of 'imageDir'.
+// 'scripted' is left pointing at the backend so its calls can be checked.
+static CachedImageServicing CreateTestCache(const fs::path& imageDir, ScriptedImageServicing*& scripted) {
+    auto backend = std::make_unique<LoggingImageServicing>();
+    backend->imageDir = imageDir;
+    backend->apps.push_back(TEST_APP);
+    backend->packages.push_back(TEST_PACKAGE);
+    backend->features.push_back({ TEST_FEATURE, ServicingState::Staged });
+    scripted = backend.get();
+    return CachedImageServicing(std::move(backend), imageDir.string());
+}
+
+// Function to list apps, packages and features through 'servicing', and return the calls they made to the backend
+static std::vector<std::string> ListAll(CachedImageServicing& servicing, ScriptedImageServicing& scripted) {
+    scripted.calls.clear();
+    AppxPackageTable apps;
+    PackageTable packages;
+    FeatureTable features;
+    CHECK(servicing.ListProvisionedApps(apps));
+    CHECK(servicing.ListPackages(packages));
+    CHECK(servicing.ListFeatures(features));
+    return scripted.calls;
+}
+
+static const std::vector<std::string> ALL_LISTINGS = { "ListProvisionedApps", "ListPackages", "ListFeatures" };
+
+TEST(CacheAnswersRepeatedListings) {
+    ScriptedImageServicing* scripted = nullptr;
+    CachedImageServicing servicing = CreateTestCache(TestDirectory("inventory_repeat"), scripted);
+    CHECK(ListAll(servicing, *scripted) == ALL_LISTINGS);
+    CHECK(ListAll(servicing, *scripted).empty());
+
+    // The cached tables are the ones the backend listed
+    AppxPackageTable apps;
+    FeatureTable features;
+    REQUIRE(servicing.ListProvisionedApps(apps));
+    REQUIRE(apps.Size() == 1);
+    CHECK(apps.Name(0) == TEST_APP);
+    REQUIRE(servicing.ListFeatures(features));
+    REQUIRE(features.Size() == 1);
+    CHECK(features.Name(0) == TEST_FEATURE);
+    CHECK(scripted->calls.empty());
+
+    servicing.Invalidate();
+    CHECK(ListAll(servicing, *scripted) == ALL_LISTINGS);
+}
+
+TEST(CacheDropsOnlyTheTablesAChangeAffects) {
+    ScriptedImageServicing* scripted = nullptr;
+    CachedImageServicing servicing = CreateTestCache(TestDirectory("inventory_changes"), scripted);
+    ListAll(servicing, *scripted);
+
+    // Apps
+    CHECK(servicing.RemoveProvisionedApp(TEST_APP).ok);
+    CHECK(ListAll(servicing, *scripted) == std::vector<std::string>{ "ListProvisionedApps" });
+    AppxPackageTable apps;
+    REQUIRE(servicing.ListProvisionedApps(apps));
+    CHECK(apps.Size() == 0);
+    servicing.AddProvisionedApp(TEST_APP);
+    CHECK(ListAll(servicing, *scripted) == std::vector<std::string>{ "ListProvisionedApps" });
+    servicing.RemoveProvisionedApps({ TEST_APP });
+    CHECK(ListAll(servicing, *scripted) == std::vector<std::string>{ "ListProvisionedApps" });
+
+    // Packages and features, which change each other's state
+    const std::vector<std::string> packagesAndFeatures = { "ListPackages", "ListFeatures" };
+    servicing.EnableFeature(TEST_FEATURE);
+    CHECK(ListAll(servicing, *scripted) == packagesAndFeatures);
+    FeatureTable features;
+    REQUIRE(servicing.ListFeatures(features));
+    CHECK(features.states[0] == ServicingState::Installed);
+    servicing.DisableFeature(TEST_FEATURE);
+    CHECK(ListAll(servicing, *scripted) == packagesAndFeatures);
+    servicing.RemovePackage(TEST_PACKAGE);
+    CHECK(ListAll(servicing, *scripted) == packagesAndFeatures);
+    servicing.AddPackage(TEST_PACKAGE);
+    CHECK(ListAll(servicing, *scripted) == packagesAndFeatures);
+    servicing.RemovePackages({ TEST_PACKAGE });
+    CHECK(ListAll(servicing, *scripted) == packagesAndFeatures);
+
+    // A failed change can still have done part of its work
+    scripted->FailOn("RemovePackage", TEST_PACKAGE, 5);
+    CHECK(!servicing.RemovePackage(TEST_PACKAGE).ok);
+    CHECK(ListAll(servicing, *scripted) == packagesAndFeatures);
+}
+
+TEST(CacheNoticesChangesFromOutside) {
+    fs::path imageDir = TestDirectory("inventory_logs");
+    ScriptedImageServicing* scripted = nullptr;
+    CachedImageServicing servicing = CreateTestCache(imageDir, scripted);
+    ListAll(servicing, *scripted);
+
+    // A dism.exe run outside MODWIN writes the session list of the component store
+    fs::path sessions = imageDir / "Windows" / "servicing" / "Sessions" / "Sessions.xml";
+    fs::create_directories(sessions.parent_path());
+    std::ofstream(sessions) << "<Sessions Version=\"1.0\"/>";
+    CHECK(ListAll(servicing, *scripted) == ALL_LISTINGS);
+    CHECK(ListAll(servicing, *scripted).empty());
+
+    fs::last_write_time(sessions, fs::last_write_time(sessions) + std::chrono::hours(1)); // Same size
+    CHECK(ListAll(servicing, *scripted) == ALL_LISTINGS);
+    CHECK(ListAll(servicing, *scripted).empty());
+
+    fs::path cbsLog = imageDir / "Windows" / "Logs" / "CBS" / "CBS.log";
+    fs::create_directories(cbsLog.parent_path());
+    std::ofstream(cbsLog) << "Info CBS Session: 31127390_1234567890 initialized.\n";
+    CHECK(ListAll(servicing, *scripted) == ALL_LISTINGS);
+
+    // A change made through the cache writes the logs too, that alone does not drop the other tables
+    uint64_t logSize = fs::file_size(cbsLog);
+    CHECK(servicing.RemoveProvisionedApp(TEST_APP).ok);
+    CHECK(fs::file_size(cbsLog) > logSize);
+    CHECK(ListAll(servicing, *scripted) == std::vector<std::string>{ "ListProvisionedApps" });
+    CHECK(ListAll(servicing, *scripted).empty());
+}
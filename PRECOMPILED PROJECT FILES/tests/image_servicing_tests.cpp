@@ -0,0 +1,109 @@
+// Tests of the batched removals of image_servicing.h, run against the scripted backend
+#include "test.h"
+#include "../image_servicing.h"
+#include <fstream> // std::ofstream for writing the script
+
+namespace fs = std::filesystem;
+
+// Function to load a scripted image with three apps and three packages, one of each failing to be removed
+static void LoadTestImage(ScriptedImageServicing& servicing, const std::string& name) {
+    fs::path script = TestDirectory(name) / "image.txt";
+    std::ofstream(script) << "app Microsoft.BingNews_4.55.62231.0_x64__8wekyb3d8bbwe\n"
+                          << "app Microsoft.GetHelp_10.2409.22951.0_x64__8wekyb3d8bbwe\n"
+                          << "app Microsoft.ZuneMusic_11.2409.6.0_x64__8wekyb3d8bbwe\n"
+                          << "package Microsoft-Windows-WordPad-FoD-Package~31bf3856ad364e35~amd64~~10.0.22621.1\n"
+                          << "package Microsoft-Windows-StepsRecorder-Package~31bf3856ad364e35~amd64~~10.0.22621.1\n"
+                          << "package Microsoft-Windows-TabletPCMath-Package~31bf3856ad364e35~amd64~~10.0.22621.1\n"
+                          << "fail RemoveProvisionedApp Microsoft.GetHelp_10.2409.22951.0_x64__8wekyb3d8bbwe 5 Access is denied.\n"
+                          << "fail RemovePackage Microsoft-Windows-StepsRecorder-Package~31bf3856ad364e35~amd64~~10.0.22621.1 -2146498530\n";
+    REQUIRE(servicing.LoadScript(script.string()));
+    REQUIRE(servicing.apps.size() == 3);
+    REQUIRE(servicing.packages.size() == 3);
+}
+
+// Backend that keeps the default batches of ImageServicing, which call the single removals one by one
+class UnbatchedImageServicing : public ScriptedImageServicing {
+public:
+    std::vector<ServicingBatchItem> RemoveProvisionedApps(const std::vector<std::string>& packageNames) override {
+        return ImageServicing::RemoveProvisionedApps(packageNames);
+    }
+    std::vector<ServicingBatchItem> RemovePackages(const std::vector<std::string>& packageIdentities) override {
+        return ImageServicing::RemovePackages(packageIdentities);
+    }
+};
+
+TEST(ServicingRemovesAppsInOneBatch) {
+    ScriptedImageServicing servicing;
+    LoadTestImage(servicing, "ServicingRemovesAppsInOneBatch");
+    std::vector<std::string> names = { servicing.apps[2], servicing.apps[1], servicing.apps[0] };
+    std::vector<ServicingBatchItem> items = servicing.RemoveProvisionedApps(names);
+
+    REQUIRE(items.size() == 3);
+    for (size_t i = 0; i < items.size(); i++) {
+        CHECK(items[i].name == names[i]); // One result per name, in the order asked
+    }
+    CHECK(items[0].result.ok);
+    CHECK(!items[1].result.ok);
+    CHECK(items[1].result.code == 5);
+    CHECK(items[1].result.message == "Access is denied.");
+    CHECK(items[2].result.ok);
+    CHECK(servicing.calls == std::vector<std::string>{ "RemoveProvisionedApps 3" });
+
+    AppxPackageTable apps;
+    REQUIRE(servicing.ListProvisionedApps(apps));
+    REQUIRE(apps.Size() == 1);
+    CHECK(apps.Name(0) == names[1]);
+    CHECK(apps.DisplayName(0) == "Microsoft.GetHelp");
+}
+
+TEST(ServicingRemovesPackagesInOneBatch) {
+    ScriptedImageServicing servicing;
+    LoadTestImage(servicing, "ServicingRemovesPackagesInOneBatch");
+    std::vector<std::string> identities = servicing.packages;
+    std::vector<ServicingBatchItem> items = servicing.RemovePackages(identities);
+
+    REQUIRE(items.size() == 3);
+    for (size_t i = 0; i < items.size(); i++) {
+        CHECK(items[i].name == identities[i]);
+    }
+    CHECK(items[0].result.ok);
+    CHECK(!items[1].result.ok);
+    CHECK(items[1].result.code == -2146498530);
+    CHECK(items[1].result.message == "Scripted failure");
+    CHECK(items[2].result.ok);
+    CHECK(servicing.calls == std::vector<std::string>{ "RemovePackages 3" });
+
+    PackageTable packages;
+    REQUIRE(servicing.ListPackages(packages));
+    REQUIRE(packages.Size() == 1);
+    CHECK(packages.Name(0) == identities[1]);
+
+    CHECK(servicing.RemovePackages({}).empty());
+    CHECK(servicing.calls.back() == "RemovePackages 0");
+}
+
+TEST(ServicingDefaultBatchRemovesOneAtATime) {
+    UnbatchedImageServicing servicing;
+    LoadTestImage(servicing, "ServicingDefaultBatchRemovesOneAtATime");
+    std::vector<std::string> names = servicing.apps;
+    std::vector<std::string> identities = servicing.packages;
+    std::vector<ServicingBatchItem> appItems = servicing.RemoveProvisionedApps(names);
+    std::vector<ServicingBatchItem> packageItems = servicing.RemovePackages(identities);
+
+    REQUIRE(appItems.size() == 3);
+    REQUIRE(packageItems.size() == 3);
+    std::vector<std::string> expectedCalls;
+    for (size_t i = 0; i < 3; i++) {
+        CHECK(appItems[i].name == names[i]);
+        CHECK(appItems[i].result.ok == (i != 1));
+        CHECK(packageItems[i].name == identities[i]);
+        CHECK(packageItems[i].result.ok == (i != 1));
+        expectedCalls.push_back("RemoveProvisionedApp " + names[i]);
+    }
+    for (const std::string& identity : identities) {
+        expectedCalls.push_back("RemovePackage " + identity);
+    }
+    CHECK(servicing.calls == expectedCalls);
+    CHECK(servicing.apps == std::vector<std::string>{ names[1] });
+    CHECK(servicing.packages == std::vector<std::string>{ identities[1] });
+}
@@ -0,0 +1,262 @@
+// Tests of the ISO writer: an image is built from a small folder and read back through each of its three directory
+// trees (ISO 9660, Joliet and UDF) and its El Torito boot catalog, with a reader written here from the specs
+#include "test.h"
+#include "../iso_writer.h"
+#include <fstream>  // std::ifstream and std::ofstream for the source files and the image
+#include <iterator> // std::istreambuf_iterator for reading the image
+#include <map>      // std::map of the files found in a directory tree
+
+namespace fs = std::filesystem;
+
+static constexpr size_t SECTOR = 2048;
+
+static uint16_t Le16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+static uint32_t Le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24); }
+static uint32_t Be32(const uint8_t* p) { return (uint32_t(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+
+// Where the data of a file was found in the image
+struct ImageFile {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+// The image read into memory
+struct IsoImage {
+    std::vector<uint8_t> bytes;
+    const uint8_t* Sector(uint64_t sector) const { return bytes.data() + sector * SECTOR; }
+    bool Has(uint64_t offset, uint64_t size) const { return offset <= bytes.size() && size <= bytes.size() - offset; }
+};
+
+// Function to collect the files of an ISO 9660 (or Joliet) directory and the directories below it, keyed by path
+static bool WalkIsoDirectory(const IsoImage& image, uint32_t sector, uint32_t size, bool joliet, const std::string& prefix,
+    std::map<std::string, ImageFile>& files, int depth = 0) {
+    if (depth > 16 || !image.Has(uint64_t(sector) * SECTOR, size)) {
+        return false;
+    }
+    for (uint32_t pos = 0; pos < size;) {
+        const uint8_t* r = image.Sector(sector) + pos;
+        if (r[0] == 0) { // Rest of the sector is padding
+            pos = (pos / SECTOR + 1) * SECTOR;
+            continue;
+        }
+        uint8_t idLength = r[32];
+        std::string name;
+        if (joliet) { // UCS-2 big-endian, kept as UTF-8 here
+            for (uint8_t i = 0; i + 1 < idLength; i += 2) {
+                char16_t c = static_cast<char16_t>((r[33 + i] << 8) | r[34 + i]);
+                if (c < 0x80) name += static_cast<char>(c);
+                else if (c < 0x800) name += { char(0xC0 | (c >> 6)), char(0x80 | (c & 0x3F)) };
+                else name += { char(0xE0 | (c >> 12)), char(0x80 | ((c >> 6) & 0x3F)), char(0x80 | (c & 0x3F)) };
+            }
+        }
+        else {
+            name.assign(reinterpret_cast<const char*>(r + 33), idLength);
+        }
+        bool dotEntry = idLength == 1 && (r[33] == 0 || r[33] == 1);
+        if (!dotEntry && (r[25] & 2)) {
+            if (!WalkIsoDirectory(image, Le32(r + 2), Le32(r + 10), joliet, prefix + name + "/", files, depth + 1)) {
+                return false;
+            }
+        }
+        else if (!dotEntry) {
+            files[prefix + name] = { uint64_t(Le32(r + 2)) * SECTOR, Le32(r + 10) };
+        }
+        pos += r[0];
+    }
+    return true;
+}
+
+// Function to check the tag of a UDF descriptor: its id, checksum and CRC
+static bool UdfTagValid(const uint8_t* p, uint16_t id) {
+    uint8_t checksum = 0;
+    for (int i = 0; i < 16; i++) {
+        checksum = static_cast<uint8_t>(checksum + (i == 4 ? 0 : p[i]));
+    }
+    uint16_t crc = 0;
+    for (size_t i = 0; i < Le16(p + 10); i++) {
+        crc ^= static_cast<uint16_t>(p[16 + i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return Le16(p) == id && checksum == p[4] && crc == Le16(p + 8);
+}
+
+// Function to collect the files of a UDF directory, given its file entry at partition block 'entry'
+static bool WalkUdfDirectory(const IsoImage& image, uint32_t partition, uint32_t entry, const std::string& prefix,
+    std::map<std::string, ImageFile>& files, int depth = 0) {
+    if (depth > 16 || !image.Has(uint64_t(partition + entry) * SECTOR, SECTOR)) {
+        return false;
+    }
+    const uint8_t* fe = image.Sector(partition + entry);
+    if (!UdfTagValid(fe, 261) || Le32(fe + 172) != 8) { // One short allocation descriptor
+        return false;
+    }
+    uint64_t size = Le32(fe + 56);
+    uint64_t offset = uint64_t(partition + Le32(fe + 180)) * SECTOR;
+    if (!image.Has(offset, size)) {
+        return false;
+    }
+    for (uint64_t pos = 0; pos < size;) {
+        const uint8_t* fid = image.bytes.data() + offset + pos;
+        if (!UdfTagValid(fid, 257)) {
+            return false;
+        }
+        uint8_t characteristics = fid[18];
+        uint8_t nameLength = fid[19];
+        uint32_t target = Le32(fid + 24);
+        const uint8_t* name = fid + 38 + Le16(fid + 36);
+        pos += (38 + Le16(fid + 36) + nameLength + 3) & ~3u;
+        if (characteristics & 0x08) { // Parent directory
+            continue;
+        }
+        std::string text;
+        for (uint8_t i = 1; i < nameLength; i += name[0] == 16 ? 2 : 1) {
+            char16_t c = name[0] == 16 ? static_cast<char16_t>((name[i] << 8) | name[i + 1]) : name[i];
+            if (c < 0x80) text += static_cast<char>(c);
+            else if (c < 0x800) text += { char(0xC0 | (c >> 6)), char(0x80 | (c & 0x3F)) };
+            else text += { char(0xE0 | (c >> 12)), char(0x80 | ((c >> 6) & 0x3F)), char(0x80 | (c & 0x3F)) };
+        }
+        if (characteristics & 0x02) {
+            if (!WalkUdfDirectory(image, partition, target, prefix + text + "/", files, depth + 1)) {
+                return false;
+            }
+            continue;
+        }
+        const uint8_t* fileEntry = image.Sector(partition + target);
+        if (!UdfTagValid(fileEntry, 261)) {
+            return false;
+        }
+        uint64_t fileSize = Le32(fileEntry + 56);
+        uint64_t fileOffset = Le32(fileEntry + 172) == 0 ? 0 : uint64_t(partition + Le32(fileEntry + 180)) * SECTOR;
+        files[prefix + text] = { fileOffset, fileSize };
+    }
+    return true;
+}
+
+static std::string Contents(const IsoImage& image, const ImageFile& file) {
+    return image.Has(file.offset, file.size) ? std::string(image.bytes.begin() + file.offset, image.bytes.begin() + file.offset + file.size) : "<outside the image>";
+}
+
+TEST(IsoImageReadsBackThroughEveryTree) {
+    fs::path dir = TestDirectory("iso_build");
+    fs::path source = dir / "ISO";
+    // Relative path (UTF-8), ISO 9660 name and contents of every file
+    struct SourceFile {
+        std::string path;
+        std::string isoPath;
+        std::string contents;
+    };
+    std::string wim;
+    for (size_t i = 0; wim.size() < 300000; i++) {
+        wim += static_cast<char>((i * 2654435761u) >> 13);
+    }
+    std::vector<SourceFile> sourceFiles = {
+        { "efi/microsoft/boot/efisys_noprompt.bin", "EFI/MICROSOFT/BOOT/EFISYS_NOPROMPT.BIN;1", std::string(5120, 'E') },
+        { "sources/install.wim", "SOURCES/INSTALL.WIM;1", wim },
+        { "setup.exe", "SETUP.EXE;1", "MZ setup" },
+        { "empty.txt", "EMPTY.TXT;1", "" },
+        { "Long name, with spaces and \xC3\xBCn\xC3\xAF" "code \xE2\x9C\x93.txt", "LONG_NAME__WITH_SPACES_AND.TXT;1", "unicode" },
+        { "deep/a/b/c/readme.md", "DEEP/A/B/C/README.MD;1", "# deep" },
+    };
+    for (const SourceFile& file : sourceFiles) {
+        fs::path path = source / fs::u8path(file.path);
+        fs::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary) << file.contents;
+    }
+
+    IsoBuildOptions options;
+    options.volumeLabel = "MODWIN_TEST";
+    options.unbufferedIo = false;
+    options.showProgress = false;
+    IsoBuildStats stats;
+    fs::path isoPath = dir / "test.iso";
+    REQUIRE(BuildIsoImage(source.string(), isoPath.string(), options, &stats));
+    CHECK(stats.files == sourceFiles.size());
+    CHECK(stats.directories == 9);
+    CHECK(stats.imageBytes == fs::file_size(isoPath));
+    CHECK(stats.imageBytes % SECTOR == 0);
+
+    IsoImage image;
+    std::ifstream file(isoPath, std::ios::binary);
+    image.bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    REQUIRE(image.bytes.size() == stats.imageBytes && image.bytes.size() > 300 * SECTOR);
+
+    // Primary volume descriptor, El Torito boot record, Joliet descriptor, terminator, UDF recognition sequence
+    const uint8_t* primary = image.Sector(16);
+    REQUIRE(primary[0] == 1 && std::string(reinterpret_cast<const char*>(primary + 1), 5) == "CD001");
+    CHECK(Le32(primary + 80) == image.bytes.size() / SECTOR);
+    CHECK(Be32(primary + 84) == image.bytes.size() / SECTOR);
+    CHECK(std::string(reinterpret_cast<const char*>(primary + 40), 11) == "MODWIN_TEST");
+    const uint8_t* bootRecord = image.Sector(17);
+    CHECK(bootRecord[0] == 0 && std::string(reinterpret_cast<const char*>(bootRecord + 7), 23) == "EL TORITO SPECIFICATION");
+    const uint8_t* joliet = image.Sector(18);
+    REQUIRE(joliet[0] == 2 && joliet[88] == '%' && joliet[89] == '/' && joliet[90] == 'E');
+    CHECK(image.Sector(19)[0] == 255);
+    CHECK(std::string(reinterpret_cast<const char*>(image.Sector(20) + 1), 5) == "BEA01");
+    CHECK(std::string(reinterpret_cast<const char*>(image.Sector(21) + 1), 5) == "NSR02");
+    CHECK(std::string(reinterpret_cast<const char*>(image.Sector(22) + 1), 5) == "TEA01");
+
+    std::map<std::string, ImageFile> isoFiles;
+    std::map<std::string, ImageFile> jolietFiles;
+    std::map<std::string, ImageFile> udfFiles;
+    CHECK(WalkIsoDirectory(image, Le32(primary + 158), Le32(primary + 166), false, "", isoFiles));
+    CHECK(WalkIsoDirectory(image, Le32(joliet + 158), Le32(joliet + 166), true, "", jolietFiles));
+
+    // UDF: anchor, then the partition and logical volume descriptors of the main sequence, then the file set
+    const uint8_t* anchor = image.Sector(256);
+    REQUIRE(UdfTagValid(anchor, 2));
+    CHECK(UdfTagValid(image.Sector(image.bytes.size() / SECTOR - 1), 2)); // Closing anchor
+    uint32_t partition = 0;
+    uint32_t fileSet = 0;
+    for (uint32_t sector = Le32(anchor + 20); sector < Le32(anchor + 20) + 16; sector++) {
+        const uint8_t* descriptor = image.Sector(sector);
+        if (Le16(descriptor) == 8) {
+            break;
+        }
+        CHECK(UdfTagValid(descriptor, Le16(descriptor)));
+        if (Le16(descriptor) == 5) {
+            partition = Le32(descriptor + 188);
+        }
+        if (Le16(descriptor) == 6) {
+            fileSet = Le32(descriptor + 252);
+        }
+    }
+    REQUIRE(partition != 0);
+    const uint8_t* fileSetDescriptor = image.Sector(partition + fileSet);
+    REQUIRE(UdfTagValid(fileSetDescriptor, 256));
+    CHECK(WalkUdfDirectory(image, partition, Le32(fileSetDescriptor + 404), "", udfFiles));
+
+    CHECK(isoFiles.size() == sourceFiles.size());
+    CHECK(jolietFiles.size() == sourceFiles.size());
+    CHECK(udfFiles.size() == sourceFiles.size());
+    for (const SourceFile& source : sourceFiles) {
+        CHECK(isoFiles.count(source.isoPath) == 1);
+        CHECK(Contents(image, isoFiles[source.isoPath]) == source.contents);
+        CHECK(Contents(image, jolietFiles[source.path]) == source.contents);
+        CHECK(Contents(image, udfFiles[source.path]) == source.contents);
+        CHECK(jolietFiles[source.path].offset == udfFiles[source.path].offset || source.contents.empty()); // One copy of the data
+    }
+
+    // Boot catalog: validation entry whose words add up to zero, then the default and the UEFI entry, both
+    // pointing at the boot image
+    REQUIRE(Le32(bootRecord + 71) == 23);
+    const uint8_t* catalog = image.Sector(23);
+    uint16_t sum = 0;
+    for (int i = 0; i < 32; i += 2) {
+        sum = static_cast<uint16_t>(sum + Le16(catalog + i));
+    }
+    CHECK(catalog[0] == 1 && catalog[30] == 0x55 && catalog[31] == 0xAA && sum == 0);
+    uint64_t bootImage = isoFiles["EFI/MICROSOFT/BOOT/EFISYS_NOPROMPT.BIN;1"].offset;
+    CHECK(catalog[32] == 0x88 && uint64_t(Le32(catalog + 40)) * SECTOR == bootImage);
+    CHECK(catalog[64] == 0x91 && catalog[65] == 0xEF);
+    CHECK(catalog[96] == 0x88 && uint64_t(Le32(catalog + 104)) * SECTOR == bootImage);
+    CHECK(Le16(catalog + 102) == (sourceFiles[0].contents.size() + 511) / 512);
+}
+
+TEST(IsoImageNeedsASourceFolder) {
+    fs::path dir = TestDirectory("iso_missing");
+    IsoBuildOptions options;
+    options.showProgress = false;
+    CHECK(!BuildIsoImage((dir / "missing").string(), (dir / "test.iso").string(), options));
+}
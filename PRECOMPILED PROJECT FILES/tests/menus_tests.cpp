@@ -0,0 +1,120 @@
+// Tests of the menu state machine: the transition table, reading choices, and RunMenus driven through thousands of
+// scripted choices
+#include "test.h"
+#include "../menus.h"
+#include <cstdint>  // uintptr_t for comparing stack addresses
+#include <iterator> // std::size of the transition table
+#include <random>   // std::mt19937 for the script
+#include <sstream>  // std::stringstream holding the script
+
+// Number of random options the script picks
+static constexpr size_t MENU_SCRIPT_TRANSITIONS = 10000;
+
+TEST(MenuTableHasEachOptionOnce) {
+    for (const MenuTransition& transition : MENU_TRANSITIONS) {
+        CHECK(FindMenuTransition(transition.from, transition.choice) == &transition);
+        CHECK(transition.from != MenuState::Exit);
+        CHECK((transition.action == MenuAction::OpenHive) == (transition.argument != nullptr));
+    }
+    CHECK(FindMenuTransition(MenuState::Main, 42) == nullptr);
+    CHECK(FindMenuTransition(MenuState::Exit, 1) == nullptr);
+}
+
+TEST(MenuChoiceSkipsBadInput) {
+    std::stringstream input("menu\n42\n4\n");
+    std::ostringstream output;
+    int choice = 0;
+    REQUIRE(ReadMenuChoice(input, output, MenuState::Apps, choice));
+    CHECK(choice == 4);
+    CHECK(output.str().find("Invalid input. Please enter a number.") != std::string::npos);
+    CHECK(output.str().find("Invalid option. Please try again.") != std::string::npos);
+    CHECK(!ReadMenuChoice(input, output, MenuState::Apps, choice)); // The input has ended
+}
+
+// Drives RunMenus through random options of MENU_TRANSITIONS with scripted input, mixed with words and numbers no
+// menu takes, and some actions failing. Every menu shown has to be the one the table leads to, each option has to
+// run its action once and every action has to run at the same stack depth.
+TEST(MenuScriptFollowsTheTable) {
+    // What the script should make the menus do
+    struct PlannedStep {
+        const MenuTransition* transition;
+        bool succeeds;
+    };
+    std::vector<PlannedStep> plan;
+    std::stringstream script;
+    std::mt19937 random(1);
+    auto optionsOf = [](MenuState state, bool toMainOnly) {
+        std::vector<const MenuTransition*> options;
+        for (const MenuTransition& transition : MENU_TRANSITIONS) {
+            if (transition.from == state && transition.to != MenuState::Exit && (!toMainOnly || transition.to == MenuState::Main)) {
+                options.push_back(&transition);
+            }
+        }
+        return options;
+    };
+    auto addStep = [&](const MenuTransition* transition, bool succeeds, MenuState& state) {
+        plan.push_back({ transition, succeeds });
+        script << transition->choice << '\n';
+        state = succeeds ? transition->to : transition->from;
+    };
+    MenuState state = MenuState::Main;
+    for (size_t i = 0; i < MENU_SCRIPT_TRANSITIONS; i++) {
+        switch (random() % 10) {
+        case 0:
+            script << "menu\n"; // Not a number
+            break;
+        case 1:
+            script << 42 << '\n'; // No menu has option 42
+            break;
+        default:
+            break;
+        }
+        std::vector<const MenuTransition*> options = optionsOf(state, false);
+        REQUIRE(!options.empty());
+        addStep(options[random() % options.size()], random() % 8 != 0, state);
+    }
+    for (size_t i = 0; state != MenuState::Main && i < MENU_STATE_COUNT; i++) { // Walks back to the main menu
+        std::vector<const MenuTransition*> options = optionsOf(state, true);
+        REQUIRE(!options.empty()); // Every menu has a way back to the main menu
+        addStep(options.front(), true, state);
+    }
+    addStep(FindMenuTransition(MenuState::Main, 9), true, state);
+
+    size_t step = 0;
+    size_t shown = 0;
+    size_t wrongMenus = 0;
+    size_t wrongActions = 0;
+    MenuState expected = MenuState::Main;
+    uintptr_t firstDepth = 0;
+    bool sameDepth = true;
+    std::vector<bool> used(std::size(MENU_TRANSITIONS));
+    auto show = [&](MenuState shownState) {
+        shown++;
+        wrongMenus += shownState != expected ? 1 : 0;
+    };
+    auto act = [&](const MenuTransition& transition) {
+        volatile char marker = 0; // Its address tells how deep the stack is
+        uintptr_t depth = reinterpret_cast<uintptr_t>(&marker);
+        firstDepth = step == 0 ? depth : firstDepth;
+        sameDepth = sameDepth && depth == firstDepth;
+        if (step >= plan.size() || plan[step].transition != &transition) {
+            wrongActions++;
+            return false;
+        }
+        used[static_cast<size_t>(&transition - MENU_TRANSITIONS)] = true;
+        bool succeeds = plan[step++].succeeds;
+        expected = succeeds ? transition.to : transition.from;
+        return succeeds;
+    };
+    std::ostream discard(nullptr); // The prompts are not printed
+    CHECK(RunMenus(MenuState::Main, script, discard, show, act));
+
+    CHECK(step == plan.size());
+    CHECK(shown == plan.size());
+    CHECK(wrongMenus == 0);
+    CHECK(wrongActions == 0);
+    CHECK(sameDepth);
+    for (size_t i = 0; i < used.size(); i++) {
+        CHECK(used[i]); // Every option was picked at least once
+    }
+}
@@ -0,0 +1,135 @@
+// Tests of the package dependency graph: package keys, reading a package manifest, and the removal order planned
+// from manifests written into a folder standing in for the mounted image
+#include "test.h"
+#include "../package_graph.h"
+#include <fstream> // std::ofstream for the manifests
+
+namespace fs = std::filesystem;
+
+static const char* MEDIA_PLAYER_MUM = "Microsoft-Windows-MediaPlayer-Package~31bf3856ad364e35~amd64~~10.0.22621.1.mum";
+
+// Function to write the manifest of package 'identity' into the image at 'imageDir', naming the packages it needs
+// and the packages it contains by their identities
+static void WriteTestManifest(const fs::path& imageDir, const std::string& identity, const std::vector<std::string>& parents,
+    const std::vector<std::string>& children = {}) {
+    auto identityTag = [](const std::string& packageIdentity) {
+        size_t first = packageIdentity.find('~');
+        size_t second = packageIdentity.find('~', first + 1);
+        size_t third = packageIdentity.find('~', second + 1);
+        return "<assemblyIdentity name=\"" + packageIdentity.substr(0, first) + "\" version=\"10.0.22621.1\" processorArchitecture=\"" +
+            packageIdentity.substr(second + 1, third - second - 1) + "\" language=\"neutral\" publicKeyToken=\"31bf3856ad364e35\" />";
+    };
+    fs::path packagesDir = imageDir / "Windows" / "servicing" / "Packages";
+    fs::create_directories(packagesDir);
+    std::ofstream file(packagesDir / (identity + ".mum"), std::ios::binary | std::ios::trunc);
+    file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\r\n<assembly xmlns=\"urn:schemas-microsoft-com:asm.v3\">\r\n  "
+        << identityTag(identity) << "\r\n  <package identifier=\"Test\">\r\n";
+    for (const std::string& parent : parents) {
+        file << "    <parent integrate=\"separate\">" << identityTag(parent) << "</parent>\r\n";
+    }
+    for (const std::string& child : children) {
+        file << "    <update name=\"Child\"><package contained=\"true\">" << identityTag(child) << "</package></update>\r\n";
+    }
+    file << "  </package>\r\n</assembly>\r\n";
+}
+
+// Function to make the identity of test package 'name'
+static std::string TestPackage(const std::string& name) {
+    return name + "-Package~31bf3856ad364e35~amd64~~10.0.22621.1";
+}
+
+TEST(PackageKeyIsNameAndArchitecture) {
+    CHECK(PackageKey("Microsoft-Windows-MediaPlayer-Package~31bf3856ad364e35~amd64~~10.0.22621.1") == "microsoft-windows-mediaplayer-package~amd64");
+    CHECK(PackageKey("Package_for_RollupFix~31bf3856ad364e35~AMD64~~22621.2861.1.6") == "package_for_rollupfix~amd64");
+    CHECK(PackageKey("Microsoft-Windows-LanguageFeatures-Basic-en-us-Package~31bf3856ad364e35~wow64~en-US~10.0.22621.1") ==
+        "microsoft-windows-languagefeatures-basic-en-us-package~wow64");
+    CHECK(PackageKey("Some-Package~31bf3856ad364e35~x86") == "some-package~x86"); // No language or version
+    CHECK(PackageKey("Some-Package~31bf3856ad364e35") == "some-package~");
+    CHECK(PackageKey("Some-Package") == "some-package");
+    CHECK(PackageKey("") == "");
+}
+
+TEST(ReadPackageManifestFromMum) {
+    fs::path dir = TestDirectory("package_manifest");
+    std::string path = (dir / MEDIA_PLAYER_MUM).string();
+    std::ofstream(path, std::ios::binary) << ReadTestFixture(MEDIA_PLAYER_MUM);
+
+    PackageManifest manifest;
+    REQUIRE(ReadPackageManifest(path, manifest));
+    CHECK(manifest.key == "microsoft-windows-mediaplayer-package~amd64");
+    REQUIRE(manifest.parents.size() == 2);
+    CHECK(manifest.parents[0] == "microsoft-windows-foundation-package~amd64");
+    CHECK(manifest.parents[1] == "microsoft-windows-client-features-package~amd64"); // Single quotes, spaces and capitals
+    REQUIRE(manifest.children.size() == 2); // The <component> of the last <update> is not a package
+    CHECK(manifest.children[0] == "microsoft-windows-mediaplayer-package-wrapper~amd64");
+    CHECK(manifest.children[1] == "microsoft-windows-mediaplayer-package-wrapper-lp~amd64");
+
+    // A manifest without an identity of its own, or no manifest at all, is not read
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "<?xml version=\"1.0\"?>\r\n<assembly>\r\n  <package />\r\n</assembly>\r\n";
+    CHECK(!ReadPackageManifest(path, manifest));
+    CHECK(!ReadPackageManifest((dir / "missing.mum").string(), manifest));
+}
+
+TEST(PlanPackageRemovalInLayers) {
+    fs::path image = TestDirectory("package_plan_layers");
+    // A needs B, B needs C, D needs C, E has no manifest, F needs a package outside the set
+    WriteTestManifest(image, TestPackage("A"), { TestPackage("B") });
+    WriteTestManifest(image, TestPackage("B"), { TestPackage("C") });
+    WriteTestManifest(image, TestPackage("C"), {});
+    WriteTestManifest(image, TestPackage("D"), { TestPackage("C") });
+    WriteTestManifest(image, TestPackage("F"), { TestPackage("Foundation") });
+
+    PackageRemovalPlan plan = PlanPackageRemoval(image.string(),
+        { TestPackage("C"), TestPackage("B"), TestPackage("A"), TestPackage("D"), TestPackage("E"), TestPackage("F") });
+    REQUIRE(plan.batches.size() == 3);
+    CHECK(plan.batches[0] == std::vector<std::string>({ TestPackage("A"), TestPackage("D"), TestPackage("E"), TestPackage("F") }));
+    CHECK(plan.batches[1] == std::vector<std::string>({ TestPackage("B") }));
+    CHECK(plan.batches[2] == std::vector<std::string>({ TestPackage("C") }));
+    CHECK(plan.cyclic.empty());
+    CHECK(plan.contained.empty());
+
+    plan = PlanPackageRemoval(image.string(), {});
+    CHECK(plan.batches.empty());
+}
+
+TEST(PlanPackageRemovalCycles) {
+    fs::path image = TestDirectory("package_plan_cycles");
+    // X and Y need each other, Z needs X, W needs nothing
+    WriteTestManifest(image, TestPackage("X"), { TestPackage("Y") });
+    WriteTestManifest(image, TestPackage("Y"), { TestPackage("X") });
+    WriteTestManifest(image, TestPackage("Z"), { TestPackage("X") });
+    WriteTestManifest(image, TestPackage("W"), {});
+
+    PackageRemovalPlan plan = PlanPackageRemoval(image.string(), { TestPackage("X"), TestPackage("Y"), TestPackage("Z"), TestPackage("W") });
+    REQUIRE(plan.batches.size() == 1);
+    CHECK(plan.batches[0] == std::vector<std::string>({ TestPackage("Z"), TestPackage("W") }));
+    CHECK(plan.cyclic == std::vector<std::string>({ TestPackage("X"), TestPackage("Y") }));
+}
+
+TEST(PlanPackageRemovalLeavesContainedPackagesToTheirContainer) {
+    fs::path image = TestDirectory("package_plan_contained");
+    // K contains L and M, and M contains N. L needs P, so K, which takes L along, goes before P.
+    WriteTestManifest(image, TestPackage("K"), {}, { TestPackage("L"), TestPackage("M"), TestPackage("Outside") });
+    WriteTestManifest(image, TestPackage("L"), { TestPackage("P"), TestPackage("K") });
+    WriteTestManifest(image, TestPackage("M"), {}, { TestPackage("N") });
+    WriteTestManifest(image, TestPackage("N"), {});
+    WriteTestManifest(image, TestPackage("P"), {});
+    // Q and R claim to contain each other: neither is dropped, they are tried one at a time
+    WriteTestManifest(image, TestPackage("Q"), {}, { TestPackage("R") });
+    WriteTestManifest(image, TestPackage("R"), {}, { TestPackage("Q") });
+
+    PackageRemovalPlan plan = PlanPackageRemoval(image.string(), { TestPackage("N"), TestPackage("L"), TestPackage("P"),
+        TestPackage("K"), TestPackage("M"), TestPackage("Q"), TestPackage("R") });
+    CHECK(plan.contained == std::vector<std::string>({ TestPackage("N"), TestPackage("L"), TestPackage("M") }));
+    REQUIRE(plan.batches.size() == 2);
+    CHECK(plan.batches[0] == std::vector<std::string>({ TestPackage("K") }));
+    CHECK(plan.batches[1] == std::vector<std::string>({ TestPackage("P") }));
+    CHECK(plan.cyclic == std::vector<std::string>({ TestPackage("Q"), TestPackage("R") }));
+
+    // Without its container in the set, a package is removed on its own
+    plan = PlanPackageRemoval(image.string(), { TestPackage("L"), TestPackage("P"), TestPackage("N") });
+    CHECK(plan.contained.empty());
+    REQUIRE(plan.batches.size() == 2);
+    CHECK(plan.batches[0] == std::vector<std::string>({ TestPackage("L"), TestPackage("N") }));
+    CHECK(plan.batches[1] == std::vector<std::string>({ TestPackage("P") }));
+}
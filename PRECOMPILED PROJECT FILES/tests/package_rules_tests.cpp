@@ -0,0 +1,96 @@
+// Tests of the package rules: how the built-in safe list and added rules classify package identities, and what a
+// rule file may hold
+#include "test.h"
+#include "../package_rules.h"
+#include <fstream> // std::ofstream for the rule files
+
+namespace fs = std::filesystem;
+
+// Function to write 'text' as the rule file 'name' of 'dir', as it is, line endings included
+static std::string WriteRuleFile(const fs::path& dir, const std::string& name, const std::string& text) {
+    fs::path path = dir / name;
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+    return path.string();
+}
+
+TEST(BuiltInRulesRemoveTheSafeList) {
+    PackageRuleSet rules;
+    CHECK(rules.RuleCount() == SAFE_PACKAGE_PREFIXES.size());
+    CHECK(rules.Classify("Microsoft-Windows-MediaPlayer-Package~31bf3856ad364e35~amd64~~10.0.22621.1") == PackageVerdict::Remove);
+    CHECK(rules.Classify("OpenSSH-Client-Package~31bf3856ad364e35~amd64~~10.0.22621.1") == PackageVerdict::Remove);
+    CHECK(rules.Classify("Microsoft-Windows-Client-LanguagePack-Package~31bf3856ad364e35~amd64~en-US~10.0.22621.1") == PackageVerdict::None);
+    CHECK(rules.Classify("Microsoft-Windows-Media") == PackageVerdict::None); // Shorter than the rule
+    CHECK(rules.Classify("") == PackageVerdict::None);
+}
+
+TEST(LongestPrefixDecides) {
+    PackageRuleSet rules;
+    rules.Add("Microsoft-Windows-Printing-PMCPPC", PackageVerdict::Keep);
+    CHECK(rules.Classify("Microsoft-Windows-Printing-PMCPPC-FoD-Package~31bf3856ad364e35~amd64~~10.0.22621.1") == PackageVerdict::Keep);
+    CHECK(rules.Classify("Microsoft-Windows-Printing-WFS-FoD-Package~31bf3856ad364e35~amd64~~10.0.22621.1") == PackageVerdict::Remove);
+
+    // A longer remove under the keep wins again, whichever rule was added first
+    rules.Add("Microsoft-Windows-Printing-PMCPPC-FoD", PackageVerdict::Remove);
+    CHECK(rules.Classify("Microsoft-Windows-Printing-PMCPPC-FoD-Package") == PackageVerdict::Remove);
+    CHECK(rules.Classify("Microsoft-Windows-Printing-PMCPPC-Other") == PackageVerdict::Keep);
+    rules.Add("Microsoft-Windows", PackageVerdict::Keep);
+    CHECK(rules.Classify("Microsoft-Windows-Printing-PMCPPC-FoD-Package") == PackageVerdict::Remove);
+    CHECK(rules.Classify("Microsoft-Windows-Notepad-System-FoD-Package") == PackageVerdict::Keep);
+    CHECK(rules.Classify("Microsoft-OneCore-DirectX-Database-FOD-Package") == PackageVerdict::Remove);
+}
+
+TEST(RulesIgnoreCase) {
+    PackageRuleSet rules;
+    CHECK(rules.Classify("MICROSOFT-WINDOWS-WORDPAD-FOD-PACKAGE") == PackageVerdict::Remove);
+    CHECK(rules.Classify("microsoft-windows-wordpad-fod-package") == PackageVerdict::Remove);
+    rules.Add("MICROSOFT-WINDOWS-NOTEPAD", PackageVerdict::Remove);
+    CHECK(rules.Classify("Microsoft-Windows-Notepad-System-FoD-Package") == PackageVerdict::Remove);
+    rules.Add("microsoft-windows-notepad", PackageVerdict::Keep); // The same prefix
+    CHECK(rules.Classify("Microsoft-Windows-Notepad-System-FoD-Package") == PackageVerdict::Keep);
+    CHECK(rules.RuleCount() == SAFE_PACKAGE_PREFIXES.size() + 1);
+}
+
+TEST(LaterRuleReplacesTheSamePrefix) {
+    PackageRuleSet rules;
+    rules.Add("Microsoft-Windows-MediaPlayer", PackageVerdict::Keep);
+    CHECK(rules.Classify("Microsoft-Windows-MediaPlayer-Package") == PackageVerdict::Keep);
+    CHECK(rules.RuleCount() == SAFE_PACKAGE_PREFIXES.size()); // Replaced, not added
+
+    // Files load in name order, so the second file has the last word
+    fs::path dir = TestDirectory("package_rules_folder");
+    WriteRuleFile(dir, "1-remove.txt", "remove Contoso-Tools\n");
+    WriteRuleFile(dir, "2-keep.txt", "keep Contoso-Tools\n");
+    WriteRuleFile(dir, "3-notes.md", "remove Contoso-Tools\n"); // Not a .txt file
+    PackageRuleSet folderRules;
+    CHECK(folderRules.LoadFolder(dir.string()) == 2);
+    CHECK(folderRules.Classify("Contoso-Tools-Package") == PackageVerdict::Keep);
+    CHECK(folderRules.RuleCount() == SAFE_PACKAGE_PREFIXES.size() + 1);
+    CHECK(PackageRuleSet().LoadFolder((dir / "missing").string()) == 0);
+}
+
+TEST(RuleFileSkipsLinesItDoesNotUnderstand) {
+    fs::path dir = TestDirectory("package_rules_file");
+    std::string path = WriteRuleFile(dir, "rules.txt",
+        "# Windows line endings\r\n"
+        "remove Contoso-Tools\r\n"
+        "  keep\tContoso-Tools-Runtime  \r\n"
+        "\r\n"
+        "   # indented comment\r\n"
+        "keep \r\n"              // No prefix, only the \r after it
+        "remove\r\n"
+        "Remove Contoso-Other\r\n" // Kinds are lowercase
+        "delete Contoso-Other\r\n"
+        "removeContoso-Other\r\n"
+        "keep Fabrikam-Driver"); // Last line without a line ending
+    PackageRuleSet rules;
+    REQUIRE(rules.LoadFile(path));
+    CHECK(rules.RuleCount() == SAFE_PACKAGE_PREFIXES.size() + 3);
+    CHECK(rules.Classify("Contoso-Tools-Package") == PackageVerdict::Remove);
+    CHECK(rules.Classify("Contoso-Tools-Runtime-Package") == PackageVerdict::Keep);
+    CHECK(rules.Classify("Contoso-Other-Package") == PackageVerdict::None);
+    CHECK(rules.Classify("Fabrikam-Driver") == PackageVerdict::Keep);
+    CHECK(rules.Classify("\r") == PackageVerdict::None);
+
+    CHECK(!rules.LoadFile((dir / "missing.txt").string()));
+    CHECK(rules.RuleCount() == SAFE_PACKAGE_PREFIXES.size() + 3);
+}
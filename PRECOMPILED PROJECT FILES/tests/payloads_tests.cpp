@@ -0,0 +1,145 @@
+// Tests of the payloads packed into MODWIN: unpacking them, and what a payload check does with the copies on disk
+// and the sidecar manifest
+#include "test.h"
+#include "../payloads.h"
+#include "../sha1.h"
+#include <chrono>   // std::chrono::hours for moving write times
+#include <fstream>  // std::ifstream and std::ofstream for the copies
+#include <iterator> // std::istreambuf_iterator for reading copies back
+
+namespace fs = std::filesystem;
+
+// Function to read a whole copy
+static std::vector<uint8_t> ReadTestCopy(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Function to check that the copy of payload 'id' in 'dir' is the packed payload
+static bool CopyIsPayload(const fs::path& dir, Payload id) {
+    std::vector<uint8_t> packed;
+    return ReadPayload(id, packed) && ReadTestCopy(dir / PayloadInfo(id).name) == packed;
+}
+
+// Function to run a payload check of 'dir' on two threads
+static PayloadSyncStats SyncTestPayloads(const fs::path& dir, bool unpackMissing) {
+    PayloadSyncStats stats;
+    CHECK(SyncPayloads(dir, unpackMissing, &stats, 2));
+    return stats;
+}
+
+TEST(ReadPayloadMatchesItsTable) {
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        std::vector<uint8_t> data;
+        REQUIRE(ReadPayload(static_cast<Payload>(i), data));
+        CHECK(data.size() == EMBEDDED_PAYLOADS[i].size);
+        uint8_t digest[SHA1_DIGEST_SIZE];
+        Sha1Buffer(data.data(), data.size(), digest);
+        CHECK(Sha1ToHex(digest) == EMBEDDED_PAYLOADS[i].sha1);
+    }
+}
+
+TEST(UnpackPayloadWritesOnlyWhatIsAsked) {
+    fs::path dir = TestDirectory("payloads_unpack");
+    REQUIRE(UnpackPayload(Payload::TPM_fix_cmd, dir));
+    CHECK(CopyIsPayload(dir, Payload::TPM_fix_cmd));
+    CHECK(!fs::exists(dir / PayloadInfo(Payload::autounattend_xml).name));
+    CHECK(!fs::exists(dir / (std::string(PayloadInfo(Payload::TPM_fix_cmd).name) + ".tmp")));
+
+    PayloadManifest manifest;
+    REQUIRE(LoadPayloadManifest(dir / PAYLOAD_MANIFEST_NAME, manifest));
+    REQUIRE(manifest.size() == 1);
+    CHECK(manifest.begin()->first == PayloadInfo(Payload::TPM_fix_cmd).name);
+    CHECK(manifest.begin()->second.sha1 == PayloadInfo(Payload::TPM_fix_cmd).sha1);
+    CHECK(manifest.begin()->second.size == PayloadInfo(Payload::TPM_fix_cmd).size);
+
+    REQUIRE(UnpackPayloads({ Payload::TPM_fix_cmd, Payload::autounattend_xml }, dir));
+    CHECK(CopyIsPayload(dir, Payload::TPM_fix_cmd));
+    CHECK(CopyIsPayload(dir, Payload::autounattend_xml));
+    REQUIRE(LoadPayloadManifest(dir / PAYLOAD_MANIFEST_NAME, manifest));
+    CHECK(manifest.size() == 2);
+}
+
+TEST(SyncPayloadsUnpacksMissingCopiesOnlyWhenAsked) {
+    fs::path dir = TestDirectory("payloads_missing");
+    PayloadSyncStats stats = SyncTestPayloads(dir, false);
+    CHECK(stats.checked == 0);
+    CHECK(stats.rewritten == 0);
+    CHECK(!fs::exists(dir / PAYLOAD_MANIFEST_NAME)); // Nothing was read or written
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        CHECK(!fs::exists(dir / EMBEDDED_PAYLOADS[i].name));
+    }
+
+    stats = SyncTestPayloads(dir, true);
+    CHECK(stats.checked == 0);
+    CHECK(stats.rewritten == PAYLOAD_COUNT);
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        CHECK(CopyIsPayload(dir, static_cast<Payload>(i)));
+    }
+}
+
+TEST(SyncPayloadsTrustsCopiesTheManifestVouchesFor) {
+    fs::path dir = TestDirectory("payloads_trusted");
+    REQUIRE(SyncPayloads(dir, true, nullptr, 2));
+    PayloadSyncStats stats = SyncTestPayloads(dir, false);
+    CHECK(stats.checked == PAYLOAD_COUNT);
+    CHECK(stats.hashed == 0);
+    CHECK(stats.rewritten == 0);
+
+    // The manifest only vouches for the copy it saw: same content but a new write time is read once, then trusted
+    const fs::path copy = dir / PayloadInfo(Payload::autounattend_xml).name;
+    fs::last_write_time(copy, fs::last_write_time(copy) + std::chrono::hours(1));
+    stats = SyncTestPayloads(dir, false);
+    CHECK(stats.hashed == 1);
+    CHECK(stats.rewritten == 0);
+    stats = SyncTestPayloads(dir, false);
+    CHECK(stats.hashed == 0);
+
+    // A manifest recording another hash, as one left by an older MODWIN would, does not vouch for anything
+    PayloadManifest manifest;
+    REQUIRE(LoadPayloadManifest(dir / PAYLOAD_MANIFEST_NAME, manifest));
+    for (auto& [name, state] : manifest) {
+        state.sha1 = "0000000000000000000000000000000000000000";
+    }
+    REQUIRE(SavePayloadManifest(dir / PAYLOAD_MANIFEST_NAME, manifest));
+    stats = SyncTestPayloads(dir, false);
+    CHECK(stats.hashed == PAYLOAD_COUNT);
+    CHECK(stats.rewritten == 0);
+}
+
+TEST(SyncPayloadsRewritesStaleCopies) {
+    fs::path dir = TestDirectory("payloads_stale");
+    REQUIRE(SyncPayloads(dir, true, nullptr, 2));
+    const fs::path cmd = dir / PayloadInfo(Payload::TPM_fix_cmd).name;
+    const fs::path xml = dir / PayloadInfo(Payload::autounattend_xml).name;
+
+    // Same size, other content: hashed, then written again
+    std::vector<uint8_t> damaged = ReadTestCopy(cmd);
+    damaged[damaged.size() / 2] ^= 0x20;
+    std::ofstream(cmd, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(damaged.data()), damaged.size());
+    fs::last_write_time(cmd, fs::last_write_time(cmd) + std::chrono::hours(1));
+    // Other size: written again without being read
+    std::ofstream(xml, std::ios::binary | std::ios::trunc) << "<unattend/>";
+
+    PayloadSyncStats stats = SyncTestPayloads(dir, false);
+    CHECK(stats.checked == 2);
+    CHECK(stats.hashed == 1);
+    CHECK(stats.rewritten == 2);
+    CHECK(CopyIsPayload(dir, Payload::TPM_fix_cmd));
+    CHECK(CopyIsPayload(dir, Payload::autounattend_xml));
+
+    PayloadManifest manifest; // Rewritten copies are recorded, so the next check trusts them
+    REQUIRE(LoadPayloadManifest(dir / PAYLOAD_MANIFEST_NAME, manifest));
+    CHECK(manifest.at(PayloadInfo(Payload::TPM_fix_cmd).name).size == PayloadInfo(Payload::TPM_fix_cmd).size);
+    stats = SyncTestPayloads(dir, false);
+    CHECK(stats.hashed == 0);
+    CHECK(stats.rewritten == 0);
+
+    // A damaged manifest is ignored: every copy is read once and the manifest is written anew
+    std::ofstream(dir / PAYLOAD_MANIFEST_NAME, std::ios::trunc) << "MODWIN payload";
+    stats = SyncTestPayloads(dir, false);
+    CHECK(stats.hashed == PAYLOAD_COUNT);
+    CHECK(stats.rewritten == 0);
+    CHECK(LoadPayloadManifest(dir / PAYLOAD_MANIFEST_NAME, manifest));
+    CHECK(manifest.size() == PAYLOAD_COUNT);
+}
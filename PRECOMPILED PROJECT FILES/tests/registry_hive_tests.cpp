@@ -0,0 +1,210 @@
+// Tests of the offline hive editor: a hive built from scratch, saved, reopened and edited again, and hives whose
+// base block is damaged
+#include "test.h"
+#include "../registry_hive.h"
+#include <algorithm> // std::transform for comparing names without regard to case
+#include <cstring> // std::memcpy for reading DWORD values
+#include <fstream> // std::fstream for damaging a saved hive
+
+namespace fs = std::filesystem;
+
+// Function to read a REG_DWORD value, 0xFFFFFFFF when it is missing or not 4 bytes
+static uint32_t ReadDword(const RegistryHive& hive, uint32_t key, const char* name) {
+    std::vector<uint8_t> bytes = hive.ReadValueData(hive.FindValue(key, name));
+    uint32_t number = 0xFFFFFFFF;
+    if (bytes.size() == 4) {
+        std::memcpy(&number, bytes.data(), 4);
+    }
+    return number;
+}
+
+// Function to set a REG_DWORD value
+static bool SetDword(RegistryHive& hive, uint32_t key, const char* name, uint32_t number) {
+    uint8_t bytes[4];
+    std::memcpy(bytes, &number, 4);
+    return hive.SetValue(key, name, HIVE_REG_DWORD, bytes, 4);
+}
+
+// Function to flip one byte of a saved file at 'offset'
+static void DamageByte(const fs::path& file, std::streamoff offset) {
+    std::fstream stream(file, std::ios::binary | std::ios::in | std::ios::out);
+    stream.seekg(offset);
+    char byte = 0;
+    stream.get(byte);
+    stream.seekp(offset);
+    stream.put(static_cast<char>(byte ^ 0x5A));
+}
+
+TEST(HiveCreateSetDeleteSaveReopen) {
+    fs::path file = TestDirectory("hive_roundtrip") / "SOFTWARE";
+    std::vector<uint8_t> big(40000); // Split into big data segments
+    for (size_t i = 0; i < big.size(); i++) {
+        big[i] = static_cast<uint8_t>(i * 7);
+    }
+    {
+        RegistryHive hive;
+        hive.Create(file);
+        uint32_t policies = hive.CreateKeyPath("Policies\\Microsoft\\Windows\\DataCollection");
+        REQUIRE(policies != HIVE_NO_CELL);
+        CHECK(SetDword(hive, policies, "AllowTelemetry", 0));
+        CHECK(SetDword(hive, policies, "Removed", 5));
+        std::vector<uint8_t> text = EncodeHiveString("Hello, hive");
+        CHECK(hive.SetValue(policies, "", HIVE_REG_SZ, text.data(), text.size()));
+        CHECK(hive.SetValue(policies, "Big", HIVE_REG_BINARY, big.data(), big.size()));
+        CHECK(hive.DeleteValue(policies, "removed")); // Names are matched without regard to case
+        CHECK(hive.CreateKeyPath("Policies\\Gone\\Below") != HIVE_NO_CELL);
+        CHECK(hive.DeleteKey(hive.OpenKey("Policies"), "GONE"));
+        CHECK(hive.Modified());
+        REQUIRE(hive.Save());
+        CHECK(!hive.Modified());
+    }
+
+    RegistryHive hive;
+    REQUIRE(hive.Open(file));
+    CHECK(!hive.Dirty());
+    uint32_t policies = hive.OpenKey("policies\\MICROSOFT\\Windows\\DataCollection");
+    REQUIRE(policies != HIVE_NO_CELL);
+    CHECK(hive.KeyName(policies) == "DataCollection");
+    CHECK(ReadDword(hive, policies, "AllowTelemetry") == 0);
+    CHECK(hive.FindValue(policies, "Removed") == HIVE_NO_CELL);
+    CHECK(hive.Values(policies).size() == 3);
+    std::vector<uint8_t> text = hive.ReadValueData(hive.FindValue(policies, ""));
+    CHECK(DecodeHiveString(text.data(), text.size()) == "Hello, hive");
+    CHECK(hive.ValueType(hive.FindValue(policies, "Big")) == HIVE_REG_BINARY);
+    CHECK(hive.ReadValueData(hive.FindValue(policies, "Big")) == big);
+    CHECK(hive.OpenKey("Policies\\Gone") == HIVE_NO_CELL);
+    CHECK(hive.Subkeys(hive.OpenKey("Policies")).size() == 1);
+    CHECK(!hive.DeleteKey(hive.Root(), "Policies\\Missing"));
+}
+
+TEST(HiveEditAfterReopen) {
+    fs::path file = TestDirectory("hive_edit") / "SYSTEM";
+    {
+        RegistryHive hive;
+        hive.Create(file);
+        uint32_t services = hive.CreateKeyPath("ControlSet001\\Services");
+        for (const char* name : { "Tcpip", "bowser", "WinDefend", "Afd", "DiagTrack" }) {
+            CHECK(SetDword(hive, hive.CreateKey(services, name), "Start", 3));
+        }
+        REQUIRE(hive.Save());
+    }
+    {
+        RegistryHive hive;
+        REQUIRE(hive.Open(file));
+        uint32_t services = hive.OpenKey("ControlSet001\\Services");
+        CHECK(SetDword(hive, hive.FindSubkey(services, "DiagTrack"), "Start", 4));
+        CHECK(hive.DeleteKey(services, "Bowser"));
+        CHECK(hive.CreateKey(services, "AFD") == hive.FindSubkey(services, "Afd")); // Keys that exist are returned
+        REQUIRE(hive.Save()); // Writes only the changed pages, logged to .LOG1 first
+        CHECK(fs::exists(file.string() + ".LOG1"));
+    }
+    RegistryHive hive;
+    REQUIRE(hive.Open(file));
+    uint32_t services = hive.OpenKey("ControlSet001\\Services");
+    std::vector<std::string> names;
+    for (uint32_t key : hive.Subkeys(services)) {
+        names.push_back(hive.KeyName(key));
+    }
+    CHECK((names == std::vector<std::string>{ "Afd", "DiagTrack", "Tcpip", "WinDefend" })); // Sorted by uppercased name
+    CHECK(ReadDword(hive, hive.FindSubkey(services, "diagtrack"), "Start") == 4);
+    CHECK(ReadDword(hive, hive.FindSubkey(services, "Tcpip"), "Start") == 3);
+}
+
+TEST(HiveWithBadChecksumIsRecoveredFromLog) {
+    fs::path file = TestDirectory("hive_checksum_log") / "DEFAULT";
+    {
+        RegistryHive hive;
+        hive.Create(file);
+        CHECK(SetDword(hive, hive.CreateKeyPath("Control Panel\\Desktop"), "MenuShowDelay", 0));
+        REQUIRE(hive.Save());
+        CHECK(SetDword(hive, hive.OpenKey("Control Panel\\Desktop"), "MenuShowDelay", 200));
+        REQUIRE(hive.Save());
+    }
+    DamageByte(file, 12); // Timestamp, covered by the checksum
+    RegistryHive hive;
+    REQUIRE(hive.Open(file));
+    CHECK(!hive.Dirty());
+    CHECK(ReadDword(hive, hive.OpenKey("Control Panel\\Desktop"), "MenuShowDelay") == 200);
+}
+
+TEST(HiveWithBadChecksumAndNoLogIsRejected) {
+    fs::path file = TestDirectory("hive_checksum") / "DRIVERS";
+    {
+        RegistryHive hive;
+        hive.Create(file);
+        CHECK(hive.CreateKeyPath("DriverDatabase") != HIVE_NO_CELL);
+        REQUIRE(hive.Save());
+    }
+    DamageByte(file, 36); // Root cell offset
+    RegistryHive hive;
+    CHECK(!hive.Open(file));
+}
+
+TEST(HiveWithThousandsOfSubkeys) {
+    fs::path file = TestDirectory("hive_subkeys") / "SOFTWARE";
+    auto nameOf = [](size_t i) { return "{CLSID-" + std::to_string(i * 7919 % 6000) + "}"; }; // Added out of order
+    {
+        RegistryHive hive;
+        hive.Create(file);
+        uint32_t classes = hive.CreateKeyPath("Classes\\CLSID");
+        for (size_t i = 0; i < 6000; i++) {
+            REQUIRE(hive.CreateKey(classes, nameOf(i)) != HIVE_NO_CELL);
+        }
+        REQUIRE(hive.Save());
+    }
+    // Each key adds one nk cell and one list entry; rewriting the whole list on every insert made this 17 MB
+    uintmax_t hiveSize = fs::file_size(file);
+    CHECK(hiveSize < 1024 * 1024);
+    {
+        RegistryHive hive;
+        REQUIRE(hive.Open(file));
+        uint32_t classes = hive.OpenKey("Classes\\CLSID");
+        CHECK(hive.CreateKey(classes, "{CLSID-new}") != HIVE_NO_CELL);
+        REQUIRE(hive.Save());
+        CHECK(fs::file_size(file.string() + ".LOG1") <= 32 * 1024); // Only the pages of one leaf and the keys
+    }
+
+    RegistryHive hive;
+    REQUIRE(hive.Open(file));
+    uint32_t classes = hive.OpenKey("Classes\\CLSID");
+    std::vector<uint32_t> subkeys = hive.Subkeys(classes);
+    CHECK(subkeys.size() == 6001);
+    bool sorted = true;
+    for (size_t i = 1; i < subkeys.size(); i++) {
+        std::string before = hive.KeyName(subkeys[i - 1]);
+        std::string after = hive.KeyName(subkeys[i]);
+        std::transform(before.begin(), before.end(), before.begin(), ::toupper);
+        std::transform(after.begin(), after.end(), after.begin(), ::toupper);
+        sorted = sorted && before < after;
+    }
+    CHECK(sorted);
+    for (size_t i = 0; i < 6000; i += 250) {
+        CHECK(hive.KeyName(hive.FindSubkey(classes, nameOf(i))) == nameOf(i));
+    }
+
+    // Keys added after others were deleted take their cells
+    for (size_t i = 0; i < 6000; i += 2) {
+        CHECK(hive.DeleteKey(classes, nameOf(i)));
+    }
+    for (size_t i = 0; i < 3000; i++) {
+        CHECK(hive.CreateKey(classes, "{CLSXD-" + std::to_string(i * 2) + "}") != HIVE_NO_CELL); // Names as long as the deleted ones
+    }
+    REQUIRE(hive.Save());
+    CHECK(fs::file_size(file) <= hiveSize + 64 * 1024); // The leaves split as the new names all sort last
+    CHECK(hive.Subkeys(classes).size() == 6001);
+    CHECK(hive.FindSubkey(classes, nameOf(0)) == HIVE_NO_CELL);
+    CHECK(hive.FindSubkey(classes, nameOf(1)) != HIVE_NO_CELL);
+    CHECK(hive.FindSubkey(classes, "{clsxd-5998}") != HIVE_NO_CELL);
+
+    // Once every key is deleted their cells merge back into runs that hold the larger keys added next
+    for (uint32_t key : hive.Subkeys(classes)) {
+        CHECK(hive.DeleteKey(classes, hive.KeyName(key)));
+    }
+    CHECK(hive.Subkeys(classes).empty());
+    for (size_t i = 0; i < 6000; i++) {
+        CHECK(hive.CreateKey(classes, "{Replacement-" + std::to_string(i) + "}") != HIVE_NO_CELL);
+    }
+    REQUIRE(hive.Save());
+    CHECK(fs::file_size(file) <= hiveSize + 128 * 1024);
+    CHECK(hive.Subkeys(classes).size() == 6000);
+}
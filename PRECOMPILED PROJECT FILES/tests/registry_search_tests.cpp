@@ -0,0 +1,136 @@
+// Tests of the registry search index: hives built here are indexed and searched by key path, value name and value
+// data, with short queries that scan the data and longer ones that go through the trigrams
+#include "test.h"
+#include "../registry_hive.h"
+#include "../registry_search.h"
+
+namespace fs = std::filesystem;
+
+// Function to set a string value of type 'type'
+static bool SetString(RegistryHive& hive, uint32_t key, const char* name, const std::string& text, uint32_t type = HIVE_REG_SZ) {
+    std::vector<uint8_t> bytes = EncodeHiveString(text);
+    return hive.SetValue(key, name, type, bytes.data(), bytes.size());
+}
+
+// Function to write a SOFTWARE and a SYSTEM hive into 'configDir'
+static void WriteSearchHives(const fs::path& configDir) {
+    {
+        RegistryHive hive;
+        hive.Create(configDir / "SOFTWARE");
+        uint32_t run = hive.CreateKeyPath("Microsoft\\Windows\\CurrentVersion\\Run");
+        CHECK(SetString(hive, run, "OneDriveSetup", "C:\\Windows\\System32\\OneDriveSetup.exe /thfirstsetup"));
+        CHECK(SetString(hive, run, "SecurityHealth", "%windir%\\system32\\SecurityHealthSystray.exe", HIVE_REG_EXPAND_SZ));
+        CHECK(hive.CreateKeyPath("Microsoft\\Windows\\CurrentVersion\\Policies\\Explorer") != HIVE_NO_CELL);
+        uint8_t one[4] = { 1, 0, 0, 0 };
+        CHECK(hive.SetValue(hive.CreateKeyPath("Microsoft\\OneDrive"), "DisableFileSyncNGSC", HIVE_REG_DWORD, one, 4));
+        uint32_t dataCollection = hive.CreateKeyPath("Policies\\Microsoft\\Windows\\DataCollection");
+        uint8_t zero[4] = {};
+        CHECK(hive.SetValue(dataCollection, "AllowTelemetry", HIVE_REG_DWORD, zero, 4));
+        std::vector<uint8_t> tags = EncodeHiveString("alpha");
+        std::vector<uint8_t> second = EncodeHiveString("telemetry beta");
+        tags.insert(tags.end(), second.begin(), second.end());
+        tags.push_back(0);
+        tags.push_back(0);
+        CHECK(hive.SetValue(dataCollection, "Tags", HIVE_REG_MULTI_SZ, tags.data(), tags.size()));
+        CHECK(SetString(hive, dataCollection, "Dada", "dada dada"));
+        REQUIRE(hive.Save());
+    }
+    {
+        RegistryHive hive;
+        hive.Create(configDir / "SYSTEM");
+        uint32_t diagTrack = hive.CreateKeyPath("ControlSet001\\Services\\DiagTrack");
+        CHECK(SetString(hive, diagTrack, "ImagePath", "%SystemRoot%\\System32\\svchost.exe -k utcsvc -p", HIVE_REG_EXPAND_SZ));
+        uint8_t four[4] = { 4, 0, 0, 0 };
+        CHECK(hive.SetValue(diagTrack, "Start", HIVE_REG_DWORD, four, 4));
+        REQUIRE(hive.Save());
+    }
+}
+
+// Function to list the hits of a search as "HIVE\key : value"
+static std::vector<std::string> HitNames(const RegistrySearchResult& result) {
+    std::vector<std::string> names;
+    for (const RegistrySearchHit& hit : result.hits) {
+        names.push_back(hit.hive + "\\" + hit.keyPath + (hit.isValue ? " : " + hit.valueName : ""));
+    }
+    return names;
+}
+
+TEST(RegistrySearchFindsKeysValuesAndData) {
+    fs::path configDir = TestDirectory("registry_search");
+    WriteSearchHives(configDir);
+    RegistrySearchIndex index;
+    REQUIRE(index.Build(configDir.string(), { "SOFTWARE", "SYSTEM", "SAM" }, true)); // SAM is missing and skipped
+    CHECK(index.KeyCount() == 14);
+    CHECK(index.ValueCount() == 8);
+
+    // Key and value names, without regard to case. The data of OneDriveSetup holds the query too, but a value is
+    // one hit at most.
+    RegistrySearchResult result = index.Find("ONEDRIVE", 100);
+    CHECK(result.totalHits == 2);
+    CHECK(HitNames(result) == std::vector<std::string>({ "SOFTWARE\\Microsoft\\OneDrive",
+        "SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Run : OneDriveSetup" }));
+
+    // A key found by name is not found again as the parent of every key below it
+    result = index.Find("microsoft", 100);
+    CHECK(HitNames(result) == std::vector<std::string>({ "SOFTWARE\\Microsoft", "SOFTWARE\\Policies\\Microsoft" }));
+    result = index.Find("windows\\currentversion", 100); // A path reaching into the key's own name
+    CHECK(HitNames(result) == std::vector<std::string>({ "SOFTWARE\\Microsoft\\Windows\\CurrentVersion" }));
+    result = index.Find("dows\\currentversion\\pol", 100);
+    CHECK(HitNames(result) == std::vector<std::string>({ "SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Policies" }));
+
+    // Data only, through the trigrams, with the data shown
+    result = index.Find("svchost.exe", 100);
+    REQUIRE(result.hits.size() == 1);
+    CHECK(result.hits[0].hive == "SYSTEM");
+    CHECK(result.hits[0].keyPath == "ControlSet001\\Services\\DiagTrack");
+    CHECK(result.hits[0].valueName == "ImagePath");
+    CHECK(result.hits[0].data == "%SystemRoot%\\System32\\svchost.exe -k utcsvc -p");
+    result = index.Find("telemetry", 100); // By name, and by the data of a REG_MULTI_SZ
+    CHECK(HitNames(result) == std::vector<std::string>({ "SOFTWARE\\Policies\\Microsoft\\Windows\\DataCollection : AllowTelemetry",
+        "SOFTWARE\\Policies\\Microsoft\\Windows\\DataCollection : Tags" }));
+    CHECK(result.hits[1].data == "alpha | telemetry beta");
+    CHECK(index.Find("telemetry alpha", 100).totalHits == 0); // Every trigram but one is in the data
+    CHECK(index.Find("0x00000001", 100).totalHits == 0);      // DWORD data is not indexed
+
+    // One and two characters scan the data
+    result = index.Find("-p", 100);
+    CHECK(HitNames(result) == std::vector<std::string>({ "SYSTEM\\ControlSet001\\Services\\DiagTrack : ImagePath" }));
+    result = index.Find("%", 100);
+    CHECK(HitNames(result) == std::vector<std::string>({ "SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Run : SecurityHealth",
+        "SYSTEM\\ControlSet001\\Services\\DiagTrack : ImagePath" }));
+    result = index.Find("da", 100); // The name and the data of Dada match several times, it is still one hit
+    CHECK(HitNames(result) == std::vector<std::string>({ "SOFTWARE\\Policies\\Microsoft\\Windows\\DataCollection",
+        "SOFTWARE\\Policies\\Microsoft\\Windows\\DataCollection : Dada" }));
+
+    CHECK(index.Find("", 100).totalHits == 0);
+    CHECK(index.Find("not in any hive", 100).totalHits == 0);
+}
+
+TEST(RegistrySearchCountsHitsPastTheLimit) {
+    fs::path configDir = TestDirectory("registry_search_limit");
+    WriteSearchHives(configDir);
+    RegistrySearchIndex index;
+    REQUIRE(index.Build(configDir.string(), { "SOFTWARE", "SYSTEM" }, true));
+    RegistrySearchResult all = index.Find("s", 100);
+    REQUIRE(all.totalHits > 3);
+    CHECK(all.hits.size() == all.totalHits);
+    RegistrySearchResult first = index.Find("s", 3);
+    CHECK(first.totalHits == all.totalHits);
+    REQUIRE(first.hits.size() == 3);
+    for (size_t i = 0; i < 3; i++) { // The same first hits
+        CHECK(HitNames(first)[i] == HitNames(all)[i]);
+    }
+    CHECK(index.Find("s", 0).hits.empty());
+}
+
+TEST(RegistrySearchWithoutDataFindsNamesOnly) {
+    fs::path configDir = TestDirectory("registry_search_names");
+    WriteSearchHives(configDir);
+    RegistrySearchIndex index;
+    REQUIRE(index.Build(configDir.string(), { "SYSTEM" }, false));
+    CHECK(index.Find("svchost", 100).totalHits == 0);
+    CHECK(HitNames(index.Find("imagepath", 100)) == std::vector<std::string>({ "SYSTEM\\ControlSet001\\Services\\DiagTrack : ImagePath" }));
+
+    RegistrySearchIndex none;
+    CHECK(!none.Build(configDir.string(), { "SAM", "DRIVERS" }, true));
+}
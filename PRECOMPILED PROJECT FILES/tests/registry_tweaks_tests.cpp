@@ -0,0 +1,100 @@
+// Tests of .reg file parsing and of applying the tweaks to the hives of an image folder
+#include "test.h"
+#include "../registry_hive.h"
+#include "../registry_tweaks.h"
+#include <fstream> // std::ofstream for writing the .reg files
+
+namespace fs = std::filesystem;
+
+// Function to write a .reg file
+static fs::path WriteRegFile(const fs::path& path, const std::string& text) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+    return path;
+}
+
+// Function to give an image folder an empty SOFTWARE hive, returning the hive file
+static fs::path CreateImageHive(const fs::path& imageDir) {
+    fs::path hivePath = imageDir / "Windows" / "System32" / "config" / "SOFTWARE";
+    fs::create_directories(hivePath.parent_path());
+    RegistryHive hive;
+    hive.Create(hivePath);
+    REQUIRE(hive.Save());
+    return hivePath;
+}
+
+TEST(RegFileRejectsBadDwords) {
+    fs::path dir = TestDirectory("reg_dwords");
+    fs::path file = WriteRegFile(dir / "dwords.reg",
+        "Windows Registry Editor Version 5.00\r\n"
+        "\r\n"
+        "[HKEY_LOCAL_MACHINE\\SOFTWARE\\MODWIN]\r\n"
+        "\"Full\"=dword:0000abcD\r\n"
+        "\"Short\"=dword:1\r\n"
+        "\"Empty\"=dword:\r\n"
+        "\"Letters\"=dword:zz\r\n"
+        "\"TooLong\"=dword:123456789\r\n"
+        "\"Prefixed\"=dword:0x10\r\n"
+        "\"Spaced\"=dword:12 34\r\n"
+        "\"Negative\"=dword:-1\r\n");
+    std::vector<RegistryTweak> tweaks;
+    REQUIRE(ParseRegFile(file.string(), tweaks));
+    REQUIRE(tweaks.size() == 3); // The key and the two valid values
+    CHECK(tweaks[0].action == RegistryTweakAction::CreateKey);
+    CHECK(tweaks[1].valueName == "Full");
+    CHECK(tweaks[1].type == HIVE_REG_DWORD);
+    CHECK(tweaks[1].data == (std::vector<uint8_t>{ 0xCD, 0xAB, 0x00, 0x00 }));
+    CHECK(tweaks[2].valueName == "Short");
+    CHECK(tweaks[2].data == (std::vector<uint8_t>{ 0x01, 0x00, 0x00, 0x00 }));
+}
+
+TEST(TweaksAreCountedOnceWhenSaveFails) {
+    fs::path imageDir = TestDirectory("reg_save_fails");
+    fs::path hivePath = CreateImageHive(imageDir);
+    fs::path file = WriteRegFile(imageDir / "tweaks.reg",
+        "Windows Registry Editor Version 5.00\r\n"
+        "[HKEY_LOCAL_MACHINE\\SOFTWARE\\MODWIN]\r\n"
+        "\"One\"=dword:00000001\r\n"
+        "\"Two\"=\"2\"\r\n");
+    std::vector<RegistryTweak> tweaks;
+    REQUIRE(ParseRegFile(file.string(), tweaks));
+    REQUIRE(tweaks.size() == 3);
+
+    fs::create_directory(hivePath.string() + ".LOG1"); // The transaction log cannot be written, so neither can the hive
+    RegistryTweakStats stats;
+    CHECK(!ApplyRegistryTweaks(imageDir.string(), tweaks, stats));
+    CHECK(stats.applied == 0);
+    CHECK(stats.failed == 3);
+    CHECK(stats.hivesWritten == 0);
+
+    fs::remove(hivePath.string() + ".LOG1");
+    stats = RegistryTweakStats();
+    CHECK(ApplyRegistryTweaks(imageDir.string(), tweaks, stats));
+    CHECK(stats.applied == 3);
+    CHECK(stats.failed == 0);
+    CHECK(stats.hivesWritten == 1);
+    RegistryHive hive;
+    REQUIRE(hive.Open(hivePath));
+    uint32_t key = hive.OpenKey("MODWIN");
+    REQUIRE(key != HIVE_NO_CELL);
+    CHECK(hive.ReadValueData(hive.FindValue(key, "One")) == (std::vector<uint8_t>{ 1, 0, 0, 0 }));
+}
+
+TEST(TweakFilesFailWhenOneCannotBeRead) {
+    fs::path imageDir = TestDirectory("reg_unreadable");
+    fs::path hivePath = CreateImageHive(imageDir);
+    fs::path tweakDir = imageDir / "TWEAKS";
+    fs::create_directories(tweakDir);
+    WriteRegFile(tweakDir / "1 good.reg",
+        "REGEDIT4\r\n"
+        "[HKLM\\SOFTWARE\\Good]\r\n"
+        "@=\"applied\"\r\n");
+    WriteRegFile(tweakDir / "2 bad.reg", "This is not a .reg file\r\n");
+
+    CHECK(!ApplyRegistryTweakFiles(imageDir.string(), tweakDir.string()));
+    RegistryHive hive;
+    REQUIRE(hive.Open(hivePath));
+    CHECK(hive.OpenKey("Good") != HIVE_NO_CELL); // The readable file is still applied
+
+    CHECK(!ApplyRegistryTweakFiles(imageDir.string(), (tweakDir / "missing.reg").string()));
+    CHECK(ApplyRegistryTweakFiles(imageDir.string(), (tweakDir / "1 good.reg").string()));
+}
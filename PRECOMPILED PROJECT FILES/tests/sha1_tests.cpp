@@ -0,0 +1,68 @@
+// Tests of SHA-1: the known answers from FIPS 180, data added in pieces, and batches of buffers against one buffer
+// at a time
+#include "test.h"
+#include "../sha1.h"
+#include <algorithm> // std::min for the last piece
+#include <vector>    // std::vector for the test buffers
+
+// Function to hash a string in one call and return the hex digest
+static std::string Sha1Hex(const std::string& text) {
+    uint8_t digest[SHA1_DIGEST_SIZE];
+    Sha1Buffer(text.data(), text.size(), digest);
+    return Sha1ToHex(digest);
+}
+
+TEST(Sha1KnownAnswers) {
+    CHECK(Sha1Hex("abc") == "a9993e364706816aba3e25717850c26c9cd0d89d");
+    CHECK(Sha1Hex("") == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    CHECK(Sha1Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") == "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+    CHECK(Sha1Hex(std::string(1000000, 'a')) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+
+    uint8_t digest[SHA1_DIGEST_SIZE];
+    Sha1Buffer(nullptr, 0, digest); // Nothing to hash needs no buffer
+    CHECK(Sha1ToHex(digest) == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+}
+
+TEST(Sha1UpdateInPieces) {
+    std::string million(1000000, 'a');
+    for (size_t piece : { 1, 3, 63, 64, 65, 1000, 4099 }) {
+        Sha1Context ctx;
+        Sha1Init(ctx);
+        for (size_t done = 0; done < million.size(); done += piece) {
+            Sha1Update(ctx, million.data() + done, std::min(piece, million.size() - done));
+            Sha1Update(ctx, nullptr, 0); // Empty updates change nothing, with or without a partial block
+        }
+        uint8_t digest[SHA1_DIGEST_SIZE];
+        Sha1Final(ctx, digest);
+        CHECK(Sha1ToHex(digest) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+    }
+}
+
+TEST(Sha1BatchMatchesSingleBuffers) {
+    std::vector<std::vector<uint8_t>> buffers(8);
+    for (size_t i = 0; i < buffers.size(); i++) {
+        buffers[i].resize(4099);
+        for (size_t j = 0; j < buffers[i].size(); j++) {
+            buffers[i][j] = static_cast<uint8_t>(j * 31 + i * 7 + j / 251);
+        }
+    }
+    const uint8_t* data[8];
+    for (size_t i = 0; i < 8; i++) {
+        data[i] = buffers[i].data();
+    }
+    // Sizes around the one and two block paddings, and odd lengths spanning many blocks
+    for (size_t size : { 0, 1, 55, 56, 63, 64, 65, 119, 127, 1001, 4099 }) {
+        for (size_t count = 0; count <= 8; count++) {
+            uint8_t digests[8][SHA1_DIGEST_SIZE] = {};
+            Sha1BufferBatch(data, count, size, digests);
+            for (size_t i = 0; i < count; i++) {
+                uint8_t expected[SHA1_DIGEST_SIZE];
+                Sha1Buffer(data[i], size, expected);
+                CHECK(Sha1ToHex(digests[i]) == Sha1ToHex(expected));
+            }
+            for (size_t i = count; i < 8; i++) { // Lanes past 'count' are not written
+                CHECK(Sha1ToHex(digests[i]) == std::string(2 * SHA1_DIGEST_SIZE, '0'));
+            }
+        }
+    }
+}
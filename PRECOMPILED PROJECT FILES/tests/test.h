@@ -0,0 +1,42 @@
+#pragma once
+// Small test harness for modwin_tests. TEST defines a test case that registers itself with the runner in
+// test_main.cpp, CHECK records a failed condition and carries on, REQUIRE also ends the test case.
+// The tests cover the modules that do not need Windows, so they build and run on any platform.
+#include <filesystem> // std::filesystem::path for the scratch folders and fixtures
+#include <string>     // std::string for scratch folder names
+#include <vector>     // std::vector for the list of test cases
+
+// One test case, registered by TEST
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+// Thrown by REQUIRE to end the current test case
+struct TestAbort {};
+
+// Registers a test case while the program starts
+struct TestRegistration {
+    TestRegistration(const char* name, void (*run)());
+};
+
+#define TEST(name)                                                  \
+    static void name();                                             \
+    static const TestRegistration name##Registration(#name, name); \
+    static void name()
+
+#define CHECK(condition) ((condition) ? (void)0 : TestFailed(__FILE__, __LINE__, #condition))
+
+#define REQUIRE(condition)                                 \
+    do {                                                   \
+        if (!(condition)) {                                \
+            TestFailed(__FILE__, __LINE__, #condition);    \
+            throw TestAbort();                             \
+        }                                                  \
+    } while (false)
+
+// Function declarations for the test harness
+std::vector<TestCase>& TestCases();
+void TestFailed(const char* file, int line, const char* expression);
+std::filesystem::path TestDirectory(const std::string& name);
+std::string ReadTestFixture(const std::string& name);
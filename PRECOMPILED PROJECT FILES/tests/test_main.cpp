@@ -0,0 +1,83 @@
+// Runner for modwin_tests: runs every test case, or those whose names contain one of the arguments, and returns
+// the number of failed cases. Visual Studio runs it after each build of modwin_tests.vcxproj. Elsewhere, from the
+// project folder:
+//   g++ -std=c++17 -I. payload_packer.cpp huffman.cpp lzms.cpp sha1.cpp -o payload_packer
+//       && ./payload_packer payloads packed
+//   g++ -std=c++17 -I. -Ipacked -Wa,-Ipacked tests/*.cpp direct_io.cpp dism_api.cpp dism_output.cpp folder_push.cpp
+//       huffman.cpp image_inventory.cpp image_listing.cpp image_servicing.cpp iso_writer.cpp lzms.cpp lzx.cpp
+//       menus.cpp package_graph.cpp package_rules.cpp payloads.cpp process_runner.cpp registry_hive.cpp
+//       registry_search.cpp registry_tweaks.cpp sha1.cpp tsv_manifest.cpp wim.cpp wim_export.cpp wim_verify.cpp
+//       xpress.cpp -o modwin_tests -pthread && ./modwin_tests
+#include "test.h"
+#include <cstring>   // std::strstr for picking test cases by name
+#include <exception> // std::exception thrown out of a test case
+#include <fstream>   // std::ifstream for reading fixtures
+#include <iostream>  // std::cout and std::cerr for the report
+#include <sstream>   // std::ostringstream holding a fixture
+
+namespace fs = std::filesystem;
+
+// Failures of the test case that is running
+static size_t currentFailures = 0;
+
+std::vector<TestCase>& TestCases() {
+    static std::vector<TestCase> cases; // Built while the program starts, before main
+    return cases;
+}
+
+TestRegistration::TestRegistration(const char* name, void (*run)()) {
+    TestCases().push_back({ name, run });
+}
+
+void TestFailed(const char* file, int line, const char* expression) {
+    std::cerr << "  " << file << ":" << line << ": CHECK failed: " << expression << "\n";
+    currentFailures++;
+}
+
+// Function to get an empty scratch folder for a test case, under the temporary folder of the system
+fs::path TestDirectory(const std::string& name) {
+    fs::path dir = fs::temp_directory_path() / "modwin_tests" / name;
+    std::error_code error;
+    fs::remove_all(dir, error);
+    fs::create_directories(dir, error);
+    return dir;
+}
+
+// Function to read a file of tests/fixtures, empty when it is missing
+std::string ReadTestFixture(const std::string& name) {
+    std::ifstream file(fs::path(__FILE__).parent_path() / "fixtures" / name, std::ios::binary);
+    std::ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+int main(int argc, char* argv[]) {
+    size_t ran = 0;
+    size_t failed = 0;
+    for (const TestCase& test : TestCases()) {
+        bool picked = argc < 2;
+        for (int i = 1; i < argc && !picked; i++) {
+            picked = std::strstr(test.name, argv[i]) != nullptr;
+        }
+        if (!picked) {
+            continue;
+        }
+        std::cout << test.name << "\n";
+        currentFailures = 0;
+        try {
+            test.run();
+        }
+        catch (const TestAbort&) {
+        }
+        catch (const std::exception& e) {
+            std::cerr << "  Exception: " << e.what() << "\n";
+            currentFailures++;
+        }
+        ran++;
+        failed += currentFailures > 0 ? 1 : 0;
+    }
+    std::error_code error;
+    fs::remove_all(fs::temp_directory_path() / "modwin_tests", error);
+    std::cout << "\n" << ran - failed << " of " << ran << " test cases passed.\n";
+    return static_cast<int>(failed);
+}
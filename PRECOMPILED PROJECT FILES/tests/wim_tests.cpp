@@ -0,0 +1,253 @@
+// Tests of the WIM reader against small WIM files built here: one with two images, an uncompressed resource and an
+// XPRESS compressed one, and damaged copies of it
+#include "test.h"
+#include "../wim.h"
+#include "../xpress.h"
+#include <algorithm> // std::min for the chunk sizes
+#include <cstring>   // std::memcpy for the WIM structures
+#include <fstream>   // std::ifstream and std::ofstream for the WIM files
+
+namespace fs = std::filesystem;
+
+static void Put16(std::vector<uint8_t>& out, size_t pos, uint16_t value) {
+    out[pos] = static_cast<uint8_t>(value);
+    out[pos + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void Put32(std::vector<uint8_t>& out, size_t pos, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[pos + i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
+static void Put64(std::vector<uint8_t>& out, size_t pos, uint64_t value) {
+    for (int i = 0; i < 8; i++) out[pos + i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
+// Function to write a 24 byte resource header at 'pos'
+static void PutResource(std::vector<uint8_t>& out, size_t pos, const WimResourceHeader& res) {
+    Put64(out, pos, res.sizeInWim);
+    out[pos + 7] = res.flags;
+    Put64(out, pos + 8, res.offsetInWim);
+    Put64(out, pos + 16, res.originalSize);
+}
+
+// A WIM built for the tests, with what went into it
+struct TestWim {
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> plainData;       // Stored as it is
+    std::vector<uint8_t> compressedData;  // Stored in XPRESS chunks
+    WimResourceHeader plain;
+    WimResourceHeader compressed;
+};
+
+// Function to append 'data' as an XPRESS compressed resource: the chunk table, then each chunk, compressed when
+// that makes it smaller
+static WimResourceHeader AppendCompressed(std::vector<uint8_t>& out, const std::vector<uint8_t>& data) {
+    WimResourceHeader res;
+    res.flags = WIM_RESHDR_FLAG_COMPRESSED;
+    res.offsetInWim = out.size();
+    res.originalSize = data.size();
+    size_t chunks = (data.size() + WIM_CHUNK_SIZE - 1) / WIM_CHUNK_SIZE;
+    std::vector<std::vector<uint8_t>> stored;
+    for (size_t i = 0; i < chunks; i++) {
+        size_t size = std::min<size_t>(WIM_CHUNK_SIZE, data.size() - i * WIM_CHUNK_SIZE);
+        std::vector<uint8_t> chunk(size);
+        size_t packed = XpressCompress(data.data() + i * WIM_CHUNK_SIZE, size, chunk.data(), chunk.size());
+        if (packed == 0) {
+            std::memcpy(chunk.data(), data.data() + i * WIM_CHUNK_SIZE, size);
+            packed = size;
+        }
+        chunk.resize(packed);
+        stored.push_back(chunk);
+    }
+    size_t table = out.size();
+    out.resize(out.size() + (chunks - 1) * 4);
+    uint32_t offset = 0;
+    for (size_t i = 0; i < chunks; i++) {
+        if (i > 0) {
+            Put32(out, table + (i - 1) * 4, offset);
+        }
+        out.insert(out.end(), stored[i].begin(), stored[i].end());
+        offset += static_cast<uint32_t>(stored[i].size());
+    }
+    res.sizeInWim = out.size() - res.offsetInWim;
+    return res;
+}
+
+// Function to build a WIM with two images, one uncompressed and one compressed resource in its lookup table and
+// UTF-16 XML data
+static TestWim BuildTestWim() {
+    TestWim wim;
+    std::vector<uint8_t>& out = wim.bytes;
+    out.resize(WIM_HEADER_SIZE);
+    std::memcpy(out.data(), "MSWIM\0\0\0", 8);
+    Put32(out, 8, WIM_HEADER_SIZE);
+    Put32(out, 12, WIM_VERSION_DEFAULT);
+    Put32(out, 16, WIM_HDR_FLAG_COMPRESSION | WIM_HDR_FLAG_COMPRESS_XPRESS);
+    Put32(out, 20, WIM_CHUNK_SIZE);
+    Put16(out, 40, 1);
+    Put16(out, 42, 1);
+    Put32(out, 44, 2);
+    Put32(out, 120, 1);
+
+    for (size_t i = 0; i < 1000; i++) {
+        wim.plainData.push_back(static_cast<uint8_t>(i * 31));
+    }
+    wim.plain.offsetInWim = out.size();
+    wim.plain.sizeInWim = wim.plain.originalSize = wim.plainData.size();
+    out.insert(out.end(), wim.plainData.begin(), wim.plainData.end());
+
+    std::string text;
+    while (text.size() < 80000) { // Three chunks, the last one short
+        text += "Windows\\System32\\drivers\\etc\\hosts " + std::to_string(text.size() % 977) + "\n";
+    }
+    wim.compressedData.assign(text.begin(), text.end());
+    wim.compressed = AppendCompressed(out, wim.compressedData);
+
+    WimResourceHeader lookup;
+    lookup.offsetInWim = out.size();
+    lookup.sizeInWim = lookup.originalSize = 2 * WIM_LOOKUP_ENTRY_SIZE;
+    out.resize(out.size() + lookup.sizeInWim);
+    const WimResourceHeader* resources[] = { &wim.plain, &wim.compressed };
+    for (size_t i = 0; i < 2; i++) {
+        size_t entry = lookup.offsetInWim + i * WIM_LOOKUP_ENTRY_SIZE;
+        PutResource(out, entry, *resources[i]);
+        Put16(out, entry + 24, 1);
+        Put32(out, entry + 26, static_cast<uint32_t>(i + 1));
+        for (size_t j = 0; j < WIM_HASH_SIZE; j++) out[entry + 30 + j] = static_cast<uint8_t>(i * 0x40 + j);
+    }
+
+    std::string xml = "<WIM><TOTALBYTES>81234</TOTALBYTES>"
+        "<IMAGE INDEX=\"1\"><NAME>Windows 11 Home</NAME><DESCRIPTION>Home &amp; family</DESCRIPTION>"
+        "<TOTALBYTES>16654245187</TOTALBYTES><FILECOUNT>101234</FILECOUNT><DIRCOUNT>23456</DIRCOUNT>"
+        "<WINDOWS><ARCH>9</ARCH><EDITIONID>Core</EDITIONID><VERSION><MAJOR>10</MAJOR><MINOR>0</MINOR>"
+        "<BUILD>26100</BUILD><SPBUILD>1742</SPBUILD></VERSION></WINDOWS></IMAGE>"
+        "<IMAGE INDEX=\"2\"><NAME>Windows 11 Pro \xC3\xA9</NAME><WINDOWS><ARCH>12</ARCH></WINDOWS></IMAGE></WIM>";
+    WimResourceHeader xmlData;
+    xmlData.offsetInWim = out.size();
+    out.push_back(0xFF); // Byte order mark
+    out.push_back(0xFE);
+    for (size_t i = 0; i < xml.size(); i++) {
+        if (static_cast<uint8_t>(xml[i]) == 0xC3) { // The one two byte character above, U+00E9
+            out.push_back(0xE9);
+            out.push_back(0);
+            i++;
+            continue;
+        }
+        out.push_back(static_cast<uint8_t>(xml[i]));
+        out.push_back(0);
+    }
+    xmlData.sizeInWim = xmlData.originalSize = out.size() - xmlData.offsetInWim;
+    PutResource(out, 48, lookup);
+    PutResource(out, 72, xmlData);
+    return wim;
+}
+
+static fs::path WriteTestWim(const std::string& name, const std::vector<uint8_t>& bytes) {
+    fs::path file = TestDirectory(name) / "install.wim";
+    std::ofstream(file, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return file;
+}
+
+TEST(WimReadsHeaderLookupTableAndXml) {
+    TestWim wim = BuildTestWim();
+    std::ifstream file(WriteTestWim("wim_read", wim.bytes), std::ios::binary);
+    WimHeader header;
+    REQUIRE(ReadWimHeader(file, header));
+    CHECK(header.version == WIM_VERSION_DEFAULT);
+    CHECK(header.flags == (WIM_HDR_FLAG_COMPRESSION | WIM_HDR_FLAG_COMPRESS_XPRESS));
+    CHECK(header.chunkSize == WIM_CHUNK_SIZE);
+    CHECK(header.imageCount == 2);
+    CHECK(header.bootIndex == 1);
+
+    std::vector<WimLookupEntry> entries;
+    REQUIRE(ReadWimLookupTable(file, header, entries));
+    REQUIRE(entries.size() == 2);
+    CHECK(entries[0].resource.offsetInWim == wim.plain.offsetInWim);
+    CHECK(entries[0].resource.sizeInWim == wim.plainData.size());
+    CHECK(entries[1].resource.flags == WIM_RESHDR_FLAG_COMPRESSED);
+    CHECK(entries[1].resource.originalSize == wim.compressedData.size());
+    CHECK(entries[1].referenceCount == 2);
+    CHECK(entries[1].hash[0] == 0x40 && entries[1].hash[19] == 0x53);
+
+    std::string xml;
+    REQUIRE(ReadWimXml(file, header, xml));
+    std::vector<WimImageInfo> images = ParseWimImages(xml);
+    REQUIRE(images.size() == 2);
+    CHECK(images[0].index == 1);
+    CHECK(images[0].name == "Windows 11 Home");
+    CHECK(images[0].description == "Home & family");
+    CHECK(images[0].editionId == "Core");
+    CHECK(images[0].architecture == "x64");
+    CHECK(images[0].version == "10.0.26100.1742");
+    CHECK(images[0].totalBytes == 16654245187ULL);
+    CHECK(images[0].fileCount == 101234);
+    CHECK(images[0].dirCount == 23456);
+    CHECK(images[1].index == 2);
+    CHECK(images[1].name == "Windows 11 Pro \xC3\xA9");
+    CHECK(images[1].architecture == "arm64");
+    CHECK(images[1].version.empty());
+}
+
+TEST(WimReadsPlainAndCompressedResources) {
+    TestWim wim = BuildTestWim();
+    std::ifstream file(WriteTestWim("wim_resources", wim.bytes), std::ios::binary);
+    WimHeader header;
+    REQUIRE(ReadWimHeader(file, header));
+    std::vector<uint8_t> data;
+    CHECK(ReadWimResource(file, header, wim.plain, data) && data == wim.plainData);
+    CHECK(ReadWimResource(file, header, wim.compressed, data) && data == wim.compressedData);
+
+    CHECK(wim.compressed.sizeInWim < wim.compressedData.size());
+    std::vector<uint64_t> chunkOffsets;
+    REQUIRE(ReadWimChunkTable(file, wim.compressed, header.chunkSize, chunkOffsets));
+    CHECK(chunkOffsets.size() == 4); // Three chunks and the end
+    CHECK(chunkOffsets.back() == wim.compressed.offsetInWim + wim.compressed.sizeInWim);
+
+    size_t pieces = 0;
+    size_t total = 0;
+    CHECK(ReadWimResourceChunks(file, header, wim.compressed, [&](const uint8_t*, size_t size) {
+        pieces++;
+        total += size;
+        return size <= WIM_CHUNK_SIZE;
+    }));
+    CHECK(pieces == 3);
+    CHECK(total == wim.compressedData.size());
+}
+
+TEST(WimRejectsDamagedFiles) {
+    TestWim wim = BuildTestWim();
+    WimHeader header;
+    std::vector<WimLookupEntry> entries;
+
+    std::vector<uint8_t> badMagic = wim.bytes;
+    badMagic[0] = 'X';
+    std::ifstream badMagicFile(WriteTestWim("wim_bad_magic", badMagic), std::ios::binary);
+    CHECK(!ReadWimHeader(badMagicFile, header));
+
+    std::vector<uint8_t> truncated(wim.bytes.begin(), wim.bytes.begin() + 100);
+    std::ifstream truncatedFile(WriteTestWim("wim_truncated", truncated), std::ios::binary);
+    CHECK(!ReadWimHeader(truncatedFile, header));
+
+    // A lookup table said to be 50 PB long is refused before anything of that size is allocated
+    std::vector<uint8_t> hugeTable = wim.bytes;
+    Put64(hugeTable, 48, WIM_LOOKUP_ENTRY_SIZE * 1000000000000ULL);
+    std::ifstream hugeTableFile(WriteTestWim("wim_huge_table", hugeTable), std::ios::binary);
+    REQUIRE(ReadWimHeader(hugeTableFile, header));
+    CHECK(!ReadWimLookupTable(hugeTableFile, header, entries));
+    CHECK(entries.empty());
+
+    // So is one that starts past the end of the file
+    std::vector<uint8_t> pastEnd = wim.bytes;
+    Put64(pastEnd, 56, pastEnd.size() + 10);
+    std::ifstream pastEndFile(WriteTestWim("wim_past_end", pastEnd), std::ios::binary);
+    REQUIRE(ReadWimHeader(pastEndFile, header));
+    CHECK(!ReadWimLookupTable(pastEndFile, header, entries));
+
+    // A chunk that points back into the one before it
+    std::vector<uint8_t> badChunks = wim.bytes;
+    Put32(badChunks, static_cast<size_t>(wim.compressed.offsetInWim + 4), 1);
+    std::ifstream badChunksFile(WriteTestWim("wim_bad_chunks", badChunks), std::ios::binary);
+    REQUIRE(ReadWimHeader(badChunksFile, header));
+    std::vector<uint8_t> data;
+    CHECK(!ReadWimResource(badChunksFile, header, wim.compressed, data));
+}
@@ -0,0 +1,186 @@
+// Tests of the integrity check: a WIM exported with an integrity table is built here from a one-file image, checked
+// as it is, then checked again with damaged chunks and a damaged table
+#include "test.h"
+#include "../sha1.h"
+#include "../wim.h"
+#include "../wim_export.h"
+#include "../wim_verify.h"
+#include <cstring> // std::memcpy for the hashes
+#include <fstream> // std::ifstream, std::ofstream and std::fstream for the WIM files
+
+namespace fs = std::filesystem;
+
+// Bytes each hash of a DISM integrity table covers
+static constexpr uint64_t TEST_INTEGRITY_CHUNK_SIZE = 10 * 1024 * 1024;
+
+static void PutLe(std::vector<uint8_t>& out, size_t pos, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) out[pos + i] = static_cast<uint8_t>(value >> (i * 8));
+}
+
+// Function to add a lookup table entry for a resource holding 'data'
+static void PutLookupEntry(std::vector<uint8_t>& out, size_t pos, const WimResourceHeader& res, const uint8_t* data, size_t size) {
+    PutLe(out, pos, res.sizeInWim, 7);
+    out[pos + 7] = res.flags;
+    PutLe(out, pos + 8, res.offsetInWim, 8);
+    PutLe(out, pos + 16, res.originalSize, 8);
+    PutLe(out, pos + 24, 1, 2); // Part number
+    PutLe(out, pos + 26, 1, 4); // Reference count
+    Sha1Buffer(data, size, out.data() + pos + 30);
+}
+
+// Function to write a single-image XPRESS WIM holding one file of 'fileSize' bytes. The file's chunks are stored
+// as they are, which an export to XPRESS copies without compressing them again.
+static void WriteSourceWim(const fs::path& path, size_t fileSize) {
+    std::vector<uint8_t> out(WIM_HEADER_SIZE);
+    std::memcpy(out.data(), "MSWIM\0\0\0", 8);
+    PutLe(out, 8, WIM_HEADER_SIZE, 4);
+    PutLe(out, 12, WIM_VERSION_DEFAULT, 4);
+    PutLe(out, 16, WIM_HDR_FLAG_COMPRESSION | WIM_HDR_FLAG_COMPRESS_XPRESS, 4);
+    PutLe(out, 20, WIM_CHUNK_SIZE, 4);
+    PutLe(out, 40, 1, 2);
+    PutLe(out, 42, 1, 2);
+    PutLe(out, 44, 1, 4);
+
+    std::vector<uint8_t> file(fileSize);
+    uint32_t seed = 12345;
+    for (uint8_t& byte : file) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+    WimResourceHeader stream;
+    stream.flags = WIM_RESHDR_FLAG_COMPRESSED;
+    stream.offsetInWim = out.size();
+    stream.originalSize = file.size();
+    size_t chunks = (file.size() + WIM_CHUNK_SIZE - 1) / WIM_CHUNK_SIZE;
+    out.resize(out.size() + (chunks - 1) * 4);
+    for (size_t i = 1; i < chunks; i++) { // Every chunk is stored at its full size
+        PutLe(out, stream.offsetInWim + (i - 1) * 4, i * WIM_CHUNK_SIZE, 4);
+    }
+    out.insert(out.end(), file.begin(), file.end());
+    stream.sizeInWim = out.size() - stream.offsetInWim;
+
+    // Metadata: no security descriptors, the root folder, and the file in it
+    std::vector<uint8_t> metadata(8 + 104 + 104 + 8);
+    PutLe(metadata, 0, 8, 4);
+    PutLe(metadata, 8, 104, 8);
+    PutLe(metadata, 16, 0x10, 4);  // FILE_ATTRIBUTE_DIRECTORY
+    PutLe(metadata, 24, 112, 8);   // Its entries
+    PutLe(metadata, 112, 104, 8);
+    PutLe(metadata, 120, 0x80, 4); // FILE_ATTRIBUTE_NORMAL
+    Sha1Buffer(file.data(), file.size(), metadata.data() + 112 + 64);
+    WimResourceHeader meta;
+    meta.flags = WIM_RESHDR_FLAG_METADATA;
+    meta.offsetInWim = out.size();
+    meta.sizeInWim = meta.originalSize = metadata.size();
+    out.insert(out.end(), metadata.begin(), metadata.end());
+
+    WimResourceHeader lookup;
+    lookup.offsetInWim = out.size();
+    lookup.sizeInWim = lookup.originalSize = 2 * WIM_LOOKUP_ENTRY_SIZE;
+    out.resize(out.size() + lookup.sizeInWim);
+    PutLookupEntry(out, lookup.offsetInWim, meta, metadata.data(), metadata.size());
+    PutLookupEntry(out, lookup.offsetInWim + WIM_LOOKUP_ENTRY_SIZE, stream, file.data(), file.size());
+
+    std::string xml = "<WIM><TOTALBYTES>0</TOTALBYTES><IMAGE INDEX=\"1\"><NAME>Test</NAME></IMAGE></WIM>";
+    WimResourceHeader xmlData;
+    xmlData.offsetInWim = out.size();
+    out.push_back(0xFF); // Byte order mark
+    out.push_back(0xFE);
+    for (char c : xml) {
+        out.push_back(static_cast<uint8_t>(c));
+        out.push_back(0);
+    }
+    xmlData.sizeInWim = xmlData.originalSize = out.size() - xmlData.offsetInWim;
+    for (const auto& [pos, res] : { std::make_pair(48, lookup), std::make_pair(72, xmlData) }) {
+        PutLe(out, pos, res.sizeInWim, 7);
+        PutLe(out, pos + 8, res.offsetInWim, 8);
+        PutLe(out, pos + 16, res.originalSize, 8);
+    }
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(out.data()), out.size());
+}
+
+// Function to flip the bits of the byte at 'offset' of a file
+static void FlipTestByte(const fs::path& path, uint64_t offset) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(static_cast<std::streamoff>(offset));
+    char byte = 0;
+    file.read(&byte, 1);
+    byte = static_cast<char>(~byte);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(&byte, 1);
+}
+
+// Function to export image 1 of 'source' to 'destination' with XPRESS compression
+static bool ExportTestWim(const fs::path& source, const fs::path& destination, bool checkIntegrity) {
+    WimExportOptions options;
+    options.compression = WimCompression::Xpress;
+    options.checkIntegrity = checkIntegrity;
+    options.showProgress = false;
+    options.threadCount = 2;
+    return ExportWimImage(source.string(), 1, destination.string(), options);
+}
+
+TEST(VerifyFindsTheDamagedChunk) {
+    fs::path dir = TestDirectory("wim_verify");
+    WriteSourceWim(dir / "source.wim", 25 * 1024 * 1024 + 4321); // Three integrity chunks, the last one short
+    fs::path wim = dir / "install.wim";
+    REQUIRE(ExportTestWim(dir / "source.wim", wim, true));
+
+    std::ifstream file(wim, std::ios::binary);
+    WimHeader header;
+    REQUIRE(ReadWimHeader(file, header));
+    file.close();
+    const uint64_t regionEnd = header.lookupTable.offsetInWim + header.lookupTable.sizeInWim;
+    WimVerifyResult result;
+    REQUIRE(VerifyWimIntegrity(wim.string(), result, 2));
+    CHECK(result.chunks == 3);
+    CHECK(result.chunkSize == TEST_INTEGRITY_CHUNK_SIZE);
+    CHECK(result.bytesChecked == regionEnd - WIM_HEADER_SIZE);
+    CHECK(result.badChunks == 0);
+
+    // One flipped byte in the second chunk
+    const uint64_t secondChunk = WIM_HEADER_SIZE + TEST_INTEGRITY_CHUNK_SIZE;
+    FlipTestByte(wim, secondChunk + 12345);
+    REQUIRE(VerifyWimIntegrity(wim.string(), result, 2));
+    CHECK(result.badChunks == 1);
+    CHECK(result.firstBadOffset == secondChunk);
+    CHECK(!VerifyWim(wim.string()));
+
+    // Put back, then one in the short last chunk, in the lookup table it ends with
+    FlipTestByte(wim, secondChunk + 12345);
+    FlipTestByte(wim, regionEnd - 1);
+    REQUIRE(VerifyWimIntegrity(wim.string(), result, 2));
+    CHECK(result.badChunks == 1);
+    CHECK(result.firstBadOffset == WIM_HEADER_SIZE + 2 * TEST_INTEGRITY_CHUNK_SIZE);
+    FlipTestByte(wim, regionEnd - 1);
+    CHECK(VerifyWim(wim.string()));
+}
+
+TEST(VerifyRejectsADamagedTable) {
+    fs::path dir = TestDirectory("wim_verify_table");
+    WriteSourceWim(dir / "source.wim", 100000);
+    fs::path wim = dir / "install.wim";
+    REQUIRE(ExportTestWim(dir / "source.wim", wim, true));
+    std::ifstream file(wim, std::ios::binary);
+    WimHeader header;
+    REQUIRE(ReadWimHeader(file, header));
+    file.close();
+    WimVerifyResult result;
+    REQUIRE(VerifyWimIntegrity(wim.string(), result));
+    CHECK(result.chunks == 1);
+    CHECK(result.badChunks == 0);
+
+    // The table's own length field no longer matches its size in the header
+    FlipTestByte(wim, header.integrityTable.offsetInWim + 1);
+    CHECK(!VerifyWimIntegrity(wim.string(), result));
+    FlipTestByte(wim, header.integrityTable.offsetInWim + 1);
+    // A hash count that does not cover the file
+    FlipTestByte(wim, header.integrityTable.offsetInWim + 4);
+    CHECK(!VerifyWimIntegrity(wim.string(), result));
+    FlipTestByte(wim, header.integrityTable.offsetInWim + 4);
+    CHECK(VerifyWimIntegrity(wim.string(), result));
+
+    // Exported without /CheckIntegrity there is nothing to check against
+    REQUIRE(ExportTestWim(dir / "source.wim", dir / "plain.wim", false));
+    CHECK(!VerifyWimIntegrity((dir / "plain.wim").string(), result));
+}
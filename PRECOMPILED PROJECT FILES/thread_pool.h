@@ -0,0 +1,172 @@
+#pragma once
+// Small fixed size worker pool used to spread independent work items (WIM chunks, files) over every CPU core,
+// and a bounded queue for chaining threads into a pipeline.
+#include <algorithm>          // std::max
+#include <atomic>             // std::atomic for handing out work items
+#include <condition_variable> // std::condition_variable for waking the workers
+#include <cstdint>            // uint64_t for the job generation
+#include <deque>              // std::deque holding the queued items
+#include <exception>          // std::exception_ptr for passing errors back to the caller
+#include <functional>         // std::function for the work item callback
+#include <mutex>              // std::mutex guarding the shared state
+#include <thread>             // std::thread for the workers
+#include <utility>            // std::move for queued items
+#include <vector>             // std::vector of worker threads
+
+class WorkerPool {
+public:
+    // Starts 'threadCount' workers, or one per CPU core when threadCount is 0
+    explicit WorkerPool(unsigned threadCount = 0) {
+        if (threadCount == 0) {
+            threadCount = std::max(1U, std::thread::hardware_concurrency());
+        }
+        // The calling thread also works during ParallelFor, so start one thread less
+        for (unsigned i = 1; i < threadCount; i++) {
+            workers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Number of threads that run work items, including the calling thread
+    unsigned ThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Calls body(i) for every i in [0, count) across all threads and returns once every call has finished.
+    // If a call throws, the first exception is rethrown here after the remaining items are done.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& body) {
+        if (count == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &body;
+            jobCount = count;
+            nextItem = 0;
+            busyWorkers = workers.size();
+            error = nullptr;
+            generation++;
+        }
+        wake.notify_all();
+        RunItems();
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return busyWorkers == 0; });
+        job = nullptr;
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    // Takes work items until none are left
+    void RunItems() {
+        for (size_t i = nextItem++; i < jobCount; i = nextItem++) {
+            try {
+                (*job)(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    void WorkerLoop() {
+        uint64_t seenGeneration = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+                if (stopping) {
+                    return;
+                }
+                seenGeneration = generation;
+            }
+            RunItems();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                busyWorkers--;
+            }
+            done.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;  // Signals a new job (or shutdown) to the workers
+    std::condition_variable done;  // Signals the caller that a worker finished its share
+    const std::function<void(size_t)>* job = nullptr; // Current work item callback
+    size_t jobCount = 0;           // Number of items in the current job
+    std::atomic<size_t> nextItem{ 0 }; // Next item to hand out
+    size_t busyWorkers = 0;        // Workers that have not finished the current job yet
+    uint64_t generation = 0;       // Incremented for every job so workers notice new work
+    bool stopping = false;         // Set when the pool is being destroyed
+    std::exception_ptr error;      // First exception thrown by a work item
+};
+
+// Queue with a fixed capacity between the stages of a pipeline. Push blocks while the queue is full, so a fast
+// producer cannot run ahead of a slow consumer and fill up the memory.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t maxItems) : capacity(std::max<size_t>(1, maxItems)) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Adds an item, waiting for room. Returns false (dropping the item) once the queue is closed.
+    bool Push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Takes the oldest item, waiting for one. Returns false when the queue is closed and empty.
+    bool Pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    // Ends the queue: consumers drain what is left, producers stop. Used both for the normal end and for aborting.
+    void Close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+private:
+    const size_t capacity;
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable notFull;  // Signals producers that an item was taken
+    std::condition_variable notEmpty; // Signals consumers that an item was added
+    bool closed = false;
+};
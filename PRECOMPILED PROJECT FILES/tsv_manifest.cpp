@@ -0,0 +1,68 @@
+#include "tsv_manifest.h"
+#include <charconv> // std::from_chars for the number fields
+#include <fstream>  // std::ifstream and std::ofstream for the manifest
+
+namespace fs = std::filesystem;
+
+// Function to read the lines of the manifest at 'manifestPath' that have 'fieldCount' fields and a name. Returns
+// false when there is no manifest or its first line is not 'header', which leaves 'lines' empty.
+bool LoadTsvManifest(const fs::path& manifestPath, const std::string& header, size_t fieldCount, std::vector<TsvManifestLine>& lines) {
+    lines.clear();
+    std::ifstream file(manifestPath);
+    std::string line;
+    if (!file || !std::getline(file, line) || line != header) {
+        return false;
+    }
+    while (std::getline(file, line)) {
+        TsvManifestLine parsed;
+        size_t start = 0;
+        while (parsed.fields.size() < fieldCount) {
+            size_t tab = line.find('\t', start);
+            if (tab == std::string::npos || tab == start) {
+                break;
+            }
+            parsed.fields.push_back(line.substr(start, tab - start));
+            start = tab + 1;
+        }
+        if (parsed.fields.size() == fieldCount && start < line.size()) {
+            parsed.name = line.substr(start);
+            lines.push_back(std::move(parsed));
+        }
+    }
+    return true;
+}
+
+// Function to write 'lines' to the manifest at 'manifestPath' under 'header'
+bool SaveTsvManifest(const fs::path& manifestPath, const std::string& header, const std::vector<TsvManifestLine>& lines) {
+    fs::path temporary = manifestPath;
+    temporary += ".tmp"; // Replaced in one step, so a failed save keeps the old manifest
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file << header << '\n';
+        for (const TsvManifestLine& line : lines) {
+            for (const std::string& field : line.fields) {
+                file << field << '\t';
+            }
+            file << line.name << '\n';
+        }
+        if (!file.flush()) {
+            return false;
+        }
+    }
+    std::error_code error;
+    fs::rename(temporary, manifestPath, error);
+    return !error;
+}
+
+// Functions to read a number field, false unless the whole field is the number
+bool ParseTsvField(const std::string& field, uint64_t& value) {
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+bool ParseTsvField(const std::string& field, int64_t& value) {
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
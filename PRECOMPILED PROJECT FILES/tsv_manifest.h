@@ -0,0 +1,22 @@
+#pragma once
+// Manifest files MODWIN keeps about files it wrote, such as the folder push manifest and the payload manifest.
+// The first line names the manifest and its version, each other line holds the tab separated fields of one file and
+// ends with the file's name, which may contain spaces and tabs. Lines that do not parse are skipped, so a manifest
+// cut short by a crash only loses its last line, and a manifest is saved to a temporary file that then replaces it.
+#include <cstdint>    // Fixed width integer types for the number fields
+#include <filesystem> // std::filesystem::path for the manifest path
+#include <string>     // std::string for the fields
+#include <vector>     // std::vector for the lines
+
+// One line of a manifest
+struct TsvManifestLine {
+    std::vector<std::string> fields; // The fields before the name, none of them empty
+    std::string name;
+};
+
+// Function declarations for tab separated manifests
+bool LoadTsvManifest(const std::filesystem::path& manifestPath, const std::string& header, size_t fieldCount,
+    std::vector<TsvManifestLine>& lines);
+bool SaveTsvManifest(const std::filesystem::path& manifestPath, const std::string& header, const std::vector<TsvManifestLine>& lines);
+bool ParseTsvField(const std::string& field, uint64_t& value);
+bool ParseTsvField(const std::string& field, int64_t& value);
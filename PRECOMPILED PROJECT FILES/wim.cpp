@@ -0,0 +1,536 @@
+#include "wim.h"
+#include "lzms.h"
+#include "lzx.h"
+#include "xpress.h"
+#include <algorithm> // std::max
+#include <cstdlib>   // std::atoi for the INDEX attribute
+#include <cstring>   // std::memcmp for checking the WIM magic
+#include <iostream>  // std::cout and std::cerr for output
+#include <set>       // std::set for spotting loops in the directory tree
+
+// Reads a little-endian 16-bit value from a byte buffer
+static uint16_t GetLe16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+// Reads a little-endian 32-bit value from a byte buffer
+static uint32_t GetLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Reads a little-endian 64-bit value from a byte buffer
+static uint64_t GetLe64(const uint8_t* p) {
+    return static_cast<uint64_t>(GetLe32(p)) | (static_cast<uint64_t>(GetLe32(p + 4)) << 32);
+}
+
+// Decodes a 24 byte resource header (7 byte size, 1 byte flags, 8 byte offset, 8 byte original size)
+static WimResourceHeader ParseResourceHeader(const uint8_t* p) {
+    WimResourceHeader res;
+    res.sizeInWim = GetLe64(p) & 0x00FFFFFFFFFFFFFFULL; // The size only uses the low 7 bytes
+    res.flags = p[7]; // The eighth byte holds the flags
+    res.offsetInWim = GetLe64(p + 8);
+    res.originalSize = GetLe64(p + 16);
+    return res;
+}
+
+// Reads 'size' bytes at 'offset' from the file into 'buffer'
+static bool ReadAt(std::ifstream& file, uint64_t offset, void* buffer, size_t size) {
+    file.clear(); // Clear any earlier end-of-file state before seeking
+    file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    file.read(static_cast<char*>(buffer), static_cast<std::streamsize>(size));
+    return file.gcount() == static_cast<std::streamsize>(size);
+}
+
+// Checks that a resource lies inside the file, before a buffer of its size is allocated from header values
+static bool ResourceInFile(std::ifstream& file, const WimResourceHeader& res) {
+    file.clear();
+    file.seekg(0, std::ios::end);
+    std::streamoff end = file.tellg();
+    uint64_t fileSize = end < 0 ? 0 : static_cast<uint64_t>(end);
+    return res.offsetInWim <= fileSize && res.sizeInWim <= fileSize - res.offsetInWim;
+}
+
+// Function to read and validate the WIM header from an open file
+bool ReadWimHeader(std::ifstream& file, WimHeader& header) {
+    uint8_t buf[WIM_HEADER_SIZE];
+    if (!ReadAt(file, 0, buf, sizeof(buf))) {
+        std::cerr << "Error: File is too small to be a WIM.\n";
+        return false;
+    }
+    if (std::memcmp(buf, "MSWIM\0\0\0", 8) != 0) { // Every WIM starts with this magic value
+        std::cerr << "Error: File is not a WIM (bad magic).\n";
+        return false;
+    }
+    header.headerSize = GetLe32(buf + 8);
+    header.version = GetLe32(buf + 12);
+    header.flags = GetLe32(buf + 16);
+    header.chunkSize = GetLe32(buf + 20);
+    std::memcpy(header.guid, buf + 24, sizeof(header.guid));
+    header.partNumber = GetLe16(buf + 40);
+    header.totalParts = GetLe16(buf + 42);
+    header.imageCount = GetLe32(buf + 44);
+    header.lookupTable = ParseResourceHeader(buf + 48);
+    header.xmlData = ParseResourceHeader(buf + 72);
+    header.bootMetadata = ParseResourceHeader(buf + 96);
+    header.bootIndex = GetLe32(buf + 120);
+    header.integrityTable = ParseResourceHeader(buf + 124);
+    if (header.headerSize != WIM_HEADER_SIZE) {
+        std::cerr << "Error: Unsupported WIM header size " << header.headerSize << ".\n";
+        return false;
+    }
+    return true;
+}
+
+// Function to read every entry of the lookup table
+bool ReadWimLookupTable(std::ifstream& file, const WimHeader& header, std::vector<WimLookupEntry>& entries) {
+    const WimResourceHeader& res = header.lookupTable;
+    entries.clear();
+    if (res.flags & WIM_RESHDR_FLAG_COMPRESSED) { // Windows and DISM always store the lookup table uncompressed
+        std::cerr << "Error: Compressed WIM lookup tables are not supported.\n";
+        return false;
+    }
+    if (res.sizeInWim % WIM_LOOKUP_ENTRY_SIZE != 0 || !ResourceInFile(file, res)) {
+        std::cerr << "Error: WIM lookup table has an invalid size.\n";
+        return false;
+    }
+    std::vector<uint8_t> buf(static_cast<size_t>(res.sizeInWim));
+    if (!buf.empty() && !ReadAt(file, res.offsetInWim, buf.data(), buf.size())) {
+        std::cerr << "Error: Unable to read the WIM lookup table.\n";
+        return false;
+    }
+    entries.reserve(buf.size() / WIM_LOOKUP_ENTRY_SIZE);
+    for (size_t pos = 0; pos < buf.size(); pos += WIM_LOOKUP_ENTRY_SIZE) {
+        const uint8_t* p = buf.data() + pos;
+        WimLookupEntry entry;
+        entry.resource = ParseResourceHeader(p);
+        entry.partNumber = GetLe16(p + 24);
+        entry.referenceCount = GetLe32(p + 26);
+        std::memcpy(entry.hash, p + 30, WIM_HASH_SIZE);
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+// Appends one Unicode code point to a UTF-8 string
+static void AppendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    }
+    else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Function to read the XML data of the WIM and convert it from UTF-16LE to UTF-8
+bool ReadWimXml(std::ifstream& file, const WimHeader& header, std::string& xml) {
+    const WimResourceHeader& res = header.xmlData;
+    xml.clear();
+    if (res.flags & WIM_RESHDR_FLAG_COMPRESSED) { // The XML data is always stored uncompressed
+        std::cerr << "Error: Compressed WIM XML data is not supported.\n";
+        return false;
+    }
+    if (res.sizeInWim > 64ULL * 1024 * 1024) { // Sanity limit, real XML data is a few kilobytes
+        std::cerr << "Error: WIM XML data is unreasonably large.\n";
+        return false;
+    }
+    std::vector<uint8_t> buf(static_cast<size_t>(res.sizeInWim));
+    if (!buf.empty() && !ReadAt(file, res.offsetInWim, buf.data(), buf.size())) {
+        std::cerr << "Error: Unable to read the WIM XML data.\n";
+        return false;
+    }
+    xml.reserve(buf.size() / 2);
+    size_t pos = 0;
+    if (buf.size() >= 2 && GetLe16(buf.data()) == 0xFEFF) { // Skip the byte order mark
+        pos = 2;
+    }
+    for (; pos + 1 < buf.size(); pos += 2) {
+        uint32_t cp = GetLe16(buf.data() + pos);
+        if (cp >= 0xD800 && cp < 0xDC00 && pos + 3 < buf.size()) { // Combine surrogate pairs
+            uint32_t low = GetLe16(buf.data() + pos + 2);
+            if (low >= 0xDC00 && low < 0xE000) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                pos += 2;
+            }
+        }
+        AppendUtf8(xml, cp);
+    }
+    return true;
+}
+
+// Replaces the XML character entities (&amp; &lt; ...) with the characters they stand for
+static std::string DecodeXmlText(const std::string& text) {
+    static const std::pair<const char*, char> entities[] = {
+        {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}
+    };
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        bool replaced = false;
+        if (text[i] == '&') {
+            for (const auto& entity : entities) {
+                size_t len = std::strlen(entity.first);
+                if (text.compare(i, len, entity.first) == 0) {
+                    out += entity.second;
+                    i += len - 1;
+                    replaced = true;
+                    break;
+                }
+            }
+        }
+        if (!replaced) {
+            out += text[i];
+        }
+    }
+    return out;
+}
+
+// Returns the text between <tag> and </tag> inside 'xml', or an empty string if the tag is missing
+static std::string GetXmlElement(const std::string& xml, const std::string& tag) {
+    std::string open = "<" + tag + ">";
+    std::string close = "</" + tag + ">";
+    size_t start = xml.find(open);
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += open.size();
+    size_t end = xml.find(close, start);
+    if (end == std::string::npos) {
+        return "";
+    }
+    return DecodeXmlText(xml.substr(start, end - start));
+}
+
+// Converts a decimal XML element to a number, returning 0 when it is missing or malformed
+static uint64_t GetXmlNumber(const std::string& xml, const std::string& tag) {
+    std::string text = GetXmlElement(xml, tag);
+    uint64_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            break;
+        }
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return value;
+}
+
+// Function to pull the list of images out of the WIM's XML data
+std::vector<WimImageInfo> ParseWimImages(const std::string& xml) {
+    std::vector<WimImageInfo> images;
+    size_t pos = 0;
+    while ((pos = xml.find("<IMAGE", pos)) != std::string::npos) {
+        size_t tagEnd = xml.find('>', pos);
+        size_t end = xml.find("</IMAGE>", pos);
+        if (tagEnd == std::string::npos || end == std::string::npos) {
+            break; // Truncated XML, stop at what we have
+        }
+        WimImageInfo image;
+        std::string tag = xml.substr(pos, tagEnd - pos);
+        size_t indexPos = tag.find("INDEX=\"");
+        if (indexPos != std::string::npos) {
+            image.index = std::atoi(tag.c_str() + indexPos + 7);
+        }
+        std::string body = xml.substr(tagEnd + 1, end - tagEnd - 1);
+        image.name = GetXmlElement(body, "NAME");
+        image.description = GetXmlElement(body, "DESCRIPTION");
+        image.totalBytes = GetXmlNumber(body, "TOTALBYTES");
+        image.fileCount = GetXmlNumber(body, "FILECOUNT");
+        image.dirCount = GetXmlNumber(body, "DIRCOUNT");
+        std::string windows = GetXmlElement(body, "WINDOWS");
+        image.editionId = GetXmlElement(windows, "EDITIONID");
+        std::string arch = GetXmlElement(windows, "ARCH");
+        if (arch == "0") image.architecture = "x86";
+        else if (arch == "9") image.architecture = "x64";
+        else if (arch == "12") image.architecture = "arm64";
+        else image.architecture = arch;
+        std::string version = GetXmlElement(windows, "VERSION");
+        if (!version.empty()) {
+            image.version = GetXmlElement(version, "MAJOR") + "." + GetXmlElement(version, "MINOR") + "." +
+                GetXmlElement(version, "BUILD") + "." + GetXmlElement(version, "SPBUILD");
+        }
+        images.push_back(image);
+        pos = end + 8;
+    }
+    return images;
+}
+
+// Formats a byte count with thousands separators the way DISM does (16,654,245,187 bytes)
+static std::string FormatBytes(uint64_t bytes) {
+    std::string digits = std::to_string(bytes);
+    std::string out;
+    int count = 0;
+    for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+        if (count != 0 && count % 3 == 0) {
+            out.insert(out.begin(), ',');
+        }
+        out.insert(out.begin(), *it);
+        ++count;
+    }
+    return out;
+}
+
+// Function to print the images inside a WIM or ESD, replacing "Dism /Get-WimInfo"
+bool PrintWimInfo(const std::string& wimPath) {
+    std::ifstream file(wimPath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Unable to open " << wimPath << "\n";
+        return false;
+    }
+    WimHeader header;
+    std::string xml;
+    if (!ReadWimHeader(file, header) || !ReadWimXml(file, header, xml)) { // The lookup table is not needed to list images
+        return false;
+    }
+    std::vector<WimImageInfo> images = ParseWimImages(xml);
+    if (images.empty()) {
+        std::cerr << "Error: No images were found in " << wimPath << "\n";
+        return false;
+    }
+    std::cout << "Details for image : " << wimPath << "\n\n"; // Same heading DISM prints
+    for (const WimImageInfo& image : images) {
+        std::cout << "Index : " << image.index << "\n";
+        std::cout << "Name : " << image.name << "\n";
+        std::cout << "Description : " << image.description << "\n";
+        std::cout << "Size : " << FormatBytes(image.totalBytes) << " bytes\n";
+        if (!image.architecture.empty() || !image.version.empty()) {
+            std::cout << "Architecture : " << image.architecture << "    Version : " << image.version << "\n";
+        }
+        std::cout << "\n";
+    }
+    return true;
+}
+
+// Function to read the chunk table of a compressed resource. On success 'chunkOffsets' holds the file offset
+// of every chunk plus one final entry marking the end of the last chunk.
+bool ReadWimChunkTable(std::ifstream& file, const WimResourceHeader& res, uint32_t chunkSize, std::vector<uint64_t>& chunkOffsets) {
+    chunkOffsets.clear();
+    if (chunkSize == 0) {
+        return false;
+    }
+    uint64_t numChunks = (res.originalSize + chunkSize - 1) / chunkSize;
+    if (numChunks == 0) {
+        chunkOffsets.push_back(res.offsetInWim);
+        return true;
+    }
+    // The table stores the start of every chunk but the first, relative to the end of the table.
+    // Resources of 4 GiB and more use 64-bit entries.
+    uint64_t entrySize = (res.originalSize > 0xFFFFFFFFULL) ? 8 : 4;
+    uint64_t tableSize = (numChunks - 1) * entrySize;
+    if (tableSize > res.sizeInWim || !ResourceInFile(file, res)) {
+        std::cerr << "Error: WIM resource has an invalid chunk table.\n";
+        return false;
+    }
+    std::vector<uint8_t> table(static_cast<size_t>(tableSize));
+    if (!table.empty() && !ReadAt(file, res.offsetInWim, table.data(), table.size())) {
+        std::cerr << "Error: Unable to read a WIM chunk table.\n";
+        return false;
+    }
+    uint64_t dataStart = res.offsetInWim + tableSize;
+    uint64_t dataEnd = res.offsetInWim + res.sizeInWim;
+    chunkOffsets.reserve(static_cast<size_t>(numChunks + 1));
+    chunkOffsets.push_back(dataStart);
+    for (uint64_t i = 0; i + 1 < numChunks; i++) {
+        const uint8_t* p = table.data() + i * entrySize;
+        uint64_t offset = dataStart + ((entrySize == 8) ? GetLe64(p) : GetLe32(p));
+        if (offset < chunkOffsets.back() || offset > dataEnd) {
+            std::cerr << "Error: WIM resource has an invalid chunk table.\n";
+            return false;
+        }
+        chunkOffsets.push_back(offset);
+    }
+    chunkOffsets.push_back(dataEnd);
+    return true;
+}
+
+// Function to decompress one chunk of a resource. Chunks that did not compress are stored as they are.
+bool DecompressWimChunk(uint32_t headerFlags, const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+    if (inSize == outSize) { // Stored uncompressed
+        std::memcpy(out, in, outSize);
+        return true;
+    }
+    if (inSize > outSize) {
+        return false;
+    }
+    if (headerFlags & WIM_HDR_FLAG_COMPRESS_LZX) {
+        return LzxDecompress(in, inSize, out, outSize);
+    }
+    if (headerFlags & WIM_HDR_FLAG_COMPRESS_XPRESS) {
+        return XpressDecompress(in, inSize, out, outSize);
+    }
+    if (headerFlags & WIM_HDR_FLAG_COMPRESS_LZMS) {
+        return LzmsDecompress(in, inSize, out, outSize);
+    }
+    return false;
+}
+
+// Checks that MODWIN can decompress the chunks of this WIM's non-solid resources
+static bool CanDecompressChunks(const WimHeader& header) {
+    if (header.flags & (WIM_HDR_FLAG_COMPRESS_LZX | WIM_HDR_FLAG_COMPRESS_XPRESS)) {
+        return header.chunkSize > 0 && header.chunkSize <= WIM_CHUNK_SIZE;
+    }
+    if (header.flags & WIM_HDR_FLAG_COMPRESS_LZMS) {
+        return header.chunkSize > 0 && header.chunkSize <= LZMS_MAX_BUFFER_SIZE;
+    }
+    return false;
+}
+
+// Function to read a (non-solid) resource chunk by chunk, handing every decompressed piece to 'consume'.
+// Nothing bigger than one chunk is held in memory, so this also works for very large files.
+bool ReadWimResourceChunks(std::ifstream& file, const WimHeader& header, const WimResourceHeader& res,
+    const std::function<bool(const uint8_t*, size_t)>& consume) {
+    if (res.flags & WIM_RESHDR_FLAG_SOLID) {
+        std::cerr << "Error: Solid WIM resources (ESD files) are not supported.\n";
+        return false;
+    }
+    if (!(res.flags & WIM_RESHDR_FLAG_COMPRESSED)) {
+        if (res.sizeInWim != res.originalSize) {
+            std::cerr << "Error: Unable to read a WIM resource.\n";
+            return false;
+        }
+        std::vector<uint8_t> buffer(static_cast<size_t>(std::min<uint64_t>(res.originalSize, 1024 * 1024)));
+        for (uint64_t done = 0; done < res.originalSize;) {
+            size_t size = static_cast<size_t>(std::min<uint64_t>(buffer.size(), res.originalSize - done));
+            if (!ReadAt(file, res.offsetInWim + done, buffer.data(), size)) {
+                std::cerr << "Error: Unable to read a WIM resource.\n";
+                return false;
+            }
+            if (!consume(buffer.data(), size)) {
+                return false;
+            }
+            done += size;
+        }
+        return true;
+    }
+    if (!CanDecompressChunks(header)) {
+        std::cerr << "Error: This WIM uses a compression format MODWIN cannot read.\n";
+        return false;
+    }
+    std::vector<uint64_t> chunkOffsets;
+    if (!ReadWimChunkTable(file, res, header.chunkSize, chunkOffsets)) {
+        return false;
+    }
+    std::vector<uint8_t> chunk;
+    std::vector<uint8_t> plain;
+    for (size_t i = 0; i + 1 < chunkOffsets.size(); i++) {
+        uint64_t outPos = static_cast<uint64_t>(i) * header.chunkSize;
+        size_t outSize = static_cast<size_t>(std::min<uint64_t>(header.chunkSize, res.originalSize - outPos));
+        chunk.resize(static_cast<size_t>(chunkOffsets[i + 1] - chunkOffsets[i]));
+        plain.resize(outSize);
+        if (chunk.size() > outSize || !ReadAt(file, chunkOffsets[i], chunk.data(), chunk.size()) ||
+            !DecompressWimChunk(header.flags, chunk.data(), chunk.size(), plain.data(), outSize)) {
+            std::cerr << "Error: WIM resource is corrupt.\n";
+            return false;
+        }
+        if (!consume(plain.data(), outSize)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to read a whole resource into memory, decompressing it if needed (used for image metadata)
+bool ReadWimResource(std::ifstream& file, const WimHeader& header, const WimResourceHeader& res, std::vector<uint8_t>& data) {
+    data.clear();
+    if (res.originalSize > 1024ULL * 1024 * 1024) { // Sanity limit, this is only used for metadata
+        std::cerr << "Error: WIM resource is too large to read into memory.\n";
+        return false;
+    }
+    data.reserve(static_cast<size_t>(res.originalSize));
+    return ReadWimResourceChunks(file, header, res, [&](const uint8_t* chunk, size_t size) {
+        data.insert(data.end(), chunk, chunk + size);
+        return true;
+    });
+}
+
+// Size of the fixed part of a directory entry in the image metadata
+static constexpr uint64_t WIM_DENTRY_FIXED_SIZE = 102;
+// Size of the fixed part of an alternate data stream entry
+static constexpr uint64_t WIM_ADS_ENTRY_FIXED_SIZE = 38;
+
+// Rounds up to the next multiple of 8, the alignment of every metadata structure
+static uint64_t Align8(uint64_t value) {
+    return (value + 7) & ~7ULL;
+}
+
+// Function to walk the directory tree stored in an image's metadata resource and collect the hash of
+// every stream it references (one entry per reference, so a hash can appear several times)
+bool CollectWimImageStreams(const std::vector<uint8_t>& metadata, std::vector<WimHash>& hashes) {
+    hashes.clear();
+    if (metadata.size() < 8) {
+        std::cerr << "Error: WIM image metadata is too small.\n";
+        return false;
+    }
+    // The metadata starts with the security descriptors, the root directory entry follows them
+    uint64_t rootOffset = Align8(std::max<uint64_t>(GetLe32(metadata.data()), 8));
+    std::vector<uint64_t> pending = { rootOffset }; // Start of directory entry lists still to be walked
+    std::set<uint64_t> visited;
+    bool isRoot = true;
+    while (!pending.empty()) {
+        uint64_t offset = pending.back();
+        pending.pop_back();
+        if (!visited.insert(offset).second) {
+            std::cerr << "Error: WIM image metadata contains a directory loop.\n";
+            return false;
+        }
+        while (true) { // Walk one list of sibling entries, which ends with a zero length
+            if (offset + 8 > metadata.size()) {
+                std::cerr << "Error: WIM image metadata is truncated.\n";
+                return false;
+            }
+            const uint8_t* p = metadata.data() + offset;
+            uint64_t length = GetLe64(p);
+            if (length == 0) {
+                break;
+            }
+            if (length < WIM_DENTRY_FIXED_SIZE || length > metadata.size() - offset) {
+                std::cerr << "Error: WIM image metadata contains an invalid directory entry.\n";
+                return false;
+            }
+            uint64_t subdirOffset = GetLe64(p + 16);
+            WimHash hash;
+            std::memcpy(hash.data(), p + 64, WIM_HASH_SIZE);
+            if (hash != WimHash{}) { // An all-zero hash means the stream is empty
+                hashes.push_back(hash);
+            }
+            uint16_t numStreams = GetLe16(p + 96);
+            offset += Align8(length);
+            for (uint16_t i = 0; i < numStreams; i++) { // Alternate (named) data streams follow the entry
+                if (offset + WIM_ADS_ENTRY_FIXED_SIZE > metadata.size()) {
+                    std::cerr << "Error: WIM image metadata is truncated.\n";
+                    return false;
+                }
+                const uint8_t* ads = metadata.data() + offset;
+                uint64_t adsLength = GetLe64(ads);
+                if (adsLength < WIM_ADS_ENTRY_FIXED_SIZE || adsLength > metadata.size() - offset) {
+                    std::cerr << "Error: WIM image metadata contains an invalid stream entry.\n";
+                    return false;
+                }
+                std::memcpy(hash.data(), ads + 16, WIM_HASH_SIZE);
+                if (hash != WimHash{}) {
+                    hashes.push_back(hash);
+                }
+                offset += Align8(adsLength);
+            }
+            if (subdirOffset != 0) {
+                pending.push_back(subdirOffset);
+            }
+            if (isRoot) { // The root entry is not part of a sibling list
+                isRoot = false;
+                break;
+            }
+        }
+    }
+    return true;
+}
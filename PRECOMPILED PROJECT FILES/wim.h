@@ -0,0 +1,107 @@
+#pragma once
+// Native reader for the WIM (Windows Imaging Format) container used by install.wim and install.esd.
+// This code does not use any Windows headers so it can be built and checked on any platform.
+#include <array>   // std::array for SHA-1 hashes
+#include <cstdint> // Fixed width integer types (uint32_t, uint64_t, ...) used by the on-disk structures
+#include <fstream> // File streams used to read the WIM file
+#include <functional> // std::function for streaming resource data
+#include <string>  // std::string for paths, names and the XML text
+#include <vector>  // std::vector for the lookup table and the image list
+
+// Size of the WIM header at the very start of every WIM file
+constexpr uint32_t WIM_HEADER_SIZE = 208;
+// Size of one entry in the WIM lookup table
+constexpr uint32_t WIM_LOOKUP_ENTRY_SIZE = 50;
+// Size of a SHA-1 hash, which is what WIM uses to identify every resource
+constexpr uint32_t WIM_HASH_SIZE = 20;
+// Chunk size DISM uses for LZX and XPRESS compressed resources
+constexpr uint32_t WIM_CHUNK_SIZE = 32768;
+// Version number of normal (non-solid) WIM files
+constexpr uint32_t WIM_VERSION_DEFAULT = 0x10D00;
+// Version number of WIM files with solid resources (ESD files)
+constexpr uint32_t WIM_VERSION_SOLID = 0xE00;
+// Chunk size DISM uses for the non-solid LZMS resources of an ESD (the image metadata)
+constexpr uint32_t WIM_LZMS_CHUNK_SIZE = 131072;
+// Original size stored in the lookup entry of a solid block, marking it as a block instead of a stream
+constexpr uint64_t WIM_SOLID_RESOURCE_MAGIC_SIZE = 0x100000000ULL;
+// Compression format number stored in the header of a solid block for LZMS
+constexpr uint32_t WIM_SOLID_FORMAT_LZMS = 3;
+
+// SHA-1 hash identifying a resource
+using WimHash = std::array<uint8_t, WIM_HASH_SIZE>;
+
+// Flags stored in the WIM header
+constexpr uint32_t WIM_HDR_FLAG_COMPRESSION = 0x00000002; // Resources in this WIM may be compressed
+constexpr uint32_t WIM_HDR_FLAG_READONLY = 0x00000004;    // WIM is marked read-only
+constexpr uint32_t WIM_HDR_FLAG_SPANNED = 0x00000008;     // WIM is one part of a split (.swm) set
+constexpr uint32_t WIM_HDR_FLAG_COMPRESS_XPRESS = 0x00020000; // Resources use XPRESS compression (/Compress:fast)
+constexpr uint32_t WIM_HDR_FLAG_COMPRESS_LZX = 0x00040000;    // Resources use LZX compression (/Compress:max)
+constexpr uint32_t WIM_HDR_FLAG_COMPRESS_LZMS = 0x00080000;   // Resources use LZMS compression (/Compress:recovery, ESD files)
+
+// Flags stored in each resource header
+constexpr uint8_t WIM_RESHDR_FLAG_FREE = 0x01;       // Resource is unused
+constexpr uint8_t WIM_RESHDR_FLAG_METADATA = 0x02;   // Resource is the metadata (directory tree) of an image
+constexpr uint8_t WIM_RESHDR_FLAG_COMPRESSED = 0x04; // Resource is compressed in chunks
+constexpr uint8_t WIM_RESHDR_FLAG_SPANNED = 0x08;    // Resource is split across parts
+constexpr uint8_t WIM_RESHDR_FLAG_SOLID = 0x10;      // Resource is part of a solid block (ESD files)
+
+// Describes where a resource lives inside the WIM file
+struct WimResourceHeader {
+    uint64_t sizeInWim = 0;    // Number of bytes the resource takes up in the file (compressed size)
+    uint8_t flags = 0;         // WIM_RESHDR_FLAG_* values
+    uint64_t offsetInWim = 0;  // Offset of the resource from the start of the file
+    uint64_t originalSize = 0; // Size of the resource once it is uncompressed
+};
+
+// The fixed size header at the start of a WIM file
+struct WimHeader {
+    uint32_t headerSize = 0;   // Always WIM_HEADER_SIZE
+    uint32_t version = 0;      // 0x10D00 for normal WIMs, 0xE00 for solid (ESD) WIMs
+    uint32_t flags = 0;        // WIM_HDR_FLAG_* values
+    uint32_t chunkSize = 0;    // Size of the chunks that compressed resources are split into
+    uint8_t guid[16] = {};     // Unique identifier of the WIM
+    uint16_t partNumber = 0;   // Part number of a split WIM, 1 for normal WIMs
+    uint16_t totalParts = 0;   // Number of parts of a split WIM, 1 for normal WIMs
+    uint32_t imageCount = 0;   // Number of images (indexes) stored in the WIM
+    WimResourceHeader lookupTable;    // Location of the lookup table
+    WimResourceHeader xmlData;        // Location of the XML data describing every image
+    WimResourceHeader bootMetadata;   // Location of the metadata of the bootable image
+    uint32_t bootIndex = 0;           // Index of the bootable image, 0 if there is none
+    WimResourceHeader integrityTable; // Location of the integrity table (/CheckIntegrity), if present
+};
+
+// One entry of the lookup table, which maps a SHA-1 hash to the resource holding that data
+struct WimLookupEntry {
+    WimResourceHeader resource;          // Where the data is stored
+    uint16_t partNumber = 0;             // Which part of a split WIM holds the data
+    uint32_t referenceCount = 0;         // How many times the images reference this data
+    uint8_t hash[WIM_HASH_SIZE] = {};    // SHA-1 of the uncompressed data
+};
+
+// The details of one image as described by the XML data
+struct WimImageInfo {
+    int index = 0;             // Index number used by DISM (/SourceIndex, /Index)
+    std::string name;          // <NAME>, e.g. "Windows 11 Pro"
+    std::string description;   // <DESCRIPTION>
+    std::string editionId;     // <WINDOWS><EDITIONID>, e.g. "Professional"
+    std::string architecture;  // <WINDOWS><ARCH> translated to x86 / x64 / arm64
+    std::string version;       // <WINDOWS><VERSION> as major.minor.build.spbuild
+    uint64_t totalBytes = 0;   // <TOTALBYTES>, the size of the image once applied
+    uint64_t fileCount = 0;    // <FILECOUNT>
+    uint64_t dirCount = 0;     // <DIRCOUNT>
+};
+
+// Function declarations for reading WIM files
+bool ReadWimHeader(std::ifstream& file, WimHeader& header);
+bool ReadWimLookupTable(std::ifstream& file, const WimHeader& header, std::vector<WimLookupEntry>& entries);
+bool ReadWimXml(std::ifstream& file, const WimHeader& header, std::string& xml);
+std::vector<WimImageInfo> ParseWimImages(const std::string& xml);
+bool PrintWimInfo(const std::string& wimPath);
+
+// Function declarations for reading resources and image metadata
+bool ReadWimChunkTable(std::ifstream& file, const WimResourceHeader& res, uint32_t chunkSize, std::vector<uint64_t>& chunkOffsets);
+bool DecompressWimChunk(uint32_t headerFlags, const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize);
+bool ReadWimResource(std::ifstream& file, const WimHeader& header, const WimResourceHeader& res, std::vector<uint8_t>& data);
+bool ReadWimResourceChunks(std::ifstream& file, const WimHeader& header, const WimResourceHeader& res,
+    const std::function<bool(const uint8_t*, size_t)>& consume);
+bool CollectWimImageStreams(const std::vector<uint8_t>& metadata, std::vector<WimHash>& hashes);
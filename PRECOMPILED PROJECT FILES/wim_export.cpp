@@ -0,0 +1,875 @@
+#include "wim_export.h"
+#include "lzms.h"
+#include "lzx.h"
+#include "sha1.h"
+#include "thread_pool.h"
+#include "wim.h"
+#include "xpress.h"
+#include <algorithm> // std::sort
+#include <atomic>    // std::atomic flags shared by the ESD pipeline threads
+#include <chrono>    // std::chrono for timing the export
+#include <cstdio>    // std::remove for the benchmark's scratch files
+#include <cstring>   // std::memcpy
+#include <iostream>  // std::cout and std::cerr for output
+#include <map>       // std::map from hash to lookup table entry
+#include <random>    // std::random_device for the new WIM's GUID
+#include <thread>    // std::thread for the ESD pipeline stages
+
+// Number of chunks each thread gets per batch (2 MiB of input per thread)
+static constexpr size_t EXPORT_CHUNKS_PER_THREAD = 64;
+// Size of the blocks the integrity table hashes, same as DISM
+static constexpr uint32_t WIM_INTEGRITY_CHUNK_SIZE = 10 * 1024 * 1024;
+// Number of integrity table blocks read and hashed together
+static constexpr size_t INTEGRITY_BATCH = 8;
+
+// Writes a little-endian 16-bit value to a byte buffer
+static void PutLe16(uint8_t* p, uint16_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+// Writes a little-endian 32-bit value to a byte buffer
+static void PutLe32(uint8_t* p, uint32_t value) {
+    PutLe16(p, static_cast<uint16_t>(value));
+    PutLe16(p + 2, static_cast<uint16_t>(value >> 16));
+}
+
+// Writes a little-endian 64-bit value to a byte buffer
+static void PutLe64(uint8_t* p, uint64_t value) {
+    PutLe32(p, static_cast<uint32_t>(value));
+    PutLe32(p + 4, static_cast<uint32_t>(value >> 32));
+}
+
+// Encodes a 24 byte resource header (7 byte size, 1 byte flags, 8 byte offset, 8 byte original size)
+static void PutResourceHeader(uint8_t* p, const WimResourceHeader& res) {
+    PutLe64(p, res.sizeInWim);
+    p[7] = res.flags;
+    PutLe64(p + 8, res.offsetInWim);
+    PutLe64(p + 16, res.originalSize);
+}
+
+// Reads 'size' bytes at 'offset' from the file into 'buffer'
+static bool ReadAt(std::ifstream& file, uint64_t offset, void* buffer, size_t size) {
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    file.read(static_cast<char*>(buffer), static_cast<std::streamsize>(size));
+    return file.gcount() == static_cast<std::streamsize>(size);
+}
+
+// Converts UTF-8 text to UTF-16LE with a byte order mark, the encoding WIM stores its XML data in
+static std::vector<uint8_t> EncodeUtf16(const std::string& text) {
+    std::vector<uint8_t> out = { 0xFF, 0xFE };
+    out.reserve(text.size() * 2 + 2);
+    auto putUnit = [&](uint32_t unit) {
+        out.push_back(static_cast<uint8_t>(unit));
+        out.push_back(static_cast<uint8_t>(unit >> 8));
+    };
+    for (size_t i = 0; i < text.size();) {
+        uint8_t c = static_cast<uint8_t>(text[i]);
+        uint32_t cp = c;
+        size_t extra = 0;
+        if (c >= 0xF0) { cp = c & 0x07; extra = 3; }
+        else if (c >= 0xE0) { cp = c & 0x0F; extra = 2; }
+        else if (c >= 0xC0) { cp = c & 0x1F; extra = 1; }
+        i++;
+        for (; extra > 0 && i < text.size(); extra--, i++) {
+            cp = (cp << 6) | (static_cast<uint8_t>(text[i]) & 0x3F);
+        }
+        if (cp >= 0x10000) { // Outside the basic plane, needs a surrogate pair
+            cp -= 0x10000;
+            putUnit(0xD800 + (cp >> 10));
+            putUnit(0xDC00 + (cp & 0x3FF));
+        }
+        else {
+            putUnit(cp);
+        }
+    }
+    return out;
+}
+
+// Returns the <IMAGE> element of one image from the WIM's XML data, renumbered to INDEX="1"
+static std::string ExtractImageXml(const std::string& xml, int index) {
+    std::string open = "<IMAGE INDEX=\"" + std::to_string(index) + "\"";
+    size_t start = xml.find(open);
+    if (start == std::string::npos) {
+        return "<IMAGE INDEX=\"1\"></IMAGE>";
+    }
+    size_t end = xml.find("</IMAGE>", start);
+    if (end == std::string::npos) {
+        return "<IMAGE INDEX=\"1\"></IMAGE>";
+    }
+    return "<IMAGE INDEX=\"1\"" + xml.substr(start + open.size(), end + 8 - start - open.size());
+}
+
+// Returns the header flags of an export: those of the source, such as READONLY, with its compression type swapped
+// for 'compressionFlag' and SPANNED dropped, since the export is one whole file
+static uint32_t ExportHeaderFlags(uint32_t sourceFlags, uint32_t compressionFlag) {
+    const uint32_t replaced = WIM_HDR_FLAG_COMPRESS_XPRESS | WIM_HDR_FLAG_COMPRESS_LZX | WIM_HDR_FLAG_COMPRESS_LZMS | WIM_HDR_FLAG_SPANNED;
+    return (sourceFlags & ~replaced) | WIM_HDR_FLAG_COMPRESSION | compressionFlag;
+}
+
+// Everything the exporters need from the source WIM
+struct ExportSource {
+    std::ifstream file;
+    WimHeader header;
+    std::vector<WimLookupEntry> lookupTable;
+    std::string xml;
+    const WimLookupEntry* metadataEntry = nullptr; // Metadata resource of the exported image
+    std::vector<uint8_t> metadata;                 // Uncompressed metadata of the exported image
+    std::vector<std::pair<const WimLookupEntry*, uint32_t>> streams; // Streams the image uses and how often, in file order
+};
+
+// Function to open the source WIM, read the image's metadata and find every stream the image references
+static bool OpenExportSource(const std::string& sourcePath, int sourceIndex, ExportSource& source) {
+    source.file.open(sourcePath, std::ios::binary);
+    if (!source.file) {
+        std::cerr << "Error: Unable to open " << sourcePath << "\n";
+        return false;
+    }
+    const WimHeader& header = source.header;
+    if (!ReadWimHeader(source.file, source.header) || !ReadWimLookupTable(source.file, header, source.lookupTable) ||
+        !ReadWimXml(source.file, header, source.xml)) {
+        return false;
+    }
+    if (header.totalParts > 1 || (header.flags & WIM_HDR_FLAG_SPANNED)) {
+        std::cerr << "Error: Split WIM files are not supported.\n";
+        return false;
+    }
+
+    // Image N is described by the Nth metadata resource in the lookup table
+    std::vector<const WimLookupEntry*> metadataEntries;
+    std::map<WimHash, const WimLookupEntry*> streamsByHash;
+    for (const WimLookupEntry& entry : source.lookupTable) {
+        if (entry.resource.flags & WIM_RESHDR_FLAG_METADATA) {
+            metadataEntries.push_back(&entry);
+        }
+        else {
+            WimHash hash;
+            std::memcpy(hash.data(), entry.hash, WIM_HASH_SIZE);
+            streamsByHash[hash] = &entry;
+        }
+    }
+    if (sourceIndex < 1 || static_cast<size_t>(sourceIndex) > metadataEntries.size()) {
+        std::cerr << "Error: Image index " << sourceIndex << " does not exist in " << sourcePath << "\n";
+        return false;
+    }
+    source.metadataEntry = metadataEntries[sourceIndex - 1];
+    std::vector<WimHash> references;
+    if (!ReadWimResource(source.file, header, source.metadataEntry->resource, source.metadata) ||
+        !CollectWimImageStreams(source.metadata, references)) {
+        return false;
+    }
+    std::map<WimHash, uint32_t> referenceCounts;
+    for (const WimHash& hash : references) {
+        referenceCounts[hash]++;
+    }
+    for (const auto& item : referenceCounts) {
+        auto found = streamsByHash.find(item.first);
+        if (found == streamsByHash.end()) {
+            std::cerr << "Error: The image references data that is missing from " << sourcePath << "\n";
+            return false;
+        }
+        if (found->second->resource.flags & WIM_RESHDR_FLAG_SOLID) {
+            std::cerr << "Error: Solid WIM resources (ESD files) are not supported.\n";
+            return false;
+        }
+        source.streams.emplace_back(found->second, item.second);
+    }
+    // Read the source front to back
+    std::sort(source.streams.begin(), source.streams.end(), [](const auto& a, const auto& b) {
+        return a.first->resource.offsetInWim < b.first->resource.offsetInWim;
+    });
+    return true;
+}
+
+// Function to finish a new single-image WIM once every resource is written: adds the lookup table, the XML data,
+// the integrity table and finally the header. 'bootMetadata' is the image's metadata if the image is bootable.
+// Removes the file when it cannot be finished, so no WIM with a blank header is left behind.
+static bool FinishWimFile(std::fstream& dst, const std::string& destinationPath, const std::vector<WimLookupEntry>& entries,
+    const std::string& imageXml, bool checkIntegrity, uint32_t version, uint32_t flags, uint32_t chunkSize,
+    const WimResourceHeader* bootMetadata, uint64_t& fileSize) {
+    // Lookup table, always stored uncompressed
+    WimHeader newHeader;
+    std::vector<uint8_t> table(entries.size() * WIM_LOOKUP_ENTRY_SIZE);
+    for (size_t r = 0; r < entries.size(); r++) {
+        uint8_t* p = table.data() + r * WIM_LOOKUP_ENTRY_SIZE;
+        const WimLookupEntry& entry = entries[r];
+        PutResourceHeader(p, entry.resource);
+        PutLe16(p + 24, entry.partNumber);
+        PutLe32(p + 26, entry.referenceCount);
+        std::memcpy(p + 30, entry.hash, WIM_HASH_SIZE);
+    }
+    newHeader.lookupTable.offsetInWim = static_cast<uint64_t>(dst.tellp());
+    newHeader.lookupTable.sizeInWim = table.size();
+    newHeader.lookupTable.originalSize = table.size();
+    dst.write(reinterpret_cast<const char*>(table.data()), table.size());
+
+    // XML data describing the single exported image
+    uint64_t xmlOffset = static_cast<uint64_t>(dst.tellp());
+    std::string newXml = "<WIM><TOTALBYTES>" + std::to_string(xmlOffset) + "</TOTALBYTES>" + imageXml + "</WIM>";
+    std::vector<uint8_t> xmlData = EncodeUtf16(newXml);
+    newHeader.xmlData.offsetInWim = xmlOffset;
+    newHeader.xmlData.sizeInWim = xmlData.size();
+    newHeader.xmlData.originalSize = xmlData.size();
+    dst.write(reinterpret_cast<const char*>(xmlData.data()), xmlData.size());
+
+    // Integrity table: SHA-1 of every 10 MiB block between the header and the end of the lookup table
+    if (checkIntegrity) {
+        uint64_t integrityOffset = static_cast<uint64_t>(dst.tellp());
+        uint64_t regionEnd = newHeader.lookupTable.offsetInWim + newHeader.lookupTable.sizeInWim;
+        uint64_t numBlocks = (regionEnd - WIM_HEADER_SIZE + WIM_INTEGRITY_CHUNK_SIZE - 1) / WIM_INTEGRITY_CHUNK_SIZE;
+        std::vector<uint8_t> integrity(12 + static_cast<size_t>(numBlocks) * WIM_HASH_SIZE);
+        PutLe32(integrity.data(), static_cast<uint32_t>(integrity.size()));
+        PutLe32(integrity.data() + 4, static_cast<uint32_t>(numBlocks));
+        PutLe32(integrity.data() + 8, WIM_INTEGRITY_CHUNK_SIZE);
+        // Blocks are read 8 at a time and hashed side by side; only the last one can be shorter
+        std::vector<char> blocks(INTEGRITY_BATCH * WIM_INTEGRITY_CHUNK_SIZE);
+        for (uint64_t first = 0; first < numBlocks; first += INTEGRITY_BATCH) {
+            uint64_t start = WIM_HEADER_SIZE + first * WIM_INTEGRITY_CHUNK_SIZE;
+            size_t size = static_cast<size_t>(std::min<uint64_t>(blocks.size(), regionEnd - start));
+            dst.seekg(static_cast<std::streamoff>(start));
+            dst.read(blocks.data(), size);
+            const uint8_t* blockData[INTEGRITY_BATCH];
+            size_t fullBlocks = size / WIM_INTEGRITY_CHUNK_SIZE;
+            for (size_t i = 0; i < fullBlocks; i++) {
+                blockData[i] = reinterpret_cast<const uint8_t*>(blocks.data()) + i * WIM_INTEGRITY_CHUNK_SIZE;
+            }
+            uint8_t* hashes = integrity.data() + 12 + first * WIM_HASH_SIZE;
+            Sha1BufferBatch(blockData, fullBlocks, WIM_INTEGRITY_CHUNK_SIZE, reinterpret_cast<uint8_t (*)[SHA1_DIGEST_SIZE]>(hashes));
+            if (size % WIM_INTEGRITY_CHUNK_SIZE != 0) {
+                Sha1Buffer(blocks.data() + fullBlocks * WIM_INTEGRITY_CHUNK_SIZE, size % WIM_INTEGRITY_CHUNK_SIZE,
+                    hashes + fullBlocks * WIM_HASH_SIZE);
+            }
+        }
+        dst.clear();
+        dst.seekp(static_cast<std::streamoff>(integrityOffset));
+        newHeader.integrityTable.offsetInWim = integrityOffset;
+        newHeader.integrityTable.sizeInWim = integrity.size();
+        newHeader.integrityTable.originalSize = integrity.size();
+        dst.write(reinterpret_cast<const char*>(integrity.data()), integrity.size());
+    }
+    fileSize = static_cast<uint64_t>(dst.tellp());
+
+    // Finally the header, now that every location is known
+    std::random_device random;
+    uint8_t h[WIM_HEADER_SIZE] = {};
+    std::memcpy(h, "MSWIM\0\0\0", 8);
+    PutLe32(h + 8, WIM_HEADER_SIZE);
+    PutLe32(h + 12, version);
+    PutLe32(h + 16, flags);
+    PutLe32(h + 20, chunkSize);
+    for (int i = 0; i < 16; i += 4) {
+        PutLe32(h + 24 + i, random());
+    }
+    PutLe16(h + 40, 1); // Part 1...
+    PutLe16(h + 42, 1); // ...of 1
+    PutLe32(h + 44, 1); // One image
+    PutResourceHeader(h + 48, newHeader.lookupTable);
+    PutResourceHeader(h + 72, newHeader.xmlData);
+    if (bootMetadata) { // Keep the image bootable if it was
+        PutResourceHeader(h + 96, *bootMetadata);
+        PutLe32(h + 120, 1);
+    }
+    PutResourceHeader(h + 124, newHeader.integrityTable);
+    dst.seekp(0);
+    dst.write(reinterpret_cast<const char*>(h), sizeof(h));
+    dst.close();
+    if (!dst) {
+        std::cerr << "Error: Unable to write " << destinationPath << "\n";
+        std::remove(destinationPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// One resource that goes into the new WIM
+struct ExportResource {
+    const WimLookupEntry* source = nullptr;    // Entry in the source WIM, or null for in-memory data
+    const std::vector<uint8_t>* memory = nullptr; // In-memory data (the image metadata)
+    bool rawCopy = false;                       // Copy the compressed bytes without touching them
+    WimLookupEntry output;                      // Entry for the new lookup table
+};
+
+// One chunk handed to the worker threads
+struct ExportChunk {
+    size_t resource = 0;          // Index into the resource list
+    size_t index = 0;             // Chunk number inside the resource
+    size_t originalSize = 0;      // Uncompressed size of the chunk
+    bool inputCompressed = false; // Input must be decompressed first
+    std::vector<uint8_t> input;   // Chunk as read from the source
+    std::vector<uint8_t> output;  // Chunk as it will be written
+    bool ok = false;
+};
+
+// Function to export one image of a WIM into a new single-image WIM, compressing chunks on all cores
+bool ExportWimImage(const std::string& sourcePath, int sourceIndex, const std::string& destinationPath,
+    const WimExportOptions& options, WimExportStats* stats) {
+    auto startTime = std::chrono::steady_clock::now();
+    ExportSource source;
+    if (!OpenExportSource(sourcePath, sourceIndex, source)) {
+        return false;
+    }
+    std::ifstream& src = source.file;
+    const WimHeader& header = source.header;
+    const WimLookupEntry& metadataEntry = *source.metadataEntry;
+    const std::vector<uint8_t>& metadata = source.metadata;
+
+    // Work out which resources the image needs and how each one gets into the new WIM
+    const uint32_t targetFlag = (options.compression == WimCompression::Xpress) ? WIM_HDR_FLAG_COMPRESS_XPRESS : WIM_HDR_FLAG_COMPRESS_LZX;
+    const bool sameFormat = (header.flags & targetFlag) && header.chunkSize == WIM_CHUNK_SIZE;
+    const bool canDecompress = (header.flags & (WIM_HDR_FLAG_COMPRESS_LZX | WIM_HDR_FLAG_COMPRESS_XPRESS)) && header.chunkSize == WIM_CHUNK_SIZE;
+    std::vector<ExportResource> resources;
+    ExportResource metadataResource;
+    metadataResource.memory = &metadata;
+    metadataResource.output = metadataEntry;
+    metadataResource.output.resource.flags = WIM_RESHDR_FLAG_METADATA | WIM_RESHDR_FLAG_COMPRESSED;
+    metadataResource.output.resource.originalSize = metadata.size();
+    metadataResource.output.partNumber = 1;
+    metadataResource.output.referenceCount = 1;
+    resources.push_back(metadataResource);
+    for (const auto& stream : source.streams) {
+        const WimLookupEntry& entry = *stream.first;
+        bool compressed = (entry.resource.flags & WIM_RESHDR_FLAG_COMPRESSED) != 0;
+        if (compressed && !canDecompress && !(sameFormat && !options.forceRecompress)) {
+            std::cerr << "Error: This WIM uses a compression format MODWIN cannot read.\n";
+            return false;
+        }
+        ExportResource resource;
+        resource.source = &entry;
+        resource.rawCopy = compressed && sameFormat && !options.forceRecompress;
+        resource.output = entry;
+        resource.output.resource.flags = WIM_RESHDR_FLAG_COMPRESSED;
+        resource.output.partNumber = 1;
+        resource.output.referenceCount = stream.second;
+        resources.push_back(resource);
+    }
+    uint64_t totalBytes = 0;
+    for (const ExportResource& resource : resources) {
+        totalBytes += resource.output.resource.originalSize;
+    }
+
+    std::fstream dst(destinationPath, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    if (!dst) {
+        std::cerr << "Error: Unable to create " << destinationPath << "\n";
+        return false;
+    }
+    std::vector<uint8_t> headerBuf(WIM_HEADER_SIZE, 0);
+    dst.write(reinterpret_cast<const char*>(headerBuf.data()), headerBuf.size()); // Real header is written last
+
+    WorkerPool pool(options.threadCount);
+    const size_t batchLimit = pool.ThreadCount() * EXPORT_CHUNKS_PER_THREAD;
+    std::vector<ExportChunk> batch(batchLimit);
+    size_t batchSize = 0;
+    uint64_t bytesDone = 0;
+    uint64_t bytesCompressed = 0;
+    int lastPercent = -1;
+    uint64_t tableOffset = 0;        // Where the chunk table of the resource being written starts
+    std::vector<uint64_t> chunkEnds; // End of every chunk written so far, relative to the end of the table
+    bool failed = false;
+
+    auto showProgress = [&]() {
+        int percent = totalBytes ? static_cast<int>(bytesDone * 100 / totalBytes) : 100;
+        if (options.showProgress && percent != lastPercent) {
+            std::cout << "\rExporting image " << sourceIndex << ": " << percent << "%" << std::flush;
+            lastPercent = percent;
+        }
+    };
+
+    // Decompresses (if needed) and compresses one chunk, runs on the worker threads
+    const std::function<void(size_t)> compressChunk = [&](size_t i) {
+        ExportChunk& chunk = batch[i];
+        thread_local std::vector<uint8_t> plain;
+        const uint8_t* data = chunk.input.data();
+        if (chunk.inputCompressed) {
+            plain.resize(chunk.originalSize);
+            if (!DecompressWimChunk(header.flags, chunk.input.data(), chunk.input.size(), plain.data(), chunk.originalSize)) {
+                chunk.ok = false;
+                return;
+            }
+            data = plain.data();
+        }
+        chunk.output.resize(chunk.originalSize);
+        size_t size = (options.compression == WimCompression::Xpress)
+            ? XpressCompress(data, chunk.originalSize, chunk.output.data(), chunk.output.size())
+            : LzxCompress(data, chunk.originalSize, chunk.output.data(), chunk.output.size());
+        if (size == 0) { // Did not get smaller, store it as it is
+            std::memcpy(chunk.output.data(), data, chunk.originalSize);
+            size = chunk.originalSize;
+        }
+        chunk.output.resize(size);
+        chunk.ok = true;
+    };
+
+    // Compresses the pending batch in parallel and writes the chunks out in order
+    auto flushBatch = [&]() {
+        if (batchSize == 0 || failed) {
+            return;
+        }
+        pool.ParallelFor(batchSize, compressChunk);
+        for (size_t i = 0; i < batchSize && !failed; i++) {
+            ExportChunk& chunk = batch[i];
+            if (!chunk.ok) {
+                std::cerr << "\nError: A resource in " << sourcePath << " is corrupt.\n";
+                failed = true;
+                break;
+            }
+            WimResourceHeader& res = resources[chunk.resource].output.resource;
+            uint64_t numChunks = (res.originalSize + WIM_CHUNK_SIZE - 1) / WIM_CHUNK_SIZE;
+            uint64_t entrySize = (res.originalSize > 0xFFFFFFFFULL) ? 8 : 4;
+            if (chunk.index == 0) { // First chunk, reserve room for the chunk table
+                tableOffset = static_cast<uint64_t>(dst.tellp());
+                res.offsetInWim = tableOffset;
+                std::vector<char> table(static_cast<size_t>((numChunks - 1) * entrySize), 0);
+                dst.write(table.data(), table.size());
+                chunkEnds.clear();
+            }
+            dst.write(reinterpret_cast<const char*>(chunk.output.data()), chunk.output.size());
+            chunkEnds.push_back((chunkEnds.empty() ? 0 : chunkEnds.back()) + chunk.output.size());
+            bytesDone += chunk.originalSize;
+            if (chunk.index + 1 == numChunks) { // Last chunk, go back and fill in the chunk table
+                std::vector<uint8_t> table(static_cast<size_t>((numChunks - 1) * entrySize));
+                for (uint64_t c = 0; c + 1 < numChunks; c++) {
+                    if (entrySize == 8) {
+                        PutLe64(table.data() + c * 8, chunkEnds[c]);
+                    }
+                    else {
+                        PutLe32(table.data() + c * 4, static_cast<uint32_t>(chunkEnds[c]));
+                    }
+                }
+                uint64_t end = static_cast<uint64_t>(dst.tellp());
+                dst.seekp(static_cast<std::streamoff>(tableOffset));
+                dst.write(reinterpret_cast<const char*>(table.data()), table.size());
+                dst.seekp(static_cast<std::streamoff>(end));
+                res.sizeInWim = end - tableOffset;
+            }
+        }
+        batchSize = 0;
+        showProgress();
+    };
+
+    std::vector<uint64_t> chunkOffsets;
+    std::vector<char> copyBuffer(1024 * 1024);
+    for (size_t r = 0; r < resources.size() && !failed; r++) {
+        ExportResource& resource = resources[r];
+        WimResourceHeader& out = resource.output.resource;
+        if (resource.rawCopy || out.originalSize == 0) { // Already in the right format, copy it byte for byte
+            flushBatch();
+            const WimResourceHeader& in = resource.source->resource;
+            out.offsetInWim = static_cast<uint64_t>(dst.tellp());
+            out.sizeInWim = in.sizeInWim;
+            out.flags = in.flags;
+            for (uint64_t done = 0; done < in.sizeInWim && !failed;) {
+                size_t size = static_cast<size_t>(std::min<uint64_t>(copyBuffer.size(), in.sizeInWim - done));
+                if (!ReadAt(src, in.offsetInWim + done, copyBuffer.data(), size)) {
+                    std::cerr << "\nError: Unable to read " << sourcePath << "\n";
+                    failed = true;
+                    break;
+                }
+                dst.write(copyBuffer.data(), size);
+                done += size;
+            }
+            bytesDone += out.originalSize;
+            showProgress();
+            continue;
+        }
+        bool sourceCompressed = resource.source && (resource.source->resource.flags & WIM_RESHDR_FLAG_COMPRESSED);
+        if (sourceCompressed && !ReadWimChunkTable(src, resource.source->resource, header.chunkSize, chunkOffsets)) {
+            failed = true;
+            break;
+        }
+        uint64_t numChunks = (out.originalSize + WIM_CHUNK_SIZE - 1) / WIM_CHUNK_SIZE;
+        for (uint64_t c = 0; c < numChunks && !failed; c++) {
+            ExportChunk& chunk = batch[batchSize];
+            chunk.resource = r;
+            chunk.index = static_cast<size_t>(c);
+            chunk.originalSize = static_cast<size_t>(std::min<uint64_t>(WIM_CHUNK_SIZE, out.originalSize - c * WIM_CHUNK_SIZE));
+            chunk.inputCompressed = sourceCompressed;
+            chunk.ok = false;
+            bool readOk = true;
+            if (resource.memory) {
+                const uint8_t* data = resource.memory->data() + c * WIM_CHUNK_SIZE;
+                chunk.input.assign(data, data + chunk.originalSize);
+            }
+            else if (sourceCompressed) {
+                chunk.input.resize(static_cast<size_t>(chunkOffsets[c + 1] - chunkOffsets[c]));
+                readOk = chunk.input.size() <= WIM_CHUNK_SIZE && ReadAt(src, chunkOffsets[c], chunk.input.data(), chunk.input.size());
+            }
+            else {
+                chunk.input.resize(chunk.originalSize);
+                readOk = ReadAt(src, resource.source->resource.offsetInWim + c * WIM_CHUNK_SIZE, chunk.input.data(), chunk.input.size());
+            }
+            if (!readOk) {
+                std::cerr << "\nError: Unable to read " << sourcePath << "\n";
+                failed = true;
+                break;
+            }
+            bytesCompressed += chunk.originalSize;
+            if (++batchSize == batchLimit) {
+                flushBatch();
+            }
+        }
+    }
+    flushBatch();
+    if (failed || !dst) {
+        if (!failed) {
+            std::cerr << "\nError: Unable to write " << destinationPath << "\n";
+        }
+        dst.close();
+        std::remove(destinationPath.c_str());
+        return false;
+    }
+    if (options.showProgress) {
+        std::cout << "\n";
+    }
+
+    std::vector<WimLookupEntry> entries;
+    for (const ExportResource& resource : resources) {
+        entries.push_back(resource.output);
+    }
+    bool bootable = header.bootIndex == static_cast<uint32_t>(sourceIndex);
+    uint64_t fileSize = 0;
+    if (!FinishWimFile(dst, destinationPath, entries, ExtractImageXml(source.xml, sourceIndex), options.checkIntegrity,
+        WIM_VERSION_DEFAULT, ExportHeaderFlags(header.flags, targetFlag), WIM_CHUNK_SIZE,
+        bootable ? &resources[0].output.resource : nullptr, fileSize)) {
+        return false;
+    }
+
+    if (stats) {
+        stats->bytesProcessed = totalBytes;
+        stats->bytesCompressed = bytesCompressed;
+        stats->bytesWritten = fileSize;
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        stats->threads = pool.ThreadCount();
+    }
+    return true;
+}
+
+// One solid block travelling through the ESD pipeline
+struct SolidChunk {
+    size_t index = 0;          // Block number inside the solid resource
+    size_t originalSize = 0;   // Uncompressed size of the block
+    std::vector<uint8_t> data; // Uncompressed block, replaced by the compressed block when that is smaller
+};
+
+// Function to write an in-memory resource (the image metadata) as a normal chunked LZMS resource, compressing
+// the chunks on the pool's threads. Fills in the offset and size of 'res'.
+static bool WriteLzmsResource(std::fstream& dst, const std::vector<uint8_t>& data, WorkerPool& pool, WimResourceHeader& res) {
+    size_t numChunks = (data.size() + WIM_LZMS_CHUNK_SIZE - 1) / WIM_LZMS_CHUNK_SIZE;
+    std::vector<std::vector<uint8_t>> chunks(numChunks);
+    pool.ParallelFor(numChunks, [&](size_t i) {
+        size_t offset = i * WIM_LZMS_CHUNK_SIZE;
+        size_t size = std::min<size_t>(WIM_LZMS_CHUNK_SIZE, data.size() - offset);
+        std::vector<uint8_t>& out = chunks[i];
+        out.resize(size);
+        size_t packed = LzmsCompress(data.data() + offset, size, out.data(), out.size());
+        if (packed == 0) { // Did not get smaller, store it as it is
+            std::memcpy(out.data(), data.data() + offset, size);
+            packed = size;
+        }
+        out.resize(packed);
+    });
+    uint64_t entrySize = (data.size() > 0xFFFFFFFFULL) ? 8 : 4;
+    std::vector<uint8_t> table(numChunks > 0 ? static_cast<size_t>((numChunks - 1) * entrySize) : 0);
+    uint64_t end = 0;
+    for (size_t i = 0; i + 1 < numChunks; i++) {
+        end += chunks[i].size();
+        if (entrySize == 8) {
+            PutLe64(table.data() + i * 8, end);
+        }
+        else {
+            PutLe32(table.data() + i * 4, static_cast<uint32_t>(end));
+        }
+    }
+    res.offsetInWim = static_cast<uint64_t>(dst.tellp());
+    dst.write(reinterpret_cast<const char*>(table.data()), table.size());
+    for (const std::vector<uint8_t>& chunk : chunks) {
+        dst.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    }
+    res.sizeInWim = static_cast<uint64_t>(dst.tellp()) - res.offsetInWim;
+    res.originalSize = data.size();
+    return static_cast<bool>(dst);
+}
+
+// Function to export one image of a WIM into a new solid LZMS compressed ESD, like DISM's /Compress:recovery.
+// Reading the source, compressing the solid blocks and writing them run at the same time as a pipeline: a reader
+// thread fills blocks, one LZMS thread per core compresses them and the calling thread writes them out in order.
+bool ExportWimImageToEsd(const std::string& sourcePath, int sourceIndex, const std::string& destinationPath,
+    const EsdExportOptions& options, WimExportStats* stats) {
+    auto startTime = std::chrono::steady_clock::now();
+    const uint32_t solidChunkSize = options.solidChunkSize;
+    if (!IsValidSolidChunkSize(solidChunkSize)) {
+        std::cerr << "Error: The solid block size must be a power of 2 between 64 KiB and 1 GiB.\n";
+        return false;
+    }
+    ExportSource source;
+    if (!OpenExportSource(sourcePath, sourceIndex, source)) {
+        return false;
+    }
+    const WimHeader& header = source.header;
+
+    // Every stream goes into one solid resource, in the order they are read
+    std::vector<WimLookupEntry> entries;
+    uint64_t solidSize = 0;
+    for (const auto& stream : source.streams) {
+        WimLookupEntry entry = *stream.first;
+        entry.resource.flags = WIM_RESHDR_FLAG_SOLID | WIM_RESHDR_FLAG_COMPRESSED;
+        entry.resource.offsetInWim = solidSize; // Solid streams store their offset inside the uncompressed block data
+        entry.resource.sizeInWim = entry.resource.originalSize;
+        entry.partNumber = 1;
+        entry.referenceCount = stream.second;
+        entries.push_back(entry);
+        solidSize += entry.resource.originalSize;
+    }
+    const size_t numChunks = static_cast<size_t>((solidSize + solidChunkSize - 1) / solidChunkSize);
+    const unsigned threads = options.threadCount ? options.threadCount : std::max(1U, std::thread::hardware_concurrency());
+
+    std::fstream dst(destinationPath, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    if (!dst) {
+        std::cerr << "Error: Unable to create " << destinationPath << "\n";
+        return false;
+    }
+    std::vector<char> headerBuf(WIM_HEADER_SIZE, 0);
+    dst.write(headerBuf.data(), headerBuf.size()); // Real header is written last
+
+    // Solid resource header: uncompressed size, block size, format and the compressed size of every block
+    uint64_t solidOffset = static_cast<uint64_t>(dst.tellp());
+    std::vector<uint8_t> solidHeader(16 + numChunks * 4, 0);
+    PutLe64(solidHeader.data(), solidSize);
+    PutLe32(solidHeader.data() + 8, solidChunkSize);
+    PutLe32(solidHeader.data() + 12, WIM_SOLID_FORMAT_LZMS);
+    if (numChunks > 0) {
+        dst.write(reinterpret_cast<const char*>(solidHeader.data()), solidHeader.size()); // Sizes are filled in at the end
+    }
+
+    // At most 'threads' blocks wait in each queue, which bounds the memory to a few blocks per thread
+    BoundedQueue<SolidChunk> toCompress(threads);
+    BoundedQueue<SolidChunk> toWrite(threads);
+    std::atomic<bool> failed{ false };
+    auto cancel = [&]() {
+        failed = true;
+        toCompress.Close();
+        toWrite.Close();
+    };
+
+    // Stage 1: read and decompress the source streams back to back, cutting the data into solid blocks
+    std::thread reader([&]() {
+        try {
+            SolidChunk chunk;
+            chunk.data.reserve(solidChunkSize);
+            auto consume = [&](const uint8_t* data, size_t size) {
+                while (size > 0) {
+                    if (failed) {
+                        return false;
+                    }
+                    size_t take = std::min<size_t>(size, solidChunkSize - chunk.data.size());
+                    chunk.data.insert(chunk.data.end(), data, data + take);
+                    data += take;
+                    size -= take;
+                    if (chunk.data.size() == solidChunkSize) {
+                        size_t next = chunk.index + 1;
+                        chunk.originalSize = chunk.data.size();
+                        if (!toCompress.Push(std::move(chunk))) {
+                            return false;
+                        }
+                        chunk = SolidChunk();
+                        chunk.index = next;
+                        chunk.data.reserve(solidChunkSize);
+                    }
+                }
+                return true;
+            };
+            for (const auto& stream : source.streams) {
+                if (!ReadWimResourceChunks(source.file, header, stream.first->resource, consume)) {
+                    cancel();
+                    return;
+                }
+            }
+            if (!chunk.data.empty()) {
+                chunk.originalSize = chunk.data.size();
+                toCompress.Push(std::move(chunk));
+            }
+            toCompress.Close();
+        }
+        catch (const std::exception&) {
+            std::cerr << "\nError: Not enough memory to read the image, try a smaller solid block size.\n";
+            cancel();
+        }
+    });
+
+    // Stage 2: compress blocks with LZMS on every core
+    std::atomic<unsigned> runningCompressors{ threads };
+    std::vector<std::thread> compressors;
+    for (unsigned t = 0; t < threads; t++) {
+        compressors.emplace_back([&]() {
+            try {
+                SolidChunk chunk;
+                std::vector<uint8_t> packed;
+                while (toCompress.Pop(chunk)) {
+                    packed.resize(chunk.originalSize);
+                    size_t size = LzmsCompress(chunk.data.data(), chunk.originalSize, packed.data(), packed.size());
+                    if (size != 0) { // Otherwise the block is stored as it is
+                        packed.resize(size);
+                        chunk.data.swap(packed);
+                    }
+                    if (!toWrite.Push(std::move(chunk))) {
+                        break;
+                    }
+                }
+            }
+            catch (const std::exception&) {
+                std::cerr << "\nError: Not enough memory to compress the image, try a smaller solid block size or fewer threads.\n";
+                cancel();
+            }
+            if (--runningCompressors == 0) {
+                toWrite.Close();
+            }
+        });
+    }
+
+    // Stage 3 (this thread): write the blocks in order, holding back any that finish early
+    std::map<size_t, SolidChunk> finished;
+    std::vector<uint32_t> compressedSizes;
+    uint64_t bytesDone = 0;
+    int lastPercent = -1;
+    SolidChunk chunk;
+    while (compressedSizes.size() < numChunks && toWrite.Pop(chunk)) {
+        finished[chunk.index] = std::move(chunk);
+        for (auto next = finished.find(compressedSizes.size()); next != finished.end(); next = finished.find(compressedSizes.size())) {
+            const SolidChunk& block = next->second;
+            dst.write(reinterpret_cast<const char*>(block.data.data()), block.data.size());
+            compressedSizes.push_back(static_cast<uint32_t>(block.data.size()));
+            bytesDone += block.originalSize;
+            finished.erase(next);
+        }
+        if (!dst) {
+            std::cerr << "\nError: Unable to write " << destinationPath << "\n";
+            cancel();
+            break;
+        }
+        int percent = solidSize ? static_cast<int>(bytesDone * 100 / solidSize) : 100;
+        if (options.showProgress && percent != lastPercent) {
+            std::cout << "\rCompressing image " << sourceIndex << " to ESD: " << percent << "%" << std::flush;
+            lastPercent = percent;
+        }
+    }
+    if (compressedSizes.size() < numChunks) {
+        cancel();
+    }
+    reader.join();
+    for (std::thread& compressor : compressors) {
+        compressor.join();
+    }
+
+    WorkerPool pool(threads);
+    WimLookupEntry metadataEntry = *source.metadataEntry;
+    metadataEntry.resource.flags = WIM_RESHDR_FLAG_METADATA | WIM_RESHDR_FLAG_COMPRESSED;
+    metadataEntry.partNumber = 1;
+    metadataEntry.referenceCount = 1;
+    if (!failed && numChunks > 0) {
+        for (size_t i = 0; i < numChunks; i++) {
+            PutLe32(solidHeader.data() + 16 + i * 4, compressedSizes[i]);
+        }
+        uint64_t solidEnd = static_cast<uint64_t>(dst.tellp());
+        dst.seekp(static_cast<std::streamoff>(solidOffset));
+        dst.write(reinterpret_cast<const char*>(solidHeader.data()), solidHeader.size());
+        dst.seekp(static_cast<std::streamoff>(solidEnd));
+
+        // The lookup entry describing the solid block goes right before the streams stored in it
+        WimLookupEntry solidEntry;
+        solidEntry.resource.flags = WIM_RESHDR_FLAG_SOLID | WIM_RESHDR_FLAG_COMPRESSED;
+        solidEntry.resource.offsetInWim = solidOffset;
+        solidEntry.resource.sizeInWim = solidEnd - solidOffset;
+        solidEntry.resource.originalSize = WIM_SOLID_RESOURCE_MAGIC_SIZE;
+        solidEntry.partNumber = 1;
+        solidEntry.referenceCount = 1;
+        entries.insert(entries.begin(), solidEntry);
+    }
+    if (failed || !WriteLzmsResource(dst, source.metadata, pool, metadataEntry.resource)) {
+        if (!failed) {
+            std::cerr << "\nError: Unable to write " << destinationPath << "\n";
+        }
+        dst.close();
+        std::remove(destinationPath.c_str());
+        return false;
+    }
+    entries.push_back(metadataEntry);
+    if (options.showProgress) {
+        std::cout << "\n";
+    }
+
+    bool bootable = header.bootIndex == static_cast<uint32_t>(sourceIndex);
+    uint64_t fileSize = 0;
+    if (!FinishWimFile(dst, destinationPath, entries, ExtractImageXml(source.xml, sourceIndex), options.checkIntegrity,
+        WIM_VERSION_SOLID, ExportHeaderFlags(header.flags, WIM_HDR_FLAG_COMPRESS_LZMS), WIM_LZMS_CHUNK_SIZE,
+        bootable ? &metadataEntry.resource : nullptr, fileSize)) {
+        return false;
+    }
+
+    if (stats) {
+        stats->bytesProcessed = solidSize + source.metadata.size();
+        stats->bytesCompressed = stats->bytesProcessed;
+        stats->bytesWritten = fileSize;
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        stats->threads = threads;
+    }
+    return true;
+}
+
+// Function to check a solid block size: LZMS takes powers of 2 from 64 KiB up to its 1 GiB buffer limit
+bool IsValidSolidChunkSize(uint64_t solidChunkSize) {
+    return solidChunkSize >= 65536 && solidChunkSize <= LZMS_MAX_BUFFER_SIZE && (solidChunkSize & (solidChunkSize - 1)) == 0;
+}
+
+// Function to compare the single threaded and multi threaded export speed on a real image.
+// Every resource is recompressed so both runs do the same amount of compression work.
+bool BenchmarkWimExport(const std::string& sourcePath, int sourceIndex, const std::string& scratchPath) {
+    unsigned cores = std::max(1U, std::thread::hardware_concurrency());
+    double baseline = 0.0;
+    for (unsigned threads : { 1U, cores }) {
+        WimExportOptions options;
+        options.threadCount = threads;
+        options.forceRecompress = true;
+        options.showProgress = false;
+        WimExportStats stats;
+        std::cout << "Exporting with " << threads << " thread(s)...\n";
+        if (!ExportWimImage(sourcePath, sourceIndex, scratchPath, options, &stats)) {
+            return false;
+        }
+        double mbPerSecond = stats.seconds > 0 ? stats.bytesCompressed / (1024.0 * 1024.0) / stats.seconds : 0.0;
+        if (threads == 1) {
+            baseline = mbPerSecond;
+        }
+        std::cout << "  " << stats.threads << " thread(s): " << stats.seconds << " s, " << mbPerSecond << " MB/s, "
+            << stats.bytesProcessed << " -> " << stats.bytesWritten << " bytes";
+        if (baseline > 0 && threads != 1) {
+            std::cout << ", " << mbPerSecond / baseline << "x faster than 1 thread";
+        }
+        std::cout << "\n";
+        std::remove(scratchPath.c_str());
+        if (cores == 1) {
+            break;
+        }
+    }
+    return true;
+}
+
+// Function to show how the solid block size trades ESD compression speed against the size of the ESD
+bool BenchmarkEsdExport(const std::string& sourcePath, int sourceIndex, const std::string& scratchPath) {
+    for (uint32_t blockMiB : { 4U, 16U, 32U, 64U }) {
+        EsdExportOptions options;
+        options.solidChunkSize = blockMiB * 1024 * 1024;
+        options.showProgress = false;
+        WimExportStats stats;
+        std::cout << "Compressing with " << blockMiB << " MiB solid blocks...\n";
+        if (!ExportWimImageToEsd(sourcePath, sourceIndex, scratchPath, options, &stats)) {
+            return false;
+        }
+        double mbPerSecond = stats.seconds > 0 ? stats.bytesProcessed / (1024.0 * 1024.0) / stats.seconds : 0.0;
+        double ratio = stats.bytesProcessed ? 100.0 * stats.bytesWritten / stats.bytesProcessed : 0.0;
+        std::cout << "  " << blockMiB << " MiB: " << stats.seconds << " s, " << mbPerSecond << " MB/s, "
+            << stats.bytesProcessed << " -> " << stats.bytesWritten << " bytes (" << ratio << "%), "
+            << stats.threads << " thread(s)\n";
+        std::remove(scratchPath.c_str());
+    }
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+// Native replacement for "dism /export-image" that compresses WIM chunks on every CPU core,
+// including solid LZMS compressed ESD files (/Compress:recovery).
+#include <cstdint> // Fixed width integer types
+#include <string>  // std::string for paths
+
+// Compression formats the exporter can write
+enum class WimCompression {
+    Xpress, // Same as DISM's /Compress:fast
+    Lzx     // Same as DISM's /Compress:max
+};
+
+// Settings for ExportWimImage
+struct WimExportOptions {
+    WimCompression compression = WimCompression::Lzx;
+    unsigned threadCount = 0;      // Number of compression threads, 0 uses one per CPU core
+    bool checkIntegrity = true;    // Write an integrity table like /CheckIntegrity
+    bool forceRecompress = false;  // Recompress resources even when they are already in the target format
+    bool showProgress = true;      // Print a percentage while exporting
+};
+
+// Settings for ExportWimImageToEsd
+struct EsdExportOptions {
+    uint32_t solidChunkSize = 32 * 1024 * 1024; // Solid block size (power of 2), bigger gives a smaller ESD but uses more memory
+    unsigned threadCount = 0;      // Number of compression threads, 0 uses one per CPU core
+    bool checkIntegrity = true;    // Write an integrity table like /CheckIntegrity
+    bool showProgress = true;      // Print a percentage while exporting
+};
+
+// Numbers collected during an export
+struct WimExportStats {
+    uint64_t bytesProcessed = 0;   // Uncompressed bytes of every exported resource
+    uint64_t bytesCompressed = 0;  // Uncompressed bytes that went through the compressor
+    uint64_t bytesWritten = 0;     // Size of the new WIM file
+    double seconds = 0.0;          // Wall clock time of the export
+    unsigned threads = 0;          // Threads that did the compression
+};
+
+// Function declarations for exporting WIM images
+bool ExportWimImage(const std::string& sourcePath, int sourceIndex, const std::string& destinationPath,
+    const WimExportOptions& options, WimExportStats* stats = nullptr);
+bool ExportWimImageToEsd(const std::string& sourcePath, int sourceIndex, const std::string& destinationPath,
+    const EsdExportOptions& options, WimExportStats* stats = nullptr);
+bool IsValidSolidChunkSize(uint64_t solidChunkSize);
+bool BenchmarkWimExport(const std::string& sourcePath, int sourceIndex, const std::string& scratchPath);
+bool BenchmarkEsdExport(const std::string& sourcePath, int sourceIndex, const std::string& scratchPath);
@@ -0,0 +1,128 @@
+#include "wim_verify.h"
+#include "direct_io.h"
+#include "sha1.h"
+#include "thread_pool.h"
+#include "wim.h"
+#include <algorithm> // std::min
+#include <chrono>    // std::chrono for timing the check
+#include <cstring>   // std::memcmp for comparing hashes
+#include <fstream>   // std::ifstream for reading the header
+#include <iostream>  // std::cout and std::cerr for output
+#include <vector>    // std::vector for the chunk results
+
+// Number of chunks each work item hashes together with Sha1BufferBatch
+static constexpr size_t VERIFY_CHUNKS_PER_ITEM = 8;
+// Size of the integrity table header: table size, entry count and chunk size
+static constexpr size_t INTEGRITY_HEADER_SIZE = 12;
+
+// Reads a little-endian 32-bit value from a byte buffer
+static uint32_t GetLe32(const uint8_t* p) {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+// Function to check every chunk of a WIM against its integrity table. The table covers the file from the end of
+// the header to the end of the lookup table. False when the WIM cannot be read or has no usable integrity table;
+// a WIM that is read but does not match returns true with 'badChunks' set.
+bool VerifyWimIntegrity(const std::string& wimPath, WimVerifyResult& result, unsigned threadCount) {
+    result = WimVerifyResult();
+    WimHeader header;
+    {
+        std::ifstream file(wimPath, std::ios::binary);
+        if (!file) {
+            std::cerr << "Error: Unable to open " << wimPath << "\n";
+            return false;
+        }
+        if (!ReadWimHeader(file, header)) {
+            return false;
+        }
+    }
+    const WimResourceHeader& tableResource = header.integrityTable;
+    if (tableResource.offsetInWim == 0 || tableResource.sizeInWim < INTEGRITY_HEADER_SIZE) {
+        std::cerr << "Error: " << wimPath << " has no integrity table, it was not saved with /CheckIntegrity.\n";
+        return false;
+    }
+    MappedFile wim;
+    if (!wim.Open(wimPath)) {
+        std::cerr << "Error: Unable to map " << wimPath << " into memory.\n";
+        return false;
+    }
+    if (tableResource.offsetInWim > wim.Size() || tableResource.sizeInWim > wim.Size() - tableResource.offsetInWim) {
+        std::cerr << "Error: The integrity table of " << wimPath << " lies past the end of the file.\n";
+        return false;
+    }
+
+    // The table: its size, the number of hashes, the chunk size and the SHA-1 of each chunk
+    const uint8_t* table = wim.Data() + tableResource.offsetInWim;
+    uint64_t tableSize = GetLe32(table);
+    uint64_t entries = GetLe32(table + 4);
+    uint32_t chunkSize = GetLe32(table + 8);
+    uint64_t regionEnd = header.lookupTable.offsetInWim + header.lookupTable.sizeInWim;
+    if (tableSize != tableResource.sizeInWim || chunkSize == 0 || INTEGRITY_HEADER_SIZE + entries * WIM_HASH_SIZE > tableSize ||
+        regionEnd < WIM_HEADER_SIZE || regionEnd > wim.Size() ||
+        entries != (regionEnd - WIM_HEADER_SIZE + chunkSize - 1) / chunkSize) {
+        std::cerr << "Error: The integrity table of " << wimPath << " is damaged.\n";
+        return false;
+    }
+    const uint8_t* expected = table + INTEGRITY_HEADER_SIZE;
+    result.chunks = entries;
+    result.chunkSize = chunkSize;
+    result.bytesChecked = regionEnd - WIM_HEADER_SIZE;
+
+    // Every chunk but the last has the full size, so groups of them hash side by side
+    std::vector<uint8_t> bad(static_cast<size_t>(entries), 0);
+    size_t items = static_cast<size_t>((entries + VERIFY_CHUNKS_PER_ITEM - 1) / VERIFY_CHUNKS_PER_ITEM);
+    WorkerPool pool(threadCount);
+    auto startTime = std::chrono::steady_clock::now();
+    pool.ParallelFor(items, [&](size_t item) {
+        uint64_t first = uint64_t(item) * VERIFY_CHUNKS_PER_ITEM;
+        size_t count = static_cast<size_t>(std::min<uint64_t>(VERIFY_CHUNKS_PER_ITEM, entries - first));
+        const uint8_t* chunkData[VERIFY_CHUNKS_PER_ITEM];
+        uint8_t digests[VERIFY_CHUNKS_PER_ITEM][SHA1_DIGEST_SIZE];
+        size_t fullChunks = 0;
+        for (size_t i = 0; i < count; i++) {
+            uint64_t start = WIM_HEADER_SIZE + (first + i) * chunkSize;
+            chunkData[i] = wim.Data() + start;
+            if (regionEnd - start >= chunkSize) {
+                fullChunks = i + 1;
+            }
+        }
+        Sha1BufferBatch(chunkData, fullChunks, chunkSize, digests);
+        if (fullChunks < count) { // The short last chunk
+            uint64_t start = WIM_HEADER_SIZE + (first + fullChunks) * chunkSize;
+            Sha1Buffer(chunkData[fullChunks], static_cast<size_t>(regionEnd - start), digests[fullChunks]);
+        }
+        for (size_t i = 0; i < count; i++) {
+            bad[first + i] = std::memcmp(digests[i], expected + (first + i) * WIM_HASH_SIZE, SHA1_DIGEST_SIZE) != 0;
+        }
+    });
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    result.threads = pool.ThreadCount();
+    for (size_t i = 0; i < bad.size(); i++) {
+        if (bad[i]) {
+            if (result.badChunks == 0) {
+                result.firstBadOffset = WIM_HEADER_SIZE + uint64_t(i) * chunkSize;
+            }
+            result.badChunks++;
+        }
+    }
+    return true;
+}
+
+// Function to check a WIM against its integrity table and print the outcome, the standalone verify mode
+bool VerifyWim(const std::string& wimPath) {
+    WimVerifyResult result;
+    std::cout << "Verifying " << wimPath << "...\n";
+    if (!VerifyWimIntegrity(wimPath, result)) {
+        return false;
+    }
+    double mbPerSecond = result.seconds > 0 ? result.bytesChecked / (1024.0 * 1024.0) / result.seconds : 0.0;
+    std::cout << "Checked " << result.chunks << " chunks (" << result.bytesChecked << " bytes) in " << result.seconds
+        << " s, " << mbPerSecond << " MB/s on " << result.threads << " thread(s)\n";
+    if (result.badChunks != 0) {
+        std::cerr << "Error: " << result.badChunks << " chunk(s) do not match the integrity table, the first one at offset "
+            << result.firstBadOffset << " (0x" << std::hex << result.firstBadOffset << std::dec << ").\n";
+        return false;
+    }
+    std::cout << "The WIM matches its integrity table.\n";
+    return true;
+}
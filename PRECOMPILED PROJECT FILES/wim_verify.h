@@ -0,0 +1,20 @@
+#pragma once
+// Checks a WIM against its integrity table (/CheckIntegrity) without DISM. The file is mapped into memory and its
+// chunks are hashed on every CPU core, so a multi-gigabyte install.wim is verified about as fast as the disk reads.
+#include <cstdint> // Fixed width integer types
+#include <string>  // std::string for paths
+
+// Outcome of checking a WIM against its integrity table
+struct WimVerifyResult {
+    uint64_t chunks = 0;          // Chunks listed in the integrity table
+    uint32_t chunkSize = 0;       // Bytes covered by each hash, 10 MiB for DISM
+    uint64_t badChunks = 0;       // Chunks whose hash does not match
+    uint64_t firstBadOffset = 0;  // File offset of the first bad chunk, when there is one
+    uint64_t bytesChecked = 0;
+    double seconds = 0.0;         // Wall clock time of the hashing
+    unsigned threads = 0;
+};
+
+// Function declarations for verifying WIM files
+bool VerifyWimIntegrity(const std::string& wimPath, WimVerifyResult& result, unsigned threadCount = 0);
+bool VerifyWim(const std::string& wimPath);
@@ -0,0 +1,305 @@
+#include "xpress.h"
+#include "huffman.h"
+#include "lz_matchfinder.h"
+#include <algorithm> // std::min
+#include <vector>    // std::vector for the parsed items
+
+// Constants of the XPRESS Huffman format
+static constexpr unsigned XPRESS_NUM_SYMBOLS = 512;     // 256 literals + 16 offset classes * 16 length headers
+static constexpr unsigned XPRESS_MAX_CODEWORD_LEN = 15;
+static constexpr unsigned XPRESS_MIN_MATCH = 3;
+static constexpr unsigned XPRESS_MAX_MATCH = 65538;     // Longest length the 16-bit length field can describe
+static constexpr unsigned XPRESS_END_OF_DATA = 256;     // Symbol Windows expects after the last item
+static constexpr size_t XPRESS_HEADER_SIZE = XPRESS_NUM_SYMBOLS / 2; // Code lengths, two per byte
+
+// ---------------------------------------------------------------------------------------------
+// Compressor
+// ---------------------------------------------------------------------------------------------
+
+// XPRESS interleaves 16-bit words of Huffman bits with raw length bytes. The decoder always has up to
+// two bit words loaded ahead, so the writer keeps two word slots reserved in front of the byte stream.
+class XpressBitWriter {
+public:
+    XpressBitWriter(uint8_t* buffer, size_t capacity)
+        : start(buffer), nextBits(buffer), nextBits2(buffer + 2), nextByte(buffer + 4), end(buffer + capacity) {}
+
+    void WriteBits(uint32_t bits, unsigned count) {
+        bitbuf = (bitbuf << count) | bits;
+        bitcount += count;
+        if (bitcount > 16) {
+            bitcount -= 16;
+            if (end - nextByte >= 2) {
+                PutLe16(nextBits, static_cast<uint16_t>(bitbuf >> bitcount));
+                nextBits = nextBits2;
+                nextBits2 = nextByte;
+                nextByte += 2;
+            }
+            else {
+                overflow = true;
+            }
+        }
+    }
+
+    void WriteByte(uint8_t value) {
+        if (nextByte < end) {
+            *nextByte++ = value;
+        }
+        else {
+            overflow = true;
+        }
+    }
+
+    void WriteU16(uint16_t value) {
+        if (end - nextByte >= 2) {
+            PutLe16(nextByte, value);
+            nextByte += 2;
+        }
+        else {
+            overflow = true;
+        }
+    }
+
+    // Flushes the remaining bits and returns the number of bytes written, 0 on overflow
+    size_t Finish() {
+        if (overflow || end - nextByte < 2) {
+            return 0;
+        }
+        PutLe16(nextBits, static_cast<uint16_t>(bitbuf << (16 - bitcount)));
+        PutLe16(nextBits2, 0);
+        return static_cast<size_t>(nextByte - start);
+    }
+
+private:
+    static void PutLe16(uint8_t* p, uint16_t value) {
+        p[0] = static_cast<uint8_t>(value);
+        p[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    uint8_t* start;
+    uint8_t* nextBits;  // Slot for the next 16 bits
+    uint8_t* nextBits2; // Slot for the 16 bits after that
+    uint8_t* nextByte;  // Where the next raw byte goes
+    uint8_t* end;
+    uint64_t bitbuf = 0;
+    unsigned bitcount = 0;
+    bool overflow = false;
+};
+
+// One parsed item: a literal (sym < 256) or a match with its length and offset details
+struct XpressItem {
+    uint16_t sym;           // Main symbol
+    uint16_t offsetBits;    // Offset without its highest set bit
+    uint32_t adjustedLen;   // Match length minus XPRESS_MIN_MATCH
+};
+
+// Returns the index of the highest set bit
+static unsigned FloorLog2(uint32_t value) {
+    unsigned log = 0;
+    while (value >>= 1) {
+        log++;
+    }
+    return log;
+}
+
+// Function to compress one chunk with XPRESS. Returns the compressed size, or 0 if the chunk
+// did not get smaller (the WIM then stores the chunk uncompressed).
+size_t XpressCompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outCapacity) {
+    if (inSize == 0 || inSize > XPRESS_MAX_CHUNK_SIZE || outCapacity < XPRESS_HEADER_SIZE + 6) {
+        return 0;
+    }
+    thread_local std::vector<XpressItem> items;
+    thread_local LzMatchFinder matchFinder;
+    items.clear();
+    uint32_t freqs[XPRESS_NUM_SYMBOLS] = {};
+    matchFinder.Reset(in, inSize, 16, 16);
+
+    // Adds a match to the item list
+    auto addMatch = [&](unsigned len, uint32_t offset) {
+        unsigned log2Offset = FloorLog2(offset);
+        uint32_t adjustedLen = len - XPRESS_MIN_MATCH;
+        XpressItem item;
+        item.sym = static_cast<uint16_t>(256 + (log2Offset << 4) + std::min(adjustedLen, 15U));
+        item.offsetBits = static_cast<uint16_t>(offset ^ (1U << log2Offset));
+        item.adjustedLen = adjustedLen;
+        freqs[item.sym]++;
+        items.push_back(item);
+    };
+
+    // Greedy parse with one step of lazy evaluation
+    size_t pos = 0;
+    uint32_t offset = 0;
+    unsigned len = matchFinder.FindMatch(pos, XPRESS_MIN_MATCH, XPRESS_MAX_MATCH, 64, inSize, offset);
+    while (pos < inSize) {
+        if (len >= XPRESS_MIN_MATCH && len < 64 && pos + 1 < inSize) {
+            uint32_t nextOffset = 0;
+            unsigned nextLen = matchFinder.FindMatch(pos + 1, XPRESS_MIN_MATCH, XPRESS_MAX_MATCH, 64, inSize, nextOffset);
+            if (nextLen > len) { // A longer match starts one byte later, send a literal instead
+                items.push_back({ in[pos], 0, 0 });
+                freqs[in[pos]]++;
+                pos++;
+                len = nextLen;
+                offset = nextOffset;
+                continue;
+            }
+            addMatch(len, offset);
+            for (size_t i = pos + 2; i < pos + len; i++) {
+                matchFinder.Skip(i);
+            }
+        }
+        else if (len >= XPRESS_MIN_MATCH) {
+            addMatch(len, offset);
+            for (size_t i = pos + 1; i < pos + len; i++) {
+                matchFinder.Skip(i);
+            }
+        }
+        else {
+            items.push_back({ in[pos], 0, 0 });
+            freqs[in[pos]]++;
+            len = 1;
+        }
+        pos += len;
+        len = (pos < inSize) ? matchFinder.FindMatch(pos, XPRESS_MIN_MATCH, XPRESS_MAX_MATCH, 64, inSize, offset) : 0;
+    }
+    freqs[XPRESS_END_OF_DATA]++;
+
+    uint8_t lens[XPRESS_NUM_SYMBOLS];
+    uint32_t codewords[XPRESS_NUM_SYMBOLS];
+    MakeHuffmanCode(XPRESS_NUM_SYMBOLS, XPRESS_MAX_CODEWORD_LEN, freqs, lens, codewords);
+
+    // The header holds the 512 code lengths, two per byte, low nibble first
+    for (unsigned i = 0; i < XPRESS_NUM_SYMBOLS; i += 2) {
+        out[i / 2] = static_cast<uint8_t>(lens[i] | (lens[i + 1] << 4));
+    }
+    XpressBitWriter bits(out + XPRESS_HEADER_SIZE, outCapacity - XPRESS_HEADER_SIZE);
+    for (const XpressItem& item : items) {
+        bits.WriteBits(codewords[item.sym], lens[item.sym]);
+        if (item.sym < 256) {
+            continue;
+        }
+        if (item.adjustedLen >= 0xF) { // Long lengths continue in the byte stream
+            uint8_t byte1 = static_cast<uint8_t>(std::min(item.adjustedLen - 0xF, 0xFFU));
+            bits.WriteByte(byte1);
+            if (byte1 == 0xFF) {
+                bits.WriteU16(static_cast<uint16_t>(item.adjustedLen));
+            }
+        }
+        bits.WriteBits(item.offsetBits, (item.sym >> 4) & 0xF);
+    }
+    bits.WriteBits(codewords[XPRESS_END_OF_DATA], lens[XPRESS_END_OF_DATA]);
+    size_t outSize = bits.Finish();
+    return (outSize != 0 && XPRESS_HEADER_SIZE + outSize < inSize) ? XPRESS_HEADER_SIZE + outSize : 0;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Decompressor
+// ---------------------------------------------------------------------------------------------
+
+// Reads 16-bit little-endian words of bits (most significant first) and raw bytes from the same stream
+class XpressBitReader {
+public:
+    XpressBitReader(const uint8_t* buffer, size_t size) : next(buffer), end(buffer + size) {}
+
+    // Loads one more word if fewer than 'count' bits are buffered (count is at most 16)
+    void EnsureBits(unsigned count) {
+        if (bitsLeft >= static_cast<int>(count)) {
+            return;
+        }
+        uint64_t word = 0;
+        if (end - next >= 2) {
+            word = uint64_t(next[0]) | (uint64_t(next[1]) << 8);
+            next += 2;
+        }
+        else {
+            paddingBits += 16; // Reading past the end gives zeros
+        }
+        bitbuf |= word << (48 - bitsLeft);
+        bitsLeft += 16;
+    }
+
+    uint32_t Peek(unsigned count) const {
+        return count == 0 ? 0 : static_cast<uint32_t>(bitbuf >> (64 - count));
+    }
+
+    void Skip(unsigned count) {
+        bitbuf <<= count;
+        bitsLeft -= count;
+    }
+
+    uint32_t Pop(unsigned count) {
+        uint32_t value = Peek(count);
+        Skip(count);
+        return value;
+    }
+
+    uint8_t ReadByte() {
+        if (next == end) {
+            overrun = true;
+            return 0;
+        }
+        return *next++;
+    }
+
+    uint16_t ReadU16() {
+        uint16_t value = ReadByte();
+        return static_cast<uint16_t>(value | (ReadByte() << 8));
+    }
+
+    // True once bytes or bits past the end of the input have been consumed
+    bool Overrun() const { return overrun || paddingBits > bitsLeft; }
+
+private:
+    const uint8_t* next;
+    const uint8_t* end;
+    uint64_t bitbuf = 0; // Unread bits, left aligned
+    int bitsLeft = 0;    // Number of valid bits in bitbuf
+    int paddingBits = 0; // Number of zero bits in bitbuf that lie past the end of the input
+    bool overrun = false;
+};
+
+// Function to decompress one XPRESS chunk of a WIM resource into exactly 'outSize' bytes
+bool XpressDecompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize) {
+    if (inSize < XPRESS_HEADER_SIZE) {
+        return false;
+    }
+    uint8_t lens[XPRESS_NUM_SYMBOLS];
+    for (unsigned i = 0; i < XPRESS_NUM_SYMBOLS; i += 2) {
+        lens[i] = in[i / 2] & 0xF;
+        lens[i + 1] = in[i / 2] >> 4;
+    }
+    HuffmanDecoder code;
+    if (!code.Build(lens, XPRESS_NUM_SYMBOLS, XPRESS_MAX_CODEWORD_LEN, 11)) {
+        return false;
+    }
+    XpressBitReader bits(in + XPRESS_HEADER_SIZE, inSize - XPRESS_HEADER_SIZE);
+    size_t pos = 0;
+    while (pos < outSize) {
+        bits.EnsureBits(XPRESS_MAX_CODEWORD_LEN);
+        int sym = code.Decode(bits);
+        if (sym < 0) {
+            return false;
+        }
+        if (sym < 256) { // Literal byte
+            out[pos++] = static_cast<uint8_t>(sym);
+            continue;
+        }
+        unsigned len = sym & 0xF;
+        unsigned log2Offset = (sym >> 4) & 0xF;
+        bits.EnsureBits(16);
+        uint32_t offset = (1U << log2Offset) | bits.Pop(log2Offset);
+        if (len == 0xF) {
+            len += bits.ReadByte();
+            if (len == 0xF + 0xFF) {
+                len = bits.ReadU16();
+            }
+        }
+        len += XPRESS_MIN_MATCH;
+        if (offset > pos || len > outSize - pos) {
+            return false; // Match reaches outside the chunk
+        }
+        for (unsigned i = 0; i < len; i++) { // Byte by byte, the source may overlap the destination
+            out[pos + i] = out[pos + i - offset];
+        }
+        pos += len;
+    }
+    return !bits.Overrun();
+}
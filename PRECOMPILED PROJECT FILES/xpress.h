@@ -0,0 +1,12 @@
+#pragma once
+// XPRESS (Huffman variant) compression as used by WIM files created with /Compress:fast.
+// Like LZX, every 32 KiB chunk of a WIM resource is compressed on its own.
+#include <cstddef> // size_t
+#include <cstdint> // Fixed width integer types
+
+// Largest chunk MODWIN compresses with XPRESS
+constexpr size_t XPRESS_MAX_CHUNK_SIZE = 32768;
+
+// Function declarations for XPRESS
+size_t XpressCompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outCapacity);
+bool XpressDecompress(const uint8_t* in, size_t inSize, uint8_t* out, size_t outSize);